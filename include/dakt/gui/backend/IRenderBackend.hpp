@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace dakt::gui {
 
@@ -34,7 +35,8 @@ inline BufferUsage operator|(BufferUsage a, BufferUsage b) { return static_cast<
 
 inline bool operator&(BufferUsage a, BufferUsage b) { return (static_cast<uint32_t>(a) & static_cast<uint32_t>(b)) != 0; }
 
-enum class TextureFormat : uint32_t { R8, RG8, RGBA8, BGRA8, R16F, RGBA16F, R32F, RGBA32F, Depth24Stencil8, Depth32F };
+// A8 stores one byte like R8 but samples as (1, 1, 1, r): alpha masks such as coverage glyph pages
+enum class TextureFormat : uint32_t { R8, RG8, RGBA8, BGRA8, R16F, RGBA16F, R32F, RGBA32F, Depth24Stencil8, Depth32F, A8 };
 
 enum class TextureUsage : uint32_t { Sampled = 1 << 0, Storage = 1 << 1, RenderTarget = 1 << 2, DepthStencil = 1 << 3 };
 
@@ -55,6 +57,7 @@ struct TextureDesc {
     TextureFormat format = TextureFormat::RGBA8;
     TextureUsage usage = TextureUsage::Sampled;
     const void* initialData = nullptr;
+    bool msdf = false; // RGBA8 glyph atlas page holding a multi-channel distance field
 };
 
 // ============================================================================
@@ -70,10 +73,29 @@ struct BackendCapabilities {
     bool supportsTessellation = false;
     bool supportsMSAA = true;
     uint32_t maxMSAASamples = 8;
+    bool supportsShaderClipping = false; // Honors Vertex::clipIndex (ClipMode::Shader)
     std::string deviceName;
     std::string apiVersion;
 };
 
+// ============================================================================
+// GPU Frame Timings
+// ============================================================================
+
+/**
+ * @brief GPU-side duration of one rendered frame
+ *
+ * Results lag behind submission by the backend's frames-in-flight count;
+ * frameIndex identifies which beginFrame() the numbers belong to.
+ */
+struct GpuFrameTimings {
+    uint64_t frameIndex = 0;
+    double renderPassMs = 0.0;        // Render pass begin to end
+    std::vector<double> drawRangeMs;  // One entry per timed batched draw, in submission order
+    uint32_t droppedDrawRanges = 0;   // Draws beyond the backend's query budget
+    bool valid = false;
+};
+
 // ============================================================================
 // Render Backend Interface
 // ============================================================================
@@ -115,6 +137,14 @@ class DAKTLIB_GUI_API IRenderBackend {
     // Debug naming
     enum class ResourceType { Buffer, Texture };
     virtual void setDebugName(ResourceType type, uint64_t handle, const char* name) = 0;
+
+    // GPU timing (optional; backends without timestamp support keep the defaults)
+    virtual bool supportsGpuTimings() const { return false; }
+    virtual void setGpuTimingsEnabled(bool enabled) { (void)enabled; }
+    virtual bool getLastGpuFrameTimings(GpuFrameTimings& out) const {
+        (void)out;
+        return false;
+    }
 };
 
 // Factory function (implemented per backend)
@@ -123,6 +153,7 @@ std::unique_ptr<IRenderBackend> createMetalBackend();
 std::unique_ptr<IRenderBackend> createDX11Backend();
 std::unique_ptr<IRenderBackend> createDX12Backend();
 std::unique_ptr<IRenderBackend> createOpenGLBackend();
+std::unique_ptr<IRenderBackend> createNullBackend(); // Always available; records instead of rendering
 
 } // namespace dakt::gui
 
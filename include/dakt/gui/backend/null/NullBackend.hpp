@@ -0,0 +1,163 @@
+#ifndef DAKTLIB_GUI_NULL_BACKEND_HPP
+#define DAKTLIB_GUI_NULL_BACKEND_HPP
+
+#include "../IRenderBackend.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace dakt::gui {
+
+// =============================================================================
+// Recorded Activity
+// =============================================================================
+
+/**
+ * @brief One submit(DrawList) call as seen by the null backend
+ */
+struct NullSubmitRecord {
+    uint64_t frameIndex = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t commandCount = 0;
+    uint32_t drawCommandCount = 0; // DrawTriangles commands only
+    uint64_t vertexBytes = 0;
+    uint64_t indexBytes = 0;
+};
+
+/**
+ * @brief One buffer/texture operation as seen by the null backend
+ */
+struct NullResourceRecord {
+    enum class Op { CreateBuffer, UpdateBuffer, DestroyBuffer, CreateTexture, UpdateTexture, DestroyTexture };
+
+    Op op = Op::CreateBuffer;
+    uint64_t handle = 0;
+    uint64_t bytes = 0; // Allocation size for creates, uploaded size for updates, 0 for destroys
+    uint64_t frameIndex = 0;
+};
+
+/**
+ * @brief Counters aggregated over a frame or over the backend lifetime
+ */
+struct NullBackendStats {
+    uint64_t frames = 0;
+    uint64_t submits = 0;
+    uint64_t vertices = 0;
+    uint64_t indices = 0;
+    uint64_t drawCommands = 0;
+    uint64_t vertexBytes = 0;
+    uint64_t indexBytes = 0;
+
+    uint64_t buffersCreated = 0;
+    uint64_t bufferUpdates = 0;
+    uint64_t bufferBytesUploaded = 0;
+    uint64_t texturesCreated = 0;
+    uint64_t textureUpdates = 0;
+    uint64_t textureBytesUploaded = 0;
+};
+
+// =============================================================================
+// Null Backend Implementation
+// =============================================================================
+
+/**
+ * @brief Render backend that draws nothing and records everything
+ *
+ * Drives Context and the immediate/retained paths without a GPU, e.g. for
+ * benchmarks on CPU-only build agents and for assertions on vertex counts
+ * and upload volume. Buffers are backed by host memory so mapBuffer() works.
+ */
+class DAKTLIB_GUI_API NullBackend : public IRenderBackend {
+  public:
+    NullBackend();
+    ~NullBackend() override;
+
+    // IRenderBackend interface
+    bool initialize(void* windowHandle, uint32_t width, uint32_t height) override;
+    void shutdown() override;
+
+    bool beginFrame() override;
+    void endFrame() override;
+    void present() override;
+
+    void submit(const DrawList& drawList) override;
+    void resize(uint32_t width, uint32_t height) override;
+
+    BufferHandle createBuffer(const BufferDesc& desc) override;
+    void destroyBuffer(BufferHandle handle) override;
+    void* mapBuffer(BufferHandle handle) override;
+    void unmapBuffer(BufferHandle handle) override;
+    void updateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset = 0) override;
+
+    TextureHandle createTexture(const TextureDesc& desc) override;
+    void destroyTexture(TextureHandle handle) override;
+    void updateTexture(TextureHandle handle, const void* data, uint32_t width, uint32_t height) override;
+
+    [[nodiscard]] const BackendCapabilities& getCapabilities() const override { return capabilities_; }
+    [[nodiscard]] const char* getName() const override { return "Null"; }
+
+    void setDebugName(ResourceType type, uint64_t handle, const char* name) override;
+
+    // Recording control
+    void setRecordingEnabled(bool enabled) { recording_ = enabled; }
+    [[nodiscard]] bool isRecordingEnabled() const { return recording_; }
+
+    /**
+     * Drop recorded submits/resource ops and zero all counters.
+     * Live resources are kept.
+     */
+    void clearRecords();
+
+    // Recorded activity
+    [[nodiscard]] const std::vector<NullSubmitRecord>& getSubmits() const { return submits_; }
+    [[nodiscard]] const std::vector<NullResourceRecord>& getResourceOps() const { return resourceOps_; }
+
+    [[nodiscard]] const NullBackendStats& getTotalStats() const { return totalStats_; }
+    [[nodiscard]] const NullBackendStats& getFrameStats() const { return frameStats_; } // Current (or last) frame
+
+    [[nodiscard]] size_t getLiveBufferCount() const { return buffers_.size(); }
+    [[nodiscard]] size_t getLiveTextureCount() const { return textures_.size(); }
+    [[nodiscard]] uint64_t getFrameIndex() const { return frameIndex_; }
+    [[nodiscard]] uint32_t getWidth() const { return width_; }
+    [[nodiscard]] uint32_t getHeight() const { return height_; }
+
+    // Host-side copies for content assertions
+    [[nodiscard]] const std::vector<uint8_t>* getBufferData(BufferHandle handle) const;
+    [[nodiscard]] const std::vector<uint8_t>* getTextureData(TextureHandle handle) const;
+
+  private:
+    struct NullTexture {
+        TextureDesc desc{};
+        std::vector<uint8_t> data;
+    };
+
+    void recordResourceOp(NullResourceRecord::Op op, uint64_t handle, uint64_t bytes);
+
+    std::unordered_map<BufferHandle, std::vector<uint8_t>> buffers_;
+    std::unordered_map<TextureHandle, NullTexture> textures_;
+    uint64_t nextBufferHandle_ = 1;
+    uint64_t nextTextureHandle_ = 1;
+
+    std::vector<NullSubmitRecord> submits_;
+    std::vector<NullResourceRecord> resourceOps_;
+    NullBackendStats totalStats_{};
+    NullBackendStats frameStats_{};
+
+    BackendCapabilities capabilities_{};
+    uint64_t frameIndex_ = 0;
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    bool initialized_ = false;
+    bool frameInProgress_ = false;
+    bool recording_ = true;
+};
+
+// Factory function declaration
+[[nodiscard]] DAKTLIB_GUI_API std::unique_ptr<IRenderBackend> createNullBackend();
+
+} // namespace dakt::gui
+
+#endif // DAKTLIB_GUI_NULL_BACKEND_HPP
@@ -0,0 +1,230 @@
+#ifndef DAKTLIB_GUI_OPENGL_BACKEND_HPP
+#define DAKTLIB_GUI_OPENGL_BACKEND_HPP
+
+#include "../IRenderBackend.hpp"
+
+// Only compile OpenGL backend when explicitly enabled
+#if defined(DAKTLIB_ENABLE_OPENGL)
+
+#include "../../subsystems/draw/DrawBatcher.hpp"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// =============================================================================
+// OpenGL Forward Declarations
+// =============================================================================
+// The GL function table and enums live in a private header so that neither
+// this header nor its consumers depend on platform GL headers.
+
+typedef struct __GLsync* GLsync;
+
+namespace dakt::gui {
+
+namespace gl {
+struct Functions;
+}
+
+/**
+ * @brief Resolves a GL entry point by name (e.g. glfwGetProcAddress, SDL_GL_GetProcAddress)
+ */
+using GLProcLoader = void* (*)(const char* name);
+
+// =============================================================================
+// OpenGL Resource Wrappers
+// =============================================================================
+
+struct OpenGLBuffer {
+    uint32_t buffer = 0;
+    uint64_t size = 0;
+    void* persistentPtr = nullptr; // Set for hostVisible buffers (persistent + coherent mapping)
+    BufferUsage usage = BufferUsage::Vertex;
+};
+
+struct OpenGLTexture {
+    uint32_t texture = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    TextureFormat format = TextureFormat::RGBA8;
+    bool msdf = false; // Drawn by the text program with median-of-three decoding
+};
+
+/**
+ * @brief Persistently mapped, coherent streaming buffer split into fenced segments
+ *
+ * Each frame writes into one segment; a fence inserted at endFrame() guards the
+ * segment until the GPU has consumed it, so the CPU never overwrites in-flight data.
+ */
+struct OpenGLRingBuffer {
+    uint32_t buffer = 0;
+    uint8_t* mappedPtr = nullptr;
+    uint64_t segmentSize = 0; // Bytes per segment
+    uint64_t writeOffset = 0; // Absolute offset of the next write in the current segment
+};
+
+// =============================================================================
+// OpenGL Backend Implementation
+// =============================================================================
+
+/**
+ * @brief OpenGL 4.5 core backend using direct state access
+ *
+ * The application owns the window and GL context: the context must be current
+ * on the calling thread for initialize() and every frame, and buffer swapping
+ * stays with the application (present() is a no-op).
+ */
+class DAKTLIB_GUI_API OpenGLBackend : public IRenderBackend {
+  public:
+    /**
+     * @param loader Entry point resolver; nullptr uses the platform GL library
+     */
+    explicit OpenGLBackend(GLProcLoader loader = nullptr);
+    ~OpenGLBackend() override;
+
+    // Non-copyable, non-movable
+    OpenGLBackend(const OpenGLBackend&) = delete;
+    OpenGLBackend& operator=(const OpenGLBackend&) = delete;
+    OpenGLBackend(OpenGLBackend&&) = delete;
+    OpenGLBackend& operator=(OpenGLBackend&&) = delete;
+
+    // IRenderBackend interface
+    bool initialize(void* windowHandle, uint32_t width, uint32_t height) override;
+    void shutdown() override;
+
+    bool beginFrame() override;
+    void endFrame() override;
+    void present() override;
+
+    void submit(const DrawList& drawList) override;
+    void resize(uint32_t width, uint32_t height) override;
+
+    BufferHandle createBuffer(const BufferDesc& desc) override;
+    void destroyBuffer(BufferHandle handle) override;
+    void* mapBuffer(BufferHandle handle) override;
+    void unmapBuffer(BufferHandle handle) override;
+    void updateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset) override;
+
+    TextureHandle createTexture(const TextureDesc& desc) override;
+    void destroyTexture(TextureHandle handle) override;
+    void updateTexture(TextureHandle handle, const void* data, uint32_t width, uint32_t height) override;
+
+    [[nodiscard]] const BackendCapabilities& getCapabilities() const override { return capabilities_; }
+    [[nodiscard]] const char* getName() const override { return "OpenGL"; }
+
+    void setDebugName(ResourceType type, uint64_t handle, const char* name) override;
+
+    // Frame parameters
+    void setClearColor(const Color& color) { clearColor_ = color; }
+    void setSDFPixelRange(float range) { sdfPixelRange_ = range; }
+
+    /**
+     * Draw calls issued for the last submit(): one per multi-draw group
+     */
+    [[nodiscard]] uint32_t getLastDrawCallCount() const { return lastDrawCalls_; }
+
+  private:
+    // Initialization helpers
+    bool loadFunctions();
+    bool queryCapabilities();
+    bool createPrograms();
+    bool createVertexArray();
+    bool createRingBuffers(uint64_t vertexSegmentSize, uint64_t indexSegmentSize);
+    bool createDefaultResources();
+
+    // Cleanup helpers
+    void destroyRingBuffers();
+    void destroyResources(); // Everything created so far; also undoes a failed initialize()
+
+    // Utility helpers
+    uint32_t compileShader(uint32_t type, const char* source);
+    uint32_t linkProgram(const char* vertexSource, const char* fragmentSource);
+
+    // Rendering helpers
+    void waitForSegment(uint32_t segment);
+    bool ensureRingCapacity(uint64_t vertexBytes, uint64_t indexBytes);
+    void uploadClipTable(const std::vector<Rect>& clipTable);
+    void applyState(const RenderState& state);
+    void flushMultiDraw();
+
+  private:
+    std::unique_ptr<gl::Functions> gl_;
+    GLProcLoader loader_ = nullptr;
+    void* libraryHandle_ = nullptr; // Platform GL library when no loader is supplied
+
+    // Programs
+    uint32_t uiProgram_ = 0;   // Colored and textured geometry
+    uint32_t textProgram_ = 0; // Distance field text (R8 SDF and msdf RGBA8 textures)
+    int32_t textPxRangeLocation_ = -1;
+    int32_t textModeLocation_ = -1;
+
+    // Geometry
+    uint32_t vertexArray_ = 0;
+    uint32_t uniformBuffer_ = 0;
+    uint32_t clipBuffer_ = 0; // Clip table SSBO (vec4 min/max per DrawList clip rect)
+    uint32_t clipBufferCapacity_ = 0;
+    std::vector<float> clipScratch_;
+
+    // Streaming buffers (one segment per frame in flight)
+    static constexpr uint32_t FRAME_SEGMENTS = 3;
+    OpenGLRingBuffer vertexRing_{};
+    OpenGLRingBuffer indexRing_{};
+    std::array<GLsync, FRAME_SEGMENTS> segmentFences_{};
+    uint32_t currentSegment_ = 0;
+
+    // Batching and multi-draw scratch (reused across frames)
+    DrawBatcher batcher_;
+    std::vector<int32_t> drawCounts_;
+    std::vector<const void*> drawOffsets_;
+    std::vector<int32_t> drawBaseVertices_;
+    RenderState boundState_{};
+    bool stateBound_ = false;
+    uint32_t lastDrawCalls_ = 0;
+
+    // Resource management
+    std::unordered_map<BufferHandle, OpenGLBuffer> buffers_;
+    std::unordered_map<TextureHandle, OpenGLTexture> textures_;
+    uint64_t nextBufferHandle_ = 1;
+    uint64_t nextTextureHandle_ = 1;
+
+    // Default resources
+    TextureHandle whiteTexture_ = InvalidTexture;
+
+    // Capabilities
+    BackendCapabilities capabilities_{};
+
+    // State
+    Color clearColor_{0, 0, 0, 255};
+    float sdfPixelRange_ = 4.0f;
+    bool initialized_ = false;
+    bool frameInProgress_ = false;
+    uint32_t windowWidth_ = 0;
+    uint32_t windowHeight_ = 0;
+};
+
+// Factory function declarations
+[[nodiscard]] DAKTLIB_GUI_API std::unique_ptr<IRenderBackend> createOpenGLBackend();
+[[nodiscard]] DAKTLIB_GUI_API std::unique_ptr<IRenderBackend> createOpenGLBackend(GLProcLoader loader);
+
+} // namespace dakt::gui
+
+#else // !DAKTLIB_ENABLE_OPENGL
+
+// =============================================================================
+// Stub when OpenGL is not enabled
+// =============================================================================
+
+#include <memory>
+
+namespace dakt::gui {
+
+// Factory returns nullptr when OpenGL is disabled
+[[nodiscard]] inline std::unique_ptr<IRenderBackend> createOpenGLBackend() { return nullptr; }
+
+} // namespace dakt::gui
+
+#endif // DAKTLIB_ENABLE_OPENGL
+
+#endif // DAKTLIB_GUI_OPENGL_BACKEND_HPP
@@ -2,6 +2,7 @@
 #define DAKTLIB_GUI_VULKAN_BACKEND_HPP
 
 #include "../IRenderBackend.hpp"
+#include "../../subsystems/draw/DrawBatcher.hpp"
 
 // Only compile Vulkan backend when explicitly enabled
 #if defined(DAKTLIB_ENABLE_VULKAN)
@@ -9,6 +10,7 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -29,6 +31,7 @@ typedef struct VkCommandBuffer_T* VkCommandBuffer;
 typedef struct VkRenderPass_T* VkRenderPass;
 typedef struct VkFramebuffer_T* VkFramebuffer;
 typedef struct VkPipeline_T* VkPipeline;
+typedef struct VkPipelineCache_T* VkPipelineCache;
 typedef struct VkPipelineLayout_T* VkPipelineLayout;
 typedef struct VkDescriptorPool_T* VkDescriptorPool;
 typedef struct VkDescriptorSetLayout_T* VkDescriptorSetLayout;
@@ -41,6 +44,7 @@ typedef struct VkImageView_T* VkImageView;
 typedef struct VkSampler_T* VkSampler;
 typedef struct VkShaderModule_T* VkShaderModule;
 typedef struct VkDeviceMemory_T* VkDeviceMemory;
+typedef struct VkQueryPool_T* VkQueryPool;
 
 namespace dakt::gui {
 
@@ -84,6 +88,32 @@ struct FrameResources {
     uint64_t vertexBufferOffset = 0;
     uint64_t indexBufferOffset = 0;
     uint64_t uniformBufferOffset = 0;
+
+    // GPU timestamps: [0] = render pass begin, [1] = render pass end, then begin/end pairs per batched draw
+    VkQueryPool timestampPool = nullptr;
+    uint32_t timestampsWritten = 0;
+    uint32_t droppedDrawRanges = 0;
+    uint64_t frameIndex = 0;
+};
+
+// =============================================================================
+// Startup Timings
+// =============================================================================
+
+/**
+ * @brief Wall-clock cost of each VulkanBackend::initialize() stage, in milliseconds
+ */
+struct VulkanStartupTimings {
+    double instanceMs = 0.0;
+    double surfaceMs = 0.0;
+    double deviceMs = 0.0;
+    double swapchainMs = 0.0;
+    double pipelineCacheLoadMs = 0.0;
+    double pipelinesMs = 0.0;
+    double resourcesMs = 0.0;
+    double totalMs = 0.0;
+
+    bool pipelineCacheHit = false; // A valid cache file was loaded from disk
 };
 
 // =============================================================================
@@ -127,6 +157,28 @@ class DAKTLIB_GUI_API VulkanBackend : public IRenderBackend {
 
     void setDebugName(ResourceType type, uint64_t handle, const char* name) override;
 
+    /**
+     * Set the file used to persist the VkPipelineCache across launches.
+     * Must be called before initialize(); an empty path disables persistence.
+     * While shaders::SPV_PLACEHOLDER is set no pipelines are created, so the
+     * saved cache holds no pipelines.
+     */
+    void setPipelineCachePath(std::string path) { pipelineCachePath_ = std::move(path); }
+    [[nodiscard]] const std::string& getPipelineCachePath() const { return pipelineCachePath_; }
+
+    /**
+     * Write the current pipeline cache to the configured path.
+     * Called automatically from shutdown().
+     */
+    bool savePipelineCache();
+
+    [[nodiscard]] const VulkanStartupTimings& getStartupTimings() const { return startupTimings_; }
+
+    // GPU timing
+    [[nodiscard]] bool supportsGpuTimings() const override { return timestampPeriodNs_ > 0.0f; }
+    void setGpuTimingsEnabled(bool enabled) override { gpuTimingsEnabled_ = enabled && supportsGpuTimings(); }
+    bool getLastGpuFrameTimings(GpuFrameTimings& out) const override;
+
   private:
     // Initialization helpers
     bool createInstance();
@@ -139,7 +191,10 @@ class DAKTLIB_GUI_API VulkanBackend : public IRenderBackend {
     bool createCommandPool();
     bool createSyncObjects();
     bool createDescriptorPool();
+    bool createQueryPools();
+    bool createPipelineCache();
     bool createPipelines();
+    VkPipeline createGraphicsPipeline(const uint32_t* vertCode, size_t vertSize, const uint32_t* fragCode, size_t fragSize);
     bool createDefaultResources();
 
     // Cleanup helpers
@@ -155,6 +210,10 @@ class DAKTLIB_GUI_API VulkanBackend : public IRenderBackend {
     void bindPipeline(bool textured);
     void updateUniformBuffer();
 
+    // GPU timing helpers
+    void readbackTimestamps(FrameResources& frame);
+    void writeTimestamp(FrameResources& frame, uint32_t stage, uint32_t query);
+
   private:
     // Vulkan core handles
     VkInstance instance_ = nullptr;
@@ -174,6 +233,10 @@ class DAKTLIB_GUI_API VulkanBackend : public IRenderBackend {
     VkPipeline uiPipeline_ = nullptr;   // Colored geometry
     VkPipeline textPipeline_ = nullptr; // SDF text
 
+    // Pipeline cache (optionally persisted to pipelineCachePath_)
+    VkPipelineCache pipelineCache_ = nullptr;
+    std::string pipelineCachePath_;
+
     // Swapchain resources
     std::vector<VkImage> swapchainImages_;
     std::vector<VkImageView> swapchainImageViews_;
@@ -187,6 +250,17 @@ class DAKTLIB_GUI_API VulkanBackend : public IRenderBackend {
     std::array<FrameResources, MAX_FRAMES_IN_FLIGHT> frameResources_{};
     uint32_t currentFrame_ = 0;
     uint32_t imageIndex_ = 0;
+    uint64_t frameCounter_ = 0;
+
+    // GPU timestamp queries
+    static constexpr uint32_t MAX_TIMESTAMP_QUERIES = 256;
+    float timestampPeriodNs_ = 0.0f; // 0 when the graphics queue cannot write timestamps
+    uint64_t timestampMask_ = 0;     // Low timestampValidBits bits of the graphics queue
+    bool gpuTimingsEnabled_ = false;
+    GpuFrameTimings lastGpuTimings_{};
+
+    // Draw list batching (reused across frames); each batch is one draw and one timed range
+    DrawBatcher batcher_;
 
     // Queue family indices
     uint32_t graphicsFamily_ = UINT32_MAX;
@@ -204,6 +278,7 @@ class DAKTLIB_GUI_API VulkanBackend : public IRenderBackend {
 
     // Capabilities
     BackendCapabilities capabilities_{};
+    VulkanStartupTimings startupTimings_{};
 
     // State
     bool initialized_ = false;
@@ -358,7 +358,7 @@ DAKTLIB_GUI_API void ProcKey(DuiCtx ctx, const DuiKeyInput* input);
 /**
  * @brief Process text input (UTF-8)
  * @param ctx Context handle
- * @param text UTF-8 encoded text string
+ * @param text UTF-8 encoded text string (malformed sequences become U+FFFD)
  */
 DAKTLIB_GUI_API void ProcText(DuiCtx ctx, const char* text);
 
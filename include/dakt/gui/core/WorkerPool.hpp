@@ -0,0 +1,67 @@
+#ifndef DAKTLIB_GUI_WORKER_POOL_HPP
+#define DAKTLIB_GUI_WORKER_POOL_HPP
+
+#include "Types.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dakt::gui {
+
+/**
+ * @brief Fixed set of worker threads for fork-join work (e.g. layout subtrees)
+ *
+ * parallelFor() blocks until every task has run; the calling thread takes
+ * tasks as well, so a pool without workers simply runs them inline. Nested
+ * calls from inside a task also run inline, which keeps the pool deadlock-free.
+ */
+class DAKTLIB_GUI_API WorkerPool {
+  public:
+    /**
+     * @param workerCount Threads to start in addition to the caller
+     */
+    explicit WorkerPool(size_t workerCount);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /**
+     * Run task(i) for every i in [0, count); returns once all have finished
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    size_t getWorkerCount() const { return workers_.size(); }
+
+    /**
+     * Process-wide pool sized to the hardware, started on first use
+     */
+    static WorkerPool& shared();
+
+  private:
+    void workerLoop();
+    void runTasks(const std::function<void(size_t)>& task, size_t count);
+
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::mutex dispatchMutex_; // One parallelFor in flight at a time
+
+    // Current job (guarded by mutex_, indices claimed atomically)
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t taskCount_ = 0;
+    std::atomic<size_t> nextTask_{0};
+    size_t activeWorkers_ = 0; // Workers that joined the current job and have not left it
+    uint64_t generation_ = 0;
+    bool stopping_ = false;
+};
+
+} // namespace dakt::gui
+
+#endif // DAKTLIB_GUI_WORKER_POOL_HPP
@@ -129,6 +129,17 @@ class DAKTLIB_GUI_API UIContainer {
     void layout();
     void forceLayout();
 
+    /**
+     * Lay out top-level widgets with at least minSubtreeSize widgets in their
+     * subtree on the shared WorkerPool. Widget::layout() overrides in those
+     * subtrees must only modify their own subtree.
+     */
+    void setParallelLayout(bool enabled, size_t minSubtreeSize = 256) {
+        parallelLayout_ = enabled;
+        parallelMinSubtree_ = minSubtreeSize;
+    }
+    bool isParallelLayoutEnabled() const { return parallelLayout_; }
+
     // ========================================================================
     // Input Processing
     // ========================================================================
@@ -158,6 +169,8 @@ class DAKTLIB_GUI_API UIContainer {
     void layoutVertical();
     void layoutHorizontal();
     void layoutChildren(Widget* widget, const Rect& available);
+    void layoutChild(Widget* child, const Rect& bounds);
+    void flushDeferredLayouts();
 
     Widget* hitTest(const Vec2& point);
     Widget* hitTestRecursive(Widget* widget, const Vec2& point);
@@ -178,6 +191,11 @@ class DAKTLIB_GUI_API UIContainer {
     bool dirty_ = true;
     float totalTime_ = 0.0f;
 
+    // Parallel layout of large top-level subtrees
+    bool parallelLayout_ = false;
+    size_t parallelMinSubtree_ = 256;
+    std::vector<std::pair<Widget*, Rect>> deferredLayouts_;
+
     std::unordered_map<std::string, Widget*> widgetLookup_;
 
     Widget* focusedWidget_ = nullptr;
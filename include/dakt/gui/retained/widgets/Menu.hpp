@@ -75,7 +75,10 @@ class DAKTLIB_GUI_API Menu : public Widget {
 
     // Styling
     float getItemHeight() const { return itemHeight_; }
-    void setItemHeight(float height) { itemHeight_ = height; }
+    void setItemHeight(float height) {
+        itemHeight_ = height;
+        markDirty();
+    }
 
     Color getBackgroundColor() const { return backgroundColor_; }
     void setBackgroundColor(const Color& color) { backgroundColor_ = color; }
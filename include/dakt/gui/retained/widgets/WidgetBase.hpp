@@ -176,6 +176,17 @@ class DAKTLIB_GUI_API Widget {
     virtual Vec2 measureContent();
     virtual void layout(const Rect& available);
 
+    /**
+     * Memoized measureContent(); recomputed after markDirty() or
+     * markNeedsLayout() on this widget or any of its descendants
+     */
+    Vec2 measure();
+
+    /**
+     * measure() clamped to availableSize, cached for the last available size
+     */
+    Vec2 measure(const Vec2& availableSize);
+
     // ========================================================================
     // State
     // ========================================================================
@@ -234,6 +245,10 @@ class DAKTLIB_GUI_API Widget {
   protected:
     void fireEvent(WidgetEventType type, const WidgetEvent& baseEvent = {});
     void propagateDirty();
+    void invalidateMeasure() {
+        measureValid_ = false;
+        constrainedValid_ = false;
+    }
 
     std::string id_;
     Widget* parent_ = nullptr;
@@ -251,6 +266,13 @@ class DAKTLIB_GUI_API Widget {
     bool dirty_ = true;
     bool needsLayout_ = true;
 
+    // Measure cache
+    Vec2 measuredSize_;
+    Vec2 constrainedAvailable_;
+    Vec2 constrainedSize_;
+    bool measureValid_ = false;
+    bool constrainedValid_ = false;
+
     WidgetCallback onClick_;
     WidgetCallback onDoubleClick_;
     WidgetCallback onHover_;
@@ -38,6 +38,7 @@ struct BatchedDrawCommand {
  * - Merging adjacent commands with same render state
  * - Sorting by texture to minimize state changes
  * - Managing clip rect stack
+ * - Ignoring clip rects entirely for ClipMode::Shader draw lists
  * - Batching instanced draws when possible
  */
 class DAKTLIB_GUI_API DrawBatcher {
@@ -104,6 +105,7 @@ class DAKTLIB_GUI_API DrawBatcher {
 
     bool sortByTexture_ = false;
     bool mergeCommands_ = true;
+    bool shaderClipping_ = false; // Clip rects live in vertices, not in state
 };
 
 } // namespace dakt::gui
@@ -14,6 +14,7 @@ struct DAKTLIB_GUI_API Vertex {
     Vec2 position;
     Vec2 uv;
     Color color;
+    uint32_t clipIndex = 0; // Entry in DrawList::getClipTable(), used in ClipMode::Shader
 
     Vertex() = default;
     Vertex(const Vec2& pos, const Vec2& texCoord, const Color& col) : position(pos), uv(texCoord), color(col) {}
@@ -25,6 +26,16 @@ struct DAKTLIB_GUI_API Vertex {
 
 enum class DrawCommandType { None, DrawTriangles, SetClipRect, SetTexture };
 
+/**
+ * @brief How clip rects reach the GPU
+ *
+ * Scissor emits a SetClipRect command per push/pop, so every clip change splits
+ * the draw. Shader stamps each vertex with an index into a per-list clip table
+ * and leaves clipping to the fragment shader, so one draw can span many clip
+ * regions. Requires BackendCapabilities::supportsShaderClipping.
+ */
+enum class ClipMode { Scissor, Shader };
+
 struct DAKTLIB_GUI_API DrawCommand {
     DrawCommandType type = DrawCommandType::None;
     uint32_t vertexOffset = 0;
@@ -67,6 +78,18 @@ class DAKTLIB_GUI_API DrawList {
     void pushClipRect(const Rect& rect);
     void popClipRect();
 
+    /**
+     * Select the clipping mode; takes effect for clip rects pushed afterwards,
+     * so set it right after reset()
+     */
+    void setClipMode(ClipMode mode) { clipMode_ = mode; }
+    ClipMode getClipMode() const { return clipMode_; }
+
+    /**
+     * Clip rects referenced by Vertex::clipIndex; entry 0 is the root clip
+     */
+    const std::vector<Rect>& getClipTable() const { return clipTable_; }
+
     // Texture binding
     void setTexture(uint64_t textureID);
 
@@ -91,6 +114,12 @@ class DAKTLIB_GUI_API DrawList {
     Rect currentClipRect_;
     uint64_t currentTexture_ = 0;
 
+    // Shader clipping
+    ClipMode clipMode_ = ClipMode::Scissor;
+    std::vector<Rect> clipTable_;
+    std::vector<uint32_t> clipIndexStack_;
+    uint32_t currentClipIndex_ = 0;
+
     void addCommand(DrawCommandType type, uint32_t vertexCount, uint32_t indexCount);
     void reserveVertices(size_t count);
     void reserveIndices(size_t count);
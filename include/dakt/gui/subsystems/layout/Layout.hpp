@@ -2,6 +2,11 @@
 #define DAKTLIB_GUI_LAYOUT_HPP
 
 #include "../../core/Types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <vector>
@@ -32,84 +37,330 @@ struct LayoutConstraints {
     float maxHeight = std::numeric_limits<float>::max();
 };
 
+/**
+ * @brief How an available size constrains a measure callback (Yoga/CSS semantics)
+ */
+enum class MeasureMode {
+    Undefined, // No constraint; report max-content size
+    Exactly,   // Size is fixed by the parent
+    AtMost     // Size may not exceed the available space
+};
+
+/**
+ * @brief Intrinsic size callback for leaf content (text, images, custom widgets)
+ */
+using MeasureFunc = std::function<Vec2(float availableWidth, MeasureMode widthMode, float availableHeight, MeasureMode heightMode)>;
+
+/**
+ * @brief Layout counters accumulated across all trees until resetStats()
+ */
+struct LayoutStats {
+    uint64_t nodesMeasured = 0;    // Measure callbacks actually invoked
+    uint64_t measureCacheHits = 0; // Measurements answered from the cache
+    uint64_t nodesVisited = 0;     // Nodes whose children were laid out
+    uint64_t relayoutRoots = 0;    // Dirty-queue entries processed below a tree root
+};
+
+class FlexLayoutEngine;
+class LayoutNode;
+struct LayoutArena;
+
+constexpr uint32_t INVALID_LAYOUT_INDEX = std::numeric_limits<uint32_t>::max();
+
+/**
+ * @brief A node's children in sibling order, walked through the arena links
+ */
+class LayoutChildren {
+  public:
+    class iterator {
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = LayoutNode*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = LayoutNode* const*;
+        using reference = LayoutNode*;
+
+        iterator() = default;
+        iterator(const LayoutArena* arena, uint32_t index, uint32_t last) : arena_(arena), index_(index), last_(last) {}
+
+        LayoutNode* operator*() const;
+        iterator& operator++();
+        iterator& operator--();
+        iterator operator++(int) {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+        iterator operator--(int) {
+            iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator& other) const { return index_ == other.index_; }
+        bool operator!=(const iterator& other) const { return index_ != other.index_; }
+
+      private:
+        const LayoutArena* arena_ = nullptr;
+        uint32_t index_ = INVALID_LAYOUT_INDEX;
+        uint32_t last_ = INVALID_LAYOUT_INDEX; // Lets end() step back onto the last child
+    };
+
+    using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = reverse_iterator;
+
+    LayoutChildren(const LayoutArena* arena, uint32_t first, uint32_t last, uint32_t count) : arena_(arena), first_(first), last_(last), count_(count) {}
+
+    iterator begin() const { return iterator(arena_, first_, last_); }
+    iterator end() const { return iterator(arena_, INVALID_LAYOUT_INDEX, last_); }
+    reverse_iterator rbegin() const { return reverse_iterator(end()); }
+    reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+  private:
+    const LayoutArena* arena_;
+    uint32_t first_;
+    uint32_t last_;
+    uint32_t count_;
+};
+
+/**
+ * @brief Layout tree node
+ *
+ * A LayoutNode is a handle: layout data for the whole tree lives in
+ * struct-of-arrays columns of a LayoutArena owned by the tree root, and
+ * child handles are pooled in the arena rather than allocated one by one.
+ * References returned by the getters are invalidated when nodes are added.
+ */
 class LayoutNode {
+    class PoolTag {
+        explicit PoolTag() = default;
+        friend struct LayoutArena;
+    };
+
   public:
     LayoutNode();
     ~LayoutNode();
 
+    // Pooled child handle; only LayoutArena can produce the tag
+    LayoutNode(PoolTag tag, LayoutArena* arena, uint32_t index);
+
+    // Handles are owned by their tree and must not move
+    LayoutNode(const LayoutNode&) = delete;
+    LayoutNode& operator=(const LayoutNode&) = delete;
+    LayoutNode(LayoutNode&&) = delete;
+    LayoutNode& operator=(LayoutNode&&) = delete;
+
     // Size/position
     void setSize(float width, float height);
     void setPosition(float x, float y);
-    Rect getRect() const { return rect_; }
-    Vec2 getSize() const { return Vec2(rect_.width, rect_.height); }
-    Vec2 getPosition() const { return Vec2(rect_.x, rect_.y); }
+    Rect getRect() const;
+    Vec2 getSize() const;
+    Vec2 getPosition() const;
 
     // Flex layout properties
-    void setFlexProperties(const FlexProperties& props) {
-        flexProps_ = props;
-        markDirty();
-    }
-
-    void setFlexDirection(FlexDirection dir) {
-        flexProps_.direction = dir;
-        markDirty();
-    }
+    void setFlexProperties(const FlexProperties& props);
+    void setFlexDirection(FlexDirection dir);
+    void setFlexGrow(float grow);
+    void setFlexShrink(float shrink);
+    void setFlexBasis(float basis);
+    const FlexProperties& getFlexProperties() const;
 
-    void setFlexGrow(float grow) {
-        flexProps_.grow = grow;
-        markDirty();
-    }
+    // Constraints
+    void setConstraints(const LayoutConstraints& constraints);
+    const LayoutConstraints& getConstraints() const;
 
-    void setFlexShrink(float shrink) {
-        flexProps_.shrink = shrink;
-        markDirty();
-    }
+    // Intrinsic sizing
+    // The callback's inputs are opaque to the layout: call markDirty() when the
+    // measured content changes so cached results are discarded.
+    void setMeasureFunc(MeasureFunc func);
+    bool hasMeasureFunc() const { return static_cast<bool>(measureFunc_); }
 
-    void setFlexBasis(float basis) {
-        flexProps_.basis = basis;
-        markDirty();
-    }
+    /**
+     * Measure content under the given constraints; results are cached per
+     * (available size, mode) until markDirty(). Without a callback the
+     * current size is returned.
+     */
+    Vec2 measure(float availableWidth, MeasureMode widthMode, float availableHeight, MeasureMode heightMode);
 
-    const FlexProperties& getFlexProperties() const { return flexProps_; }
+    static LayoutStats getStats();
+    static void resetStats();
 
-    // Constraints
-    void setConstraints(const LayoutConstraints& constraints) {
-        constraints_ = constraints;
-        markDirty();
-    }
+    /**
+     * Lay out sibling subtrees of at least minSubtreeSize nodes on the shared
+     * WorkerPool. Siblings write disjoint arena slots, so results match the
+     * sequential pass exactly. While enabled, measure callbacks may run
+     * concurrently and must not modify any layout tree.
+     */
+    static void setParallelLayout(bool enabled, size_t minSubtreeSize = DEFAULT_PARALLEL_SUBTREE_SIZE);
+    static bool isParallelLayoutEnabled();
+    static size_t getParallelSubtreeSize();
 
-    const LayoutConstraints& getConstraints() const { return constraints_; }
+    static constexpr size_t DEFAULT_PARALLEL_SUBTREE_SIZE = 256;
 
     // Hierarchy
     LayoutNode* addChild();
     void removeChild(LayoutNode* child);
-    const std::vector<std::unique_ptr<LayoutNode>>& getChildren() const { return children_; }
+    LayoutChildren getChildren() const;
 
-    LayoutNode* getParent() { return parent_; }
-    const LayoutNode* getParent() const { return parent_; }
+    LayoutNode* getParent();
+    const LayoutNode* getParent() const;
+
+    // Nodes in this subtree, including this one
+    size_t getSubtreeSize() const;
 
     // Dirty tracking
-    bool isDirty() const { return dirty_; }
+    // markDirty() is for changes to this node's own properties: it relays out
+    // the parent and continues upward only until a relayout boundary, which is
+    // queued on the tree root instead.
+    bool isDirty() const;
     void markDirty();
-    void markClean() { dirty_ = false; }
+    void markClean();
+
+    /**
+     * True when this node's size cannot depend on its children: the tree root,
+     * fixed width and height constraints, or a flex item with a definite basis
+     * whose cross size is stretched by its parent
+     */
+    bool isRelayoutBoundary() const;
 
     // Layout computation
+    // On a tree root this also processes queued relayout boundaries, shallowest first.
     void computeLayout(float parentWidth, float parentHeight);
     void layoutChildren();
 
+    // Arena access for data-oriented passes
+    LayoutArena& getArena() { return *arena_; }
+    const LayoutArena& getArena() const { return *arena_; }
+    uint32_t getIndex() const { return index_; }
+
   private:
-    Rect rect_;
-    FlexProperties flexProps_;
-    LayoutConstraints constraints_;
-    std::vector<std::unique_ptr<LayoutNode>> children_;
-    LayoutNode* parent_ = nullptr;
-    bool dirty_ = true;
-
-    // Layout cache
-    float desiredWidth_ = 0.0f;
-    float desiredHeight_ = 0.0f;
+    struct MeasureCacheEntry {
+        float availableWidth = 0.0f;
+        float availableHeight = 0.0f;
+        MeasureMode widthMode = MeasureMode::Undefined;
+        MeasureMode heightMode = MeasureMode::Undefined;
+        Vec2 result;
+    };
+
+    static constexpr size_t MAX_MEASURE_CACHE_ENTRIES = 8;
+
+    friend class FlexLayoutEngine;
+    friend struct LayoutArena;
+
+    // Rect assignment from the parent's layout pass; dirties this subtree only
+    void assignRect(float x, float y, float width, float height);
+
+    void markNeedsLayout();
+    void enqueueRelayout();
+    void processDirtyQueue();
+    void resetHandle();
+
+    LayoutArena* arena_ = nullptr;
+    uint32_t index_ = 0;
+    std::unique_ptr<LayoutArena> ownedArena_; // Tree roots only
+
+    // Measurement (cache allocated on first measure)
+    MeasureFunc measureFunc_;
+    std::vector<MeasureCacheEntry> measureCache_;
+    size_t measureCacheNext_ = 0; // Round-robin slot once the cache is full
+};
+
+// ============================================================================
+// Layout Arena
+// ============================================================================
+
+/**
+ * @brief Struct-of-arrays storage for one layout tree
+ *
+ * Every column is indexed by node index. Children form a doubly linked
+ * sibling list; freed indices are recycled through a free list.
+ */
+struct LayoutArena {
+    enum Flags : uint8_t {
+        FLAG_DIRTY = 1 << 0,
+        FLAG_QUEUED = 1 << 1,
+        FLAG_ALIVE = 1 << 2,
+    };
+
+    // Geometry and properties
+    std::vector<Rect> rects;
+    std::vector<FlexProperties> flexProps;
+    std::vector<LayoutConstraints> constraints;
+    std::vector<uint8_t> flags;
+
+    // Hierarchy
+    std::vector<uint32_t> parent;
+    std::vector<uint32_t> firstChild;
+    std::vector<uint32_t> lastChild;
+    std::vector<uint32_t> nextSibling;
+    std::vector<uint32_t> prevSibling;
+    std::vector<uint32_t> childCount;
+    std::vector<uint32_t> subtreeSize; // Node count including self
+
+    // Handles by index (the root handle lives outside the pool)
+    std::vector<LayoutNode*> handles;
+
+    // Relayout boundaries awaiting layout
+    std::vector<uint32_t> dirtyQueue;
+
+    explicit LayoutArena(LayoutNode* root);
+
+    uint32_t allocate();
+    void release(uint32_t index);
+    size_t getNodeCount() const { return handles.size() - freeList_.size(); }
+
+    bool isDirty(uint32_t index) const { return (flags[index] & FLAG_DIRTY) != 0; }
+
+  private:
+    std::deque<LayoutNode> pool_;
+    std::vector<uint32_t> freeList_;
 };
 
+inline LayoutNode* LayoutChildren::iterator::operator*() const { return arena_->handles[index_]; }
+
+inline LayoutChildren::iterator& LayoutChildren::iterator::operator++() {
+    index_ = arena_->nextSibling[index_];
+    return *this;
+}
+
+inline LayoutChildren::iterator& LayoutChildren::iterator::operator--() {
+    index_ = (index_ == INVALID_LAYOUT_INDEX) ? last_ : arena_->prevSibling[index_];
+    return *this;
+}
+
+inline Rect LayoutNode::getRect() const { return arena_->rects[index_]; }
+inline Vec2 LayoutNode::getSize() const { return Vec2(arena_->rects[index_].width, arena_->rects[index_].height); }
+inline Vec2 LayoutNode::getPosition() const { return Vec2(arena_->rects[index_].x, arena_->rects[index_].y); }
+inline const FlexProperties& LayoutNode::getFlexProperties() const { return arena_->flexProps[index_]; }
+inline const LayoutConstraints& LayoutNode::getConstraints() const { return arena_->constraints[index_]; }
+inline bool LayoutNode::isDirty() const { return arena_->isDirty(index_); }
+inline void LayoutNode::markClean() { arena_->flags[index_] &= static_cast<uint8_t>(~LayoutArena::FLAG_DIRTY); }
+
+inline LayoutChildren LayoutNode::getChildren() const {
+    return LayoutChildren(arena_, arena_->firstChild[index_], arena_->lastChild[index_], arena_->childCount[index_]);
+}
+
+inline size_t LayoutNode::getSubtreeSize() const { return arena_->subtreeSize[index_]; }
+
+inline LayoutNode* LayoutNode::getParent() {
+    uint32_t p = arena_->parent[index_];
+    return p == INVALID_LAYOUT_INDEX ? nullptr : arena_->handles[p];
+}
+
+inline const LayoutNode* LayoutNode::getParent() const {
+    uint32_t p = arena_->parent[index_];
+    return p == INVALID_LAYOUT_INDEX ? nullptr : arena_->handles[p];
+}
+
+/**
+ * @brief Flexbox layout of a container's children (FlexLayout.cpp)
+ */
+void FlexLayout_ComputeLayout(LayoutNode* container, float width, float height);
+
 } // namespace dakt::gui
 
 #endif
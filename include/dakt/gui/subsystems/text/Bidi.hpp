@@ -0,0 +1,131 @@
+#ifndef DAKTLIB_GUI_BIDI_HPP
+#define DAKTLIB_GUI_BIDI_HPP
+
+#include "../../core/Types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace dakt::gui {
+
+// ============================================================================
+// Bidirectional Text (UAX #9)
+// ============================================================================
+
+/**
+ * @brief Unicode Bidi_Class values
+ */
+enum class BidiClass : uint8_t {
+    L,   // Left-to-right
+    R,   // Right-to-left
+    AL,  // Arabic letter
+    EN,  // European number
+    ES,  // European separator
+    ET,  // European terminator
+    AN,  // Arabic number
+    CS,  // Common separator
+    NSM, // Nonspacing mark
+    BN,  // Boundary neutral
+    B,   // Paragraph separator
+    S,   // Segment separator
+    WS,  // Whitespace
+    ON,  // Other neutral
+    LRE, // Explicit formatting
+    LRO,
+    RLE,
+    RLO,
+    PDF,
+    LRI, // Isolates
+    RLI,
+    FSI,
+    PDI,
+};
+
+/**
+ * Bidi class of a codepoint (two table reads)
+ */
+DAKTLIB_GUI_API BidiClass getBidiClass(uint32_t codepoint);
+
+/**
+ * @brief UAX #9 analysis of a paragraph
+ *
+ * analyze() decodes the text once, classifies it through generated Unicode
+ * tables and resolves embedding levels (explicit embeddings and isolates,
+ * weak types, bracket pairs, neutrals, implicit levels). The result depends
+ * only on the text, so callers keep it and ask for line runs again whenever
+ * the text is re-wrapped. Text containing paragraph separators is resolved
+ * as consecutive paragraphs.
+ */
+class BidiParagraph {
+  public:
+    static constexpr uint8_t AUTO_LEVEL = 0xFF; // Base level from the first strong character
+    static constexpr uint8_t MAX_DEPTH = 125;
+
+    /**
+     * @brief Logical range [start, end) of codepoints at one level
+     */
+    struct Run {
+        uint32_t start = 0;
+        uint32_t end = 0;
+        uint8_t level = 0;
+
+        bool isRTL() const { return (level & 1) != 0; }
+    };
+
+    /**
+     * Analyze UTF-8 text (malformed sequences count as U+FFFD)
+     * @param baseLevel 0 (LTR), 1 (RTL) or AUTO_LEVEL
+     */
+    void analyze(std::string_view text, uint8_t baseLevel = AUTO_LEVEL);
+
+    /**
+     * Analyze codepoints; byte offsets then count codepoints
+     */
+    void analyze(const uint32_t* codepoints, size_t count, uint8_t baseLevel = AUTO_LEVEL);
+
+    size_t size() const { return levels_.size(); }
+    bool empty() const { return levels_.empty(); }
+
+    // Base level of the paragraph containing codepoint index
+    uint8_t getBaseLevel(size_t index = 0) const;
+
+    // Resolved level per codepoint, before line-based rule L1
+    const std::vector<uint8_t>& getLevels() const { return levels_; }
+
+    // True if any codepoint resolved to an odd level
+    bool hasRTL() const { return hasRTL_; }
+
+    // Byte offset of codepoint index in the analyzed text (size() gives the text length)
+    uint32_t getByteOffset(size_t index) const { return offsets_[index]; }
+
+    // Index of the first codepoint at or after a byte offset (size() past the end)
+    size_t getIndex(uint32_t byteOffset) const;
+
+    /**
+     * Level runs of the line [start, end) in visual order (rules L1 and L2).
+     * Characters inside RTL runs still need reversing by the caller.
+     */
+    void getLineRuns(size_t start, size_t end, std::vector<Run>& runs) const;
+
+  private:
+    void resolve(uint8_t baseLevel);
+    void resolveParagraph(size_t start, size_t end, uint8_t baseLevel);
+    uint8_t firstStrongLevel(size_t start, size_t end, uint8_t fallback) const;
+    void resolveSequence(const std::vector<uint32_t>& sequence, size_t start, size_t end, uint8_t paragraphLevel);
+    void resolveBrackets(const std::vector<uint32_t>& sequence, std::vector<BidiClass>& types, BidiClass sos, uint8_t level) const;
+
+    std::vector<uint32_t> codepoints_;
+    std::vector<uint32_t> offsets_;          // Byte offset per codepoint, plus the end
+    std::vector<BidiClass> classes_;         // Original classes, for L1
+    std::vector<BidiClass> types_;           // Classes being resolved
+    std::vector<uint8_t> levels_;
+    std::vector<uint32_t> matchingPDI_;      // Isolate initiator -> its PDI (or size())
+    std::vector<uint32_t> paragraphStarts_;  // First codepoint of each paragraph
+    std::vector<uint8_t> baseLevels_;        // Per paragraph
+    bool hasRTL_ = false;
+};
+
+} // namespace dakt::gui
+
+#endif // DAKTLIB_GUI_BIDI_HPP
@@ -0,0 +1,50 @@
+#ifndef DAKTLIB_GUI_COVERAGE_RASTERIZER_HPP
+#define DAKTLIB_GUI_COVERAGE_RASTERIZER_HPP
+
+#include "../../core/Types.hpp"
+#include "SDFGenerator.hpp"
+#include "TTFParser.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace dakt::gui {
+
+/**
+ * @brief Anti-aliased coverage rasterizer for glyph outlines
+ *
+ * Each outline edge adds the signed area it covers to the pixels it crosses
+ * (as in font-rs and stb_truetype); a running sum along the rows then is the
+ * exact coverage of every pixel, with no supersampling. The sum runs four
+ * pixels at a time (SSE2/NEON, picked at compile time). Curves are flattened
+ * to lines first.
+ *
+ * The bitmap is one channel of 0-255 coverage, tight around the glyph with
+ * no padding. Below about 12 px it is sharper than a distance field drawn
+ * at the same size and several times cheaper to produce.
+ */
+class CoverageRasterizer {
+  public:
+    /**
+     * Rasterize a glyph at fontSize pixels per em
+     * @param offsetX Subpixel shift of the outline to the right, in pixels;
+     *                the bitmap stays aligned to the unshifted origin's pixel grid
+     * @return Single-channel coverage bitmap, bearings in pixels (1x1 and empty for blank glyphs)
+     */
+    SDFGlyphBitmap rasterize(const GlyphOutlineView& outline, float fontSize, int16_t unitsPerEm, float offsetX = 0.0f);
+
+  private:
+    // Accumulate the signed area of one line (bitmap coordinates, y down)
+    void drawLine(Vec2 p0, Vec2 p1);
+    void drawQuadratic(Vec2 p0, Vec2 p1, Vec2 p2);
+
+    // Running sum of the accumulation buffer into count coverage bytes
+    void accumulate(uint8_t* out, size_t count) const;
+
+    std::vector<float> area_; // width_ * height_ plus slack; reused between glyphs
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+};
+
+} // namespace dakt::gui
+
+#endif
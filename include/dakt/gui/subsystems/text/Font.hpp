@@ -6,7 +6,6 @@
 #include <map>
 #include <memory>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace dakt::gui {
@@ -49,15 +48,24 @@ class Font {
     int16_t getDescender() const { return descender_; }
     int16_t getLineGap() const { return lineGap_; }
 
-    // Glyph access
+    // Glyph access; metrics for every glyph are built when the font loads
     uint16_t getGlyphId(uint32_t codepoint) const;
-    const Glyph* getGlyph(uint16_t glyphId) const;
+    const Glyph* getGlyph(uint16_t glyphId) const { return glyphId < glyphs_.size() ? &glyphs_[glyphId] : nullptr; }
 
     // Metrics conversion
     float pixelsFromUnits(float units, float fontSize) const;
     float unitsFromPixels(float pixels, float fontSize) const;
 
+    // Parsed font tables (GSUB, GPOS, ...); null while the built-in fallback metrics are in use
+    const TTFParser* getParser() const { return parser_.get(); }
+
+    // FNV-1a hash of the font file; identifies the font in persistent glyph caches (0 for the fallback)
+    uint64_t getContentHash() const { return contentHash_; }
+
   private:
+    void adoptParser(std::unique_ptr<TTFParser> parser);
+    void buildFallbackGlyphs();
+
     std::unique_ptr<TTFParser> parser_;
     std::string filePath_;
     std::string familyName_;
@@ -67,8 +75,9 @@ class Font {
     int16_t ascender_ = 800;
     int16_t descender_ = -200;
     int16_t lineGap_ = 0;
+    uint64_t contentHash_ = 0;
 
-    mutable std::unordered_map<uint16_t, Glyph> glyphCache_;
+    std::vector<Glyph> glyphs_; // Indexed by glyph ID
 };
 
 } // namespace dakt::gui
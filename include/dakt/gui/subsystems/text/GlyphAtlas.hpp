@@ -4,13 +4,18 @@
 #include "../../core/Types.hpp"
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace dakt::gui {
 
 // Forward declarations
 class Font;
+class GlyphAtlasCache;
+class SkylinePacker;
+struct AtlasCacheRecord;
 
 // ============================================================================
 // SDF Glyph Atlas
@@ -18,7 +23,7 @@ class Font;
 
 struct AtlasGlyph {
     uint32_t glyphID;
-    float fontSize;
+    float fontSize; // Size the metrics below are for
 
     // Position in atlas texture (normalized 0-1)
     float atlasX, atlasY;
@@ -32,22 +37,103 @@ struct AtlasGlyph {
     uint32_t pageIndex = 0; // Which atlas page (if multiple)
 };
 
+// How a page's texels are drawn; values match renderMode in text.frag.glsl
+enum class GlyphRenderMode : uint32_t {
+    SDF,     // Single-channel distance field
+    MSDF,    // Multi-channel distance field (RGBA); upload as TextureFormat::RGBA8 with TextureDesc::msdf
+    Coverage // Plain anti-aliased alpha, drawn 1:1; upload as TextureFormat::A8
+};
+
 struct AtlasPage {
     uint32_t width = 512;
     uint32_t height = 512;
-    std::vector<uint8_t> pixelData; // Grayscale SDF data
+    uint32_t channels = 1;          // 1 for SDF and coverage, 4 (RGBA) for MSDF/MTSDF
+    std::vector<uint8_t> pixelData; // width * height * channels
     float pixelsPerEmUnit = 1.0f;   // Scale from font units to pixels
+    GlyphRenderMode renderMode = GlyphRenderMode::SDF;
+};
+
+/**
+ * @brief Which size an SDF glyph is rasterized at for a requested font size
+ *
+ * A distance field scales cleanly, so sizes share a reference rasterization
+ * drawn scaled: referenceSize serves every size up to maxMagnification times
+ * it, then the reference doubles (up to maxReferenceSize). Minified fields
+ * stop anti-aliasing once the spread covers less than one output pixel and
+ * lose thin stems at small sizes, so sizes below exactBelow, or below
+ * referenceSize / spread, get their own whole-pixel rasterization.
+ *
+ * Below coverageBelow no distance field is generated at all: glyphs are
+ * rasterized as anti-aliased coverage on their own pages, which is sharper
+ * at those sizes and far cheaper to produce (0 disables).
+ */
+struct SizeBucketPolicy {
+    float referenceSize = 32.0f;
+    float maxReferenceSize = 256.0f;
+    float maxMagnification = 2.0f;
+    float exactBelow = 12.0f;
+    float coverageBelow = 12.0f;
+};
+
+/**
+ * @brief Horizontal subpixel positioning of coverage glyphs
+ *
+ * Coverage bitmaps are drawn 1:1 on whole pixels, so a pen position between
+ * pixels is rounded to the nearest of `phases` steps and the glyph is drawn
+ * from a variant rasterized that far to the right. Variants are only made
+ * for glyphs actually drawn at a phase; past maxVariants of them, glyphs
+ * snap to whole pixels instead (phases 1 always does).
+ */
+struct SubpixelPolicy {
+    uint32_t phases = 4; // 1-4
+    uint32_t maxVariants = 2048;
 };
 
+// Font-wide metrics stored with a baked atlas, so it renders without the font file
+struct AtlasFontInfo {
+    uint64_t fontHash = 0; // Font::getContentHash()
+    int16_t unitsPerEm = 0;
+    int16_t ascender = 0;
+    int16_t descender = 0;
+    int16_t lineGap = 0;
+};
+
+/**
+ * @brief Packs rasterized glyphs of any number of fonts into shared pages
+ *
+ * Glyphs are keyed by (font, glyph, raster size), the font by its content
+ * hash, so regular, bold, mono and icon fonts drawn together fill the same
+ * few textures. Lookups without a font refer to the first font added, which
+ * for a baked atlas is the only one.
+ */
 class GlyphAtlas {
   public:
     GlyphAtlas(uint32_t pageWidth = 512, uint32_t pageHeight = 512);
     ~GlyphAtlas();
 
-    // Add glyph to atlas
-    bool addGlyph(Font& font, uint32_t glyphID, float fontSize);
-    bool hasGlyph(uint32_t glyphID, float fontSize) const;
-    const AtlasGlyph& getGlyph(uint32_t glyphID, float fontSize) const;
+    // Add glyph to atlas (from the cache when set, otherwise rasterized at getRasterSize(fontSize)).
+    // phase selects a subpixel variant of coverage glyphs (below getSubpixelPolicy().phases); fields ignore it
+    bool addGlyph(Font& font, uint32_t glyphID, float fontSize, uint32_t phase = 0);
+    bool hasGlyph(const Font& font, uint32_t glyphID, float fontSize, uint32_t phase = 0) const;
+    AtlasGlyph getGlyph(const Font& font, uint32_t glyphID, float fontSize, uint32_t phase = 0) const; // Metrics scaled to fontSize
+
+    // Glyphs of the first font added
+    bool hasGlyph(uint32_t glyphID, float fontSize, uint32_t phase = 0) const;
+    AtlasGlyph getGlyph(uint32_t glyphID, float fontSize, uint32_t phase = 0) const;
+
+    // Distinct fonts with glyphs in the atlas
+    uint32_t getFontCount() const { return static_cast<uint32_t>(fontIDs_.size()); }
+
+    // Size buckets; glyphs already added keep their rasterization
+    void setSizeBuckets(const SizeBucketPolicy& policy) { sizeBuckets_ = policy; }
+    const SizeBucketPolicy& getSizeBuckets() const { return sizeBuckets_; }
+    float getRasterSize(float fontSize) const;
+    GlyphRenderMode getRenderMode(float fontSize) const; // Of the page a glyph at fontSize lands on
+
+    // Subpixel variants; changing the policy leaves existing variants in place
+    void setSubpixelPolicy(const SubpixelPolicy& policy);
+    const SubpixelPolicy& getSubpixelPolicy() const { return subpixel_; }
+    uint32_t getSubpixelVariantCount() const { return variantCount_; }
 
     // Atlas pages
     uint32_t getPageCount() const { return pages_.size(); }
@@ -55,37 +141,85 @@ class GlyphAtlas {
 
     // Rasterization parameters
     void setSDFSpread(uint32_t spread) { sdfSpread_ = spread; }
-    void setMSDF(bool enabled) { enableMSDF_ = enabled; }
+    void setMSDF(bool enabled); // Clears the atlas when the page format changes
+
+    // Persistent glyph cache (not owned); null rasterizes every glyph
+    void setCache(GlyphAtlasCache* cache) { cache_ = cache; }
+    GlyphAtlasCache* getCache() const { return cache_; }
+
+    // Add every glyph the cache holds for font at the current settings, so
+    // text that was on screen last run renders at full quality on frame one
+    size_t loadFromCache(Font& font);
 
     // Clear and rebuild
     void clear();
     void regenerate(Font& font, float fontSize);
 
-    // Load/save atlas format
+    // Add a character's glyph and remember its glyph ID for findGlyphId().
+    // The character map is for the atlas's first font; other fonts are rejected
+    bool addCodepoint(Font& font, uint32_t codepoint, float fontSize);
+    uint32_t findGlyphId(uint32_t codepoint) const; // 0 when not added
+
+    void setFontInfo(const Font& font);
+    const AtlasFontInfo& getFontInfo() const { return fontInfo_; }
+
+    // Load/save baked atlas format (.daktfont): pages, glyph metrics, character map and font info.
+    // A baked atlas holds one font; saving fails once glyphs of a second were added
     bool saveToFile(const std::string& filePath) const;
+    bool saveToMemory(std::vector<uint8_t>& out) const;
     bool loadFromFile(const std::string& filePath);
+    bool loadFromMemory(const uint8_t* data, size_t size); // e.g. an array written by dakt-fontbake --embed
 
   private:
-    // Packing
-    struct PackRect {
-        uint32_t x, y, w, h;
-        bool used = false;
-    };
+    // Packing; glyphs only share pages of their render mode
+    bool packGlyph(uint32_t width, uint32_t height, GlyphRenderMode mode, uint32_t& outPage, uint32_t& outX, uint32_t& outY);
+    void addPage(GlyphRenderMode mode);
+    GlyphRenderMode fieldMode() const { return enableMSDF_ ? GlyphRenderMode::MSDF : GlyphRenderMode::SDF; }
+
+    // Map key glyph ID of a phase: coverage variants carry their offset in the top byte
+    uint32_t variantID(uint32_t glyphID, GlyphRenderMode mode, uint32_t phase) const;
 
-    bool packGlyph(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY);
+    // Dense font IDs in order of first use; registerFont() adds the font if new
+    uint32_t registerFont(const Font& font);
+    bool findFont(const Font& font, uint32_t& outFontID) const;
 
-    // TODO: Rendering methods - declared in cpp for now
-    // void rasterizeGlyph(const Glyph& glyph, uint8_t* sdfData, uint32_t width, uint32_t height, float spread);
-    // void rasterizeGlyphMSDF(const Glyph& glyph, uint8_t* msdfData, uint32_t width, uint32_t height, float spread);
+    const AtlasGlyph* findGlyph(uint32_t fontID, uint32_t glyphID, float fontSize, uint32_t phase) const;
+    AtlasGlyph scaledGlyph(const AtlasGlyph* glyph, uint32_t glyphID, float fontSize) const;
+
+    // Copy a bitmap rasterized at rasterSize into a page and record it under variantID
+    bool placeGlyph(uint32_t fontID, uint32_t variantID, float rasterSize, GlyphRenderMode mode, const AtlasCacheRecord& metrics, const uint8_t* pixels);
+
+    struct GlyphKey {
+        uint32_t fontID;
+        uint32_t variantID;
+        uint32_t sizeKey; // Raster size in tenths of a pixel
+
+        bool operator==(const GlyphKey& other) const { return fontID == other.fontID && variantID == other.variantID && sizeKey == other.sizeKey; }
+    };
+
+    struct GlyphKeyHash {
+        size_t operator()(const GlyphKey& key) const {
+            uint64_t h = (static_cast<uint64_t>(key.fontID) << 32 | key.variantID) * 0x9E3779B97F4A7C15ULL;
+            h ^= key.sizeKey * 0xC2B2AE3D27D4EB4FULL;
+            return static_cast<size_t>(h ^ (h >> 29));
+        }
+    };
 
     uint32_t pageWidth_, pageHeight_;
     std::vector<AtlasPage> pages_;
-    std::vector<PackRect> packRects_; // Current page packing state
+    std::vector<std::unique_ptr<SkylinePacker>> packers_; // Per page; null for pages loaded from file
 
-    std::map<std::pair<uint32_t, uint32_t>, AtlasGlyph> glyphMap_; // (glyphID, fontSize hash) -> AtlasGlyph
+    std::unordered_map<GlyphKey, AtlasGlyph, GlyphKeyHash> glyphMap_; // AtlasGlyph at raster size
+    std::unordered_map<uint64_t, uint32_t> fontIDs_;                  // Font::getContentHash() -> font ID
+    std::map<uint32_t, uint32_t> codepoints_;                         // codepoint -> glyphID
+    SizeBucketPolicy sizeBuckets_;
+    SubpixelPolicy subpixel_;
+    uint32_t variantCount_ = 0; // Glyphs in glyphMap_ with a subpixel offset
+    AtlasFontInfo fontInfo_;
 
     uint32_t sdfSpread_ = 2;
     bool enableMSDF_ = false;
+    GlyphAtlasCache* cache_ = nullptr;
 };
 
 } // namespace dakt::gui
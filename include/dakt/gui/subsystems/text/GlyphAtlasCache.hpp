@@ -0,0 +1,165 @@
+#ifndef DAKTLIB_GUI_GLYPH_ATLAS_CACHE_HPP
+#define DAKTLIB_GUI_GLYPH_ATLAS_CACHE_HPP
+
+#include "../../core/Types.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace dakt::gui {
+
+// ============================================================================
+// Persistent Glyph Atlas Cache
+// ============================================================================
+
+/**
+ * @brief Identifies one cache file: the glyphs of one font at one size
+ */
+struct AtlasCacheKey {
+    uint64_t fontHash = 0;   // Font::getContentHash()
+    uint32_t sizeBucket = 0; // GlyphAtlas size key
+    uint32_t spread = 0;     // SDF spread in pixels (0 for coverage)
+    uint32_t mode = 0;       // GlyphRenderMode
+
+    bool operator==(const AtlasCacheKey& other) const { return fontHash == other.fontHash && sizeBucket == other.sizeBucket && spread == other.spread && mode == other.mode; }
+};
+
+struct AtlasCacheKeyHash {
+    size_t operator()(const AtlasCacheKey& key) const {
+        uint64_t h = key.fontHash;
+        h ^= (static_cast<uint64_t>(key.sizeBucket) << 32 | key.spread << 8 | key.mode) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+};
+
+/**
+ * @brief Rasterized glyph as stored in a cache file (trivially copyable, 28 bytes)
+ */
+struct AtlasCacheRecord {
+    uint32_t glyphID = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint16_t channels = 1;
+    uint16_t reserved = 0;
+    float advanceWidth = 0.0f;
+    float bearingX = 0.0f;
+    float bearingY = 0.0f;
+    uint32_t pixelOffset = 0; // Into the file's pixel block
+
+    size_t pixelSize() const { return static_cast<size_t>(width) * height * channels; }
+};
+
+/**
+ * @brief Directory of memory-mapped glyph bitmap files shared across launches
+ *
+ * Each AtlasCacheKey has one file holding glyph records sorted by glyph ID
+ * and their pixels. A file is mapped the first time its key is used and
+ * rejected unless its version, key and checksum match, so stale or corrupt
+ * files cost nothing but a re-rasterization. Glyphs passed to store() are
+ * merged into their file on a background thread (write to a temporary file,
+ * then rename); flush() and the destructor wait for it. A write that cannot
+ * replace its file (Windows refuses while the file is mapped) is retried by
+ * the next flush() after the mapping is released.
+ *
+ * find(), forEach() and store() are meant to be called from the thread that
+ * owns the atlas.
+ */
+class DAKTLIB_GUI_API GlyphAtlasCache {
+  public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    /**
+     * @param directory Created if missing
+     */
+    explicit GlyphAtlasCache(std::string directory);
+    ~GlyphAtlasCache();
+
+    GlyphAtlasCache(const GlyphAtlasCache&) = delete;
+    GlyphAtlasCache& operator=(const GlyphAtlasCache&) = delete;
+
+    /**
+     * Look up a glyph; maps the key's file on first use
+     * @return The glyph's pixels inside the mapping, or null if not cached
+     */
+    const uint8_t* find(const AtlasCacheKey& key, uint32_t glyphID, AtlasCacheRecord& record);
+
+    /**
+     * Visit every glyph cached for key
+     * @return Number of glyphs visited
+     */
+    size_t forEach(const AtlasCacheKey& key, const std::function<void(const AtlasCacheRecord&, const uint8_t*)>& visit);
+
+    /**
+     * Keys with a file on disk for a font
+     */
+    std::vector<AtlasCacheKey> findKeys(uint64_t fontHash) const;
+
+    /**
+     * Queue a freshly rasterized glyph for write-back (pixels are copied)
+     */
+    void store(const AtlasCacheKey& key, const AtlasCacheRecord& record, const uint8_t* pixels);
+
+    /**
+     * Write every queued glyph now and wait until it is on disk
+     */
+    void flush();
+
+    const std::string& getDirectory() const { return directory_; }
+    std::string getFilePath(const AtlasCacheKey& key) const;
+
+    size_t getHitCount() const { return hitCount_; }
+    size_t getMissCount() const { return missCount_; }
+    size_t getRejectedCount() const { return rejectedCount_; } // Files that failed validation
+
+  private:
+    class MappedFile;
+
+    // A validated mapping of one key's file
+    struct MappedEntry {
+        std::unique_ptr<MappedFile> file;
+        const AtlasCacheRecord* records = nullptr;
+        uint32_t recordCount = 0;
+        const uint8_t* pixels = nullptr;
+    };
+
+    struct PendingGlyphs {
+        std::vector<AtlasCacheRecord> records; // pixelOffset indexes pixels
+        std::vector<uint8_t> pixels;
+    };
+
+    const MappedEntry& map(const AtlasCacheKey& key);
+    bool openValidated(const std::string& path, const AtlasCacheKey& key, MappedEntry& entry) const;
+    void writerLoop();
+    bool writeKey(const AtlasCacheKey& key, const PendingGlyphs& pending); // False if the file was not replaced
+    static void appendGlyphs(PendingGlyphs& to, const PendingGlyphs& from);
+    void requeueDeferred(); // Owner thread, mutex_ held
+
+    std::string directory_;
+    std::unordered_map<AtlasCacheKey, MappedEntry, AtlasCacheKeyHash> mapped_;
+
+    // Write-back queue (guarded by mutex_)
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable written_;
+    std::unordered_map<AtlasCacheKey, PendingGlyphs, AtlasCacheKeyHash> pending_;
+    std::unordered_map<AtlasCacheKey, PendingGlyphs, AtlasCacheKeyHash> deferred_; // Failed writes, e.g. a file still mapped on Windows
+    uint64_t storedSequence_ = 0;  // Glyphs ever stored
+    uint64_t writtenSequence_ = 0; // Glyphs on disk
+    bool flushRequested_ = false;
+    bool stopping_ = false;
+    std::thread writer_; // Started by the first store()
+
+    size_t hitCount_ = 0;
+    size_t missCount_ = 0;
+    size_t rejectedCount_ = 0;
+};
+
+} // namespace dakt::gui
+
+#endif // DAKTLIB_GUI_GLYPH_ATLAS_CACHE_HPP
@@ -41,7 +41,7 @@ struct TextCacheKeyHash {
  */
 struct CachedGlyphPosition {
     uint32_t glyphID;
-    float x, y; // Position relative to text origin
+    float x, y; // Position relative to text origin; whole pixels for coverage glyphs
     float width, height;
     float atlasX, atlasY, atlasW, atlasH; // UV coordinates in atlas
     uint32_t atlasPage;
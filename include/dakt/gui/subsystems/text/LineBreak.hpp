@@ -0,0 +1,95 @@
+#ifndef DAKTLIB_GUI_LINEBREAK_HPP
+#define DAKTLIB_GUI_LINEBREAK_HPP
+
+#include "../../core/Types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace dakt::gui {
+
+// ============================================================================
+// Line Breaking (UAX #14)
+// ============================================================================
+
+/**
+ * @brief Unicode Line_Break values
+ */
+enum class LineBreakClass : uint8_t {
+    BK,  // Mandatory break
+    CR,  // Carriage return
+    LF,  // Line feed
+    CM,  // Combining mark
+    NL,  // Next line
+    SG,  // Surrogate
+    WJ,  // Word joiner
+    ZW,  // Zero width space
+    GL,  // Non-breaking ("glue")
+    SP,  // Space
+    ZWJ, // Zero width joiner
+    B2,  // Break opportunity before and after
+    BA,  // Break after
+    BB,  // Break before
+    HY,  // Hyphen
+    CB,  // Contingent break
+    CL,  // Close punctuation
+    CP,  // Close parenthesis
+    EX,  // Exclamation / interrogation
+    IN,  // Inseparable
+    NS,  // Nonstarter
+    OP,  // Open punctuation
+    QU,  // Quotation
+    IS,  // Infix numeric separator
+    NU,  // Numeric
+    PO,  // Postfix numeric
+    PR,  // Prefix numeric
+    SY,  // Symbols allowing break after
+    AI,  // Ambiguous (alphabetic or ideographic)
+    AL,  // Alphabetic
+    CJ,  // Conditional Japanese starter
+    EB,  // Emoji base
+    EM,  // Emoji modifier
+    H2,  // Hangul LV syllable
+    H3,  // Hangul LVT syllable
+    HL,  // Hebrew letter
+    Ideographic, // ID; spelled out so it does not hide dakt::gui::ID
+    JL,  // Hangul L jamo
+    JV,  // Hangul V jamo
+    JT,  // Hangul T jamo
+    RI,  // Regional indicator
+    SA,  // Complex context (South East Asian)
+    XX,  // Unknown
+};
+
+/**
+ * Line break class of a codepoint (two table reads)
+ */
+DAKTLIB_GUI_API LineBreakClass getLineBreakClass(uint32_t codepoint);
+
+/**
+ * @brief Line break opportunity before a codepoint
+ */
+enum class BreakAction : uint8_t {
+    None,      // Lines may not break here
+    Allowed,   // Lines may break here
+    Mandatory, // Lines must break here (after a newline and at the end)
+};
+
+/**
+ * Find the line break opportunities of a paragraph with the default UAX #14
+ * rules. breaks[i] is the opportunity before codepoints[i], so breaks has
+ * count + 1 entries and breaks[count] is Mandatory. Complex-context scripts
+ * (Thai, Lao, Khmer, Myanmar) get no dictionary breaking.
+ */
+DAKTLIB_GUI_API void findLineBreaks(const uint32_t* codepoints, size_t count, std::vector<BreakAction>& breaks);
+
+/**
+ * True for codepoints that hang at the end of a line instead of taking
+ * width: spaces, newlines and zero width space
+ */
+DAKTLIB_GUI_API bool isLineEndSpace(uint32_t codepoint);
+
+} // namespace dakt::gui
+
+#endif // DAKTLIB_GUI_LINEBREAK_HPP
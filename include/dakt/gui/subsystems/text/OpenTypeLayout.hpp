@@ -0,0 +1,268 @@
+#ifndef DAKTLIB_GUI_OPENTYPE_LAYOUT_HPP
+#define DAKTLIB_GUI_OPENTYPE_LAYOUT_HPP
+
+#include "TextShaper.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dakt::gui {
+
+// Forward declaration
+class BinaryStream;
+
+// ============================================================================
+// Common Tables
+// ============================================================================
+
+/**
+ * @brief Compiled OpenType coverage table
+ *
+ * Membership is one bitset test; the coverage index is a binary search over
+ * the covered glyphs, which the format keeps sorted.
+ */
+class GlyphCoverage {
+  public:
+    void load(BinaryStream& stream, size_t offset);
+
+    bool contains(uint32_t glyphID) const { return (glyphID >> 6) < bits_.size() && ((bits_[glyphID >> 6] >> (glyphID & 63)) & 1) != 0; }
+
+    // Coverage index of glyphID, or -1 if not covered
+    int32_t indexOf(uint32_t glyphID) const;
+
+    const std::vector<uint16_t>& getGlyphs() const { return glyphs_; }
+    const std::vector<uint64_t>& getBits() const { return bits_; }
+
+  private:
+    std::vector<uint64_t> bits_;
+    std::vector<uint16_t> glyphs_; // Position = coverage index
+};
+
+/**
+ * @brief Compiled OpenType class definition, flattened to a dense array
+ */
+class GlyphClassDef {
+  public:
+    void load(BinaryStream& stream, size_t offset);
+
+    uint16_t classOf(uint32_t glyphID) const { return glyphID - firstGlyph_ < classes_.size() ? classes_[glyphID - firstGlyph_] : 0; }
+
+  private:
+    uint32_t firstGlyph_ = 0;
+    std::vector<uint16_t> classes_;
+};
+
+// ============================================================================
+// Glyph Substitution (GSUB)
+// ============================================================================
+
+/**
+ * @brief GSUB lookups compiled for a fixed set of features
+ *
+ * load() walks the script and feature lists once and compiles only the
+ * lookups those features (and the contextual lookups they call) reference:
+ * coverages become bitsets, ligature sets become tries and context rules
+ * flat arrays. Single, multiple, alternate (first alternate), ligature,
+ * contextual and chaining contextual lookups are supported, including
+ * extension subtables and GDEF-based lookup flags.
+ */
+class GlyphSubstitution {
+  public:
+    /**
+     * Compile lookups from a GSUB table
+     * @param data GSUB table bytes
+     * @param size GSUB table length
+     * @param scriptTag OpenType script to use (e.g. 'latn'); falls back to DFLT
+     * @param features Feature tags to enable (e.g. 'liga', 'calt')
+     * @param gdef Optional GDEF table, needed for lookups that skip marks
+     * @param gdefSize GDEF table length
+     * @return true if any lookup was compiled
+     */
+    bool load(const uint8_t* data, size_t size, uint32_t scriptTag, const std::vector<uint32_t>& features, const uint8_t* gdef = nullptr, size_t gdefSize = 0);
+
+    bool empty() const { return active_.empty(); }
+
+    /**
+     * Run the enabled lookups over glyphs in LookupList order. One scan of the
+     * buffer selects the lookups that can apply; the rest are never visited.
+     * Substituted glyphs keep their cluster but not their advance.
+     * @return true if any glyph changed
+     */
+    bool apply(std::vector<ShapedGlyph>& glyphs) const;
+
+  private:
+    enum class LookupType : uint8_t {
+        Single = 1,
+        Multiple = 2,
+        Alternate = 3,
+        Ligature = 4,
+        Context = 5,
+        ChainContext = 6,
+        Extension = 7,
+    };
+
+    static constexpr uint32_t NO_LIGATURE = 0xFFFFFFFF;
+
+    struct LigatureNode {
+        uint16_t glyphID = 0;
+        uint16_t childCount = 0;
+        uint32_t firstChild = 0;       // Children are contiguous and sorted by glyph
+        uint32_t ligature = NO_LIGATURE; // Glyph produced when matching ends here
+    };
+
+    struct SequenceLookup {
+        uint16_t sequenceIndex = 0;
+        uint16_t lookupIndex = 0;
+    };
+
+    // Context rule; the first input glyph is matched by the rule set it belongs to
+    struct ContextRule {
+        uint32_t backtrack = 0, input = 0, lookahead = 0; // Offsets into Subtable::values
+        uint16_t backtrackCount = 0, inputCount = 0, lookaheadCount = 0;
+        uint32_t firstRecord = 0;
+        uint16_t recordCount = 0;
+    };
+
+    struct Subtable {
+        LookupType type = LookupType::Single;
+        uint16_t format = 0;
+        GlyphCoverage coverage;
+
+        // Single format 1
+        int32_t delta = 0;
+
+        // Single format 2, multiple and alternate: output glyphs per coverage index
+        std::vector<uint16_t> outputs;
+        std::vector<uint32_t> outputStarts; // Coverage index -> range in outputs (count + 1)
+
+        // Ligature: trie root per coverage index
+        std::vector<LigatureNode> trie;
+
+        // Context and chaining context
+        GlyphClassDef backtrackClasses, inputClasses, lookaheadClasses;
+        std::vector<GlyphCoverage> coverages; // Format 3 sequence items index this
+        std::vector<uint16_t> values;         // Glyphs, classes or coverage indices
+        std::vector<ContextRule> rules;
+        std::vector<uint32_t> ruleStarts; // Coverage index (format 1) or class (format 2) -> rules
+        std::vector<SequenceLookup> records;
+    };
+
+    struct Lookup {
+        bool compiled = false;
+        uint16_t flags = 0;
+        std::vector<Subtable> subtables;
+        std::vector<uint64_t> coverageBits; // Union of the subtables' first-glyph coverage
+    };
+
+    enum class Sequence : uint8_t { Backtrack, Input, Lookahead };
+
+    // Compilation
+    void compileLookup(BinaryStream& stream, size_t lookupListOffset, uint16_t index, int depth);
+    bool compileSubtable(BinaryStream& stream, size_t offset, LookupType type, Subtable& subtable);
+    void compileContext(BinaryStream& stream, size_t offset, Subtable& subtable);
+    void compileChainContext(BinaryStream& stream, size_t offset, Subtable& subtable);
+    void readRule(BinaryStream& stream, Subtable& subtable, bool chained);
+
+    // Application
+    uint64_t startMask(const std::vector<ShapedGlyph>& glyphs) const;
+    bool skips(uint32_t glyphID, uint16_t flags) const;
+    size_t nextIndex(const std::vector<ShapedGlyph>& glyphs, size_t index, uint16_t flags) const;
+    size_t prevIndex(const std::vector<ShapedGlyph>& glyphs, size_t index, uint16_t flags) const;
+    bool applyAt(const Lookup& lookup, std::vector<ShapedGlyph>& glyphs, size_t& index, int depth, bool& changed) const;
+    bool applySubtable(const Lookup& lookup, const Subtable& subtable, std::vector<ShapedGlyph>& glyphs, size_t& index, int depth, bool& changed) const;
+    bool applyContext(const Lookup& lookup, const Subtable& subtable, std::vector<ShapedGlyph>& glyphs, size_t& index, int depth, bool& changed) const;
+    bool matchesItem(const Subtable& subtable, Sequence sequence, uint32_t glyphID, uint16_t value) const;
+
+    std::vector<Lookup> lookups_; // Indexed like the font's LookupList
+    std::vector<uint16_t> active_; // Enabled lookups in application order
+    std::vector<uint64_t> startMasks_; // Glyph -> bit k set if active_[k] can start on it
+
+    GlyphClassDef glyphClasses_;      // GDEF: 1 base, 2 ligature, 3 mark, 4 component
+    GlyphClassDef markAttachClasses_; // GDEF mark attachment classes
+};
+
+// ============================================================================
+// Glyph Positioning (GPOS / kern)
+// ============================================================================
+
+/**
+ * @brief Pair kerning from GPOS PairPos lookups or the legacy kern table
+ *
+ * Everything is flattened at load time so kerning a glyph pair costs a few
+ * array reads per lookup: explicit pairs (PairPos format 1, kern format 0)
+ * go into an open-addressed table keyed by the glyph pair, class pairs
+ * (PairPos format 2) into a dense first-glyph class array and a class
+ * matrix. Only the first glyph's XAdvance is applied, and pairs are always
+ * adjacent glyphs (lookup flags are not honoured).
+ */
+class GlyphPositioning {
+  public:
+    struct KerningPair {
+        uint16_t left = 0;
+        uint16_t right = 0;
+        int16_t value = 0; // Font units
+    };
+
+    /**
+     * Compile the pair positioning lookups of a GPOS table
+     * @param data GPOS table bytes
+     * @param size GPOS table length
+     * @param scriptTag OpenType script to use (e.g. 'latn'); falls back to DFLT
+     * @param features Feature tags to enable (normally just 'kern')
+     * @return true if any pair lookup was compiled
+     */
+    bool load(const uint8_t* data, size_t size, uint32_t scriptTag, const std::vector<uint32_t>& features);
+
+    /**
+     * Load the horizontal format 0 subtables of a legacy (version 0) kern table
+     * @return true if any pairs were loaded
+     */
+    bool loadKern(const uint8_t* data, size_t size);
+
+    /**
+     * Add explicit pairs as one more lookup; the first entry for a pair wins
+     * @return true if pairs is not empty
+     */
+    bool loadPairs(const std::vector<KerningPair>& pairs);
+
+    bool empty() const { return tables_.empty(); }
+
+    // Advance adjustment between two adjacent glyphs, in font units
+    int32_t getKerning(uint32_t left, uint32_t right) const;
+
+    // Add pair adjustments to the glyphs' advances
+    void apply(std::vector<ShapedGlyph>& glyphs) const;
+
+  private:
+    static constexpr uint32_t EMPTY_PAIR = 0xFFFFFFFF;
+
+    struct PairSlot {
+        uint32_t key = EMPTY_PAIR; // (left << 16) | right
+        int32_t value = 0;
+    };
+
+    struct ClassSubtable {
+        GlyphClassDef secondClasses;
+        uint16_t class2Count = 0;
+        std::vector<int16_t> values; // class1 * class2Count + class2
+    };
+
+    // One lookup; lookups add up
+    struct PairTable {
+        std::vector<PairSlot> slots; // Power-of-two size, linear probing
+        std::vector<uint64_t> pairFirsts; // Bit per first glyph with explicit pairs
+        std::vector<uint32_t> firstClasses; // Glyph -> (class subtable + 1) << 16 | class1, 0 if none
+        std::vector<ClassSubtable> classSubtables;
+    };
+
+    void compileLookup(BinaryStream& stream, size_t lookupListOffset, uint16_t index);
+    void compilePairSubtable(BinaryStream& stream, size_t offset, PairTable& table, std::vector<KerningPair>& pairs) const;
+    static void buildPairs(PairTable& table, const std::vector<KerningPair>& pairs);
+    static int32_t lookupPair(const PairTable& table, uint32_t left, uint32_t right);
+
+    std::vector<PairTable> tables_;
+};
+
+} // namespace dakt::gui
+
+#endif // DAKTLIB_GUI_OPENTYPE_LAYOUT_HPP
@@ -42,7 +42,7 @@ struct EdgeSegment {
     enum Type { Linear, Quadratic, Cubic };
     Type type;
     Vec2 p0, p1, p2, p3; // Control points (p2, p3 only for quad/cubic)
-    int color = 0;       // For MSDF edge coloring
+    int color = 7;       // MSDF channel mask: 1 red, 2 green, 4 blue
 };
 
 /**
@@ -91,13 +91,25 @@ class SDFGenerator {
      */
     SDFGlyphBitmap generate(const GlyphOutline& outline, float fontSize, int16_t unitsPerEm);
 
+    /**
+     * Generate SDF bitmap straight from TTFParser's outline arena
+     */
+    SDFGlyphBitmap generate(const GlyphOutlineView& outline, float fontSize, int16_t unitsPerEm);
+
     /**
      * Convert glyph outline to shape for SDF processing
      */
     Shape outlineToShape(const GlyphOutline& outline, float scale);
+    Shape outlineToShape(const GlyphOutlineView& outline, float scale);
+
+    /**
+     * Assign MSDF channels to edges: colors switch at corners so each corner
+     * stays sharp, smooth contours keep all channels (generate() calls this)
+     */
+    void colorEdges(Shape& shape);
 
     /**
-     * Calculate signed distance from point to shape
+     * Calculate signed distance from point to shape (positive inside)
      */
     float signedDistance(const Shape& shape, Vec2 point) const;
 
@@ -107,20 +119,25 @@ class SDFGenerator {
     float distanceToEdge(const EdgeSegment& edge, Vec2 point) const;
 
   private:
-    // Edge coloring for MSDF (assigns colors to edges to prevent artifacts)
-    void colorEdges(Shape& shape);
+    // Append one TrueType contour (quadratic, on/off-curve points) to shape
+    void appendContour(const GlyphPoint* points, size_t count, float scale, Shape& shape) const;
+
+    SDFGlyphBitmap generateShape(Shape& shape, const GlyphBounds& bounds, int16_t advanceWidth, float scale);
 
     // Distance calculations
     float distanceToLine(Vec2 p, Vec2 a, Vec2 b) const;
     float distanceToQuadratic(Vec2 p, Vec2 p0, Vec2 p1, Vec2 p2) const;
     float distanceToCubic(Vec2 p, Vec2 p0, Vec2 p1, Vec2 p2, Vec2 p3) const;
 
-    // Winding number calculation for inside/outside test
-    int calculateWinding(const Contour& contour, Vec2 point) const;
+    // Non-zero winding number of the whole shape at point (scanline crossings)
+    int windingAt(const Shape& shape, Vec2 point) const;
 
-    // MSDF-specific: calculate per-channel distances
+    // MSDF-specific: per-channel pseudo-distances (positive on the right of each edge)
     Vec3 msdfDistance(const Shape& shape, Vec2 point) const;
 
+    // Flatten texels whose channels would interpolate into a false edge (interleaved, normalized)
+    void correctErrors(std::vector<float>& field, uint32_t width, uint32_t height, uint32_t stride) const;
+
     float spread_ = 4.0f;
     SDFMode mode_ = SDFMode::SDF;
 };
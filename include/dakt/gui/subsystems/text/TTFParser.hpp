@@ -4,18 +4,21 @@
 #include <array>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace dakt::gui {
 
 /**
  * @brief Binary stream reader for big-endian font data
+ *
+ * The stream reads the caller's bytes in place; they must outlive it.
  */
 class BinaryStream {
   public:
     explicit BinaryStream(const std::vector<uint8_t>& data);
+    explicit BinaryStream(std::vector<uint8_t>&&) = delete;
     explicit BinaryStream(const uint8_t* data, size_t size);
 
     uint8_t readU8();
@@ -29,11 +32,12 @@ class BinaryStream {
     void seek(size_t offset);
     void skip(size_t count);
     size_t tell() const { return position_; }
-    size_t size() const { return data_.size(); }
-    bool eof() const { return position_ >= data_.size(); }
+    size_t size() const { return size_; }
+    bool eof() const { return position_ >= size_; }
 
   private:
-    const std::vector<uint8_t> data_;
+    const uint8_t* data_;
+    size_t size_;
     size_t position_ = 0;
 };
 
@@ -80,6 +84,40 @@ struct GlyphOutline {
     int16_t leftSideBearing = 0;
 };
 
+/**
+ * @brief Glyph outline stored in the parser's outline arena
+ *
+ * Contour c covers points [c ? contourEnds[c - 1] : 0, contourEnds[c]).
+ * The pointers stay valid as long as the parser.
+ */
+struct GlyphOutlineView {
+    const GlyphPoint* points = nullptr;
+    const uint16_t* contourEnds = nullptr;
+    uint16_t pointCount = 0;
+    uint16_t contourCount = 0;
+    int16_t xMin = 0;
+    int16_t yMin = 0;
+    int16_t xMax = 0;
+    int16_t yMax = 0;
+    int16_t advanceWidth = 0;
+    int16_t leftSideBearing = 0;
+
+    bool empty() const { return contourCount == 0; }
+
+    // Copy into an owning outline (e.g. to apply variation deltas)
+    GlyphOutline toOutline() const;
+};
+
+/**
+ * @brief Glyph bounding box from the glyf table
+ */
+struct GlyphBounds {
+    int16_t xMin = 0;
+    int16_t yMin = 0;
+    int16_t xMax = 0;
+    int16_t yMax = 0;
+};
+
 /**
  * @brief Font metrics from HEAD table
  */
@@ -121,6 +159,12 @@ struct CmapEntry {
 /**
  * @brief TrueType/OpenType font parser
  * Supports TTF and OTF (with glyf outlines)
+ *
+ * Per-glyph metrics and bounds are dense arrays filled at load time, and the
+ * cmap is flattened into 256-codepoint pages. Outlines live in one arena of
+ * points and contour ends: load time reserves each glyph's slice, and the
+ * first getGlyphOutline() call for a glyph decodes it exactly once, so
+ * outlines can be requested from several threads.
  */
 class TTFParser {
   public:
@@ -146,9 +190,10 @@ class TTFParser {
 
     // Glyph queries
     uint16_t getGlyphId(uint32_t codepoint) const;
-    const GlyphOutline* getGlyphOutline(uint16_t glyphId) const;
+    GlyphOutlineView getGlyphOutline(uint16_t glyphId) const; // Empty for blank and composite glyphs
     int16_t getAdvanceWidth(uint16_t glyphId) const;
     int16_t getLeftSideBearing(uint16_t glyphId) const;
+    GlyphBounds getGlyphBounds(uint16_t glyphId) const { return glyphId < glyphBounds_.size() ? glyphBounds_[glyphId] : GlyphBounds{}; }
 
     // Font info
     uint16_t getGlyphCount() const { return glyphCount_; }
@@ -170,10 +215,10 @@ class TTFParser {
     bool parseLocaTable(BinaryStream& stream);
     bool parseCmapTable(BinaryStream& stream);
     bool parseNameTable(BinaryStream& stream);
+    void buildCharacterPages();
 
     // Glyph outline parsing
-    GlyphOutline parseSimpleGlyph(BinaryStream& stream, int16_t xMin, int16_t yMin, int16_t xMax, int16_t yMax);
-    GlyphOutline parseCompositeGlyph(BinaryStream& stream, int16_t xMin, int16_t yMin, int16_t xMax, int16_t yMax);
+    void parseSimpleGlyph(uint16_t glyphId) const;
 
     // Helper for name table string extraction
     std::string extractNameString(const std::vector<uint8_t>& data, uint16_t offset, uint16_t length, uint16_t platformId);
@@ -182,13 +227,22 @@ class TTFParser {
     std::vector<uint8_t> fontData_;
     std::vector<TableDirectory> tables_;
     std::vector<uint32_t> glyphLocations_; // loca table
-    std::unordered_map<uint16_t, GlyphOutline> glyphCache_;
     std::vector<int16_t> advanceWidths_;    // hmtx table
     std::vector<int16_t> leftSideBearings_; // hmtx table
+    std::vector<GlyphBounds> glyphBounds_;  // glyf headers
+
+    // Outline arena; glyph g owns points [pointStarts_[g], pointStarts_[g + 1]) and likewise contours
+    std::vector<uint32_t> pointStarts_;
+    std::vector<uint32_t> contourStarts_;
+    std::unique_ptr<GlyphPoint[]> outlinePoints_;  // Filled lazily by getGlyphOutline()
+    std::unique_ptr<uint16_t[]> contourEnds_;      // Same
+    std::unique_ptr<std::once_flag[]> outlineOnce_; // Per glyph
 
     FontMetrics fontMetrics_;
     HorizontalMetrics hMetrics_;
     std::vector<CmapEntry> cmapEntries_;
+    std::vector<uint16_t> cmapPages_;  // BMP codepoint >> 8 -> page in cmapGlyphs_ (page 0 maps nothing)
+    std::vector<uint16_t> cmapGlyphs_; // 256 glyph IDs per page
 
     uint16_t glyphCount_ = 0;
     uint16_t numberOfHMetrics_ = 0;
@@ -1,7 +1,9 @@
 #ifndef DAKTLIB_GUI_TEXT_HPP
 #define DAKTLIB_GUI_TEXT_HPP
 
+#include "LineBreak.hpp"
 #include "TextShaper.hpp"
+#include <list>
 #include <map>
 #include <memory>
 #include <string>
@@ -12,6 +14,7 @@ namespace dakt::gui {
 // Forward declarations
 class Font;
 class GlyphAtlas;
+class GlyphAtlasCache;
 
 // ============================================================================
 // Text Rendering Parameters
@@ -41,11 +44,49 @@ struct TextLine {
     uint32_t endCluster = 0;
 };
 
+/**
+ * @brief Lines of a shaped paragraph
+ *
+ * Besides the lines, a layout keeps what wrapping needs: the paragraph's
+ * glyphs, their pixel advances as prefix sums and the UAX #14 break
+ * opportunities mapped to glyph boundaries. reflow() re-splits the lines for
+ * a new width from those alone, without shaping or analyzing the text again.
+ */
 struct TextLayout {
-    std::vector<TextLine> lines;
+    std::vector<TextLine> lines; // First lineCount are valid; reflow() reuses the rest
     float totalWidth = 0.0f;
     float totalHeight = 0.0f;
     uint32_t lineCount = 0;
+    bool hasRTL = false; // Lines need the paragraph's bidi analysis to reflow
+
+    // Break opportunity before glyph index
+    struct Break {
+        uint32_t glyph = 0;
+        uint32_t contentEnd = 0; // Line end before trailing spaces and newlines
+        uint32_t cluster = 0;    // Byte offset of the break in the text
+        bool mandatory = false;
+    };
+
+    std::vector<ShapedGlyph> glyphs;
+    std::vector<float> advanceSums; // Pixel advance before each glyph (glyphs.size() + 1)
+    std::vector<Break> breaks;      // Ascending; the last one is the end of the text
+    float lineHeight = 0.0f;        // Pixels
+    float maxWidth = 0.0f;          // 0 = no wrapping
+
+    /**
+     * Split the glyphs into lines no wider than maxWidth, breaking at the
+     * last opportunity that fits. Words wider than a line are split between
+     * glyphs. With the paragraph's bidi analysis each line's glyphs are put
+     * in visual order; without it they stay in logical order.
+     */
+    void reflow(float maxWidth, const BidiParagraph* bidi = nullptr);
+
+  private:
+    void addLine(uint32_t start, uint32_t end, uint32_t contentEnd, uint32_t startCluster, uint32_t endCluster);
+    void reorderLine(TextLine& line, const BidiParagraph& bidi);
+
+    std::vector<BidiParagraph::Run> bidiRuns_; // Reused by reorderLine()
+    std::vector<ShapedGlyph> visualGlyphs_;    // Reused by reorderLine()
 };
 
 // ============================================================================
@@ -61,21 +102,59 @@ class TextRenderer {
     bool loadFont(const std::string& name, const std::string& filePath);
     Font* getFont(const std::string& name);
 
-    // Shape and layout text
+    // Shape and layout text; the returned copy holds only the valid lines
     ShapedRun shapeText(const std::string& fontName, const std::string& text);
     TextLayout layoutText(const std::string& fontName, const std::string& text, const TextRenderParams& params);
 
-    // Get glyph atlas for rendering
-    GlyphAtlas& getAtlas(const std::string& fontName);
+    /**
+     * Layout of a paragraph, cached by font, text, size and line height.
+     * When only maxWidth changed since the last call the cached layout is
+     * reflowed. The reference stays valid until LAYOUT_CACHE_SIZE other
+     * paragraphs have been laid out. Only the first lineCount lines are valid.
+     */
+    const TextLayout& reflowText(const std::string& fontName, const std::string& text, const TextRenderParams& params);
+
+    // Glyph atlas shared by every loaded font, so mixed fonts draw from the same pages
+    GlyphAtlas& getAtlas();
+
+    /**
+     * Keep rasterized glyphs in directory across runs. The atlas starts with
+     * every glyph cached for each loaded font; an empty path disables the cache.
+     */
+    void setAtlasCacheDirectory(const std::string& directory);
+    GlyphAtlasCache* getAtlasCache() { return atlasCache_.get(); }
 
     // Text metrics
     Vec2 measureText(const std::string& fontName, const std::string& text, float fontSize);
     float measureLine(const std::string& fontName, const std::string& text, float fontSize);
 
+    // Shaped words reused by layoutText() and measureText()
+    ShapedWordCache& getWordCache() { return wordCache_; }
+
   private:
+    void buildLayout(Font& font, const std::string& text, const TextRenderParams& params, TextLayout& layout);
+
+    // Recently laid out paragraphs, most recent first
+    struct LayoutEntry {
+        const Font* font = nullptr;
+        std::string text;
+        size_t hash = 0;
+        float fontSize = 0.0f;
+        float lineHeight = 0.0f;
+        TextLayout layout;
+    };
+    static constexpr size_t LAYOUT_CACHE_SIZE = 32;
+
     std::map<std::string, std::unique_ptr<Font>> fonts_;
-    std::map<std::string, std::unique_ptr<GlyphAtlas>> atlases_;
+    std::unique_ptr<GlyphAtlasCache> atlasCache_; // Outlives the atlas that points at it
+    std::unique_ptr<GlyphAtlas> atlas_;
     TextShaper shaper_;
+    ShapedWordCache wordCache_;
+    std::list<LayoutEntry> layoutCache_;
+    ShapedRun scratchRun_;                    // Reused by buildLayout()
+    std::vector<uint32_t> scratchCodepoints_; // Reused by measureLine() and buildLayout()
+    std::vector<uint32_t> scratchOffsets_;    // Codepoint byte offsets, reused by buildLayout()
+    std::vector<BreakAction> scratchBreaks_;  // Reused by buildLayout()
 };
 
 } // namespace dakt::gui
@@ -2,14 +2,22 @@
 #define DAKTLIB_GUI_TEXT_SHAPER_HPP
 
 #include "../../core/Types.hpp"
+#include "Bidi.hpp"
+#include <array>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace dakt::gui {
 
-// Forward declaration
+// Forward declarations
 class Font;
+class GlyphPositioning;
+class GlyphSubstitution;
 
 // ============================================================================
 // Text Shaping
@@ -32,17 +40,51 @@ struct ShapedRun {
     bool isRTL = false;       // Right-to-left text
 };
 
+/**
+ * @brief Caller-owned output of TextShaper::shapeInto()
+ *
+ * Glyph clusters are byte offsets into the shaped text. Keep one buffer per
+ * call site and reuse it: storage grows to the longest text and is never freed.
+ */
+struct ShapedGlyphBuffer {
+    std::vector<ShapedGlyph> glyphs;
+    uint32_t scriptTag = 0;
+    bool isRTL = false;
+
+    void clear() {
+        glyphs.clear();
+        scriptTag = 0;
+        isRTL = false;
+    }
+};
+
 class TextShaper {
   public:
     TextShaper();
     ~TextShaper();
 
     // Shape text with font
+    // Pure ASCII text maps through a per-font glyph table and skips GSUB/GPOS
+    // when the font has nothing those passes could apply.
     ShapedRun shape(Font& font, const std::string& text, uint32_t scriptTag = 0);
 
-    // Shape bidirectional text
+    /**
+     * Shape text into buffer without allocating once the buffer has grown:
+     * UTF-8 is decoded once and substitution/positioning run in place.
+     * Clusters are byte offsets into text.
+     */
+    void shapeInto(Font& font, std::string_view text, ShapedGlyphBuffer& buffer, uint32_t scriptTag = 0);
+
+    // Shape bidirectional text into runs in visual order (UAX #9, one line)
     std::vector<ShapedRun> shapeBidi(Font& font, const std::string& text);
 
+    /**
+     * Bidi analysis of a paragraph, cached by text so re-wrapping or
+     * re-shaping the same paragraph skips the analysis. The reference stays
+     * valid until BIDI_CACHE_SIZE other paragraphs have been analyzed.
+     */
+    const BidiParagraph& getBidiParagraph(std::string_view text);
+
     // Apply GSUB (substitution) features
     void applyGSUB(Font& font, ShapedRun& run);
 
@@ -52,10 +94,45 @@ class TextShaper {
     // Ligature substitution
     void substituteWhitespace(ShapedRun& run, uint32_t spaceGlyphID);
 
+    // Drop per-font shaping data (call before a font is destroyed or reloaded)
+    void invalidateFont(const Font* font);
+
   private:
-    // Bidirectional algorithm
-    void determineBidiLevel(const std::string& text, std::vector<uint32_t>& levels);
-    void reorderLogicalToVisual(std::vector<ShapedRun>& runs, const std::vector<uint32_t>& levels);
+    /**
+     * @brief Shaping facts about a font, gathered on first use
+     */
+    struct FontPlan {
+        std::array<uint16_t, 128> asciiGlyphs{};
+        std::array<float, 128> asciiAdvances{};
+
+        // GSUB compiled from the font; null when it has none
+        std::unique_ptr<GlyphSubstitution> gsub;
+
+        // Built-in fi/fl ligatures for fonts without GSUB
+        bool hasLigatures = false;
+        uint16_t glyphF = 0, glyphI = 0, glyphL = 0, glyphFi = 0, glyphFl = 0;
+        float advanceFi = 0.0f, advanceFl = 0.0f;
+
+        // Pair kerning from GPOS, the kern table or built-in pairs; null when disabled
+        std::unique_ptr<GlyphPositioning> gpos;
+    };
+
+    const FontPlan& getPlan(Font& font);
+    bool isFeatureEnabled(uint32_t tag) const;
+
+    // In-place passes over shaped glyphs
+    static void substitute(Font& font, const FontPlan& plan, std::vector<ShapedGlyph>& glyphs);
+    static void substituteLigatures(const FontPlan& plan, std::vector<ShapedGlyph>& glyphs);
+
+    // Recently analyzed paragraphs, most recent first
+    struct BidiEntry {
+        std::string text;
+        size_t hash = 0;
+        BidiParagraph paragraph;
+    };
+    static constexpr size_t BIDI_CACHE_SIZE = 32;
+    std::list<BidiEntry> bidiCache_;
+    std::vector<BidiParagraph::Run> bidiRuns_;
 
     // Feature application
     struct Feature {
@@ -64,6 +141,114 @@ class TextShaper {
     };
 
     std::vector<Feature> features_;
+    std::unordered_map<const Font*, FontPlan> plans_;
+};
+
+// ============================================================================
+// Word Shaping Cache
+// ============================================================================
+
+/**
+ * @brief Shaped glyphs for one word or whitespace run
+ */
+struct ShapedWord {
+    std::vector<ShapedGlyph> glyphs; // Clusters are byte offsets into the word
+    uint32_t scriptTag = 0;
+    bool isRTL = false;
+    float advance = 0.0f; // Sum of xAdvance, font units
+};
+
+/**
+ * @brief LRU cache of shaped words
+ *
+ * Paragraphs are split at ASCII whitespace and assembled from cached words,
+ * so text that repeats the same tokens is shaped once per token. Shaped
+ * advances are in font units, so entries are shared across font sizes.
+ */
+class ShapedWordCache {
+  public:
+    explicit ShapedWordCache(size_t maxEntries = 4096);
+    ~ShapedWordCache();
+
+    /**
+     * Get the shaped word, shaping it on a miss. The reference stays valid
+     * until the next get() or invalidation.
+     */
+    const ShapedWord& get(TextShaper& shaper, Font& font, std::string_view word);
+
+    /**
+     * Shape a paragraph word by word into run (clusters are byte offsets into text)
+     */
+    void shapeText(TextShaper& shaper, Font& font, std::string_view text, ShapedRun& run);
+
+    /**
+     * Total advance of a paragraph in font units, summed from cached words
+     */
+    float measureText(TextShaper& shaper, Font& font, std::string_view text);
+
+    void invalidateFont(const Font* font);
+    void clear();
+
+    void setMaxEntries(size_t maxEntries) { maxEntries_ = maxEntries; }
+    size_t getMaxEntries() const { return maxEntries_; }
+
+    size_t getEntryCount() const { return cache_.size(); }
+    size_t getHitCount() const { return hitCount_; }
+    size_t getMissCount() const { return missCount_; }
+    void resetStats() {
+        hitCount_ = 0;
+        missCount_ = 0;
+    }
+
+  private:
+    struct Key {
+        const Font* font;
+        std::string text;
+    };
+
+    struct KeyView {
+        const Font* font;
+        std::string_view text;
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(const Key& key) const { return (*this)(KeyView{key.font, key.text}); }
+        size_t operator()(const KeyView& key) const {
+            size_t h = std::hash<const void*>{}(key.font);
+            h ^= std::hash<std::string_view>{}(key.text) + 0x9e3779b9 + (h << 6) + (h >> 2);
+            return h;
+        }
+    };
+
+    struct KeyEqual {
+        using is_transparent = void;
+        static KeyView view(const Key& key) { return KeyView{key.font, key.text}; }
+        static KeyView view(const KeyView& key) { return key; }
+        template <typename A, typename B> bool operator()(const A& a, const B& b) const {
+            KeyView va = view(a);
+            KeyView vb = view(b);
+            return va.font == vb.font && va.text == vb.text;
+        }
+    };
+
+    void evictLRU();
+
+    ShapedGlyphBuffer scratch_;
+
+    // LRU list (front = most recent, back = least recent)
+    using LRUList = std::list<Key>;
+    LRUList lruList_;
+
+    struct CacheEntry {
+        ShapedWord word;
+        LRUList::iterator lruIterator;
+    };
+    std::unordered_map<Key, CacheEntry, KeyHash, KeyEqual> cache_;
+
+    size_t maxEntries_;
+    size_t hitCount_ = 0;
+    size_t missCount_ = 0;
 };
 
 } // namespace dakt::gui
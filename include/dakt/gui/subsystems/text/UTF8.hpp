@@ -0,0 +1,73 @@
+#ifndef DAKTLIB_GUI_UTF8_HPP
+#define DAKTLIB_GUI_UTF8_HPP
+
+#include "../../core/Types.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Validating UTF-8 decoding shared by shaping, measurement, cursors and the C API
+ *
+ * Runs of ASCII are scanned and widened 16/32 bytes at a time (SSE2/AVX2/NEON,
+ * picked at compile time); multi-byte sequences go through a strict scalar
+ * decoder. Malformed input never reads past the end of the text: each maximal
+ * invalid subpart decodes to U+FFFD, as recommended by the Unicode standard.
+ */
+namespace dakt::gui::utf8 {
+
+constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+/**
+ * Number of leading bytes that are ASCII
+ */
+DAKTLIB_GUI_API size_t asciiPrefix(std::string_view text);
+
+/**
+ * Decode the codepoint starting at offset and advance offset past it
+ * @return The codepoint, or REPLACEMENT_CHARACTER for a malformed sequence
+ */
+DAKTLIB_GUI_API uint32_t decodeOne(std::string_view text, size_t& offset);
+
+/**
+ * Decode text into out, which must hold at least text.size() codepoints
+ * @param offsets Optional, receives the byte offset of each codepoint (same capacity)
+ * @return Number of codepoints written
+ */
+DAKTLIB_GUI_API size_t decode(std::string_view text, uint32_t* out, uint32_t* offsets = nullptr);
+
+/**
+ * Decode text into out, replacing its contents (capacity is reused)
+ */
+DAKTLIB_GUI_API void decode(std::string_view text, std::vector<uint32_t>& out);
+
+/**
+ * Number of codepoints decode() yields for text
+ */
+DAKTLIB_GUI_API size_t length(std::string_view text);
+
+/**
+ * Byte offset of the codepoint at index (text.size() when index is past the end)
+ */
+DAKTLIB_GUI_API size_t offsetOf(std::string_view text, size_t index);
+
+/**
+ * True if text is well-formed UTF-8
+ */
+DAKTLIB_GUI_API bool isValid(std::string_view text);
+
+/**
+ * Append the UTF-8 encoding of codepoint to out
+ */
+DAKTLIB_GUI_API void append(uint32_t codepoint, std::string& out);
+
+/**
+ * Copy of text with every malformed sequence replaced by U+FFFD
+ */
+DAKTLIB_GUI_API std::string sanitize(std::string_view text);
+
+} // namespace dakt::gui::utf8
+
+#endif // DAKTLIB_GUI_UTF8_HPP
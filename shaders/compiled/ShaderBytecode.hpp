@@ -13,6 +13,10 @@
 
 namespace dakt::gui::shaders {
 
+// The modules below are truncated stubs, not valid SPIR-V, and must never
+// reach vkCreateShaderModule. Set to false when replacing them with glslc output.
+static constexpr bool SPV_PLACEHOLDER = true;
+
 // ============================================================================
 // UI Vertex Shader (ui.vert.glsl compiled to SPIR-V)
 // ============================================================================
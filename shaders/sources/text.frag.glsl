@@ -19,12 +19,12 @@ layout(binding = 0) uniform UniformBuffer {
     float padding[3];
 } ubo;
 
-// SDF texture (R8 for SDF, RGB8 for MSDF)
+// Glyph atlas page (R8 for SDF, RGB8 for MSDF, A8 for coverage)
 layout(binding = 1) uniform sampler2D sdfTexture;
 
 // Push constants for per-draw parameters
 layout(push_constant) uniform PushConstants {
-    int renderMode;  // 0 = SDF, 1 = MSDF
+    int renderMode;  // 0 = SDF, 1 = MSDF, 2 = coverage (GlyphRenderMode)
     float softness;  // Edge softness (0.0 = sharp, 1.0 = soft)
 } pc;
 
@@ -62,7 +62,10 @@ float screenPxDistance(float sdfValue) {
 void main() {
     float opacity;
     
-    if (pc.renderMode == 1) {
+    if (pc.renderMode == 2) {
+        // Coverage mode - small text rasterized at its drawn size, alpha as is
+        opacity = texture(sdfTexture, fragTexCoord).a;
+    } else if (pc.renderMode == 1) {
         // MSDF mode - use median of RGB channels
         vec3 msd = texture(sdfTexture, fragTexCoord).rgb;
         float sd = median(msd.r, msd.g, msd.b);
@@ -0,0 +1,301 @@
+/**
+ * @file NullBackend.cpp
+ * @brief Recording backend with no GPU work (headless tests and benchmarks)
+ */
+
+#include "dakt/gui/backend/null/NullBackend.hpp"
+#include "dakt/gui/subsystems/draw/DrawList.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dakt::gui {
+
+// =============================================================================
+// Helpers
+// =============================================================================
+
+static uint64_t bytesPerPixel(TextureFormat format) {
+    switch (format) {
+    case TextureFormat::R8:
+    case TextureFormat::A8:
+        return 1;
+    case TextureFormat::RG8:
+    case TextureFormat::R16F:
+        return 2;
+    case TextureFormat::RGBA8:
+    case TextureFormat::BGRA8:
+    case TextureFormat::R32F:
+    case TextureFormat::Depth24Stencil8:
+    case TextureFormat::Depth32F:
+        return 4;
+    case TextureFormat::RGBA16F:
+        return 8;
+    case TextureFormat::RGBA32F:
+        return 16;
+    }
+    return 4;
+}
+
+// =============================================================================
+// NullBackend Implementation
+// =============================================================================
+
+NullBackend::NullBackend() {
+    capabilities_.maxTextureSize = 16384;
+    capabilities_.maxUniformBufferSize = 65536;
+    capabilities_.supportsMSAA = false;
+    capabilities_.maxMSAASamples = 1;
+    capabilities_.deviceName = "Null Device";
+    capabilities_.apiVersion = "0.0";
+}
+
+NullBackend::~NullBackend() {
+    if (initialized_) {
+        shutdown();
+    }
+}
+
+bool NullBackend::initialize(void* windowHandle, uint32_t width, uint32_t height) {
+    (void)windowHandle;
+    width_ = width;
+    height_ = height;
+    initialized_ = true;
+    return true;
+}
+
+void NullBackend::shutdown() {
+    buffers_.clear();
+    textures_.clear();
+    frameInProgress_ = false;
+    initialized_ = false;
+}
+
+// =============================================================================
+// Frame Management
+// =============================================================================
+
+bool NullBackend::beginFrame() {
+    if (!initialized_ || frameInProgress_) {
+        return false;
+    }
+
+    frameIndex_++;
+    frameStats_ = NullBackendStats{};
+    frameStats_.frames = 1;
+    totalStats_.frames++;
+    frameInProgress_ = true;
+    return true;
+}
+
+void NullBackend::endFrame() { frameInProgress_ = false; }
+
+void NullBackend::present() {}
+
+void NullBackend::resize(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return;
+    }
+    width_ = width;
+    height_ = height;
+}
+
+// =============================================================================
+// Draw Submission
+// =============================================================================
+
+void NullBackend::submit(const DrawList& drawList) {
+    NullSubmitRecord record;
+    record.frameIndex = frameIndex_;
+    record.vertexCount = drawList.getVertexCount();
+    record.indexCount = drawList.getIndexCount();
+    record.commandCount = static_cast<uint32_t>(drawList.getCommands().size());
+    record.drawCommandCount = static_cast<uint32_t>(
+        std::count_if(drawList.getCommands().begin(), drawList.getCommands().end(), [](const DrawCommand& cmd) { return cmd.type == DrawCommandType::DrawTriangles; }));
+    record.vertexBytes = static_cast<uint64_t>(record.vertexCount) * sizeof(Vertex);
+    record.indexBytes = static_cast<uint64_t>(record.indexCount) * sizeof(uint32_t);
+
+    for (NullBackendStats* stats : {&frameStats_, &totalStats_}) {
+        stats->submits++;
+        stats->vertices += record.vertexCount;
+        stats->indices += record.indexCount;
+        stats->drawCommands += record.drawCommandCount;
+        stats->vertexBytes += record.vertexBytes;
+        stats->indexBytes += record.indexBytes;
+    }
+
+    if (recording_) {
+        submits_.push_back(record);
+    }
+}
+
+// =============================================================================
+// Buffer Management
+// =============================================================================
+
+BufferHandle NullBackend::createBuffer(const BufferDesc& desc) {
+    BufferHandle handle = nextBufferHandle_++;
+    auto& storage = buffers_[handle];
+    storage.resize(static_cast<size_t>(desc.size));
+    if (desc.initialData && desc.size > 0) {
+        std::memcpy(storage.data(), desc.initialData, static_cast<size_t>(desc.size));
+    }
+
+    for (NullBackendStats* stats : {&frameStats_, &totalStats_}) {
+        stats->buffersCreated++;
+        if (desc.initialData) {
+            stats->bufferBytesUploaded += desc.size;
+        }
+    }
+    recordResourceOp(NullResourceRecord::Op::CreateBuffer, handle, desc.size);
+    return handle;
+}
+
+void NullBackend::destroyBuffer(BufferHandle handle) {
+    if (buffers_.erase(handle) > 0) {
+        recordResourceOp(NullResourceRecord::Op::DestroyBuffer, handle, 0);
+    }
+}
+
+void* NullBackend::mapBuffer(BufferHandle handle) {
+    auto it = buffers_.find(handle);
+    if (it == buffers_.end() || it->second.empty()) {
+        return nullptr;
+    }
+    return it->second.data();
+}
+
+void NullBackend::unmapBuffer(BufferHandle handle) {
+    // A mapped write is treated as a full upload of the buffer
+    auto it = buffers_.find(handle);
+    if (it == buffers_.end()) {
+        return;
+    }
+
+    const uint64_t bytes = it->second.size();
+    for (NullBackendStats* stats : {&frameStats_, &totalStats_}) {
+        stats->bufferUpdates++;
+        stats->bufferBytesUploaded += bytes;
+    }
+    recordResourceOp(NullResourceRecord::Op::UpdateBuffer, handle, bytes);
+}
+
+void NullBackend::updateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset) {
+    auto it = buffers_.find(handle);
+    if (it == buffers_.end() || !data || offset + size > it->second.size()) {
+        return;
+    }
+
+    std::memcpy(it->second.data() + offset, data, static_cast<size_t>(size));
+
+    for (NullBackendStats* stats : {&frameStats_, &totalStats_}) {
+        stats->bufferUpdates++;
+        stats->bufferBytesUploaded += size;
+    }
+    recordResourceOp(NullResourceRecord::Op::UpdateBuffer, handle, size);
+}
+
+// =============================================================================
+// Texture Management
+// =============================================================================
+
+TextureHandle NullBackend::createTexture(const TextureDesc& desc) {
+    TextureHandle handle = nextTextureHandle_++;
+    NullTexture& texture = textures_[handle];
+    texture.desc = desc;
+    texture.desc.initialData = nullptr;
+
+    const uint64_t bytes = static_cast<uint64_t>(desc.width) * desc.height * std::max(desc.depth, 1u) * bytesPerPixel(desc.format);
+    texture.data.resize(static_cast<size_t>(bytes));
+    if (desc.initialData && bytes > 0) {
+        std::memcpy(texture.data.data(), desc.initialData, static_cast<size_t>(bytes));
+    }
+
+    for (NullBackendStats* stats : {&frameStats_, &totalStats_}) {
+        stats->texturesCreated++;
+        if (desc.initialData) {
+            stats->textureBytesUploaded += bytes;
+        }
+    }
+    recordResourceOp(NullResourceRecord::Op::CreateTexture, handle, bytes);
+    return handle;
+}
+
+void NullBackend::destroyTexture(TextureHandle handle) {
+    if (textures_.erase(handle) > 0) {
+        recordResourceOp(NullResourceRecord::Op::DestroyTexture, handle, 0);
+    }
+}
+
+void NullBackend::updateTexture(TextureHandle handle, const void* data, uint32_t width, uint32_t height) {
+    auto it = textures_.find(handle);
+    if (it == textures_.end() || !data) {
+        return;
+    }
+
+    NullTexture& texture = it->second;
+    const uint64_t bpp = bytesPerPixel(texture.desc.format);
+    const uint32_t copyWidth = std::min(width, texture.desc.width);
+    const uint32_t copyHeight = std::min(height, texture.desc.height);
+
+    // Source rows are tightly packed at the given width; copy the overlapping region
+    const auto* src = static_cast<const uint8_t*>(data);
+    for (uint32_t y = 0; y < copyHeight; ++y) {
+        std::memcpy(texture.data.data() + y * texture.desc.width * bpp, src + y * width * bpp, static_cast<size_t>(copyWidth * bpp));
+    }
+
+    const uint64_t bytes = static_cast<uint64_t>(width) * height * bpp;
+    for (NullBackendStats* stats : {&frameStats_, &totalStats_}) {
+        stats->textureUpdates++;
+        stats->textureBytesUploaded += bytes;
+    }
+    recordResourceOp(NullResourceRecord::Op::UpdateTexture, handle, bytes);
+}
+
+// =============================================================================
+// Debug & Recording
+// =============================================================================
+
+void NullBackend::setDebugName(ResourceType type, uint64_t handle, const char* name) {
+    (void)type;
+    (void)handle;
+    (void)name;
+}
+
+void NullBackend::clearRecords() {
+    submits_.clear();
+    resourceOps_.clear();
+    totalStats_ = NullBackendStats{};
+    frameStats_ = NullBackendStats{};
+}
+
+const std::vector<uint8_t>* NullBackend::getBufferData(BufferHandle handle) const {
+    auto it = buffers_.find(handle);
+    return it != buffers_.end() ? &it->second : nullptr;
+}
+
+const std::vector<uint8_t>* NullBackend::getTextureData(TextureHandle handle) const {
+    auto it = textures_.find(handle);
+    return it != textures_.end() ? &it->second.data : nullptr;
+}
+
+void NullBackend::recordResourceOp(NullResourceRecord::Op op, uint64_t handle, uint64_t bytes) {
+    if (!recording_) {
+        return;
+    }
+
+    NullResourceRecord record;
+    record.op = op;
+    record.handle = handle;
+    record.bytes = bytes;
+    record.frameIndex = frameIndex_;
+    resourceOps_.push_back(record);
+}
+
+// =============================================================================
+// Factory Function
+// =============================================================================
+
+std::unique_ptr<IRenderBackend> createNullBackend() { return std::make_unique<NullBackend>(); }
+
+} // namespace dakt::gui
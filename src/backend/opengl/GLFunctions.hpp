@@ -0,0 +1,208 @@
+/**
+ * @file GLFunctions.hpp
+ * @brief Minimal OpenGL 4.5 core declarations and function table
+ *
+ * The library stays dependency-free, so instead of a loader library or the
+ * platform GL headers we declare only the types, enums and entry points the
+ * OpenGL backend uses. Function pointers are resolved at initialize() time
+ * through an application-supplied or platform loader.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Same spelling as the platform GL headers, so both may be included together
+typedef struct __GLsync* GLsync;
+
+#if defined(_WIN32)
+#define DAKT_GL_APIENTRY __stdcall
+#else
+#define DAKT_GL_APIENTRY
+#endif
+
+namespace dakt::gui::gl {
+
+// ============================================================================
+// Types
+// ============================================================================
+
+using GLenum = uint32_t;
+using GLboolean = uint8_t;
+using GLbitfield = uint32_t;
+using GLint = int32_t;
+using GLuint = uint32_t;
+using GLsizei = int32_t;
+using GLfloat = float;
+using GLchar = char;
+using GLubyte = uint8_t;
+using GLuint64 = uint64_t;
+using GLintptr = ptrdiff_t;
+using GLsizeiptr = ptrdiff_t;
+using GLsync = ::GLsync;
+
+// ============================================================================
+// Enums
+// ============================================================================
+
+constexpr GLboolean GL_FALSE_VALUE = 0;
+constexpr GLboolean GL_TRUE_VALUE = 1;
+
+constexpr GLenum TRIANGLES = 0x0004;
+constexpr GLenum UNSIGNED_BYTE = 0x1401;
+constexpr GLenum UNSIGNED_INT = 0x1405;
+constexpr GLenum FLOAT = 0x1406;
+constexpr GLenum HALF_FLOAT = 0x140B;
+constexpr GLenum UNSIGNED_INT_24_8 = 0x84FA;
+
+constexpr GLenum CULL_FACE = 0x0B44;
+constexpr GLenum DEPTH_TEST = 0x0B71;
+constexpr GLenum BLEND = 0x0BE2;
+constexpr GLenum SCISSOR_TEST = 0x0C11;
+constexpr GLenum ONE = 1;
+constexpr GLenum SRC_ALPHA = 0x0302;
+constexpr GLenum ONE_MINUS_SRC_ALPHA = 0x0303;
+constexpr GLenum FUNC_ADD = 0x8006;
+constexpr GLbitfield COLOR_BUFFER_BIT = 0x00004000;
+
+constexpr GLenum FRAGMENT_SHADER = 0x8B30;
+constexpr GLenum VERTEX_SHADER = 0x8B31;
+constexpr GLenum COMPILE_STATUS = 0x8B81;
+constexpr GLenum LINK_STATUS = 0x8B82;
+constexpr GLenum INFO_LOG_LENGTH = 0x8B84;
+
+constexpr GLbitfield MAP_WRITE_BIT = 0x0002;
+constexpr GLbitfield MAP_INVALIDATE_RANGE_BIT = 0x0004;
+constexpr GLbitfield MAP_PERSISTENT_BIT = 0x0040;
+constexpr GLbitfield MAP_COHERENT_BIT = 0x0080;
+constexpr GLbitfield DYNAMIC_STORAGE_BIT = 0x0100;
+constexpr GLenum UNIFORM_BUFFER = 0x8A11;
+constexpr GLenum SHADER_STORAGE_BUFFER = 0x90D2;
+
+constexpr GLenum TEXTURE_2D = 0x0DE1;
+constexpr GLenum TEXTURE_MAG_FILTER = 0x2800;
+constexpr GLenum TEXTURE_MIN_FILTER = 0x2801;
+constexpr GLenum TEXTURE_WRAP_S = 0x2802;
+constexpr GLenum TEXTURE_WRAP_T = 0x2803;
+constexpr GLenum LINEAR = 0x2601;
+constexpr GLenum CLAMP_TO_EDGE = 0x812F;
+constexpr GLenum TEXTURE_SWIZZLE_R = 0x8E42;
+constexpr GLenum TEXTURE_SWIZZLE_G = 0x8E43;
+constexpr GLenum TEXTURE_SWIZZLE_B = 0x8E44;
+constexpr GLenum TEXTURE_SWIZZLE_A = 0x8E45;
+constexpr GLenum UNPACK_ROW_LENGTH = 0x0CF2;
+constexpr GLenum UNPACK_ALIGNMENT = 0x0CF5;
+
+constexpr GLenum RED = 0x1903;
+constexpr GLenum RGBA = 0x1908;
+constexpr GLenum RG = 0x8227;
+constexpr GLenum BGRA = 0x80E1;
+constexpr GLenum DEPTH_COMPONENT = 0x1902;
+constexpr GLenum DEPTH_STENCIL = 0x84F9;
+constexpr GLenum R8 = 0x8229;
+constexpr GLenum RG8 = 0x822B;
+constexpr GLenum RGBA8 = 0x8058;
+constexpr GLenum R16F = 0x822D;
+constexpr GLenum R32F = 0x822E;
+constexpr GLenum RGBA16F = 0x881A;
+constexpr GLenum RGBA32F = 0x8814;
+constexpr GLenum DEPTH24_STENCIL8 = 0x88F0;
+constexpr GLenum DEPTH_COMPONENT32F = 0x8CAC;
+
+constexpr GLenum SYNC_GPU_COMMANDS_COMPLETE = 0x9117;
+constexpr GLbitfield SYNC_FLUSH_COMMANDS_BIT = 0x00000001;
+constexpr GLenum TIMEOUT_EXPIRED = 0x911B;
+constexpr GLenum WAIT_FAILED = 0x911D;
+
+constexpr GLenum RENDERER = 0x1F01;
+constexpr GLenum VERSION = 0x1F02;
+constexpr GLenum MAX_TEXTURE_SIZE = 0x0D33;
+constexpr GLenum MAX_VERTEX_ATTRIBS = 0x8869;
+constexpr GLenum MAX_UNIFORM_BLOCK_SIZE = 0x8A30;
+constexpr GLenum MAX_SAMPLES = 0x8D57;
+constexpr GLenum MAJOR_VERSION = 0x821B;
+constexpr GLenum MINOR_VERSION = 0x821C;
+
+constexpr GLenum TEXTURE = 0x1702;
+constexpr GLenum BUFFER = 0x82E0;
+constexpr GLenum FRAMEBUFFER = 0x8D40;
+
+// ============================================================================
+// Function Table
+// ============================================================================
+// X(return type, name without the "gl" prefix, parameter list...)
+
+#define DAKT_GL_FUNCTIONS(X)                                                                                                           \
+    X(void, GetIntegerv, GLenum pname, GLint* data)                                                                                    \
+    X(const GLubyte*, GetString, GLenum name)                                                                                          \
+    X(void, Enable, GLenum cap)                                                                                                        \
+    X(void, Disable, GLenum cap)                                                                                                       \
+    X(void, BlendEquation, GLenum mode)                                                                                                \
+    X(void, BlendFuncSeparate, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)                                         \
+    X(void, Viewport, GLint x, GLint y, GLsizei width, GLsizei height)                                                                  \
+    X(void, Scissor, GLint x, GLint y, GLsizei width, GLsizei height)                                                                  \
+    X(void, ClearColor, GLfloat r, GLfloat g, GLfloat b, GLfloat a)                                                                    \
+    X(void, Clear, GLbitfield mask)                                                                                                    \
+    X(void, Finish, void)                                                                                                              \
+    X(void, PixelStorei, GLenum pname, GLint param)                                                                                    \
+    X(void, BindFramebuffer, GLenum target, GLuint framebuffer)                                                                        \
+    X(GLuint, CreateShader, GLenum type)                                                                                               \
+    X(void, ShaderSource, GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)                              \
+    X(void, CompileShader, GLuint shader)                                                                                              \
+    X(void, GetShaderiv, GLuint shader, GLenum pname, GLint* params)                                                                   \
+    X(void, GetShaderInfoLog, GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)                                        \
+    X(void, DeleteShader, GLuint shader)                                                                                               \
+    X(GLuint, CreateProgram, void)                                                                                                     \
+    X(void, AttachShader, GLuint program, GLuint shader)                                                                               \
+    X(void, DetachShader, GLuint program, GLuint shader)                                                                               \
+    X(void, LinkProgram, GLuint program)                                                                                               \
+    X(void, GetProgramiv, GLuint program, GLenum pname, GLint* params)                                                                 \
+    X(void, GetProgramInfoLog, GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)                                      \
+    X(void, DeleteProgram, GLuint program)                                                                                             \
+    X(void, UseProgram, GLuint program)                                                                                                \
+    X(void, CreateBuffers, GLsizei n, GLuint* buffers)                                                                                 \
+    X(void, DeleteBuffers, GLsizei n, const GLuint* buffers)                                                                           \
+    X(void, NamedBufferStorage, GLuint buffer, GLsizeiptr size, const void* data, GLbitfield flags)                                     \
+    X(void, NamedBufferSubData, GLuint buffer, GLintptr offset, GLsizeiptr size, const void* data)                                     \
+    X(void*, MapNamedBufferRange, GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access)                                \
+    X(GLboolean, UnmapNamedBuffer, GLuint buffer)                                                                                      \
+    X(void, BindBufferBase, GLenum target, GLuint index, GLuint buffer)                                                                \
+    X(void, CreateVertexArrays, GLsizei n, GLuint* arrays)                                                                             \
+    X(void, DeleteVertexArrays, GLsizei n, const GLuint* arrays)                                                                       \
+    X(void, BindVertexArray, GLuint array)                                                                                             \
+    X(void, VertexArrayVertexBuffer, GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride)                \
+    X(void, VertexArrayElementBuffer, GLuint vaobj, GLuint buffer)                                                                     \
+    X(void, EnableVertexArrayAttrib, GLuint vaobj, GLuint index)                                                                       \
+    X(void, VertexArrayAttribFormat, GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint offset)   \
+    X(void, VertexArrayAttribIFormat, GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset)                \
+    X(void, VertexArrayAttribBinding, GLuint vaobj, GLuint attribindex, GLuint bindingindex)                                           \
+    X(void, CreateTextures, GLenum target, GLsizei n, GLuint* textures)                                                                \
+    X(void, DeleteTextures, GLsizei n, const GLuint* textures)                                                                         \
+    X(void, TextureStorage2D, GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height)                    \
+    X(void, TextureSubImage2D, GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, \
+      GLenum type, const void* pixels)                                                                                                 \
+    X(void, TextureParameteri, GLuint texture, GLenum pname, GLint param)                                                              \
+    X(void, BindTextureUnit, GLuint unit, GLuint texture)                                                                              \
+    X(void, ObjectLabel, GLenum identifier, GLuint name, GLsizei length, const GLchar* label)                                          \
+    X(GLsync, FenceSync, GLenum condition, GLbitfield flags)                                                                           \
+    X(GLenum, ClientWaitSync, GLsync sync, GLbitfield flags, GLuint64 timeout)                                                         \
+    X(void, DeleteSync, GLsync sync)                                                                                                   \
+    X(GLint, GetUniformLocation, GLuint program, const GLchar* name)                                                                   \
+    X(void, ProgramUniform1i, GLuint program, GLint location, GLint v0)                                                                \
+    X(void, ProgramUniform1f, GLuint program, GLint location, GLfloat v0)                                                              \
+    X(void, MultiDrawElementsBaseVertex, GLenum mode, const GLsizei* count, GLenum type, const void* const* indices, GLsizei drawcount, \
+      const GLint* basevertex)
+
+/**
+ * @brief Resolved OpenGL entry points (nullptr until loaded)
+ */
+struct Functions {
+#define DAKT_GL_DECLARE(ret, name, ...)                                                                                                \
+    using PFN_##name = ret(DAKT_GL_APIENTRY*)(__VA_ARGS__);                                                                            \
+    PFN_##name name = nullptr;
+    DAKT_GL_FUNCTIONS(DAKT_GL_DECLARE)
+#undef DAKT_GL_DECLARE
+};
+
+} // namespace dakt::gui::gl
@@ -1,6 +1,458 @@
-// OpenGL backend stubs
+#include "dakt/gui/backend/opengl/OpenGLBackend.hpp"
+
+// Only compile when OpenGL is enabled
+#if defined(DAKTLIB_ENABLE_OPENGL)
+
+#include "GLFunctions.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(DAKTLIB_PLATFORM_LINUX) || defined(__linux__)
+#include <dlfcn.h>
+#endif
+
 namespace dakt::gui {
-void OpenGL_Init() {}
-void OpenGL_Resources() {}
-void OpenGL_Render() {}
+
+// =============================================================================
+// Embedded GLSL
+// =============================================================================
+// GL flavour of shaders/sources: no push constants, explicit std140 bindings.
+
+static const char* UI_VERT_GLSL = R"(#version 450 core
+layout(location = 0) in vec2 inPosition;
+layout(location = 1) in vec2 inTexCoord;
+layout(location = 2) in vec4 inColor;
+layout(location = 3) in uint inClipIndex;
+
+layout(std140, binding = 0) uniform UniformBuffer {
+    mat4 projection;
+} ubo;
+
+layout(location = 0) out vec2 fragTexCoord;
+layout(location = 1) out vec4 fragColor;
+layout(location = 2) out vec2 fragPosition;
+layout(location = 3) flat out uint fragClipIndex;
+
+void main() {
+    gl_Position = ubo.projection * vec4(inPosition, 0.0, 1.0);
+    fragTexCoord = inTexCoord;
+    fragColor = inColor;
+    fragPosition = inPosition;
+    fragClipIndex = inClipIndex;
+}
+)";
+
+// Per-vertex clip regions (ClipMode::Shader); scissor-mode lists only use entry 0.
+// Coverage fades over one pixel so fractional clip edges stay smooth.
+#define DAKT_GLSL_CLIP_TABLE                                                                                                           \
+    "layout(location = 2) in vec2 fragPosition;\n"                                                                                    \
+    "layout(location = 3) flat in uint fragClipIndex;\n"                                                                              \
+    "layout(std430, binding = 1) readonly buffer ClipTable { vec4 clipRects[]; };\n"                                                   \
+    "float clipCoverage() {\n"                                                                                                        \
+    "    vec4 r = clipRects[fragClipIndex];\n"                                                                                        \
+    "    vec2 d = min(fragPosition - r.xy, r.zw - fragPosition);\n"                                                                   \
+    "    return clamp(min(d.x, d.y) + 0.5, 0.0, 1.0);\n"                                                                              \
+    "}\n"
+
+static const char* UI_FRAG_GLSL = "#version 450 core\n"
+                                  "layout(location = 0) in vec2 fragTexCoord;\n"
+                                  "layout(location = 1) in vec4 fragColor;\n" DAKT_GLSL_CLIP_TABLE R"(
+layout(binding = 0) uniform sampler2D texSampler;
+
+layout(location = 0) out vec4 outColor;
+
+void main() {
+    float coverage = clipCoverage();
+    if (coverage <= 0.0) {
+        discard;
+    }
+    vec4 color = fragColor * texture(texSampler, fragTexCoord);
+    outColor = vec4(color.rgb, color.a * coverage);
+}
+)";
+
+static const char* TEXT_FRAG_GLSL = "#version 450 core\n"
+                                    "layout(location = 0) in vec2 fragTexCoord;\n"
+                                    "layout(location = 1) in vec4 fragColor;\n" DAKT_GLSL_CLIP_TABLE R"(
+layout(binding = 0) uniform sampler2D sdfTexture;
+uniform float screenPxRange;
+uniform int renderMode; // GlyphRenderMode: 0 = SDF, 1 = MSDF
+
+layout(location = 0) out vec4 outColor;
+
+float median(float r, float g, float b) {
+    return max(min(r, g), min(max(r, g), b));
+}
+
+void main() {
+    vec4 texel = texture(sdfTexture, fragTexCoord);
+    float sd = renderMode == 1 ? median(texel.r, texel.g, texel.b) : texel.r;
+    float screenPxDist = (sd - 0.5) * max(screenPxRange, 1.0);
+    float opacity = clamp(screenPxDist + 0.5, 0.0, 1.0) * clipCoverage();
+    if (opacity < 0.001) {
+        discard;
+    }
+    outColor = vec4(fragColor.rgb, fragColor.a * opacity);
+}
+)";
+
+#undef DAKT_GLSL_CLIP_TABLE
+
+// =============================================================================
+// OpenGLBackend Implementation
+// =============================================================================
+
+OpenGLBackend::OpenGLBackend(GLProcLoader loader) : gl_(std::make_unique<gl::Functions>()), loader_(loader) {}
+
+OpenGLBackend::~OpenGLBackend() {
+    if (initialized_) {
+        shutdown();
+    }
+
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+    if (libraryHandle_) {
+        FreeLibrary(static_cast<HMODULE>(libraryHandle_));
+    }
+#elif defined(DAKTLIB_PLATFORM_LINUX) || defined(__linux__)
+    if (libraryHandle_) {
+        dlclose(libraryHandle_);
+    }
+#endif
+}
+
+bool OpenGLBackend::initialize(void* windowHandle, uint32_t width, uint32_t height) {
+    // The application owns the window and has made its context current
+    (void)windowHandle;
+    windowWidth_ = width;
+    windowHeight_ = height;
+
+    if (!loadFunctions()) {
+        return false;
+    }
+
+    // Initial segments hold 64K vertices / 128K indices per frame and grow on demand
+    if (!queryCapabilities() || !createPrograms() || !createVertexArray() || !createRingBuffers(65536 * sizeof(Vertex), 131072 * sizeof(uint32_t)) ||
+        !createDefaultResources()) {
+        destroyResources();
+        return false;
+    }
+
+    initialized_ = true;
+    return true;
+}
+
+void OpenGLBackend::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    destroyResources();
+}
+
+void OpenGLBackend::destroyResources() {
+    const gl::Functions& gl = *gl_;
+    gl.Finish();
+
+    destroyRingBuffers();
+
+    for (auto& [handle, buffer] : buffers_) {
+        gl.DeleteBuffers(1, &buffer.buffer);
+    }
+    buffers_.clear();
+
+    for (auto& [handle, texture] : textures_) {
+        gl.DeleteTextures(1, &texture.texture);
+    }
+    textures_.clear();
+    whiteTexture_ = InvalidTexture;
+
+    if (uniformBuffer_) {
+        gl.DeleteBuffers(1, &uniformBuffer_);
+        uniformBuffer_ = 0;
+    }
+
+    if (clipBuffer_) {
+        gl.DeleteBuffers(1, &clipBuffer_);
+        clipBuffer_ = 0;
+        clipBufferCapacity_ = 0;
+    }
+
+    if (vertexArray_) {
+        gl.DeleteVertexArrays(1, &vertexArray_);
+        vertexArray_ = 0;
+    }
+
+    if (uiProgram_) {
+        gl.DeleteProgram(uiProgram_);
+        uiProgram_ = 0;
+    }
+
+    if (textProgram_) {
+        gl.DeleteProgram(textProgram_);
+        textProgram_ = 0;
+    }
+
+    frameInProgress_ = false;
+    initialized_ = false;
+}
+
+// =============================================================================
+// Function Loading
+// =============================================================================
+
+bool OpenGLBackend::loadFunctions() {
+    using RawProc = void* (*)(const char*);
+    RawProc platformGetProc = nullptr;
+
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+    if (!loader_ && !libraryHandle_) {
+        libraryHandle_ = LoadLibraryA("opengl32.dll");
+    }
+#elif defined(DAKTLIB_PLATFORM_LINUX) || defined(__linux__)
+    if (!loader_ && !libraryHandle_) {
+        libraryHandle_ = dlopen("libGL.so.1", RTLD_NOW | RTLD_LOCAL);
+    }
+    if (libraryHandle_) {
+        platformGetProc = reinterpret_cast<RawProc>(dlsym(libraryHandle_, "glXGetProcAddressARB"));
+    }
+#endif
+
+    if (!loader_ && !libraryHandle_) {
+        return false; // No loader and no platform GL library (e.g. macOS, which stops at GL 4.1)
+    }
+
+    auto resolve = [&](const char* name) -> void* {
+        if (loader_) {
+            return loader_(name);
+        }
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+        // wglGetProcAddress only returns post-1.1 entry points and needs a current context
+        auto* wglGetProc = reinterpret_cast<PROC(WINAPI*)(LPCSTR)>(GetProcAddress(static_cast<HMODULE>(libraryHandle_), "wglGetProcAddress"));
+        PROC proc = wglGetProc ? wglGetProc(name) : nullptr;
+        const auto value = reinterpret_cast<intptr_t>(proc);
+        if (value == 0 || value == 1 || value == 2 || value == 3 || value == -1) {
+            proc = GetProcAddress(static_cast<HMODULE>(libraryHandle_), name);
+        }
+        return reinterpret_cast<void*>(proc);
+#elif defined(DAKTLIB_PLATFORM_LINUX) || defined(__linux__)
+        void* proc = platformGetProc ? platformGetProc(name) : nullptr;
+        return proc ? proc : dlsym(libraryHandle_, name);
+#else
+        (void)platformGetProc;
+        return nullptr;
+#endif
+    };
+
+    bool complete = true;
+    gl::Functions& gl = *gl_;
+#define DAKT_GL_LOAD(ret, name, ...)                                                                                                   \
+    gl.name = reinterpret_cast<gl::Functions::PFN_##name>(resolve("gl" #name));                                                        \
+    complete = complete && gl.name != nullptr;
+    DAKT_GL_FUNCTIONS(DAKT_GL_LOAD)
+#undef DAKT_GL_LOAD
+
+    return complete;
+}
+
+bool OpenGLBackend::queryCapabilities() {
+    const gl::Functions& gl = *gl_;
+
+    gl::GLint major = 0;
+    gl::GLint minor = 0;
+    gl.GetIntegerv(gl::MAJOR_VERSION, &major);
+    gl.GetIntegerv(gl::MINOR_VERSION, &minor);
+    if (major < 4 || (major == 4 && minor < 5)) {
+        return false; // DSA and buffer storage need a 4.5 core context
+    }
+
+    gl::GLint maxTextureSize = 0;
+    gl::GLint maxUniformBlockSize = 0;
+    gl::GLint maxVertexAttribs = 0;
+    gl::GLint maxSamples = 0;
+    gl.GetIntegerv(gl::MAX_TEXTURE_SIZE, &maxTextureSize);
+    gl.GetIntegerv(gl::MAX_UNIFORM_BLOCK_SIZE, &maxUniformBlockSize);
+    gl.GetIntegerv(gl::MAX_VERTEX_ATTRIBS, &maxVertexAttribs);
+    gl.GetIntegerv(gl::MAX_SAMPLES, &maxSamples);
+
+    capabilities_.maxTextureSize = static_cast<uint32_t>(maxTextureSize);
+    capabilities_.maxUniformBufferSize = static_cast<uint32_t>(maxUniformBlockSize);
+    capabilities_.maxVertexAttributes = static_cast<uint32_t>(maxVertexAttribs);
+    capabilities_.supportsCompute = true; // Core since 4.3
+    capabilities_.supportsGeometryShaders = true;
+    capabilities_.supportsTessellation = true;
+    capabilities_.supportsMSAA = maxSamples > 1;
+    capabilities_.maxMSAASamples = static_cast<uint32_t>(maxSamples);
+    capabilities_.supportsShaderClipping = true; // Storage buffers are core since 4.3
+
+    const auto* renderer = reinterpret_cast<const char*>(gl.GetString(gl::RENDERER));
+    const auto* version = reinterpret_cast<const char*>(gl.GetString(gl::VERSION));
+    capabilities_.deviceName = renderer ? renderer : "";
+    capabilities_.apiVersion = version ? version : (std::to_string(major) + "." + std::to_string(minor));
+    return true;
+}
+
+// =============================================================================
+// Programs
+// =============================================================================
+
+uint32_t OpenGLBackend::compileShader(uint32_t type, const char* source) {
+    const gl::Functions& gl = *gl_;
+
+    gl::GLuint shader = gl.CreateShader(type);
+    gl.ShaderSource(shader, 1, &source, nullptr);
+    gl.CompileShader(shader);
+
+    gl::GLint status = 0;
+    gl.GetShaderiv(shader, gl::COMPILE_STATUS, &status);
+    if (!status) {
+        gl::GLint logLength = 0;
+        gl.GetShaderiv(shader, gl::INFO_LOG_LENGTH, &logLength);
+        std::string log(static_cast<size_t>(logLength > 0 ? logLength : 1), '\0');
+        gl.GetShaderInfoLog(shader, static_cast<gl::GLsizei>(log.size()), nullptr, log.data());
+        std::fprintf(stderr, "[DaktLib-GUI] OpenGL shader compile failed: %s\n", log.c_str());
+        gl.DeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+uint32_t OpenGLBackend::linkProgram(const char* vertexSource, const char* fragmentSource) {
+    const gl::Functions& gl = *gl_;
+
+    gl::GLuint vertexShader = compileShader(gl::VERTEX_SHADER, vertexSource);
+    gl::GLuint fragmentShader = compileShader(gl::FRAGMENT_SHADER, fragmentSource);
+    if (!vertexShader || !fragmentShader) {
+        if (vertexShader) {
+            gl.DeleteShader(vertexShader);
+        }
+        if (fragmentShader) {
+            gl.DeleteShader(fragmentShader);
+        }
+        return 0;
+    }
+
+    gl::GLuint program = gl.CreateProgram();
+    gl.AttachShader(program, vertexShader);
+    gl.AttachShader(program, fragmentShader);
+    gl.LinkProgram(program);
+    gl.DetachShader(program, vertexShader);
+    gl.DetachShader(program, fragmentShader);
+    gl.DeleteShader(vertexShader);
+    gl.DeleteShader(fragmentShader);
+
+    gl::GLint status = 0;
+    gl.GetProgramiv(program, gl::LINK_STATUS, &status);
+    if (!status) {
+        gl::GLint logLength = 0;
+        gl.GetProgramiv(program, gl::INFO_LOG_LENGTH, &logLength);
+        std::string log(static_cast<size_t>(logLength > 0 ? logLength : 1), '\0');
+        gl.GetProgramInfoLog(program, static_cast<gl::GLsizei>(log.size()), nullptr, log.data());
+        std::fprintf(stderr, "[DaktLib-GUI] OpenGL program link failed: %s\n", log.c_str());
+        gl.DeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+bool OpenGLBackend::createPrograms() {
+    uiProgram_ = linkProgram(UI_VERT_GLSL, UI_FRAG_GLSL);
+    textProgram_ = linkProgram(UI_VERT_GLSL, TEXT_FRAG_GLSL);
+    if (!uiProgram_ || !textProgram_) {
+        return false;
+    }
+
+    textPxRangeLocation_ = gl_->GetUniformLocation(textProgram_, "screenPxRange");
+    textModeLocation_ = gl_->GetUniformLocation(textProgram_, "renderMode");
+    return true;
+}
+
+// =============================================================================
+// Vertex Array
+// =============================================================================
+
+bool OpenGLBackend::createVertexArray() {
+    const gl::Functions& gl = *gl_;
+
+    gl.CreateVertexArrays(1, &vertexArray_);
+    if (!vertexArray_) {
+        return false;
+    }
+
+    // Vertex layout: position (vec2), uv (vec2), color (RGBA8, normalized)
+    gl.EnableVertexArrayAttrib(vertexArray_, 0);
+    gl.VertexArrayAttribFormat(vertexArray_, 0, 2, gl::FLOAT, gl::GL_FALSE_VALUE, static_cast<gl::GLuint>(offsetof(Vertex, position)));
+    gl.VertexArrayAttribBinding(vertexArray_, 0, 0);
+
+    gl.EnableVertexArrayAttrib(vertexArray_, 1);
+    gl.VertexArrayAttribFormat(vertexArray_, 1, 2, gl::FLOAT, gl::GL_FALSE_VALUE, static_cast<gl::GLuint>(offsetof(Vertex, uv)));
+    gl.VertexArrayAttribBinding(vertexArray_, 1, 0);
+
+    gl.EnableVertexArrayAttrib(vertexArray_, 2);
+    gl.VertexArrayAttribFormat(vertexArray_, 2, 4, gl::UNSIGNED_BYTE, gl::GL_TRUE_VALUE, static_cast<gl::GLuint>(offsetof(Vertex, color)));
+    gl.VertexArrayAttribBinding(vertexArray_, 2, 0);
+
+    gl.EnableVertexArrayAttrib(vertexArray_, 3);
+    gl.VertexArrayAttribIFormat(vertexArray_, 3, 1, gl::UNSIGNED_INT, static_cast<gl::GLuint>(offsetof(Vertex, clipIndex)));
+    gl.VertexArrayAttribBinding(vertexArray_, 3, 0);
+
+    // Projection matrix
+    gl.CreateBuffers(1, &uniformBuffer_);
+    gl.NamedBufferStorage(uniformBuffer_, sizeof(float) * 16, nullptr, gl::DYNAMIC_STORAGE_BIT);
+    return uniformBuffer_ != 0;
+}
+
+// =============================================================================
+// Default Resources
+// =============================================================================
+
+bool OpenGLBackend::createDefaultResources() {
+    // Create a 1x1 white texture as default
+    uint32_t whitePixel = 0xFFFFFFFF;
+    TextureDesc desc{};
+    desc.width = 1;
+    desc.height = 1;
+    desc.format = TextureFormat::RGBA8;
+    desc.usage = TextureUsage::Sampled;
+    desc.initialData = &whitePixel;
+
+    whiteTexture_ = createTexture(desc);
+    return whiteTexture_ != InvalidTexture;
+}
+
+// =============================================================================
+// Resize
+// =============================================================================
+
+void OpenGLBackend::resize(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return;
+    }
+
+    // The default framebuffer is resized by the windowing system
+    windowWidth_ = width;
+    windowHeight_ = height;
+}
+
+// =============================================================================
+// Factory Functions
+// =============================================================================
+
+std::unique_ptr<IRenderBackend> createOpenGLBackend() { return std::make_unique<OpenGLBackend>(); }
+
+std::unique_ptr<IRenderBackend> createOpenGLBackend(GLProcLoader loader) { return std::make_unique<OpenGLBackend>(loader); }
+
 } // namespace dakt::gui
+
+#endif // DAKTLIB_ENABLE_OPENGL
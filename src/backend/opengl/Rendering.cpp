@@ -1,3 +1,218 @@
+#include "dakt/gui/backend/opengl/OpenGLBackend.hpp"
+
+#if defined(DAKTLIB_ENABLE_OPENGL)
+
+#include "GLFunctions.hpp"
+
+#include <algorithm>
+#include <cstring>
+
 namespace dakt::gui {
-void OpenGL_Render2() {}
+
+// =============================================================================
+// Fence Synchronization
+// =============================================================================
+
+void OpenGLBackend::waitForSegment(uint32_t segment) {
+    GLsync& fence = segmentFences_[segment];
+    if (!fence) {
+        return;
+    }
+
+    // Normally already signalled: the segment was last used FRAME_SEGMENTS frames ago
+    const gl::Functions& gl = *gl_;
+    constexpr gl::GLuint64 ONE_SECOND_NS = 1000000000ULL;
+    while (gl.ClientWaitSync(fence, gl::SYNC_FLUSH_COMMANDS_BIT, ONE_SECOND_NS) == gl::TIMEOUT_EXPIRED) {
+    }
+
+    gl.DeleteSync(fence);
+    fence = nullptr;
+}
+
+// =============================================================================
+// Frame Management
+// =============================================================================
+
+bool OpenGLBackend::beginFrame() {
+    if (!initialized_) {
+        return false;
+    }
+
+    const gl::Functions& gl = *gl_;
+
+    // Reclaim this frame's ring segment
+    waitForSegment(currentSegment_);
+    vertexRing_.writeOffset = currentSegment_ * vertexRing_.segmentSize;
+    indexRing_.writeOffset = currentSegment_ * indexRing_.segmentSize;
+
+    const auto width = static_cast<gl::GLsizei>(windowWidth_);
+    const auto height = static_cast<gl::GLsizei>(windowHeight_);
+
+    gl.BindFramebuffer(gl::FRAMEBUFFER, 0);
+    gl.Viewport(0, 0, width, height);
+    gl.Disable(gl::SCISSOR_TEST);
+    gl.ClearColor(clearColor_.r / 255.0f, clearColor_.g / 255.0f, clearColor_.b / 255.0f, clearColor_.a / 255.0f);
+    gl.Clear(gl::COLOR_BUFFER_BIT);
+
+    // UI render state: alpha blending, no depth, no culling, scissored
+    gl.Enable(gl::BLEND);
+    gl.BlendEquation(gl::FUNC_ADD);
+    gl.BlendFuncSeparate(gl::SRC_ALPHA, gl::ONE_MINUS_SRC_ALPHA, gl::ONE, gl::ONE_MINUS_SRC_ALPHA);
+    gl.Disable(gl::CULL_FACE);
+    gl.Disable(gl::DEPTH_TEST);
+    gl.Enable(gl::SCISSOR_TEST);
+
+    // Orthographic projection matrix (column-major), top-left origin
+    const float L = 0.0f;
+    const float R = static_cast<float>(windowWidth_);
+    const float T = 0.0f;
+    const float B = static_cast<float>(windowHeight_);
+    const float projection[16] = {
+        2.0f / (R - L),    0.0f,              0.0f,  0.0f, //
+        0.0f,              2.0f / (T - B),    0.0f,  0.0f, //
+        0.0f,              0.0f,              -1.0f, 0.0f, //
+        (R + L) / (L - R), (T + B) / (B - T), 0.0f,  1.0f, //
+    };
+    gl.NamedBufferSubData(uniformBuffer_, 0, sizeof(projection), projection);
+    gl.BindBufferBase(gl::UNIFORM_BUFFER, 0, uniformBuffer_);
+
+    if (textPxRangeLocation_ >= 0) {
+        gl.ProgramUniform1f(textProgram_, textPxRangeLocation_, sdfPixelRange_);
+    }
+
+    gl.BindVertexArray(vertexArray_);
+
+    stateBound_ = false;
+    frameInProgress_ = true;
+    return true;
+}
+
+void OpenGLBackend::endFrame() {
+    if (!frameInProgress_) {
+        return;
+    }
+
+    const gl::Functions& gl = *gl_;
+
+    // Guard this frame's ring segment until the GPU has consumed it
+    segmentFences_[currentSegment_] = gl.FenceSync(gl::SYNC_GPU_COMMANDS_COMPLETE, 0);
+    currentSegment_ = (currentSegment_ + 1) % FRAME_SEGMENTS;
+
+    // Leave the context tidy for application rendering
+    gl.BindVertexArray(0);
+    gl.UseProgram(0);
+    gl.Disable(gl::SCISSOR_TEST);
+
+    frameInProgress_ = false;
+}
+
+void OpenGLBackend::present() {
+    // Buffer swapping belongs to the application's windowing layer
+}
+
+// =============================================================================
+// Draw Submission
+// =============================================================================
+
+void OpenGLBackend::submit(const DrawList& drawList) {
+    lastDrawCalls_ = 0;
+    if (!frameInProgress_) {
+        return;
+    }
+
+    const auto& vertices = drawList.getVertices();
+    const auto& indices = drawList.getIndices();
+    if (vertices.empty() || indices.empty()) {
+        return;
+    }
+
+    const uint64_t vertexBytes = vertices.size() * sizeof(Vertex);
+    const uint64_t indexBytes = indices.size() * sizeof(uint32_t);
+    if (!ensureRingCapacity(vertexBytes, indexBytes)) {
+        return;
+    }
+
+    // Stream geometry straight into the persistently mapped, coherent rings
+    std::memcpy(vertexRing_.mappedPtr + vertexRing_.writeOffset, vertices.data(), static_cast<size_t>(vertexBytes));
+    std::memcpy(indexRing_.mappedPtr + indexRing_.writeOffset, indices.data(), static_cast<size_t>(indexBytes));
+
+    // DrawList indices are absolute within the list, so one base vertex serves every command
+    const auto baseVertex = static_cast<int32_t>(vertexRing_.writeOffset / sizeof(Vertex));
+    const uint64_t indexBase = indexRing_.writeOffset;
+
+    vertexRing_.writeOffset += vertexBytes;
+    indexRing_.writeOffset += indexBytes;
+
+    uploadClipTable(drawList.getClipTable());
+
+    batcher_.reset();
+    batcher_.batchCommands(drawList);
+
+    // Consecutive batches sharing a render state become one glMultiDrawElementsBaseVertex
+    for (const auto& batch : batcher_.getBatchedCommands()) {
+        if (batch.indexCount == 0) {
+            continue;
+        }
+
+        if (!stateBound_ || batch.state != boundState_) {
+            flushMultiDraw();
+            applyState(batch.state);
+        }
+
+        drawCounts_.push_back(static_cast<int32_t>(batch.indexCount));
+        drawOffsets_.push_back(reinterpret_cast<const void*>(static_cast<uintptr_t>(indexBase + batch.indexOffset * sizeof(uint32_t))));
+        drawBaseVertices_.push_back(baseVertex);
+    }
+
+    flushMultiDraw();
+}
+
+void OpenGLBackend::applyState(const RenderState& state) {
+    const gl::Functions& gl = *gl_;
+
+    // Scissor (GL window coordinates have a bottom-left origin)
+    const Rect& clip = state.clipRect;
+    if (clip.width > 0 && clip.height > 0) {
+        const float bottom = static_cast<float>(windowHeight_) - clip.bottom();
+        gl.Scissor(static_cast<gl::GLint>(std::max(clip.x, 0.0f)), static_cast<gl::GLint>(std::max(bottom, 0.0f)), static_cast<gl::GLsizei>(clip.width),
+                   static_cast<gl::GLsizei>(clip.height));
+    } else {
+        gl.Scissor(0, 0, static_cast<gl::GLsizei>(windowWidth_), static_cast<gl::GLsizei>(windowHeight_));
+    }
+
+    // R8 textures are SDF glyph pages and msdf textures MSDF pages, both drawn by the
+    // text program; everything else (A8 coverage glyphs included) samples as color
+    auto it = textures_.find(state.textureID != 0 ? state.textureID : whiteTexture_);
+    if (it == textures_.end()) {
+        it = textures_.find(whiteTexture_);
+    }
+    const bool msdf = it != textures_.end() && it->second.msdf;
+    const bool distanceField = msdf || (it != textures_.end() && it->second.format == TextureFormat::R8);
+
+    gl.UseProgram(distanceField ? textProgram_ : uiProgram_);
+    if (distanceField && textModeLocation_ >= 0) {
+        gl.ProgramUniform1i(textProgram_, textModeLocation_, msdf ? 1 : 0);
+    }
+    gl.BindTextureUnit(0, it != textures_.end() ? it->second.texture : 0);
+
+    boundState_ = state;
+    stateBound_ = true;
+}
+
+void OpenGLBackend::flushMultiDraw() {
+    if (drawCounts_.empty()) {
+        return;
+    }
+
+    gl_->MultiDrawElementsBaseVertex(gl::TRIANGLES, drawCounts_.data(), gl::UNSIGNED_INT, drawOffsets_.data(), static_cast<gl::GLsizei>(drawCounts_.size()),
+                                     drawBaseVertices_.data());
+    lastDrawCalls_++;
+
+    drawCounts_.clear();
+    drawOffsets_.clear();
+    drawBaseVertices_.clear();
+}
+
 } // namespace dakt::gui
+
+#endif // DAKTLIB_ENABLE_OPENGL
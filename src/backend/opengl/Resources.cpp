@@ -1,3 +1,346 @@
+/**
+ * @file Resources.cpp
+ * @brief OpenGL resource management (buffers, textures, streaming rings)
+ */
+
+#include "dakt/gui/backend/opengl/OpenGLBackend.hpp"
+
+#if defined(DAKTLIB_ENABLE_OPENGL)
+
+#include "GLFunctions.hpp"
+
+#include <algorithm>
+#include <cstring>
+
 namespace dakt::gui {
-void OpenGL_Resources2() {}
+
+// ============================================================================
+// Format Mapping
+// ============================================================================
+
+struct GLFormatInfo {
+    gl::GLenum internalFormat;
+    gl::GLenum format;
+    gl::GLenum type;
+};
+
+static GLFormatInfo toGLFormat(TextureFormat format) {
+    switch (format) {
+    case TextureFormat::R8:
+    case TextureFormat::A8:
+        return {gl::R8, gl::RED, gl::UNSIGNED_BYTE};
+    case TextureFormat::RG8:
+        return {gl::RG8, gl::RG, gl::UNSIGNED_BYTE};
+    case TextureFormat::RGBA8:
+        return {gl::RGBA8, gl::RGBA, gl::UNSIGNED_BYTE};
+    case TextureFormat::BGRA8:
+        return {gl::RGBA8, gl::BGRA, gl::UNSIGNED_BYTE};
+    case TextureFormat::R16F:
+        return {gl::R16F, gl::RED, gl::HALF_FLOAT};
+    case TextureFormat::RGBA16F:
+        return {gl::RGBA16F, gl::RGBA, gl::HALF_FLOAT};
+    case TextureFormat::R32F:
+        return {gl::R32F, gl::RED, gl::FLOAT};
+    case TextureFormat::RGBA32F:
+        return {gl::RGBA32F, gl::RGBA, gl::FLOAT};
+    case TextureFormat::Depth24Stencil8:
+        return {gl::DEPTH24_STENCIL8, gl::DEPTH_STENCIL, gl::UNSIGNED_INT_24_8};
+    case TextureFormat::Depth32F:
+        return {gl::DEPTH_COMPONENT32F, gl::DEPTH_COMPONENT, gl::FLOAT};
+    }
+    return {gl::RGBA8, gl::RGBA, gl::UNSIGNED_BYTE};
+}
+
+// ============================================================================
+// Buffer Management
+// ============================================================================
+
+BufferHandle OpenGLBackend::createBuffer(const BufferDesc& desc) {
+    const gl::Functions& gl = *gl_;
+
+    OpenGLBuffer glBuffer{};
+    glBuffer.size = desc.size;
+    glBuffer.usage = desc.usage;
+
+    gl.CreateBuffers(1, &glBuffer.buffer);
+    if (!glBuffer.buffer) {
+        return InvalidBuffer;
+    }
+
+    // Host-visible buffers stay persistently mapped; everything else is updated
+    // with glNamedBufferSubData or a transient write mapping
+    gl::GLbitfield flags = gl::DYNAMIC_STORAGE_BIT | gl::MAP_WRITE_BIT;
+    if (desc.hostVisible) {
+        flags |= gl::MAP_PERSISTENT_BIT | gl::MAP_COHERENT_BIT;
+    }
+    gl.NamedBufferStorage(glBuffer.buffer, static_cast<gl::GLsizeiptr>(desc.size), desc.initialData, flags);
+
+    if (desc.hostVisible) {
+        glBuffer.persistentPtr =
+            gl.MapNamedBufferRange(glBuffer.buffer, 0, static_cast<gl::GLsizeiptr>(desc.size), gl::MAP_WRITE_BIT | gl::MAP_PERSISTENT_BIT | gl::MAP_COHERENT_BIT);
+    }
+
+    BufferHandle handle = nextBufferHandle_++;
+    buffers_[handle] = glBuffer;
+    return handle;
+}
+
+void OpenGLBackend::destroyBuffer(BufferHandle handle) {
+    auto it = buffers_.find(handle);
+    if (it == buffers_.end()) {
+        return;
+    }
+
+    // Deleting a buffer implicitly unmaps it
+    gl_->DeleteBuffers(1, &it->second.buffer);
+    buffers_.erase(it);
+}
+
+void* OpenGLBackend::mapBuffer(BufferHandle handle) {
+    auto it = buffers_.find(handle);
+    if (it == buffers_.end()) {
+        return nullptr;
+    }
+
+    OpenGLBuffer& glBuffer = it->second;
+    if (glBuffer.persistentPtr) {
+        return glBuffer.persistentPtr;
+    }
+
+    return gl_->MapNamedBufferRange(glBuffer.buffer, 0, static_cast<gl::GLsizeiptr>(glBuffer.size), gl::MAP_WRITE_BIT | gl::MAP_INVALIDATE_RANGE_BIT);
+}
+
+void OpenGLBackend::unmapBuffer(BufferHandle handle) {
+    auto it = buffers_.find(handle);
+    if (it == buffers_.end() || it->second.persistentPtr) {
+        return; // Persistent mappings live until the buffer is destroyed
+    }
+
+    gl_->UnmapNamedBuffer(it->second.buffer);
+}
+
+void OpenGLBackend::updateBuffer(BufferHandle handle, const void* data, uint64_t size, uint64_t offset) {
+    auto it = buffers_.find(handle);
+    if (it == buffers_.end() || !data || offset + size > it->second.size) {
+        return;
+    }
+
+    OpenGLBuffer& glBuffer = it->second;
+    if (glBuffer.persistentPtr) {
+        std::memcpy(static_cast<uint8_t*>(glBuffer.persistentPtr) + offset, data, static_cast<size_t>(size));
+        return;
+    }
+
+    gl_->NamedBufferSubData(glBuffer.buffer, static_cast<gl::GLintptr>(offset), static_cast<gl::GLsizeiptr>(size), data);
+}
+
+// ============================================================================
+// Texture Management
+// ============================================================================
+
+TextureHandle OpenGLBackend::createTexture(const TextureDesc& desc) {
+    const gl::Functions& gl = *gl_;
+    const GLFormatInfo info = toGLFormat(desc.format);
+
+    OpenGLTexture glTexture{};
+    glTexture.width = desc.width;
+    glTexture.height = desc.height;
+    glTexture.format = desc.format;
+    glTexture.msdf = desc.msdf && desc.format == TextureFormat::RGBA8;
+
+    // Immutable storage: the size and format are fixed, contents change via sub-image uploads
+    gl.CreateTextures(gl::TEXTURE_2D, 1, &glTexture.texture);
+    if (!glTexture.texture) {
+        return InvalidTexture;
+    }
+
+    gl.TextureStorage2D(glTexture.texture, static_cast<gl::GLsizei>(std::max(desc.mipLevels, 1u)), info.internalFormat, static_cast<gl::GLsizei>(desc.width),
+                        static_cast<gl::GLsizei>(desc.height));
+    gl.TextureParameteri(glTexture.texture, gl::TEXTURE_MIN_FILTER, static_cast<gl::GLint>(gl::LINEAR));
+    gl.TextureParameteri(glTexture.texture, gl::TEXTURE_MAG_FILTER, static_cast<gl::GLint>(gl::LINEAR));
+    gl.TextureParameteri(glTexture.texture, gl::TEXTURE_WRAP_S, static_cast<gl::GLint>(gl::CLAMP_TO_EDGE));
+    gl.TextureParameteri(glTexture.texture, gl::TEXTURE_WRAP_T, static_cast<gl::GLint>(gl::CLAMP_TO_EDGE));
+    if (desc.format == TextureFormat::A8) {
+        gl.TextureParameteri(glTexture.texture, gl::TEXTURE_SWIZZLE_R, static_cast<gl::GLint>(gl::ONE));
+        gl.TextureParameteri(glTexture.texture, gl::TEXTURE_SWIZZLE_G, static_cast<gl::GLint>(gl::ONE));
+        gl.TextureParameteri(glTexture.texture, gl::TEXTURE_SWIZZLE_B, static_cast<gl::GLint>(gl::ONE));
+        gl.TextureParameteri(glTexture.texture, gl::TEXTURE_SWIZZLE_A, static_cast<gl::GLint>(gl::RED));
+    }
+
+    TextureHandle handle = nextTextureHandle_++;
+    textures_[handle] = glTexture;
+
+    if (desc.initialData) {
+        updateTexture(handle, desc.initialData, desc.width, desc.height);
+    }
+
+    return handle;
+}
+
+void OpenGLBackend::destroyTexture(TextureHandle handle) {
+    auto it = textures_.find(handle);
+    if (it == textures_.end()) {
+        return;
+    }
+
+    gl_->DeleteTextures(1, &it->second.texture);
+    textures_.erase(it);
+}
+
+void OpenGLBackend::updateTexture(TextureHandle handle, const void* data, uint32_t width, uint32_t height) {
+    auto it = textures_.find(handle);
+    if (it == textures_.end() || !data) {
+        return;
+    }
+
+    const gl::Functions& gl = *gl_;
+    const OpenGLTexture& glTexture = it->second;
+    const GLFormatInfo info = toGLFormat(glTexture.format);
+
+    // Source rows are tightly packed at `width`; R8/RG8 rows are not 4-byte aligned in general
+    gl.PixelStorei(gl::UNPACK_ALIGNMENT, 1);
+    gl.PixelStorei(gl::UNPACK_ROW_LENGTH, static_cast<gl::GLint>(width));
+    gl.TextureSubImage2D(glTexture.texture, 0, 0, 0, static_cast<gl::GLsizei>(std::min(width, glTexture.width)), static_cast<gl::GLsizei>(std::min(height, glTexture.height)),
+                         info.format, info.type, data);
+    gl.PixelStorei(gl::UNPACK_ROW_LENGTH, 0);
+    gl.PixelStorei(gl::UNPACK_ALIGNMENT, 4);
+}
+
+// ============================================================================
+// Streaming Ring Buffers
+// ============================================================================
+
+static bool createRing(const gl::Functions& gl, OpenGLRingBuffer& ring, uint64_t segmentSize, uint32_t segments) {
+    const gl::GLbitfield flags = gl::MAP_WRITE_BIT | gl::MAP_PERSISTENT_BIT | gl::MAP_COHERENT_BIT;
+    const auto totalSize = static_cast<gl::GLsizeiptr>(segmentSize * segments);
+
+    gl.CreateBuffers(1, &ring.buffer);
+    if (!ring.buffer) {
+        return false;
+    }
+
+    gl.NamedBufferStorage(ring.buffer, totalSize, nullptr, flags);
+    ring.mappedPtr = static_cast<uint8_t*>(gl.MapNamedBufferRange(ring.buffer, 0, totalSize, flags));
+    ring.segmentSize = segmentSize;
+    ring.writeOffset = 0;
+    return ring.mappedPtr != nullptr;
+}
+
+bool OpenGLBackend::createRingBuffers(uint64_t vertexSegmentSize, uint64_t indexSegmentSize) {
+    const gl::Functions& gl = *gl_;
+
+    if (!createRing(gl, vertexRing_, vertexSegmentSize, FRAME_SEGMENTS) || !createRing(gl, indexRing_, indexSegmentSize, FRAME_SEGMENTS)) {
+        return false;
+    }
+
+    gl.VertexArrayVertexBuffer(vertexArray_, 0, vertexRing_.buffer, 0, static_cast<gl::GLsizei>(sizeof(Vertex)));
+    gl.VertexArrayElementBuffer(vertexArray_, indexRing_.buffer);
+    return true;
+}
+
+void OpenGLBackend::destroyRingBuffers() {
+    const gl::Functions& gl = *gl_;
+
+    for (auto& fence : segmentFences_) {
+        if (fence) {
+            gl.DeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+
+    for (OpenGLRingBuffer* ring : {&vertexRing_, &indexRing_}) {
+        if (ring->buffer) {
+            gl.DeleteBuffers(1, &ring->buffer);
+        }
+        *ring = OpenGLRingBuffer{};
+    }
+}
+
+bool OpenGLBackend::ensureRingCapacity(uint64_t vertexBytes, uint64_t indexBytes) {
+    const uint64_t vertexSegmentStart = currentSegment_ * vertexRing_.segmentSize;
+    const uint64_t indexSegmentStart = currentSegment_ * indexRing_.segmentSize;
+    const uint64_t vertexUsed = vertexRing_.writeOffset - vertexSegmentStart;
+    const uint64_t indexUsed = indexRing_.writeOffset - indexSegmentStart;
+
+    if (vertexUsed + vertexBytes <= vertexRing_.segmentSize && indexUsed + indexBytes <= indexRing_.segmentSize) {
+        return true;
+    }
+
+    // Grow: drain the GPU, then reallocate every segment at the new size. Draws
+    // already issued this frame have completed, so the new segment starts empty.
+    uint64_t newVertexSize = vertexRing_.segmentSize;
+    uint64_t newIndexSize = indexRing_.segmentSize;
+    while (newVertexSize < vertexUsed + vertexBytes) {
+        newVertexSize *= 2;
+    }
+    while (newIndexSize < indexUsed + indexBytes) {
+        newIndexSize *= 2;
+    }
+
+    gl_->Finish();
+    destroyRingBuffers();
+    if (!createRingBuffers(newVertexSize, newIndexSize)) {
+        return false;
+    }
+
+    vertexRing_.writeOffset = currentSegment_ * vertexRing_.segmentSize;
+    indexRing_.writeOffset = currentSegment_ * indexRing_.segmentSize;
+    return true;
+}
+
+// ============================================================================
+// Clip Table
+// ============================================================================
+
+void OpenGLBackend::uploadClipTable(const std::vector<Rect>& clipTable) {
+    const gl::Functions& gl = *gl_;
+    const auto count = static_cast<uint32_t>(std::max<size_t>(clipTable.size(), 1));
+
+    if (count > clipBufferCapacity_) {
+        if (clipBuffer_) {
+            gl.DeleteBuffers(1, &clipBuffer_);
+        }
+        clipBufferCapacity_ = std::max(count, clipBufferCapacity_ * 2);
+        gl.CreateBuffers(1, &clipBuffer_);
+        gl.NamedBufferStorage(clipBuffer_, static_cast<gl::GLsizeiptr>(clipBufferCapacity_) * 4 * sizeof(float), nullptr, gl::DYNAMIC_STORAGE_BIT);
+    }
+
+    // Stored as min/max corners so the fragment shader needs no adds
+    clipScratch_.clear();
+    for (const Rect& rect : clipTable) {
+        clipScratch_.insert(clipScratch_.end(), {rect.x, rect.y, rect.right(), rect.bottom()});
+    }
+    if (clipScratch_.empty()) {
+        clipScratch_.insert(clipScratch_.end(), {0.0f, 0.0f, static_cast<float>(windowWidth_), static_cast<float>(windowHeight_)});
+    }
+
+    // Buffer updates are ordered after earlier draws, so one buffer serves every submit
+    gl.NamedBufferSubData(clipBuffer_, 0, static_cast<gl::GLsizeiptr>(clipScratch_.size() * sizeof(float)), clipScratch_.data());
+    gl.BindBufferBase(gl::SHADER_STORAGE_BUFFER, 1, clipBuffer_);
+}
+
+// ============================================================================
+// Debug Naming
+// ============================================================================
+
+void OpenGLBackend::setDebugName(ResourceType type, uint64_t handle, const char* name) {
+    if (!name) {
+        return;
+    }
+
+    if (type == ResourceType::Buffer) {
+        auto it = buffers_.find(handle);
+        if (it != buffers_.end()) {
+            gl_->ObjectLabel(gl::BUFFER, it->second.buffer, -1, name);
+        }
+    } else {
+        auto it = textures_.find(handle);
+        if (it != textures_.end()) {
+            gl_->ObjectLabel(gl::TEXTURE, it->second.texture, -1, name);
+        }
+    }
+}
+
 } // namespace dakt::gui
+
+#endif // DAKTLIB_ENABLE_OPENGL
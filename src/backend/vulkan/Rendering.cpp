@@ -53,6 +53,9 @@ bool VulkanBackend::beginFrame() {
         }
     }
 
+    // The fence guarantees this slot's previous frame finished, so its queries are ready
+    readbackTimestamps(frame);
+
     vkResetFences(device_, 1, &frame.inFlightFence);
     vkResetCommandBuffer(frame.commandBuffer, 0);
 
@@ -70,6 +73,16 @@ bool VulkanBackend::beginFrame() {
         return false;
     }
 
+    frame.frameIndex = frameCounter_++;
+    frame.timestampsWritten = 0;
+    frame.droppedDrawRanges = 0;
+    if (gpuTimingsEnabled_ && frame.timestampPool) {
+        // Query resets must be recorded outside a render pass
+        vkCmdResetQueryPool(frame.commandBuffer, frame.timestampPool, 0, MAX_TIMESTAMP_QUERIES);
+        writeTimestamp(frame, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0);
+        frame.timestampsWritten = 2; // Slot 1 is reserved for the render pass end
+    }
+
     // Begin render pass
     if (!framebuffers_.empty()) {
         VkRenderPassBeginInfo renderPassInfo{};
@@ -117,6 +130,10 @@ void VulkanBackend::endFrame() {
         vkCmdEndRenderPass(frame.commandBuffer);
     }
 
+    if (frame.timestampsWritten > 0) {
+        writeTimestamp(frame, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 1);
+    }
+
     // End command buffer recording
     if (vkEndCommandBuffer(frame.commandBuffer) != VK_SUCCESS) {
         frameInProgress_ = false;
@@ -194,25 +211,43 @@ void VulkanBackend::recordCommandBuffer(const DrawList& drawList) {
     // Update uniform buffer
     updateUniformBuffer();
 
-    // Get draw commands from draw list
-    const auto& commands = drawList.getCommands();
+    // Submit the batched ranges, so timings match the draws the GPU actually runs
+    batcher_.reset();
+    batcher_.batchCommands(drawList);
+
+    for (const auto& batch : batcher_.getBatchedCommands()) {
+        if (batch.indexCount == 0) {
+            continue;
+        }
 
-    for (const auto& cmd : commands) {
-        // Bind pipeline based on command type
-        bindPipeline(cmd.textureID != InvalidTexture);
+        bindPipeline(batch.state.isTextured);
 
         // Set scissor rect if clipping
-        if (cmd.clipRect.width > 0 && cmd.clipRect.height > 0) {
+        const Rect& clip = batch.state.clipRect;
+        if (clip.width > 0 && clip.height > 0) {
             VkRect2D scissor{};
-            scissor.offset.x = static_cast<int32_t>(cmd.clipRect.x);
-            scissor.offset.y = static_cast<int32_t>(cmd.clipRect.y);
-            scissor.extent.width = static_cast<uint32_t>(cmd.clipRect.width);
-            scissor.extent.height = static_cast<uint32_t>(cmd.clipRect.height);
+            scissor.offset.x = static_cast<int32_t>(clip.x);
+            scissor.offset.y = static_cast<int32_t>(clip.y);
+            scissor.extent.width = static_cast<uint32_t>(clip.width);
+            scissor.extent.height = static_cast<uint32_t>(clip.height);
             vkCmdSetScissor(frame.commandBuffer, 0, 1, &scissor);
         }
 
-        // Draw
-        vkCmdDrawIndexed(frame.commandBuffer, cmd.indexCount, 1, cmd.indexOffset, static_cast<int32_t>(cmd.vertexOffset), 0);
+        // DrawList indices are absolute within the list, so the base vertex is 0.
+        // Each draw is bracketed by timestamps while the query budget lasts
+        const bool timed = frame.timestampsWritten > 0;
+        const uint32_t query = frame.timestampsWritten;
+        if (timed && query + 2 <= MAX_TIMESTAMP_QUERIES) {
+            writeTimestamp(frame, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, query);
+            vkCmdDrawIndexed(frame.commandBuffer, batch.indexCount, 1, batch.indexOffset, 0, 0);
+            writeTimestamp(frame, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, query + 1);
+            frame.timestampsWritten += 2;
+        } else {
+            if (timed) {
+                frame.droppedDrawRanges++;
+            }
+            vkCmdDrawIndexed(frame.commandBuffer, batch.indexCount, 1, batch.indexOffset, 0, 0);
+        }
     }
 }
 
@@ -257,6 +292,49 @@ void VulkanBackend::updateUniformBuffer() {
     // Would update per-frame uniform buffer here
 }
 
+// =============================================================================
+// GPU Timestamps
+// =============================================================================
+
+void VulkanBackend::writeTimestamp(FrameResources& frame, uint32_t stage, uint32_t query) {
+    vkCmdWriteTimestamp(frame.commandBuffer, static_cast<VkPipelineStageFlagBits>(stage), frame.timestampPool, query);
+}
+
+void VulkanBackend::readbackTimestamps(FrameResources& frame) {
+    if (frame.timestampsWritten == 0 || !frame.timestampPool) {
+        return;
+    }
+
+    uint64_t ticks[MAX_TIMESTAMP_QUERIES];
+    const uint32_t count = frame.timestampsWritten;
+    frame.timestampsWritten = 0;
+
+    if (vkGetQueryPoolResults(device_, frame.timestampPool, 0, count, sizeof(ticks), ticks, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+        return;
+    }
+
+    const double msPerTick = static_cast<double>(timestampPeriodNs_) / 1.0e6;
+    // Only the low timestampValidBits bits count; masking the difference also survives a wrap
+    auto toMs = [&](uint32_t begin, uint32_t end) { return static_cast<double>(((ticks[end] & timestampMask_) - (ticks[begin] & timestampMask_)) & timestampMask_) * msPerTick; };
+
+    lastGpuTimings_.frameIndex = frame.frameIndex;
+    lastGpuTimings_.renderPassMs = toMs(0, 1);
+    lastGpuTimings_.drawRangeMs.clear();
+    for (uint32_t q = 2; q + 1 < count; q += 2) {
+        lastGpuTimings_.drawRangeMs.push_back(toMs(q, q + 1));
+    }
+    lastGpuTimings_.droppedDrawRanges = frame.droppedDrawRanges;
+    lastGpuTimings_.valid = true;
+}
+
+bool VulkanBackend::getLastGpuFrameTimings(GpuFrameTimings& out) const {
+    if (!lastGpuTimings_.valid) {
+        return false;
+    }
+    out = lastGpuTimings_;
+    return true;
+}
+
 // =============================================================================
 // Shader Module Creation
 // =============================================================================
@@ -187,6 +187,7 @@ TextureHandle VulkanBackend::createTexture(const TextureDesc& desc) {
     VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
     switch (desc.format) {
     case TextureFormat::R8:
+    case TextureFormat::A8:
         format = VK_FORMAT_R8_UNORM;
         break;
     case TextureFormat::RG8:
@@ -283,6 +284,9 @@ TextureHandle VulkanBackend::createTexture(const TextureDesc& desc) {
     viewInfo.image = vkTexture.image;
     viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
     viewInfo.format = format;
+    if (desc.format == TextureFormat::A8) {
+        viewInfo.components = {VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_ONE, VK_COMPONENT_SWIZZLE_R};
+    }
     viewInfo.subresourceRange.aspectMask = aspectFlags;
     viewInfo.subresourceRange.baseMipLevel = 0;
     viewInfo.subresourceRange.levelCount = desc.mipLevels;
@@ -357,6 +361,7 @@ void VulkanBackend::updateTexture(TextureHandle handle, const void* data, uint32
     size_t pixelSize = 4; // Assume RGBA8
     switch (texture.format) {
     case TextureFormat::R8:
+    case TextureFormat::A8:
         pixelSize = 1;
         break;
     case TextureFormat::RG8:
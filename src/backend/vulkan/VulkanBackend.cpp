@@ -5,8 +5,15 @@
 
 #include "dakt/gui/subsystems/draw/DrawList.hpp"
 
+#include "../../../shaders/compiled/ShaderBytecode.hpp"
+
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <stdexcept>
 #include <vector>
 
@@ -36,20 +43,50 @@
 namespace dakt::gui {
 
 // =============================================================================
-// Embedded Shader SPIR-V
+// Startup Timing Helpers
 // =============================================================================
-// These are placeholder SPIR-V modules - real shaders should be compiled
-// from GLSL and embedded via CMake
 
-static const uint32_t UI_VERT_SPV[] = {
-    // Minimal valid SPIR-V header (placeholder)
-    0x07230203, 0x00010000, 0x000d000b, 0x00000030, 0x00000000, 0x00020011, 0x00000001, 0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
-};
+using StartupClock = std::chrono::steady_clock;
+
+static double elapsedMs(StartupClock::time_point start) { return std::chrono::duration<double, std::milli>(StartupClock::now() - start).count(); }
 
-static const uint32_t UI_FRAG_SPV[] = {
-    0x07230203, 0x00010000, 0x000d000b, 0x00000018, 0x00000000, 0x00020011, 0x00000001, 0x0006000b, 0x00000001, 0x4c534c47, 0x6474732e, 0x3035342e, 0x00000000, 0x0003000e, 0x00000000, 0x00000001,
+// =============================================================================
+// Pipeline Cache File Format
+// =============================================================================
+// The raw vkGetPipelineCacheData blob is wrapped in our own header so a cache
+// produced by a different GPU or driver build is rejected before it reaches the
+// driver. Layout: PipelineCacheFileHeader followed by dataSize bytes of blob.
+
+static constexpr uint32_t PIPELINE_CACHE_MAGIC = 0x43504B44; // 'DKPC'
+static constexpr uint32_t PIPELINE_CACHE_VERSION = 1;
+
+struct PipelineCacheFileHeader {
+    uint32_t magic = PIPELINE_CACHE_MAGIC;
+    uint32_t version = PIPELINE_CACHE_VERSION;
+    uint32_t vendorID = 0;
+    uint32_t deviceID = 0;
+    uint32_t driverVersion = 0;
+    uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+    uint32_t reserved = 0;
+    uint64_t dataSize = 0;
+    uint64_t dataHash = 0;
 };
 
+static uint64_t fnv1a64(const void* data, size_t len) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool headerMatchesDevice(const PipelineCacheFileHeader& header, const VkPhysicalDeviceProperties& props) {
+    return header.magic == PIPELINE_CACHE_MAGIC && header.version == PIPELINE_CACHE_VERSION && header.vendorID == props.vendorID && header.deviceID == props.deviceID &&
+           header.driverVersion == props.driverVersion && std::memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
 // =============================================================================
 // VulkanBackend Implementation
 // =============================================================================
@@ -65,15 +102,23 @@ VulkanBackend::~VulkanBackend() {
 bool VulkanBackend::initialize(void* windowHandle, uint32_t width, uint32_t height) {
     windowWidth_ = width;
     windowHeight_ = height;
+    startupTimings_ = VulkanStartupTimings{};
+
+    const auto initStart = StartupClock::now();
+    auto stageStart = initStart;
 
     if (!createInstance()) {
         return false;
     }
+    startupTimings_.instanceMs = elapsedMs(stageStart);
 
+    stageStart = StartupClock::now();
     if (!createSurface(windowHandle)) {
         return false;
     }
+    startupTimings_.surfaceMs = elapsedMs(stageStart);
 
+    stageStart = StartupClock::now();
     if (!selectPhysicalDevice()) {
         return false;
     }
@@ -81,7 +126,9 @@ bool VulkanBackend::initialize(void* windowHandle, uint32_t width, uint32_t heig
     if (!createLogicalDevice()) {
         return false;
     }
+    startupTimings_.deviceMs = elapsedMs(stageStart);
 
+    stageStart = StartupClock::now();
     if (!createSwapchain()) {
         return false;
     }
@@ -93,7 +140,9 @@ bool VulkanBackend::initialize(void* windowHandle, uint32_t width, uint32_t heig
     if (!createFramebuffers()) {
         return false;
     }
+    startupTimings_.swapchainMs = elapsedMs(stageStart);
 
+    stageStart = StartupClock::now();
     if (!createCommandPool()) {
         return false;
     }
@@ -106,13 +155,30 @@ bool VulkanBackend::initialize(void* windowHandle, uint32_t width, uint32_t heig
         return false;
     }
 
+    if (!createQueryPools()) {
+        return false;
+    }
+    startupTimings_.resourcesMs = elapsedMs(stageStart);
+
+    stageStart = StartupClock::now();
+    if (!createPipelineCache()) {
+        return false;
+    }
+    startupTimings_.pipelineCacheLoadMs = elapsedMs(stageStart);
+
+    stageStart = StartupClock::now();
     if (!createPipelines()) {
         return false;
     }
+    startupTimings_.pipelinesMs = elapsedMs(stageStart);
 
+    stageStart = StartupClock::now();
     if (!createDefaultResources()) {
         return false;
     }
+    startupTimings_.resourcesMs += elapsedMs(stageStart);
+
+    startupTimings_.totalMs = elapsedMs(initStart);
 
     // Set capabilities
     initialized_ = true;
@@ -146,6 +212,10 @@ void VulkanBackend::shutdown() {
             vkDestroyFence(device_, frame.inFlightFence, nullptr);
             frame.inFlightFence = nullptr;
         }
+        if (frame.timestampPool) {
+            vkDestroyQueryPool(device_, frame.timestampPool, nullptr);
+            frame.timestampPool = nullptr;
+        }
     }
 
     if (commandPool_) {
@@ -163,6 +233,12 @@ void VulkanBackend::shutdown() {
         descriptorSetLayout_ = nullptr;
     }
 
+    if (pipelineCache_) {
+        savePipelineCache();
+        vkDestroyPipelineCache(device_, pipelineCache_, nullptr);
+        pipelineCache_ = nullptr;
+    }
+
     if (uiPipeline_) {
         vkDestroyPipeline(device_, uiPipeline_, nullptr);
         uiPipeline_ = nullptr;
@@ -741,6 +817,134 @@ bool VulkanBackend::createDescriptorPool() {
     return vkCreateDescriptorSetLayout(device_, &layoutInfo, nullptr, &descriptorSetLayout_) == VK_SUCCESS;
 }
 
+// =============================================================================
+// Timestamp Query Pools
+// =============================================================================
+
+bool VulkanBackend::createQueryPools() {
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physicalDevice_, &props);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice_, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice_, &queueFamilyCount, queueFamilies.data());
+
+    // Timing is optional: leave timestampPeriodNs_ at 0 when the queue cannot write timestamps
+    if (graphicsFamily_ >= queueFamilyCount || queueFamilies[graphicsFamily_].timestampValidBits == 0 || props.limits.timestampPeriod <= 0.0f) {
+        timestampPeriodNs_ = 0.0f;
+        return true;
+    }
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = MAX_TIMESTAMP_QUERIES;
+
+    for (auto& frame : frameResources_) {
+        if (vkCreateQueryPool(device_, &poolInfo, nullptr, &frame.timestampPool) != VK_SUCCESS) {
+            return false;
+        }
+    }
+
+    const uint32_t validBits = queueFamilies[graphicsFamily_].timestampValidBits;
+    timestampMask_ = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+    timestampPeriodNs_ = props.limits.timestampPeriod;
+    return true;
+}
+
+// =============================================================================
+// Pipeline Cache
+// =============================================================================
+
+bool VulkanBackend::createPipelineCache() {
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physicalDevice_, &props);
+
+    std::vector<char> initialData;
+    if (!pipelineCachePath_.empty()) {
+        std::ifstream file(pipelineCachePath_, std::ios::binary | std::ios::ate);
+        const auto fileSize = file.is_open() ? static_cast<uint64_t>(file.tellg()) : 0;
+        file.seekg(0);
+
+        PipelineCacheFileHeader header{};
+        if (fileSize >= sizeof(header) && file.read(reinterpret_cast<char*>(&header), sizeof(header)) && headerMatchesDevice(header, props) && header.dataSize == fileSize - sizeof(header)) {
+            initialData.resize(static_cast<size_t>(header.dataSize));
+            if (!file.read(initialData.data(), static_cast<std::streamsize>(initialData.size())) || fnv1a64(initialData.data(), initialData.size()) != header.dataHash) {
+                initialData.clear();
+            }
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = initialData.size();
+    cacheInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+    if (vkCreatePipelineCache(device_, &cacheInfo, nullptr, &pipelineCache_) == VK_SUCCESS) {
+        startupTimings_.pipelineCacheHit = !initialData.empty();
+        return true;
+    }
+
+    // The driver rejected the blob despite a matching header; start cold
+    cacheInfo.initialDataSize = 0;
+    cacheInfo.pInitialData = nullptr;
+    return vkCreatePipelineCache(device_, &cacheInfo, nullptr, &pipelineCache_) == VK_SUCCESS;
+}
+
+bool VulkanBackend::savePipelineCache() {
+    if (!pipelineCache_ || pipelineCachePath_.empty()) {
+        return false;
+    }
+
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+        return false;
+    }
+
+    std::vector<char> data(dataSize);
+    if (vkGetPipelineCacheData(device_, pipelineCache_, &dataSize, data.data()) != VK_SUCCESS) {
+        return false;
+    }
+    data.resize(dataSize);
+
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(physicalDevice_, &props);
+
+    PipelineCacheFileHeader header{};
+    header.vendorID = props.vendorID;
+    header.deviceID = props.deviceID;
+    header.driverVersion = props.driverVersion;
+    std::memcpy(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE);
+    header.dataSize = data.size();
+    header.dataHash = fnv1a64(data.data(), data.size());
+
+    // Write to a temporary file and rename so a crash mid-write never leaves a truncated cache
+    const std::string tempPath = pipelineCachePath_ + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            return false;
+        }
+    }
+
+    // Replace in one step, so the path always holds either the old cache or the new one
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+    const bool replaced = MoveFileExW(std::filesystem::path(tempPath).c_str(), std::filesystem::path(pipelineCachePath_).c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const bool replaced = std::rename(tempPath.c_str(), pipelineCachePath_.c_str()) == 0;
+#endif
+    if (!replaced) {
+        std::remove(tempPath.c_str());
+    }
+    return replaced;
+}
+
 // =============================================================================
 // Pipelines
 // =============================================================================
@@ -756,13 +960,128 @@ bool VulkanBackend::createPipelines() {
         return false;
     }
 
-    // Note: Actual pipeline creation requires valid SPIR-V shaders
-    // For now, we skip pipeline creation since we have placeholder shaders
-    // Real implementation would create vertex/fragment shader modules and graphics pipeline
+    // Pipelines need a render pass and valid SPIR-V; while the embedded shaders are
+    // placeholders they stay null and bindPipeline() skips them
+    if (!renderPass_ || shaders::SPV_PLACEHOLDER) {
+        return true;
+    }
+
+    uiPipeline_ = createGraphicsPipeline(shaders::UI_VERT_SPV, shaders::UI_VERT_SPV_SIZE, shaders::UI_FRAG_SPV, shaders::UI_FRAG_SPV_SIZE);
+    textPipeline_ = createGraphicsPipeline(shaders::TEXT_VERT_SPV, shaders::TEXT_VERT_SPV_SIZE, shaders::TEXT_FRAG_SPV, shaders::TEXT_FRAG_SPV_SIZE);
 
     return true;
 }
 
+VkPipeline VulkanBackend::createGraphicsPipeline(const uint32_t* vertCode, size_t vertSize, const uint32_t* fragCode, size_t fragSize) {
+    VkShaderModule vertModule = createShaderModule(vertCode, vertSize);
+    VkShaderModule fragModule = createShaderModule(fragCode, fragSize);
+
+    if (!vertModule || !fragModule) {
+        if (vertModule) {
+            vkDestroyShaderModule(device_, vertModule, nullptr);
+        }
+        if (fragModule) {
+            vkDestroyShaderModule(device_, fragModule, nullptr);
+        }
+        return VK_NULL_HANDLE;
+    }
+
+    VkPipelineShaderStageCreateInfo stages[2]{};
+    stages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    stages[0].module = vertModule;
+    stages[0].pName = "main";
+    stages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    stages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    stages[1].module = fragModule;
+    stages[1].pName = "main";
+
+    // Vertex layout matches dakt::gui::Vertex: position (vec2), uv (vec2), color (RGBA8, normalized)
+    VkVertexInputBindingDescription binding{};
+    binding.binding = 0;
+    binding.stride = sizeof(Vertex);
+    binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+
+    VkVertexInputAttributeDescription attributes[] = {
+        {0, 0, VK_FORMAT_R32G32_SFLOAT, static_cast<uint32_t>(offsetof(Vertex, position))},
+        {1, 0, VK_FORMAT_R32G32_SFLOAT, static_cast<uint32_t>(offsetof(Vertex, uv))},
+        {2, 0, VK_FORMAT_R8G8B8A8_UNORM, static_cast<uint32_t>(offsetof(Vertex, color))},
+    };
+
+    VkPipelineVertexInputStateCreateInfo vertexInput{};
+    vertexInput.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInput.vertexBindingDescriptionCount = 1;
+    vertexInput.pVertexBindingDescriptions = &binding;
+    vertexInput.vertexAttributeDescriptionCount = 3;
+    vertexInput.pVertexAttributeDescriptions = attributes;
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
+    inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    VkPipelineViewportStateCreateInfo viewportState{};
+    viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    viewportState.viewportCount = 1;
+    viewportState.scissorCount = 1;
+
+    VkPipelineRasterizationStateCreateInfo rasterizer{};
+    rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    rasterizer.polygonMode = VK_POLYGON_MODE_FILL;
+    rasterizer.cullMode = VK_CULL_MODE_NONE;
+    rasterizer.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterizer.lineWidth = 1.0f;
+
+    VkPipelineMultisampleStateCreateInfo multisample{};
+    multisample.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    // Premultiplied-style alpha blending for UI
+    VkPipelineColorBlendAttachmentState blendAttachment{};
+    blendAttachment.blendEnable = VK_TRUE;
+    blendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+    blendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.colorBlendOp = VK_BLEND_OP_ADD;
+    blendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+    blendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+    blendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;
+    blendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendStateCreateInfo colorBlend{};
+    colorBlend.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    colorBlend.attachmentCount = 1;
+    colorBlend.pAttachments = &blendAttachment;
+
+    VkDynamicState dynamicStates[] = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
+    VkPipelineDynamicStateCreateInfo dynamicState{};
+    dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    dynamicState.dynamicStateCount = 2;
+    dynamicState.pDynamicStates = dynamicStates;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = stages;
+    pipelineInfo.pVertexInputState = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewportState;
+    pipelineInfo.pRasterizationState = &rasterizer;
+    pipelineInfo.pMultisampleState = &multisample;
+    pipelineInfo.pColorBlendState = &colorBlend;
+    pipelineInfo.pDynamicState = &dynamicState;
+    pipelineInfo.layout = pipelineLayout_;
+    pipelineInfo.renderPass = renderPass_;
+    pipelineInfo.subpass = 0;
+
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    if (vkCreateGraphicsPipelines(device_, pipelineCache_, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        pipeline = VK_NULL_HANDLE;
+    }
+
+    vkDestroyShaderModule(device_, vertModule, nullptr);
+    vkDestroyShaderModule(device_, fragModule, nullptr);
+    return pipeline;
+}
+
 // =============================================================================
 // Default Resources
 // =============================================================================
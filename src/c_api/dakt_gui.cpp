@@ -22,6 +22,7 @@
 #include "dakt/gui/subsystems/draw/DrawList.hpp"
 #include "dakt/gui/subsystems/input/Input.hpp"
 #include "dakt/gui/subsystems/style/Style.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
 #include "dakt/gui/immediate/Widgets/InputText.hpp"
 #include "dakt/gui/immediate/Widgets/Button.hpp"
 #include "dakt/gui/immediate/Widgets/Checkbox.hpp"
@@ -502,7 +503,8 @@ DAKTLIB_GUI_API void ProcText(DuiCtx ctx, const char* text) {
     }
 
     dakt::gui::KeyboardInput kbIn = internal->keyboardInput;
-    kbIn.textInput = text;
+    // Hosts pass raw platform text; hand the widgets well-formed UTF-8 only
+    kbIn.textInput = dakt::gui::utf8::sanitize(text);
     internal->input->processKeyboard(kbIn);
 }
 
@@ -0,0 +1,115 @@
+#include "dakt/gui/core/WorkerPool.hpp"
+
+namespace dakt::gui {
+
+namespace {
+
+// Set while the current thread runs pool tasks; nested parallelFor() runs inline
+thread_local bool t_inTask = false;
+
+} // namespace
+
+WorkerPool::WorkerPool(size_t workerCount) {
+    workers_.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back([this] { workerLoop(); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+WorkerPool& WorkerPool::shared() {
+    static WorkerPool pool([] {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? static_cast<size_t>(hardware - 1) : size_t{0};
+    }());
+    return pool;
+}
+
+void WorkerPool::parallelFor(size_t count, const std::function<void(size_t)>& task) {
+    if (count == 0) {
+        return;
+    }
+
+    if (workers_.empty() || count == 1 || t_inTask) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatch(dispatchMutex_);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        taskCount_ = count;
+        nextTask_.store(0, std::memory_order_relaxed);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    runTasks(task, count);
+
+    // Every index is claimed; wait for workers still running theirs. A worker
+    // waking after this point finds no job and goes back to sleep.
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return activeWorkers_ == 0; });
+    task_ = nullptr;
+    taskCount_ = 0;
+}
+
+void WorkerPool::workerLoop() {
+    uint64_t seenGeneration = 0;
+
+    for (;;) {
+        const std::function<void(size_t)>* task = nullptr;
+        size_t count = 0;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seenGeneration; });
+            if (stopping_) {
+                return;
+            }
+
+            seenGeneration = generation_;
+            if (!task_) {
+                continue;
+            }
+            task = task_;
+            count = taskCount_;
+            ++activeWorkers_;
+        }
+
+        runTasks(*task, count);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --activeWorkers_;
+        }
+        done_.notify_all();
+    }
+}
+
+void WorkerPool::runTasks(const std::function<void(size_t)>& task, size_t count) {
+    const bool wasInTask = t_inTask;
+    t_inTask = true;
+
+    for (size_t i = nextTask_.fetch_add(1, std::memory_order_relaxed); i < count; i = nextTask_.fetch_add(1, std::memory_order_relaxed)) {
+        task(i);
+    }
+
+    t_inTask = wasInTask;
+}
+
+} // namespace dakt::gui
@@ -4,6 +4,7 @@
  */
 
 #include "dakt/gui/core/Context.hpp"
+#include "dakt/gui/core/WorkerPool.hpp"
 #include "dakt/gui/subsystems/draw/DrawList.hpp"
 #include "dakt/gui/retained/Containers/ContainerBase.hpp"
 #include "dakt/gui/retained/Containers/Grid.hpp"
@@ -16,6 +17,22 @@
 
 namespace dakt::gui {
 
+namespace {
+
+// Widgets in a subtree, counting stops once limit is reached
+size_t countWidgets(const Widget* widget, size_t limit) {
+    size_t count = 1;
+    for (const auto& child : widget->getChildren()) {
+        if (count >= limit) {
+            break;
+        }
+        count += countWidgets(child.get(), limit - count);
+    }
+    return count;
+}
+
+} // namespace
+
 // ============================================================================
 // Internal Root Widget
 // ============================================================================
@@ -135,12 +152,13 @@ void UIContainer::layout() {
         // Manual positioning - just layout children in place
         for (auto& child : root_->getChildren()) {
             if (child->needsLayout()) {
-                child->layout(child->getBounds());
+                layoutChild(child.get(), child->getBounds());
             }
         }
         break;
     }
 
+    flushDeferredLayouts();
     clearDirty();
 }
 
@@ -164,7 +182,7 @@ void UIContainer::layoutVertical() {
         if (!child->isVisible())
             continue;
 
-        Vec2 size = child->measureContent();
+        Vec2 size = child->measure();
         totalHeight += size.y;
         visibleCount++;
     }
@@ -212,7 +230,7 @@ void UIContainer::layoutVertical() {
         if (!child->isVisible())
             continue;
 
-        Vec2 size = child->measureContent();
+        Vec2 size = child->measure();
         float childWidth = size.x;
         float childX = contentX;
 
@@ -232,7 +250,7 @@ void UIContainer::layoutVertical() {
         }
 
         Rect childBounds(childX, y, childWidth, size.y);
-        child->layout(childBounds);
+        layoutChild(child.get(), childBounds);
 
         y += size.y + spacing_;
     }
@@ -252,7 +270,7 @@ void UIContainer::layoutHorizontal() {
         if (!child->isVisible())
             continue;
 
-        Vec2 size = child->measureContent();
+        Vec2 size = child->measure();
         totalWidth += size.x;
         visibleCount++;
     }
@@ -300,7 +318,7 @@ void UIContainer::layoutHorizontal() {
         if (!child->isVisible())
             continue;
 
-        Vec2 size = child->measureContent();
+        Vec2 size = child->measure();
         float childHeight = size.y;
         float childY = contentY;
 
@@ -320,7 +338,7 @@ void UIContainer::layoutHorizontal() {
         }
 
         Rect childBounds(x, childY, size.x, childHeight);
-        child->layout(childBounds);
+        layoutChild(child.get(), childBounds);
 
         x += size.x + spacing_;
     }
@@ -328,6 +346,28 @@ void UIContainer::layoutHorizontal() {
 
 void UIContainer::layoutChildren(Widget* widget, const Rect& available) { widget->layout(available); }
 
+void UIContainer::layoutChild(Widget* child, const Rect& bounds) {
+    // Large subtrees wait for flushDeferredLayouts(); bounds are already final
+    if (parallelLayout_ && countWidgets(child, parallelMinSubtree_) >= parallelMinSubtree_) {
+        deferredLayouts_.emplace_back(child, bounds);
+        return;
+    }
+    child->layout(bounds);
+}
+
+void UIContainer::flushDeferredLayouts() {
+    if (deferredLayouts_.empty()) {
+        return;
+    }
+
+    // Sibling subtrees share no state, so each one lays out exactly as it would sequentially
+    WorkerPool::shared().parallelFor(deferredLayouts_.size(), [this](size_t i) {
+        auto& [child, bounds] = deferredLayouts_[i];
+        child->layout(bounds);
+    });
+    deferredLayouts_.clear();
+}
+
 void UIContainer::processInput(InputSystem& input) {
     Vec2 mousePos = input.getMousePosition();
     bool leftDown = input.isMouseButtonDown(MouseButton::Left);
@@ -16,6 +16,7 @@
 #include "dakt/gui/retained/widgets/WidgetBase.hpp"
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace dakt::gui {
 
@@ -56,6 +57,7 @@ Widget& Widget::operator=(Widget&& other) noexcept {
         visible_ = other.visible_;
         dirty_ = other.dirty_;
         needsLayout_ = other.needsLayout_;
+        invalidateMeasure();
         onClick_ = std::move(other.onClick_);
         onDoubleClick_ = std::move(other.onDoubleClick_);
         onHover_ = std::move(other.onHover_);
@@ -139,7 +141,7 @@ Vec2 Widget::measureContent() {
 
     Vec2 size{0, 0};
     for (auto& child : children_) {
-        Vec2 childSize = child->measureContent();
+        Vec2 childSize = child->measure();
         size.x = std::max(size.x, childSize.x);
         size.y += childSize.y;
     }
@@ -150,6 +152,29 @@ Vec2 Widget::measureContent() {
     return size;
 }
 
+Vec2 Widget::measure() {
+    if (!measureValid_) {
+        measuredSize_ = measureContent();
+        measureValid_ = true;
+    }
+    return measuredSize_;
+}
+
+Vec2 Widget::measure(const Vec2& availableSize) {
+    if (constrainedValid_ && constrainedAvailable_.x == availableSize.x && constrainedAvailable_.y == availableSize.y) {
+        return constrainedSize_;
+    }
+
+    Vec2 size = measure();
+    size.x = std::min(size.x, availableSize.x);
+    size.y = std::min(size.y, availableSize.y);
+
+    constrainedAvailable_ = availableSize;
+    constrainedSize_ = size;
+    constrainedValid_ = true;
+    return size;
+}
+
 void Widget::layout(const Rect& available) {
     bounds_ = available;
 
@@ -161,8 +186,7 @@ void Widget::layout(const Rect& available) {
         if (!child->isVisible())
             continue;
 
-        Vec2 childSize = child->measureContent();
-        childSize.x = std::min(childSize.x, contentWidth);
+        Vec2 childSize = child->measure(Vec2(contentWidth, std::numeric_limits<float>::max()));
 
         Rect childBounds(available.x + padding_.left, y, childSize.x, childSize.y);
 
@@ -208,6 +232,7 @@ void Widget::setEnabled(bool enabled) {
 
 void Widget::markDirty() {
     dirty_ = true;
+    invalidateMeasure();
     propagateDirty();
 }
 
@@ -218,7 +243,9 @@ void Widget::markNeedsLayout() {
 
 void Widget::propagateDirty() {
     if (parent_) {
+        // A parent's measured size depends on its children
         parent_->dirty_ = true;
+        parent_->invalidateMeasure();
         parent_->propagateDirty();
     }
 }
@@ -754,8 +781,7 @@ void Panel::layout(const Rect& available) {
         if (!child->isVisible())
             continue;
 
-        Vec2 childSize = child->measureContent();
-        childSize.x = std::min(childSize.x, contentWidth);
+        Vec2 childSize = child->measure(Vec2(contentWidth, std::numeric_limits<float>::max()));
 
         Rect childBounds(available.x + padding_.left, y, contentWidth, childSize.y);
         child->layout(childBounds);
@@ -824,7 +850,7 @@ void ScrollView::layout(const Rect& available) {
         if (!child->isVisible())
             continue;
 
-        Vec2 childSize = child->measureContent();
+        Vec2 childSize = child->measure();
         Rect childBounds(padding_.left, y, contentWidth, childSize.y);
         child->layout(childBounds);
         y += childSize.y + 4.0f;
@@ -952,7 +978,7 @@ void ScrollView::build(Context& ctx) {
 void ScrollView::updateContentSize() {
     contentSize_ = Vec2(0, 0);
     for (auto& child : children_) {
-        Vec2 childSize = child->measureContent();
+        Vec2 childSize = child->measure();
         contentSize_.x = std::max(contentSize_.x, childSize.x);
         contentSize_.y += childSize.y + 4.0f;
     }
@@ -1010,7 +1036,7 @@ Vec2 TreeNode::measureContent() {
 
     if (isExpanded()) {
         for (auto& child : children_) {
-            Vec2 childSize = child->measureContent();
+            Vec2 childSize = child->measure();
             width = std::max(width, indentWidth_ + childSize.x);
             height += childSize.y;
         }
@@ -1031,7 +1057,7 @@ void TreeNode::layout(const Rect& available) {
             if (!child->isVisible())
                 continue;
 
-            Vec2 childSize = child->measureContent();
+            Vec2 childSize = child->measure();
             Rect childBounds(childX, y, childWidth, childSize.y);
             child->layout(childBounds);
             y += childSize.y;
@@ -30,11 +30,8 @@ void Stack::layoutStack() {
         if (!child->isVisible())
             continue;
 
-        Vec2 childSize = child->measureContent();
-
-        // Clamp to available space
-        childSize.x = std::min(childSize.x, availableWidth);
-        childSize.y = std::min(childSize.y, availableHeight);
+        // Clamped to available space
+        Vec2 childSize = child->measure(Vec2(availableWidth, availableHeight));
 
         // Get alignment for this widget
         Alignment hAlign = hAlign_;
@@ -33,7 +33,7 @@ void Wrap::layoutWrap() {
             if (!child->isVisible())
                 continue;
 
-            Vec2 childSize = child->measureContent();
+            Vec2 childSize = child->measure();
 
             // Check if we need to wrap
             if (x + childSize.x > startX + availableWidth && x > startX) {
@@ -58,7 +58,7 @@ void Wrap::layoutWrap() {
             if (!child->isVisible())
                 continue;
 
-            Vec2 childSize = child->measureContent();
+            Vec2 childSize = child->measure();
 
             // Check if we need to wrap
             if (y + childSize.y > startY + availableHeight && y > startY) {
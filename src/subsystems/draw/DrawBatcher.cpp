@@ -25,6 +25,7 @@ void DrawBatcher::batchCommands(const DrawList& drawList) {
     stats_.originalCommandCount = static_cast<uint32_t>(commands.size());
     batchedCommands_.clear();
     batchedCommands_.reserve(commands.size());
+    shaderClipping_ = drawList.getClipMode() == ClipMode::Shader;
 
     RenderState state{};
     uint64_t lastTextureID = 0;
@@ -33,7 +34,7 @@ void DrawBatcher::batchCommands(const DrawList& drawList) {
     for (const auto& cmd : commands) {
         switch (cmd.type) {
         case DrawCommandType::SetClipRect:
-            if (cmd.clipRect != lastClipRect) {
+            if (!shaderClipping_ && cmd.clipRect != lastClipRect) {
                 lastClipRect = cmd.clipRect;
                 state.clipRect = cmd.clipRect;
                 stats_.clipRectChanges++;
@@ -81,8 +82,12 @@ void DrawBatcher::batchCommands(const DrawList& drawList) {
 }
 
 bool DrawBatcher::canMerge(const BatchedDrawCommand& a, const BatchedDrawCommand& b) const {
-    // Must have same render state
-    if (a.state != b.state) {
+    // Must have same render state (the fragment shader clips in shader mode)
+    if (shaderClipping_) {
+        if (a.state.textureID != b.state.textureID || a.state.isTextured != b.state.isTextured || a.state.isSDF != b.state.isSDF) {
+            return false;
+        }
+    } else if (a.state != b.state) {
         return false;
     }
 
@@ -15,6 +15,7 @@ DrawList::DrawList() {
 
     // Default clip rect (will be set to window size)
     currentClipRect_ = Rect(0, 0, 10000, 10000);
+    clipTable_.push_back(currentClipRect_);
 }
 
 DrawList::~DrawList() = default;
@@ -26,13 +27,27 @@ void DrawList::reset() {
     clipRectStack_.clear();
     currentTexture_ = 0;
     currentClipRect_ = Rect(0, 0, 10000, 10000);
+
+    clipTable_.clear();
+    clipTable_.push_back(currentClipRect_);
+    clipIndexStack_.clear();
+    currentClipIndex_ = 0;
 }
 
 void DrawList::addCommand(DrawCommandType type, uint32_t vertexCount, uint32_t indexCount) {
+    const bool shaderClip = clipMode_ == ClipMode::Shader;
+
+    // Tag the new vertices with the active clip region
+    if (shaderClip && currentClipIndex_ != 0) {
+        for (size_t i = vertices_.size() - vertexCount; i < vertices_.size(); ++i) {
+            vertices_[i].clipIndex = currentClipIndex_;
+        }
+    }
+
     // Try to merge with previous command if compatible
     if (!commands_.empty() && type == DrawCommandType::DrawTriangles) {
         auto& prev = commands_.back();
-        if (prev.type == DrawCommandType::DrawTriangles && prev.clipRect == currentClipRect_ && prev.textureID == currentTexture_) {
+        if (prev.type == DrawCommandType::DrawTriangles && (shaderClip || prev.clipRect == currentClipRect_) && prev.textureID == currentTexture_) {
             // Extend previous command
             prev.vertexCount += vertexCount;
             prev.indexCount += indexCount;
@@ -63,7 +78,12 @@ void DrawList::reserveIndices(size_t count) {
     }
 }
 
-void DrawList::addVertex(const Vertex& vertex) { vertices_.push_back(vertex); }
+void DrawList::addVertex(const Vertex& vertex) {
+    vertices_.push_back(vertex);
+    if (clipMode_ == ClipMode::Shader) {
+        vertices_.back().clipIndex = currentClipIndex_;
+    }
+}
 
 void DrawList::addIndex(uint32_t index) { indices_.push_back(index); }
 
@@ -310,7 +330,20 @@ void DrawList::drawText(const Vec2& position, const char* text, Color color, flo
 
 void DrawList::pushClipRect(const Rect& rect) {
     clipRectStack_.push_back(currentClipRect_);
-    currentClipRect_ = currentClipRect_.intersection(rect);
+    Rect clipped = currentClipRect_.intersection(rect);
+
+    if (clipMode_ == ClipMode::Shader) {
+        // No command: vertices carry the region, so draws keep merging
+        clipIndexStack_.push_back(currentClipIndex_);
+        if (clipped != currentClipRect_) {
+            clipTable_.push_back(clipped);
+            currentClipIndex_ = static_cast<uint32_t>(clipTable_.size() - 1);
+        }
+        currentClipRect_ = clipped;
+        return;
+    }
+
+    currentClipRect_ = clipped;
 
     DrawCommand cmd;
     cmd.type = DrawCommandType::SetClipRect;
@@ -323,6 +356,12 @@ void DrawList::popClipRect() {
         currentClipRect_ = clipRectStack_.back();
         clipRectStack_.pop_back();
 
+        if (!clipIndexStack_.empty()) {
+            currentClipIndex_ = clipIndexStack_.back();
+            clipIndexStack_.pop_back();
+            return;
+        }
+
         DrawCommand cmd;
         cmd.type = DrawCommandType::SetClipRect;
         cmd.clipRect = currentClipRect_;
@@ -33,7 +33,7 @@ HitTestResult HitTester::recursiveTest(LayoutNode* node, const Vec2& point, int
 
     // Traverse children in reverse order (last child is topmost)
     for (auto it = children.rbegin(); it != children.rend(); ++it) {
-        HitTestResult childResult = recursiveTest(it->get(), point, childZOrder);
+        HitTestResult childResult = recursiveTest(*it, point, childZOrder);
         if (childResult.hit && childResult.zOrder > result.zOrder) {
             result = childResult;
         }
@@ -81,8 +81,8 @@ void HitTester::recursiveRectTest(LayoutNode* node, const Rect& area, std::vecto
 
     // Test children
     const auto& children = node->getChildren();
-    for (const auto& child : children) {
-        recursiveRectTest(child.get(), area, results, zOrder + 1);
+    for (LayoutNode* child : children) {
+        recursiveRectTest(child, area, results, zOrder + 1);
     }
 }
 
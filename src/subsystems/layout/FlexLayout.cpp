@@ -1,4 +1,5 @@
 #include "dakt/gui/subsystems/layout/Layout.hpp"
+#include "dakt/gui/core/WorkerPool.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -54,7 +55,7 @@ class FlexLayoutEngine {
 
         for (const auto& child : children) {
             FlexItem item;
-            item.node = child.get();
+            item.node = child;
             const auto& childFlex = child->getFlexProperties();
             const auto& constraints = child->getConstraints();
 
@@ -64,6 +65,11 @@ class FlexLayoutEngine {
             // Determine base size
             if (!std::isnan(childFlex.basis)) {
                 item.baseSize = childFlex.basis;
+            } else if (child->hasMeasureFunc()) {
+                // Content size within the space the line can offer
+                Vec2 measured = (flex.direction == FlexDirection::Row) ? child->measure(availableMain, MeasureMode::AtMost, availableCross, MeasureMode::AtMost)
+                                                                       : child->measure(availableCross, MeasureMode::AtMost, availableMain, MeasureMode::AtMost);
+                item.baseSize = (flex.direction == FlexDirection::Row) ? measured.x : measured.y;
             } else {
                 // Use child's current size or a default
                 item.baseSize = (flex.direction == FlexDirection::Row) ? child->getSize().x : child->getSize().y;
@@ -168,10 +174,18 @@ class FlexLayoutEngine {
             float maxCross = 0.0f;
             for (auto* item : line.items) {
                 // Get item's cross size
-                float itemCross = (flex.direction == FlexDirection::Row) ? item->node->getSize().y : item->node->getSize().x;
+                float itemCross = 0.0f;
+                if (item->node->hasMeasureFunc()) {
+                    // Main size is resolved now, e.g. text wraps to its final width
+                    Vec2 measured = (flex.direction == FlexDirection::Row) ? item->node->measure(item->finalSize, MeasureMode::Exactly, availableCross, MeasureMode::AtMost)
+                                                                           : item->node->measure(availableCross, MeasureMode::AtMost, item->finalSize, MeasureMode::Exactly);
+                    itemCross = (flex.direction == FlexDirection::Row) ? measured.y : measured.x;
+                } else {
+                    itemCross = (flex.direction == FlexDirection::Row) ? item->node->getSize().y : item->node->getSize().x;
 
-                if (itemCross <= 0.0f) {
-                    itemCross = 30.0f; // Default cross size
+                    if (itemCross <= 0.0f) {
+                        itemCross = 30.0f; // Default cross size
+                    }
                 }
 
                 item->crossSize = itemCross;
@@ -198,6 +212,10 @@ class FlexLayoutEngine {
         float mainOffset = isRow ? containerRect.x + padding.left : containerRect.y + padding.top;
         float crossOffset = isRow ? containerRect.y + padding.top : containerRect.x + padding.left;
 
+        const bool parallel = LayoutNode::isParallelLayoutEnabled();
+        const size_t minParallelSubtree = LayoutNode::getParallelSubtreeSize();
+        std::vector<LayoutNode*> heavyItems;
+
         for (auto& line : lines) {
             // Calculate main-axis position based on justifyContent
             float lineMainStart = mainOffset;
@@ -257,21 +275,30 @@ class FlexLayoutEngine {
 
                 // Set position and size
                 if (isRow) {
-                    item->node->setPosition(currentMain, itemCrossOffset);
-                    item->node->setSize(item->finalSize, item->crossSize);
+                    item->node->assignRect(currentMain, itemCrossOffset, item->finalSize, item->crossSize);
                 } else {
-                    item->node->setPosition(itemCrossOffset, currentMain);
-                    item->node->setSize(item->crossSize, item->finalSize);
+                    item->node->assignRect(itemCrossOffset, currentMain, item->crossSize, item->finalSize);
                 }
 
                 currentMain += item->finalSize + gap;
 
-                // Recursively layout children
-                item->node->computeLayout(item->node->getSize().x, item->node->getSize().y);
+                // Recursively layout children; large subtrees are deferred to the worker pool
+                if (parallel && item->node->isDirty() && item->node->getSubtreeSize() >= minParallelSubtree) {
+                    heavyItems.push_back(item->node);
+                } else {
+                    item->node->computeLayout(item->node->getSize().x, item->node->getSize().y);
+                }
             }
 
             crossOffset += line.crossSize;
         }
+
+        if (!heavyItems.empty()) {
+            WorkerPool::shared().parallelFor(heavyItems.size(), [&heavyItems](size_t i) {
+                LayoutNode* node = heavyItems[i];
+                node->computeLayout(node->getSize().x, node->getSize().y);
+            });
+        }
     }
 };
 
@@ -1,68 +1,427 @@
 #include "dakt/gui/subsystems/layout/Layout.hpp"
+#include "dakt/gui/core/WorkerPool.hpp"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 namespace dakt::gui {
 
-LayoutNode::LayoutNode() = default;
+namespace {
+
+std::atomic<uint64_t> g_nodesMeasured{0};
+std::atomic<uint64_t> g_measureCacheHits{0};
+std::atomic<uint64_t> g_nodesVisited{0};
+std::atomic<uint64_t> g_relayoutRoots{0};
+
+std::atomic<bool> g_parallelLayout{false};
+std::atomic<size_t> g_parallelMinSubtree{LayoutNode::DEFAULT_PARALLEL_SUBTREE_SIZE};
+
+// Returns true when the rect changed; the node then needs its children laid out again
+bool assignArenaRect(LayoutArena& arena, uint32_t index, const Rect& rect) {
+    Rect& current = arena.rects[index];
+    if (current.x == rect.x && current.y == rect.y && current.width == rect.width && current.height == rect.height) {
+        return false;
+    }
+    current = rect;
+    arena.flags[index] |= LayoutArena::FLAG_DIRTY;
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// LayoutArena
+// ============================================================================
+
+LayoutArena::LayoutArena(LayoutNode* root) {
+    rects.emplace_back();
+    flexProps.emplace_back();
+    constraints.emplace_back();
+    flags.push_back(FLAG_DIRTY | FLAG_ALIVE);
+    parent.push_back(INVALID_LAYOUT_INDEX);
+    firstChild.push_back(INVALID_LAYOUT_INDEX);
+    lastChild.push_back(INVALID_LAYOUT_INDEX);
+    nextSibling.push_back(INVALID_LAYOUT_INDEX);
+    prevSibling.push_back(INVALID_LAYOUT_INDEX);
+    childCount.push_back(0);
+    subtreeSize.push_back(1);
+    handles.push_back(root);
+}
+
+uint32_t LayoutArena::allocate() {
+    uint32_t index = 0;
+
+    if (!freeList_.empty()) {
+        index = freeList_.back();
+        freeList_.pop_back();
+
+        rects[index] = Rect();
+        flexProps[index] = FlexProperties();
+        constraints[index] = LayoutConstraints();
+        parent[index] = INVALID_LAYOUT_INDEX;
+        firstChild[index] = INVALID_LAYOUT_INDEX;
+        lastChild[index] = INVALID_LAYOUT_INDEX;
+        nextSibling[index] = INVALID_LAYOUT_INDEX;
+        prevSibling[index] = INVALID_LAYOUT_INDEX;
+        childCount[index] = 0;
+        subtreeSize[index] = 1;
+    } else {
+        index = static_cast<uint32_t>(handles.size());
+
+        rects.emplace_back();
+        flexProps.emplace_back();
+        constraints.emplace_back();
+        flags.push_back(0);
+        parent.push_back(INVALID_LAYOUT_INDEX);
+        firstChild.push_back(INVALID_LAYOUT_INDEX);
+        lastChild.push_back(INVALID_LAYOUT_INDEX);
+        nextSibling.push_back(INVALID_LAYOUT_INDEX);
+        prevSibling.push_back(INVALID_LAYOUT_INDEX);
+        childCount.push_back(0);
+        subtreeSize.push_back(1);
+        handles.push_back(&pool_.emplace_back(LayoutNode::PoolTag(), this, index));
+    }
+
+    flags[index] = FLAG_DIRTY | FLAG_ALIVE;
+    return index;
+}
+
+void LayoutArena::release(uint32_t index) {
+    for (uint32_t child = firstChild[index]; child != INVALID_LAYOUT_INDEX;) {
+        uint32_t next = nextSibling[child];
+        release(child);
+        child = next;
+    }
+
+    handles[index]->resetHandle();
+    flags[index] = 0;
+    freeList_.push_back(index);
+}
+
+// ============================================================================
+// LayoutNode
+// ============================================================================
+
+LayoutNode::LayoutNode() : ownedArena_(std::make_unique<LayoutArena>(this)) { arena_ = ownedArena_.get(); }
+
+LayoutNode::LayoutNode(PoolTag, LayoutArena* arena, uint32_t index) : arena_(arena), index_(index) {}
+
 LayoutNode::~LayoutNode() = default;
 
+void LayoutNode::resetHandle() {
+    measureFunc_ = nullptr;
+    measureCache_.clear();
+    measureCacheNext_ = 0;
+}
+
 void LayoutNode::setSize(float width, float height) {
-    if (rect_.width != width || rect_.height != height) {
-        rect_.width = width;
-        rect_.height = height;
-        markDirty();
+    Rect& rect = arena_->rects[index_];
+    if (rect.width != width || rect.height != height) {
+        rect.width = width;
+        rect.height = height;
+
+        // The children need relaying out; this node's own measure cache stays valid
+        if (!isDirty()) {
+            arena_->flags[index_] |= LayoutArena::FLAG_DIRTY;
+            enqueueRelayout();
+        }
     }
 }
 
 void LayoutNode::setPosition(float x, float y) {
-    if (rect_.x != x || rect_.y != y) {
-        rect_.x = x;
-        rect_.y = y;
+    Rect& rect = arena_->rects[index_];
+    if (rect.x != x || rect.y != y) {
+        rect.x = x;
+        rect.y = y;
+
+        // Child rects are absolute, so the subtree moves with us
+        if (!isDirty()) {
+            arena_->flags[index_] |= LayoutArena::FLAG_DIRTY;
+            enqueueRelayout();
+        }
     }
 }
 
-LayoutNode* LayoutNode::addChild() {
-    children_.push_back(std::make_unique<LayoutNode>());
-    children_.back()->parent_ = this;
+void LayoutNode::assignRect(float x, float y, float width, float height) { assignArenaRect(*arena_, index_, Rect(x, y, width, height)); }
+
+void LayoutNode::setFlexProperties(const FlexProperties& props) {
+    arena_->flexProps[index_] = props;
     markDirty();
-    return children_.back().get();
+}
+
+void LayoutNode::setFlexDirection(FlexDirection dir) {
+    arena_->flexProps[index_].direction = dir;
+    markDirty();
+}
+
+void LayoutNode::setFlexGrow(float grow) {
+    arena_->flexProps[index_].grow = grow;
+    markDirty();
+}
+
+void LayoutNode::setFlexShrink(float shrink) {
+    arena_->flexProps[index_].shrink = shrink;
+    markDirty();
+}
+
+void LayoutNode::setFlexBasis(float basis) {
+    arena_->flexProps[index_].basis = basis;
+    markDirty();
+}
+
+void LayoutNode::setConstraints(const LayoutConstraints& constraints) {
+    arena_->constraints[index_] = constraints;
+    markDirty();
+}
+
+void LayoutNode::setMeasureFunc(MeasureFunc func) {
+    measureFunc_ = std::move(func);
+    markDirty();
+}
+
+LayoutNode* LayoutNode::addChild() {
+    LayoutArena& arena = *arena_;
+    uint32_t child = arena.allocate();
+
+    // Append to the sibling list
+    uint32_t last = arena.lastChild[index_];
+    arena.parent[child] = index_;
+    arena.prevSibling[child] = last;
+    if (last != INVALID_LAYOUT_INDEX) {
+        arena.nextSibling[last] = child;
+    } else {
+        arena.firstChild[index_] = child;
+    }
+    arena.lastChild[index_] = child;
+    arena.childCount[index_]++;
+
+    for (uint32_t node = index_; node != INVALID_LAYOUT_INDEX; node = arena.parent[node]) {
+        arena.subtreeSize[node]++;
+    }
+
+    markNeedsLayout();
+    return arena.handles[child];
 }
 
 void LayoutNode::removeChild(LayoutNode* child) {
-    auto it = std::find_if(children_.begin(), children_.end(), [child](const auto& ptr) { return ptr.get() == child; });
-    if (it != children_.end()) {
-        children_.erase(it);
-        markDirty();
+    LayoutArena& arena = *arena_;
+    if (!child || child->arena_ != arena_ || arena.parent[child->index_] != index_) {
+        return;
+    }
+
+    const uint32_t index = child->index_;
+
+    // Drop queued boundaries inside the removed subtree
+    auto& queue = arena.dirtyQueue;
+    queue.erase(std::remove_if(queue.begin(), queue.end(),
+                               [&arena, index](uint32_t queued) {
+                                   for (uint32_t node = queued; node != INVALID_LAYOUT_INDEX; node = arena.parent[node]) {
+                                       if (node == index) {
+                                           return true;
+                                       }
+                                   }
+                                   return false;
+                               }),
+                queue.end());
+
+    // Unlink from the sibling list
+    uint32_t prev = arena.prevSibling[index];
+    uint32_t next = arena.nextSibling[index];
+    if (prev != INVALID_LAYOUT_INDEX) {
+        arena.nextSibling[prev] = next;
+    } else {
+        arena.firstChild[index_] = next;
     }
+    if (next != INVALID_LAYOUT_INDEX) {
+        arena.prevSibling[next] = prev;
+    } else {
+        arena.lastChild[index_] = prev;
+    }
+    arena.childCount[index_]--;
+
+    const uint32_t removed = arena.subtreeSize[index];
+    for (uint32_t node = index_; node != INVALID_LAYOUT_INDEX; node = arena.parent[node]) {
+        arena.subtreeSize[node] -= removed;
+    }
+
+    arena.release(index);
+    markNeedsLayout();
 }
 
 void LayoutNode::markDirty() {
-    if (!dirty_) {
-        dirty_ = true;
-        if (parent_) {
-            parent_->markDirty();
+    measureCache_.clear();
+    measureCacheNext_ = 0;
+
+    // Our own properties feed the parent's layout of us
+    arena_->flags[index_] |= LayoutArena::FLAG_DIRTY;
+    if (LayoutNode* parent = getParent()) {
+        parent->markNeedsLayout();
+    }
+}
+
+void LayoutNode::markNeedsLayout() {
+    LayoutArena& arena = *arena_;
+    uint32_t node = index_;
+    while (!arena.isDirty(node)) {
+        arena.flags[node] |= LayoutArena::FLAG_DIRTY;
+        if (arena.parent[node] == INVALID_LAYOUT_INDEX) {
+            return; // Tree root: computeLayout() picks it up directly
+        }
+        if (arena.handles[node]->isRelayoutBoundary()) {
+            arena.handles[node]->enqueueRelayout();
+            return;
+        }
+        node = arena.parent[node];
+    }
+}
+
+bool LayoutNode::isRelayoutBoundary() const {
+    const LayoutArena& arena = *arena_;
+    const uint32_t parent = arena.parent[index_];
+    if (parent == INVALID_LAYOUT_INDEX) {
+        return true;
+    }
+
+    const LayoutConstraints& constraints = arena.constraints[index_];
+    if (constraints.minWidth == constraints.maxWidth && constraints.minHeight == constraints.maxHeight) {
+        return true;
+    }
+
+    // Definite basis fixes the main axis; a stretching parent fixes the cross axis
+    return !std::isnan(arena.flexProps[index_].basis) && !measureFunc_ && arena.flexProps[parent].alignItems == AlignItems::Stretch;
+}
+
+void LayoutNode::enqueueRelayout() {
+    LayoutArena& arena = *arena_;
+    if ((arena.flags[index_] & LayoutArena::FLAG_QUEUED) || arena.parent[index_] == INVALID_LAYOUT_INDEX) {
+        return;
+    }
+
+    arena.dirtyQueue.push_back(index_);
+    arena.flags[index_] |= LayoutArena::FLAG_QUEUED;
+}
+
+void LayoutNode::processDirtyQueue() {
+    LayoutArena& arena = *arena_;
+    std::vector<std::pair<uint32_t, uint32_t>> ordered;
+
+    // Entries may be queued while laying out (e.g. from measure callbacks)
+    while (!arena.dirtyQueue.empty()) {
+        ordered.clear();
+        for (uint32_t node : arena.dirtyQueue) {
+            uint32_t depth = 0;
+            for (uint32_t p = arena.parent[node]; p != INVALID_LAYOUT_INDEX; p = arena.parent[p]) {
+                ++depth;
+            }
+            ordered.emplace_back(depth, node);
+        }
+        arena.dirtyQueue.clear();
+
+        // Shallowest first: a boundary laid out by an ancestor's pass is clean by the time we reach it
+        std::stable_sort(ordered.begin(), ordered.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        for (auto& [depth, node] : ordered) {
+            arena.flags[node] &= static_cast<uint8_t>(~LayoutArena::FLAG_QUEUED);
+            if (arena.isDirty(node)) {
+                g_relayoutRoots.fetch_add(1, std::memory_order_relaxed);
+                const Rect& rect = arena.rects[node];
+                arena.handles[node]->computeLayout(rect.width, rect.height);
+            }
+        }
+    }
+}
+
+Vec2 LayoutNode::measure(float availableWidth, MeasureMode widthMode, float availableHeight, MeasureMode heightMode) {
+    if (!measureFunc_) {
+        return getSize();
+    }
+
+    // The available size is meaningless for an undefined axis, so don't key on it
+    if (widthMode == MeasureMode::Undefined) {
+        availableWidth = 0.0f;
+    }
+    if (heightMode == MeasureMode::Undefined) {
+        availableHeight = 0.0f;
+    }
+
+    for (const auto& entry : measureCache_) {
+        if (entry.widthMode == widthMode && entry.heightMode == heightMode && entry.availableWidth == availableWidth && entry.availableHeight == availableHeight) {
+            g_measureCacheHits.fetch_add(1, std::memory_order_relaxed);
+            return entry.result;
         }
     }
+
+    MeasureCacheEntry entry;
+    entry.availableWidth = availableWidth;
+    entry.availableHeight = availableHeight;
+    entry.widthMode = widthMode;
+    entry.heightMode = heightMode;
+    entry.result = measureFunc_(availableWidth, widthMode, availableHeight, heightMode);
+    g_nodesMeasured.fetch_add(1, std::memory_order_relaxed);
+
+    if (measureCache_.size() < MAX_MEASURE_CACHE_ENTRIES) {
+        measureCache_.push_back(entry);
+    } else {
+        measureCache_[measureCacheNext_] = entry;
+        measureCacheNext_ = (measureCacheNext_ + 1) % MAX_MEASURE_CACHE_ENTRIES;
+    }
+
+    return entry.result;
+}
+
+LayoutStats LayoutNode::getStats() {
+    LayoutStats stats;
+    stats.nodesMeasured = g_nodesMeasured.load(std::memory_order_relaxed);
+    stats.measureCacheHits = g_measureCacheHits.load(std::memory_order_relaxed);
+    stats.nodesVisited = g_nodesVisited.load(std::memory_order_relaxed);
+    stats.relayoutRoots = g_relayoutRoots.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void LayoutNode::resetStats() {
+    g_nodesMeasured.store(0, std::memory_order_relaxed);
+    g_measureCacheHits.store(0, std::memory_order_relaxed);
+    g_nodesVisited.store(0, std::memory_order_relaxed);
+    g_relayoutRoots.store(0, std::memory_order_relaxed);
 }
 
+void LayoutNode::setParallelLayout(bool enabled, size_t minSubtreeSize) {
+    g_parallelMinSubtree.store(std::max<size_t>(minSubtreeSize, 1), std::memory_order_relaxed);
+    g_parallelLayout.store(enabled, std::memory_order_relaxed);
+}
+
+bool LayoutNode::isParallelLayoutEnabled() { return g_parallelLayout.load(std::memory_order_relaxed); }
+
+size_t LayoutNode::getParallelSubtreeSize() { return g_parallelMinSubtree.load(std::memory_order_relaxed); }
+
 void LayoutNode::computeLayout(float parentWidth, float parentHeight) {
-    if (!dirty_)
+    const bool isRoot = arena_->parent[index_] == INVALID_LAYOUT_INDEX;
+
+    if (!isDirty()) {
+        if (isRoot) {
+            processDirtyQueue();
+        }
         return;
+    }
+
+    g_nodesVisited.fetch_add(1, std::memory_order_relaxed);
+
+    const FlexProperties& flexProps = arena_->flexProps[index_];
+    const LayoutConstraints& constraints = arena_->constraints[index_];
 
     // Clamp to constraints
-    float availWidth = std::clamp(parentWidth, constraints_.minWidth, constraints_.maxWidth);
-    float availHeight = std::clamp(parentHeight, constraints_.minHeight, constraints_.maxHeight);
+    float availWidth = std::clamp(parentWidth, constraints.minWidth, constraints.maxWidth);
+    float availHeight = std::clamp(parentHeight, constraints.minHeight, constraints.maxHeight);
 
     // Account for padding
-    float contentWidth = availWidth - flexProps_.padding.left - flexProps_.padding.right;
-    float contentHeight = availHeight - flexProps_.padding.top - flexProps_.padding.bottom;
+    float contentWidth = availWidth - flexProps.padding.left - flexProps.padding.right;
+    float contentHeight = availHeight - flexProps.padding.top - flexProps.padding.bottom;
 
     contentWidth = std::max(0.0f, contentWidth);
     contentHeight = std::max(0.0f, contentHeight);
 
     // Measure and layout children based on flex direction
-    if (flexProps_.direction == FlexDirection::Row) {
+    if (flexProps.direction == FlexDirection::Row) {
         // Row: horizontal main axis
         layoutChildren();
     } else {
@@ -71,40 +430,76 @@ void LayoutNode::computeLayout(float parentWidth, float parentHeight) {
     }
 
     markClean();
+
+    // Boundaries below the root that were dirtied independently
+    if (isRoot) {
+        processDirtyQueue();
+    }
 }
 
 void LayoutNode::layoutChildren() {
     // Simple layout: stack children vertically/horizontally
-    const auto& padding = flexProps_.padding;
-    float x = rect_.x + padding.left;
-    float y = rect_.y + padding.top;
+    // Columns are re-indexed on every access: measure callbacks may grow the arena
+    // (sequential layout only; parallel layout requires a frozen tree).
+    LayoutArena& arena = *arena_;
+    const bool parallel = isParallelLayoutEnabled();
+    const size_t minParallelSubtree = getParallelSubtreeSize();
+    std::vector<uint32_t> heavyChildren;
+    const Rect rect = arena.rects[index_];
+    const EdgeInsets padding = arena.flexProps[index_].padding;
+    const bool isRow = arena.flexProps[index_].direction == FlexDirection::Row;
 
-    float availWidth = rect_.width - padding.left - padding.right;
-    float availHeight = rect_.height - padding.top - padding.bottom;
+    float x = rect.x + padding.left;
+    float y = rect.y + padding.top;
 
-    for (auto& child : children_) {
-        child->setPosition(x, y);
+    float availWidth = rect.width - padding.left - padding.right;
+    float availHeight = rect.height - padding.top - padding.bottom;
 
-        if (flexProps_.direction == FlexDirection::Row) {
+    for (uint32_t child = arena.firstChild[index_]; child != INVALID_LAYOUT_INDEX; child = arena.nextSibling[child]) {
+        if (isRow) {
             // Row layout
-            float childWidth = child->flexProps_.basis;
+            float childWidth = arena.flexProps[child].basis;
             if (std::isnan(childWidth)) {
-                childWidth = 100.0f; // Default child width
+                // Measured content, else default child width
+                LayoutNode* node = arena.handles[child];
+                childWidth = node->hasMeasureFunc() ? node->measure(availWidth, MeasureMode::AtMost, availHeight, MeasureMode::Exactly).x : 100.0f;
             }
-            child->setSize(childWidth, availHeight);
-            x += childWidth + child->flexProps_.margin.right;
+            assignArenaRect(arena, child, Rect(x, y, childWidth, availHeight));
+            x += childWidth + arena.flexProps[child].margin.right;
         } else {
             // Column layout
-            float childHeight = child->flexProps_.basis;
+            float childHeight = arena.flexProps[child].basis;
             if (std::isnan(childHeight)) {
-                childHeight = 30.0f; // Default child height
+                // Measured content, else default child height
+                LayoutNode* node = arena.handles[child];
+                childHeight = node->hasMeasureFunc() ? node->measure(availWidth, MeasureMode::Exactly, availHeight, MeasureMode::AtMost).y : 30.0f;
             }
-            child->setSize(availWidth, childHeight);
-            y += childHeight + child->flexProps_.margin.bottom;
+            assignArenaRect(arena, child, Rect(x, y, availWidth, childHeight));
+            y += childHeight + arena.flexProps[child].margin.bottom;
+        }
+
+        // Unchanged, clean children keep their subtree as is, without touching their handle
+        if (!arena.isDirty(child)) {
+            continue;
         }
+        if (parallel && arena.subtreeSize[child] >= minParallelSubtree) {
+            heavyChildren.push_back(child);
+            continue;
+        }
+        const Rect& childRect = arena.rects[child];
+        arena.handles[child]->computeLayout(childRect.width, childRect.height);
+    }
 
-        child->computeLayout(child->rect_.width, child->rect_.height);
+    if (heavyChildren.empty()) {
+        return;
     }
+
+    // Large sibling subtrees touch disjoint slots of every column, so they can run side by side
+    WorkerPool::shared().parallelFor(heavyChildren.size(), [&arena, &heavyChildren](size_t i) {
+        const uint32_t child = heavyChildren[i];
+        const Rect childRect = arena.rects[child];
+        arena.handles[child]->computeLayout(childRect.width, childRect.height);
+    });
 }
 
 } // namespace dakt::gui
@@ -0,0 +1,647 @@
+#include "dakt/gui/subsystems/text/Bidi.hpp"
+#include "BidiTables.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
+#include <algorithm>
+#include <array>
+
+namespace dakt::gui {
+
+namespace {
+
+constexpr uint32_t NONE = 0xFFFFFFFF;
+constexpr size_t MAX_BRACKET_DEPTH = 63; // BD16
+
+bool isRemovedByX9(BidiClass c) {
+    switch (c) {
+    case BidiClass::LRE:
+    case BidiClass::LRO:
+    case BidiClass::RLE:
+    case BidiClass::RLO:
+    case BidiClass::PDF:
+    case BidiClass::BN:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool isIsolateInitiator(BidiClass c) { return c == BidiClass::LRI || c == BidiClass::RLI || c == BidiClass::FSI; }
+
+// NI in rules N1 and N2
+bool isNeutralOrIsolate(BidiClass c) {
+    switch (c) {
+    case BidiClass::B:
+    case BidiClass::S:
+    case BidiClass::WS:
+    case BidiClass::ON:
+    case BidiClass::LRI:
+    case BidiClass::RLI:
+    case BidiClass::FSI:
+    case BidiClass::PDI:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Direction a resolved type contributes to N0-N2: numbers count as R
+BidiClass strongDirection(BidiClass c) {
+    switch (c) {
+    case BidiClass::L:
+        return BidiClass::L;
+    case BidiClass::R:
+    case BidiClass::AL:
+    case BidiClass::EN:
+    case BidiClass::AN:
+        return BidiClass::R;
+    default:
+        return BidiClass::ON;
+    }
+}
+
+BidiClass directionOfLevel(uint8_t level) { return (level & 1) != 0 ? BidiClass::R : BidiClass::L; }
+
+uint8_t nextOddLevel(uint8_t level) { return static_cast<uint8_t>((level + 1) | 1); }
+uint8_t nextEvenLevel(uint8_t level) { return static_cast<uint8_t>((level + 2) & ~1); }
+
+// U+2329/U+232A are canonically equivalent to U+3008/U+3009
+uint32_t canonicalBracket(uint32_t codepoint) {
+    if (codepoint == 0x2329) {
+        return 0x3008;
+    }
+    if (codepoint == 0x232A) {
+        return 0x3009;
+    }
+    return codepoint;
+}
+
+// Closing bracket paired with an opening one, or 0
+uint32_t closingBracketFor(uint32_t codepoint) {
+    const auto* first = std::begin(bidi_tables::BRACKETS);
+    const auto* last = std::end(bidi_tables::BRACKETS);
+    const auto* it = std::lower_bound(first, last, codepoint, [](const bidi_tables::BracketPair& pair, uint32_t cp) { return pair.open < cp; });
+    return it != last && it->open == codepoint ? it->close : 0;
+}
+
+bool isClosingBracket(uint32_t codepoint) {
+    return std::any_of(std::begin(bidi_tables::BRACKETS), std::end(bidi_tables::BRACKETS),
+                       [codepoint](const bidi_tables::BracketPair& pair) { return pair.close == codepoint; });
+}
+
+} // namespace
+
+BidiClass getBidiClass(uint32_t codepoint) {
+    if (codepoint > 0x10FFFF) {
+        return BidiClass::L;
+    }
+    constexpr uint32_t mask = (1u << bidi_tables::BLOCK_SHIFT) - 1;
+    const size_t block = bidi_tables::STAGE1[codepoint >> bidi_tables::BLOCK_SHIFT];
+    return static_cast<BidiClass>(bidi_tables::STAGE2[(block << bidi_tables::BLOCK_SHIFT) | (codepoint & mask)]);
+}
+
+// ============================================================================
+// BidiParagraph
+// ============================================================================
+
+void BidiParagraph::analyze(std::string_view text, uint8_t baseLevel) {
+    codepoints_.resize(text.size());
+    offsets_.resize(text.size());
+    const size_t count = utf8::decode(text, codepoints_.data(), offsets_.data());
+    codepoints_.resize(count);
+    offsets_.resize(count);
+    offsets_.push_back(static_cast<uint32_t>(text.size()));
+    resolve(baseLevel);
+}
+
+void BidiParagraph::analyze(const uint32_t* codepoints, size_t count, uint8_t baseLevel) {
+    codepoints_.assign(codepoints, codepoints + count);
+    offsets_.resize(count + 1);
+    for (size_t i = 0; i <= count; ++i) {
+        offsets_[i] = static_cast<uint32_t>(i);
+    }
+    resolve(baseLevel);
+}
+
+void BidiParagraph::resolve(uint8_t baseLevel) {
+    const size_t count = codepoints_.size();
+    classes_.resize(count);
+    levels_.assign(count, 0);
+    paragraphStarts_.clear();
+    baseLevels_.clear();
+    hasRTL_ = false;
+
+    bool needsResolution = baseLevel != AUTO_LEVEL && (baseLevel & 1) != 0;
+    for (size_t i = 0; i < count; ++i) {
+        const BidiClass c = getBidiClass(codepoints_[i]);
+        classes_[i] = c;
+        needsResolution |= c == BidiClass::R || c == BidiClass::AL || c == BidiClass::AN || c >= BidiClass::LRE;
+    }
+
+    // Nothing right-to-left or explicit: every level is 0 in every paragraph
+    if (!needsResolution) {
+        paragraphStarts_.push_back(0);
+        baseLevels_.push_back(0);
+        return;
+    }
+
+    types_ = classes_;
+    matchingPDI_.assign(count, NONE);
+
+    size_t start = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (classes_[i] == BidiClass::B || i + 1 == count) {
+            resolveParagraph(start, i + 1, baseLevel);
+            start = i + 1;
+        }
+    }
+    if (paragraphStarts_.empty()) {
+        paragraphStarts_.push_back(0);
+        baseLevels_.push_back(baseLevel == AUTO_LEVEL ? 0 : baseLevel & 1);
+    }
+
+    hasRTL_ = std::any_of(levels_.begin(), levels_.end(), [](uint8_t level) { return (level & 1) != 0; });
+}
+
+uint8_t BidiParagraph::firstStrongLevel(size_t start, size_t end, uint8_t fallback) const {
+    // P2: skip isolates, stop at a paragraph separator
+    for (size_t i = start; i < end; ++i) {
+        const BidiClass c = classes_[i];
+        if (c == BidiClass::L) {
+            return 0;
+        }
+        if (c == BidiClass::R || c == BidiClass::AL) {
+            return 1;
+        }
+        if (isIsolateInitiator(c)) {
+            if (matchingPDI_[i] == NONE) {
+                break;
+            }
+            i = matchingPDI_[i];
+        } else if (c == BidiClass::B) {
+            break;
+        }
+    }
+    return fallback;
+}
+
+void BidiParagraph::resolveParagraph(size_t start, size_t end, uint8_t baseLevel) {
+    // BD9: pair isolate initiators with their PDIs
+    std::vector<uint32_t> openIsolates;
+    for (size_t i = start; i < end; ++i) {
+        if (isIsolateInitiator(classes_[i])) {
+            openIsolates.push_back(static_cast<uint32_t>(i));
+        } else if (classes_[i] == BidiClass::PDI && !openIsolates.empty()) {
+            matchingPDI_[openIsolates.back()] = static_cast<uint32_t>(i);
+            openIsolates.pop_back();
+        }
+    }
+
+    // P2, P3
+    const uint8_t paragraphLevel = baseLevel == AUTO_LEVEL ? firstStrongLevel(start, end, 0) : (baseLevel & 1);
+    paragraphStarts_.push_back(static_cast<uint32_t>(start));
+    baseLevels_.push_back(paragraphLevel);
+
+    // X1-X8: explicit embeddings, overrides and isolates
+    struct Status {
+        uint8_t level;
+        BidiClass override; // ON when neutral
+        bool isolate;
+    };
+    std::array<Status, MAX_DEPTH + 2> stack;
+    size_t depth = 0;
+    stack[depth++] = {paragraphLevel, BidiClass::ON, false};
+    size_t overflowIsolates = 0;
+    size_t overflowEmbeddings = 0;
+    size_t validIsolates = 0;
+
+    for (size_t i = start; i < end; ++i) {
+        const BidiClass c = classes_[i];
+        switch (c) {
+        case BidiClass::RLE:
+        case BidiClass::LRE:
+        case BidiClass::RLO:
+        case BidiClass::LRO: {
+            const Status& top = stack[depth - 1];
+            levels_[i] = top.level;
+            const bool rtl = c == BidiClass::RLE || c == BidiClass::RLO;
+            const uint8_t level = rtl ? nextOddLevel(top.level) : nextEvenLevel(top.level);
+            if (level <= MAX_DEPTH && overflowIsolates == 0 && overflowEmbeddings == 0) {
+                const BidiClass override = c == BidiClass::RLO ? BidiClass::R : (c == BidiClass::LRO ? BidiClass::L : BidiClass::ON);
+                stack[depth++] = {level, override, false};
+            } else if (overflowIsolates == 0) {
+                ++overflowEmbeddings;
+            }
+            break;
+        }
+
+        case BidiClass::RLI:
+        case BidiClass::LRI:
+        case BidiClass::FSI: {
+            const Status& top = stack[depth - 1];
+            levels_[i] = top.level;
+            if (top.override != BidiClass::ON) {
+                types_[i] = top.override;
+            }
+
+            bool rtl = c == BidiClass::RLI;
+            if (c == BidiClass::FSI) {
+                rtl = firstStrongLevel(i + 1, matchingPDI_[i] != NONE ? matchingPDI_[i] : end, 0) == 1;
+            }
+            const uint8_t level = rtl ? nextOddLevel(top.level) : nextEvenLevel(top.level);
+            if (level <= MAX_DEPTH && overflowIsolates == 0 && overflowEmbeddings == 0) {
+                ++validIsolates;
+                stack[depth++] = {level, BidiClass::ON, true};
+            } else {
+                ++overflowIsolates;
+            }
+            break;
+        }
+
+        case BidiClass::PDI:
+            if (overflowIsolates > 0) {
+                --overflowIsolates;
+            } else if (validIsolates > 0) {
+                overflowEmbeddings = 0;
+                while (!stack[depth - 1].isolate) {
+                    --depth;
+                }
+                --depth;
+                --validIsolates;
+            }
+            levels_[i] = stack[depth - 1].level;
+            if (stack[depth - 1].override != BidiClass::ON) {
+                types_[i] = stack[depth - 1].override;
+            }
+            break;
+
+        case BidiClass::PDF:
+            if (overflowIsolates == 0) {
+                if (overflowEmbeddings > 0) {
+                    --overflowEmbeddings;
+                } else if (!stack[depth - 1].isolate && depth >= 2) {
+                    --depth;
+                }
+            }
+            levels_[i] = stack[depth - 1].level;
+            break;
+
+        case BidiClass::B:
+            levels_[i] = paragraphLevel;
+            break;
+
+        case BidiClass::BN:
+            levels_[i] = stack[depth - 1].level;
+            break;
+
+        default:
+            levels_[i] = stack[depth - 1].level;
+            if (stack[depth - 1].override != BidiClass::ON) {
+                types_[i] = stack[depth - 1].override;
+            }
+            break;
+        }
+    }
+
+    // X9, X10: level runs of the remaining characters, chained across isolates
+    struct LevelRun {
+        uint32_t first; // Index into kept
+        uint32_t last;
+    };
+    std::vector<uint32_t> kept;
+    kept.reserve(end - start);
+    for (size_t i = start; i < end; ++i) {
+        if (!isRemovedByX9(classes_[i])) {
+            kept.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    std::vector<LevelRun> runs;
+    std::vector<uint32_t> runStartingAt(end - start, NONE); // Character -> run it starts
+    for (uint32_t k = 0; k < kept.size(); ++k) {
+        if (k == 0 || levels_[kept[k]] != levels_[kept[k - 1]]) {
+            runStartingAt[kept[k] - start] = static_cast<uint32_t>(runs.size());
+            runs.push_back({k, k});
+        } else {
+            runs.back().last = k;
+        }
+    }
+
+    // Runs starting with a matched PDI continue the sequence of their initiator
+    std::vector<bool> continued(runs.size(), false);
+    std::vector<uint32_t> sequence;
+    for (size_t r = 0; r < runs.size(); ++r) {
+        if (continued[r]) {
+            continue;
+        }
+
+        sequence.clear();
+        const LevelRun* current = &runs[r];
+        for (;;) {
+            for (uint32_t k = current->first; k <= current->last; ++k) {
+                sequence.push_back(kept[k]);
+            }
+            const uint32_t last = kept[current->last];
+            if (!isIsolateInitiator(classes_[last]) || matchingPDI_[last] == NONE) {
+                break;
+            }
+            const uint32_t next = runStartingAt[matchingPDI_[last] - start];
+            if (next == NONE) {
+                break;
+            }
+            continued[next] = true;
+            current = &runs[next];
+        }
+
+        resolveSequence(sequence, start, end, paragraphLevel);
+    }
+
+    // Removed characters take the level of what precedes them
+    for (size_t i = start; i < end; ++i) {
+        if (isRemovedByX9(classes_[i])) {
+            levels_[i] = i == start ? paragraphLevel : levels_[i - 1];
+        }
+    }
+}
+
+void BidiParagraph::resolveSequence(const std::vector<uint32_t>& sequence, size_t start, size_t end, uint8_t paragraphLevel) {
+    const size_t count = sequence.size();
+    const uint8_t level = levels_[sequence.front()];
+
+    // sos/eos from the neighbouring levels (X10)
+    uint8_t before = paragraphLevel;
+    for (size_t i = sequence.front(); i-- > start;) {
+        if (!isRemovedByX9(classes_[i])) {
+            before = levels_[i];
+            break;
+        }
+    }
+    uint8_t after = paragraphLevel;
+    if (!isIsolateInitiator(classes_[sequence.back()])) {
+        for (size_t i = sequence.back() + 1; i < end; ++i) {
+            if (!isRemovedByX9(classes_[i])) {
+                after = levels_[i];
+                break;
+            }
+        }
+    }
+    const BidiClass sos = directionOfLevel(std::max(before, level));
+    const BidiClass eos = directionOfLevel(std::max(after, level));
+
+    std::vector<BidiClass> types(count);
+    for (size_t k = 0; k < count; ++k) {
+        types[k] = types_[sequence[k]];
+    }
+
+    // W1: marks take the type of what they follow
+    for (size_t k = 0; k < count; ++k) {
+        if (types[k] == BidiClass::NSM) {
+            if (k == 0) {
+                types[k] = sos;
+            } else {
+                const BidiClass prev = types[k - 1];
+                types[k] = isIsolateInitiator(prev) || prev == BidiClass::PDI ? BidiClass::ON : prev;
+            }
+        }
+    }
+
+    // W2, W3: European numbers after Arabic letters become Arabic numbers
+    BidiClass lastStrong = sos;
+    for (auto& type : types) {
+        if (type == BidiClass::L || type == BidiClass::R || type == BidiClass::AL) {
+            lastStrong = type;
+        } else if (type == BidiClass::EN && lastStrong == BidiClass::AL) {
+            type = BidiClass::AN;
+        }
+    }
+    for (auto& type : types) {
+        if (type == BidiClass::AL) {
+            type = BidiClass::R;
+        }
+    }
+
+    // W4: single separators between numbers
+    for (size_t k = 1; k + 1 < count; ++k) {
+        const BidiClass prev = types[k - 1];
+        const BidiClass next = types[k + 1];
+        if (types[k] == BidiClass::ES && prev == BidiClass::EN && next == BidiClass::EN) {
+            types[k] = BidiClass::EN;
+        } else if (types[k] == BidiClass::CS && prev == next && (prev == BidiClass::EN || prev == BidiClass::AN)) {
+            types[k] = prev;
+        }
+    }
+
+    // W5: terminators next to European numbers
+    for (size_t k = 0; k < count;) {
+        if (types[k] != BidiClass::ET) {
+            ++k;
+            continue;
+        }
+        size_t runEnd = k;
+        while (runEnd < count && types[runEnd] == BidiClass::ET) {
+            ++runEnd;
+        }
+        if ((k > 0 && types[k - 1] == BidiClass::EN) || (runEnd < count && types[runEnd] == BidiClass::EN)) {
+            std::fill(types.begin() + static_cast<std::ptrdiff_t>(k), types.begin() + static_cast<std::ptrdiff_t>(runEnd), BidiClass::EN);
+        }
+        k = runEnd;
+    }
+
+    // W6, W7
+    lastStrong = sos;
+    for (auto& type : types) {
+        if (type == BidiClass::ES || type == BidiClass::ET || type == BidiClass::CS) {
+            type = BidiClass::ON;
+        } else if (type == BidiClass::L || type == BidiClass::R) {
+            lastStrong = type;
+        } else if (type == BidiClass::EN && lastStrong == BidiClass::L) {
+            type = BidiClass::L;
+        }
+    }
+
+    // N0
+    resolveBrackets(sequence, types, sos, level);
+
+    // N1, N2: neutrals between equal directions take it, others the embedding direction
+    const BidiClass embedding = directionOfLevel(level);
+    for (size_t k = 0; k < count;) {
+        if (!isNeutralOrIsolate(types[k])) {
+            ++k;
+            continue;
+        }
+        size_t runEnd = k;
+        while (runEnd < count && isNeutralOrIsolate(types[runEnd])) {
+            ++runEnd;
+        }
+        const BidiClass leading = k == 0 ? sos : strongDirection(types[k - 1]);
+        const BidiClass trailing = runEnd == count ? eos : strongDirection(types[runEnd]);
+        const BidiClass resolved = leading == trailing ? leading : embedding;
+        std::fill(types.begin() + static_cast<std::ptrdiff_t>(k), types.begin() + static_cast<std::ptrdiff_t>(runEnd), resolved);
+        k = runEnd;
+    }
+
+    // I1, I2
+    for (size_t k = 0; k < count; ++k) {
+        uint8_t& resolved = levels_[sequence[k]];
+        const BidiClass type = types[k];
+        if ((resolved & 1) == 0) {
+            if (type == BidiClass::R) {
+                resolved += 1;
+            } else if (type == BidiClass::AN || type == BidiClass::EN) {
+                resolved += 2;
+            }
+        } else if (type == BidiClass::L || type == BidiClass::EN || type == BidiClass::AN) {
+            resolved += 1;
+        }
+    }
+}
+
+void BidiParagraph::resolveBrackets(const std::vector<uint32_t>& sequence, std::vector<BidiClass>& types, BidiClass sos, uint8_t level) const {
+    // BD16: pair brackets that are still ON
+    struct Opener {
+        uint32_t close;
+        uint32_t position;
+    };
+    std::array<Opener, MAX_BRACKET_DEPTH> openers;
+    size_t depth = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+    for (size_t k = 0; k < sequence.size(); ++k) {
+        if (types[k] != BidiClass::ON) {
+            continue;
+        }
+        const uint32_t codepoint = codepoints_[sequence[k]];
+        if (const uint32_t close = closingBracketFor(codepoint)) {
+            if (depth == openers.size()) {
+                break;
+            }
+            openers[depth++] = {canonicalBracket(close), static_cast<uint32_t>(k)};
+        } else if (depth > 0 && isClosingBracket(codepoint)) {
+            const uint32_t closing = canonicalBracket(codepoint);
+            for (size_t d = depth; d-- > 0;) {
+                if (openers[d].close == closing) {
+                    pairs.emplace_back(openers[d].position, static_cast<uint32_t>(k));
+                    depth = d;
+                    break;
+                }
+            }
+        }
+    }
+    if (pairs.empty()) {
+        return;
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    const BidiClass embedding = directionOfLevel(level);
+    for (const auto& [open, close] : pairs) {
+        bool hasEmbedding = false;
+        bool hasOpposite = false;
+        for (uint32_t k = open + 1; k < close && !hasEmbedding; ++k) {
+            const BidiClass direction = strongDirection(types[k]);
+            hasEmbedding = direction == embedding;
+            hasOpposite |= direction != BidiClass::ON && direction != embedding;
+        }
+
+        BidiClass resolved = BidiClass::ON;
+        if (hasEmbedding) {
+            resolved = embedding;
+        } else if (hasOpposite) {
+            // N0 c: the opposite direction only if the preceding context agrees
+            BidiClass context = sos;
+            for (uint32_t k = open; k-- > 0;) {
+                const BidiClass direction = strongDirection(types[k]);
+                if (direction != BidiClass::ON) {
+                    context = direction;
+                    break;
+                }
+            }
+            resolved = context != embedding ? context : embedding;
+        }
+        if (resolved == BidiClass::ON) {
+            continue;
+        }
+
+        // Marks following a bracket (ON after W1) change with it
+        for (uint32_t bracket : {open, close}) {
+            types[bracket] = resolved;
+            for (size_t k = bracket + 1; k < sequence.size() && classes_[sequence[k]] == BidiClass::NSM; ++k) {
+                types[k] = resolved;
+            }
+        }
+    }
+}
+
+uint8_t BidiParagraph::getBaseLevel(size_t index) const {
+    if (baseLevels_.empty()) {
+        return 0;
+    }
+    const auto it = std::upper_bound(paragraphStarts_.begin(), paragraphStarts_.end(), static_cast<uint32_t>(index));
+    return baseLevels_[static_cast<size_t>(std::max<std::ptrdiff_t>(it - paragraphStarts_.begin() - 1, 0))];
+}
+
+size_t BidiParagraph::getIndex(uint32_t byteOffset) const {
+    if (offsets_.empty()) {
+        return 0;
+    }
+    const auto it = std::lower_bound(offsets_.begin(), offsets_.end() - 1, byteOffset);
+    return static_cast<size_t>(it - offsets_.begin());
+}
+
+void BidiParagraph::getLineRuns(size_t start, size_t end, std::vector<Run>& runs) const {
+    runs.clear();
+    end = std::min(end, levels_.size());
+    if (start >= end) {
+        return;
+    }
+
+    // L1, walking backwards: separators, and whitespace before them or at the
+    // end of the line, return to the paragraph level
+    const uint8_t baseLevel = getBaseLevel(start);
+    bool trailing = true;
+    for (size_t i = end; i-- > start;) {
+        const BidiClass c = classes_[i];
+        uint8_t level = levels_[i];
+        if (c == BidiClass::S || c == BidiClass::B) {
+            level = baseLevel;
+            trailing = true;
+        } else if (c == BidiClass::WS || isIsolateInitiator(c) || c == BidiClass::PDI || isRemovedByX9(c)) {
+            if (trailing) {
+                level = baseLevel;
+            }
+        } else {
+            trailing = false;
+        }
+
+        if (!runs.empty() && runs.back().level == level) {
+            runs.back().start = static_cast<uint32_t>(i);
+        } else {
+            runs.push_back({static_cast<uint32_t>(i), static_cast<uint32_t>(i + 1), level});
+        }
+    }
+    std::reverse(runs.begin(), runs.end());
+
+    // L2: reverse every sequence at or above each odd level, highest first
+    uint8_t highest = 0;
+    uint8_t lowestOdd = MAX_DEPTH + 2;
+    for (const Run& run : runs) {
+        highest = std::max(highest, run.level);
+        if (run.level & 1) {
+            lowestOdd = std::min(lowestOdd, run.level);
+        }
+    }
+    for (uint8_t level = highest; level >= lowestOdd && level > 0; --level) {
+        for (size_t i = 0; i < runs.size();) {
+            if (runs[i].level < level) {
+                ++i;
+                continue;
+            }
+            size_t runEnd = i;
+            while (runEnd < runs.size() && runs[runEnd].level >= level) {
+                ++runEnd;
+            }
+            std::reverse(runs.begin() + static_cast<std::ptrdiff_t>(i), runs.begin() + static_cast<std::ptrdiff_t>(runEnd));
+            i = runEnd;
+        }
+    }
+}
+
+} // namespace dakt::gui
@@ -0,0 +1,240 @@
+#include "dakt/gui/subsystems/text/CoverageRasterizer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DAKTLIB_COVERAGE_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DAKTLIB_COVERAGE_NEON 1
+#endif
+
+namespace dakt::gui {
+
+// Slack past the last row: a line at the right edge writes one cell beyond it
+static constexpr size_t AREA_SLACK = 4;
+
+SDFGlyphBitmap CoverageRasterizer::rasterize(const GlyphOutlineView& outline, float fontSize, int16_t unitsPerEm, float offsetX) {
+    SDFGlyphBitmap result;
+    const float scale = fontSize / static_cast<float>(unitsPerEm);
+    result.advanceWidth = outline.advanceWidth * scale;
+
+    if (outline.contourCount == 0 || outline.pointCount == 0) {
+        // Empty glyph (e.g., space)
+        result.width = 1;
+        result.height = 1;
+        result.pixels.resize(1, 0);
+        return result;
+    }
+
+    // Whole-pixel box around the outline; bitmap y grows downward from its top
+    const float left = std::floor(outline.xMin * scale + offsetX);
+    const float top = std::ceil(outline.yMax * scale);
+    width_ = std::max(1u, static_cast<uint32_t>(std::ceil(outline.xMax * scale + offsetX) - left));
+    height_ = std::max(1u, static_cast<uint32_t>(top - std::floor(outline.yMin * scale)));
+    area_.assign(static_cast<size_t>(width_) * height_ + AREA_SLACK, 0.0f);
+
+    auto toBitmap = [&](const GlyphPoint& point) { return Vec2(point.x * scale + offsetX - left, top - point.y * scale); };
+
+    // TrueType contours: quadratic curves with implied on-curve points between consecutive off-curve points
+    uint16_t start = 0;
+    for (uint16_t c = 0; c < outline.contourCount; ++c) {
+        const GlyphPoint* points = outline.points + start;
+        const size_t n = outline.contourEnds[c] - start;
+        start = outline.contourEnds[c];
+        if (n < 2)
+            continue;
+
+        // Start on an on-curve point; a contour of only off-curve points starts between its last and first
+        size_t first = 0;
+        while (first < n && !points[first].onCurve) {
+            ++first;
+        }
+        const Vec2 origin = first < n ? toBitmap(points[first]) : (toBitmap(points[n - 1]) + toBitmap(points[0])) * 0.5f;
+        if (first == n) {
+            first = n - 1;
+        }
+
+        Vec2 current = origin;
+        Vec2 control;
+        bool hasControl = false;
+        for (size_t k = 1; k <= n; ++k) {
+            const GlyphPoint& point = points[(first + k) % n];
+            const Vec2 p = toBitmap(point);
+            if (point.onCurve) {
+                if (hasControl) {
+                    drawQuadratic(current, control, p);
+                } else {
+                    drawLine(current, p);
+                }
+                current = p;
+                hasControl = false;
+            } else {
+                if (hasControl) {
+                    const Vec2 implied = (control + p) * 0.5f;
+                    drawQuadratic(current, control, implied);
+                    current = implied;
+                }
+                control = p;
+                hasControl = true;
+            }
+        }
+
+        // Only an all-off-curve contour ends away from its start
+        if (hasControl) {
+            drawQuadratic(current, control, origin);
+        } else if (current != origin) {
+            drawLine(current, origin);
+        }
+    }
+
+    result.width = width_;
+    result.height = height_;
+    result.channels = 1;
+    result.bearingX = left;
+    result.bearingY = top;
+    result.pixels.resize(static_cast<size_t>(width_) * height_);
+    accumulate(result.pixels.data(), result.pixels.size());
+    return result;
+}
+
+void CoverageRasterizer::drawLine(Vec2 p0, Vec2 p1) {
+    if (p0.y == p1.y)
+        return;
+
+    // Walk downward; the sign records which way the edge winds
+    const float direction = p0.y < p1.y ? 1.0f : -1.0f;
+    if (p0.y > p1.y) {
+        std::swap(p0, p1);
+    }
+    if (p1.y <= 0.0f || p0.y >= static_cast<float>(height_))
+        return;
+
+    const float dxdy = (p1.x - p0.x) / (p1.y - p0.y);
+    float x = p0.x;
+    if (p0.y < 0.0f) {
+        x -= p0.y * dxdy;
+    }
+
+    const float maxX = static_cast<float>(width_);
+    const uint32_t yStart = static_cast<uint32_t>(std::max(p0.y, 0.0f));
+    const uint32_t yEnd = std::min(height_, static_cast<uint32_t>(std::ceil(p1.y)));
+    for (uint32_t y = yStart; y < yEnd; ++y) {
+        float* row = area_.data() + static_cast<size_t>(y) * width_;
+        const float dy = std::min(static_cast<float>(y + 1), p1.y) - std::max(static_cast<float>(y), p0.y);
+        const float xNext = x + dxdy * dy;
+        const float d = dy * direction;
+
+        const float x0 = std::clamp(std::min(x, xNext), 0.0f, maxX);
+        const float x1 = std::clamp(std::max(x, xNext), 0.0f, maxX);
+        const float x0Floor = std::floor(x0);
+        const float x1Ceil = std::ceil(x1);
+        const int x0i = static_cast<int>(x0Floor);
+        const int x1i = static_cast<int>(x1Ceil);
+
+        if (x1i <= x0i + 1) {
+            // Within one pixel: split by where the segment's midpoint falls
+            const float xm = 0.5f * (x0 + x1) - x0Floor;
+            row[x0i] += d - d * xm;
+            row[x0i + 1] += d * xm;
+        } else {
+            // Across several pixels: a triangle at each end, even steps between
+            const float s = 1.0f / (x1 - x0);
+            const float x0f = x0 - x0Floor;
+            const float a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+            const float x1f = x1 - x1Ceil + 1.0f;
+            const float am = 0.5f * s * x1f * x1f;
+            row[x0i] += d * a0;
+            if (x1i == x0i + 2) {
+                row[x0i + 1] += d * (1.0f - a0 - am);
+            } else {
+                const float a1 = s * (1.5f - x0f);
+                row[x0i + 1] += d * (a1 - a0);
+                for (int xi = x0i + 2; xi < x1i - 1; ++xi) {
+                    row[xi] += d * s;
+                }
+                const float a2 = a1 + static_cast<float>(x1i - x0i - 3) * s;
+                row[x1i - 1] += d * (1.0f - a2 - am);
+            }
+            row[x1i] += d * am;
+        }
+        x = xNext;
+    }
+}
+
+void CoverageRasterizer::drawQuadratic(Vec2 p0, Vec2 p1, Vec2 p2) {
+    // Segment count grows with the square root of the curve's deviation from its chord
+    const float deviation = (p0 - p1 * 2.0f + p2).lengthSquared();
+    if (deviation < 0.333f) {
+        drawLine(p0, p2);
+        return;
+    }
+
+    const int segments = 1 + static_cast<int>(std::floor(std::sqrt(std::sqrt(3.0f * deviation))));
+    Vec2 previous = p0;
+    for (int i = 1; i <= segments; ++i) {
+        const float t = static_cast<float>(i) / static_cast<float>(segments);
+        const Vec2 next = i == segments ? p2 : Vec2::lerp(Vec2::lerp(p0, p1, t), Vec2::lerp(p1, p2, t), t);
+        drawLine(previous, next);
+        previous = next;
+    }
+}
+
+void CoverageRasterizer::accumulate(uint8_t* out, size_t count) const {
+    // Rows sum to zero, so one running sum over the whole buffer covers every row
+    const float* area = area_.data();
+    size_t i = 0;
+    float sum = 0.0f;
+
+#if defined(DAKTLIB_COVERAGE_SSE2)
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 full = _mm_set1_ps(255.0f);
+    __m128 offset = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        // In-register prefix sum of four cells, then add the total so far
+        __m128 x = _mm_loadu_ps(area + i);
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+        x = _mm_add_ps(x, offset);
+
+        const __m128 coverage = _mm_mul_ps(_mm_min_ps(_mm_andnot_ps(signBit, x), one), full);
+        __m128i bytes = _mm_cvtps_epi32(coverage);
+        bytes = _mm_packs_epi32(bytes, bytes);
+        bytes = _mm_packus_epi16(bytes, bytes);
+        const int32_t packed = _mm_cvtsi128_si32(bytes);
+        std::memcpy(out + i, &packed, 4);
+
+        offset = _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    sum = _mm_cvtss_f32(offset);
+#elif defined(DAKTLIB_COVERAGE_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    float32x4_t offset = zero;
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(area + i);
+        x = vaddq_f32(x, vextq_f32(zero, x, 3));
+        x = vaddq_f32(x, vextq_f32(zero, x, 2));
+        x = vaddq_f32(x, offset);
+
+        const uint32x4_t coverage = vcvtnq_u32_f32(vmulq_n_f32(vminq_f32(vabsq_f32(x), one), 255.0f));
+        const uint16x4_t narrow = vmovn_u32(coverage);
+        const uint8x8_t bytes = vmovn_u16(vcombine_u16(narrow, narrow));
+        const uint32_t packed = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+        std::memcpy(out + i, &packed, 4);
+
+        offset = vdupq_laneq_f32(x, 3);
+    }
+    sum = vgetq_lane_f32(offset, 0);
+#endif
+
+    for (; i < count; ++i) {
+        sum += area[i];
+        out[i] = static_cast<uint8_t>(std::lround(std::min(std::abs(sum), 1.0f) * 255.0f));
+    }
+}
+
+} // namespace dakt::gui
@@ -3,48 +3,95 @@
 
 namespace dakt::gui {
 
-Font::Font() = default;
+static uint64_t fnv1a64(const void* data, size_t len) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+Font::Font() { buildFallbackGlyphs(); }
 
 Font::~Font() = default;
 
 bool Font::loadFromFile(const std::string& filePath) {
-    // Stub implementation
-    familyName_ = "Arial";
-    fullName_ = "Arial Regular";
-    return false;
+    auto parser = std::make_unique<TTFParser>();
+    if (!parser->loadFromFile(filePath)) {
+        // Keep the built-in fallback metrics
+        familyName_ = "Arial";
+        fullName_ = "Arial Regular";
+        return false;
+    }
+
+    filePath_ = filePath;
+    adoptParser(std::move(parser));
+    return true;
 }
 
 bool Font::loadFromMemory(const uint8_t* data, size_t size) {
-    // Stub implementation
-    familyName_ = "Arial";
-    fullName_ = "Arial Regular";
-    return false;
+    auto parser = std::make_unique<TTFParser>();
+    if (!parser->loadFromMemory(data, size)) {
+        // Keep the built-in fallback metrics
+        familyName_ = "Arial";
+        fullName_ = "Arial Regular";
+        return false;
+    }
+
+    adoptParser(std::move(parser));
+    return true;
 }
 
-uint16_t Font::getGlyphId(uint32_t codepoint) const {
-    // Stub: return simple mapping
-    return (codepoint >= 32 && codepoint < 127) ? (codepoint - 32) : 0;
+void Font::adoptParser(std::unique_ptr<TTFParser> parser) {
+    parser_ = std::move(parser);
+    familyName_ = parser_->getFamilyName();
+    fullName_ = parser_->getFullName();
+
+    unitsPerEm_ = parser_->getFontMetrics().unitsPerEm;
+    ascender_ = parser_->getHorizontalMetrics().ascender;
+    descender_ = parser_->getHorizontalMetrics().descender;
+    lineGap_ = parser_->getHorizontalMetrics().lineGap;
+    contentHash_ = fnv1a64(parser_->getFontData().data(), parser_->getFontData().size());
+
+    // Dense metrics from the parser's hmtx and glyf arrays
+    glyphs_.resize(parser_->getGlyphCount());
+    for (uint16_t glyphId = 0; glyphId < glyphs_.size(); ++glyphId) {
+        const GlyphBounds bounds = parser_->getGlyphBounds(glyphId);
+        Glyph& glyph = glyphs_[glyphId];
+        glyph.glyphID = glyphId;
+        glyph.advanceWidth = parser_->getAdvanceWidth(glyphId);
+        glyph.leftSideBearing = parser_->getLeftSideBearing(glyphId);
+        glyph.xMin = bounds.xMin;
+        glyph.yMin = bounds.yMin;
+        glyph.xMax = bounds.xMax;
+        glyph.yMax = bounds.yMax;
+    }
 }
 
-const Glyph* Font::getGlyph(uint16_t glyphId) const {
-    auto& glyphCache = const_cast<std::unordered_map<uint16_t, Glyph>&>(glyphCache_);
-    auto it = glyphCache.find(glyphId);
-    if (it != glyphCache.end()) {
-        return &it->second;
+void Font::buildFallbackGlyphs() {
+    // One stub glyph per printable ASCII character (see getGlyphId)
+    glyphs_.resize(95);
+    for (uint16_t glyphId = 0; glyphId < glyphs_.size(); ++glyphId) {
+        Glyph& glyph = glyphs_[glyphId];
+        glyph.glyphID = glyphId;
+        glyph.advanceWidth = 500;
+        glyph.leftSideBearing = 50;
+        glyph.xMin = 0;
+        glyph.yMin = -200;
+        glyph.xMax = 450;
+        glyph.yMax = 800;
     }
+}
 
-    Glyph glyph;
-    glyph.glyphID = glyphId;
-    glyph.advanceWidth = 500;
-    glyph.leftSideBearing = 50;
-    glyph.xMin = 0;
-    glyph.yMin = -200;
-    glyph.xMax = 450;
-    glyph.yMax = 800;
-
-    auto& cached = glyphCache[glyphId];
-    cached = glyph;
-    return &cached;
+uint16_t Font::getGlyphId(uint32_t codepoint) const {
+    if (parser_) {
+        return parser_->getGlyphId(codepoint);
+    }
+
+    // Stub: return simple mapping
+    return (codepoint >= 32 && codepoint < 127) ? (codepoint - 32) : 0;
 }
 
 float Font::pixelsFromUnits(float units, float fontSize) const {
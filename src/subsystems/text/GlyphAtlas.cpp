@@ -1,5 +1,7 @@
 #include "dakt/gui/subsystems/text/GlyphAtlas.hpp"
+#include "dakt/gui/subsystems/text/CoverageRasterizer.hpp"
 #include "dakt/gui/subsystems/text/Font.hpp"
+#include "dakt/gui/subsystems/text/GlyphAtlasCache.hpp"
 #include "dakt/gui/subsystems/text/SDFGenerator.hpp"
 #include "dakt/gui/subsystems/text/TTFParser.hpp"
 #include <algorithm>
@@ -120,134 +122,293 @@ class SkylinePacker {
 // GlyphAtlas Implementation
 // ============================================================================
 
+// Pixels left empty between glyphs so bilinear filtering never samples a neighbour
+static constexpr uint32_t GLYPH_GUTTER = 1;
+
 GlyphAtlas::GlyphAtlas(uint32_t pageWidth, uint32_t pageHeight) : pageWidth_(pageWidth), pageHeight_(pageHeight) {
     // Create first page
-    pages_.emplace_back();
-    pages_[0].width = pageWidth_;
-    pages_[0].height = pageHeight_;
-    pages_[0].pixelData.resize(pageWidth_ * pageHeight_, 128); // Neutral SDF value
+    addPage(fieldMode());
 }
 
 GlyphAtlas::~GlyphAtlas() = default;
 
-static uint32_t hashFontSize(float fontSize) {
-    // Hash font size to integer for map key
-    return static_cast<uint32_t>(fontSize * 10.0f);
+// Map and cache key of a raster size, in tenths of a pixel
+static uint32_t sizeKey(float rasterSize) { return static_cast<uint32_t>(std::lround(rasterSize * 10.0f)); }
+
+static uint32_t pageChannels(GlyphRenderMode mode) { return mode == GlyphRenderMode::MSDF ? 4 : 1; }
+
+// Empty texels: the neutral distance for fields, nothing covered for coverage
+static uint8_t pageBackground(GlyphRenderMode mode) { return mode == GlyphRenderMode::Coverage ? 0 : 128; }
+
+// Subpixel offsets are kept in twelfths of a pixel, a step every phase count up to 4 divides.
+// TrueType glyph IDs are 16-bit, so the offset goes in the top byte of the map key's glyph ID
+static constexpr uint32_t SUBPIXEL_UNITS = 12;
+static constexpr uint32_t SUBPIXEL_SHIFT = 24;
+
+static uint32_t subpixelOffset(uint32_t variantID) { return variantID >> SUBPIXEL_SHIFT; }
+
+// Coverage bitmaps do not depend on the spread, so their cache files ignore it
+static AtlasCacheKey makeCacheKey(const Font& font, uint32_t sizeKey, uint32_t spread, GlyphRenderMode mode) {
+    return AtlasCacheKey{font.getContentHash(), sizeKey, mode == GlyphRenderMode::Coverage ? 0 : spread, static_cast<uint32_t>(mode)};
+}
+
+void GlyphAtlas::addPage(GlyphRenderMode mode) {
+    AtlasPage page;
+    page.width = pageWidth_;
+    page.height = pageHeight_;
+    page.channels = pageChannels(mode);
+    page.renderMode = mode;
+    page.pixelData.resize(static_cast<size_t>(pageWidth_) * pageHeight_ * page.channels, pageBackground(mode));
+    pages_.push_back(std::move(page));
+    packers_.push_back(std::make_unique<SkylinePacker>(pageWidth_, pageHeight_));
+}
+
+void GlyphAtlas::setMSDF(bool enabled) {
+    if (enabled == enableMSDF_) {
+        return;
+    }
+    enableMSDF_ = enabled;
+
+    // Pages change channel count; start over with one empty page
+    glyphMap_.clear();
+    fontIDs_.clear();
+    codepoints_.clear();
+    variantCount_ = 0;
+    pages_.clear();
+    packers_.clear();
+    addPage(fieldMode());
+}
+
+void GlyphAtlas::setSubpixelPolicy(const SubpixelPolicy& policy) {
+    subpixel_ = policy;
+    subpixel_.phases = std::clamp(policy.phases, 1u, 4u);
+}
+
+uint32_t GlyphAtlas::variantID(uint32_t glyphID, GlyphRenderMode mode, uint32_t phase) const {
+    // Distance fields render at any offset; only coverage bitmaps need variants
+    if (mode != GlyphRenderMode::Coverage || phase == 0)
+        return glyphID;
+    const uint32_t offset = std::min(phase, subpixel_.phases - 1) * SUBPIXEL_UNITS / subpixel_.phases;
+    return glyphID | offset << SUBPIXEL_SHIFT;
+}
+
+uint32_t GlyphAtlas::registerFont(const Font& font) { return fontIDs_.try_emplace(font.getContentHash(), static_cast<uint32_t>(fontIDs_.size())).first->second; }
+
+bool GlyphAtlas::findFont(const Font& font, uint32_t& outFontID) const {
+    auto it = fontIDs_.find(font.getContentHash());
+    if (it == fontIDs_.end())
+        return false;
+    outFontID = it->second;
+    return true;
+}
+
+GlyphRenderMode GlyphAtlas::getRenderMode(float fontSize) const { return fontSize < sizeBuckets_.coverageBelow ? GlyphRenderMode::Coverage : fieldMode(); }
+
+float GlyphAtlas::getRasterSize(float fontSize) const {
+    if (fontSize < sizeBuckets_.coverageBelow)
+        return std::max(1.0f, std::round(fontSize)); // Coverage does not scale cleanly
+
+    const float exactLimit = std::max(sizeBuckets_.exactBelow, sizeBuckets_.referenceSize / static_cast<float>(std::max(sdfSpread_, 1u)));
+    if (fontSize < exactLimit)
+        return std::max(1.0f, std::round(fontSize));
+
+    float reference = sizeBuckets_.referenceSize;
+    while (fontSize > reference * sizeBuckets_.maxMagnification && reference * 2.0f <= sizeBuckets_.maxReferenceSize) {
+        reference *= 2.0f;
+    }
+    return reference;
 }
 
-bool GlyphAtlas::addGlyph(Font& font, uint32_t glyphID, float fontSize) {
-    auto key = std::make_pair(glyphID, hashFontSize(fontSize));
+bool GlyphAtlas::addGlyph(Font& font, uint32_t glyphID, float fontSize, uint32_t phase) {
+    const float rasterSize = getRasterSize(fontSize);
+    const GlyphRenderMode mode = getRenderMode(fontSize);
+    const uint32_t id = variantID(glyphID, mode, phase);
+    const GlyphKey key{registerFont(font), id, sizeKey(rasterSize)};
     if (glyphMap_.find(key) != glyphMap_.end()) {
         return true; // Already in atlas
     }
+    if (id != glyphID && variantCount_ >= subpixel_.maxVariants)
+        return false; // Out of variants; the caller snaps to whole pixels
 
-    // Get glyph outline from font's parser
     const Glyph* glyph = font.getGlyph(static_cast<uint16_t>(glyphID));
     if (!glyph)
         return false;
 
-    // Generate SDF bitmap
+    // A glyph rasterized by an earlier run needs no work beyond the copy
+    const AtlasCacheKey cacheKey = makeCacheKey(font, key.sizeKey, sdfSpread_, mode);
+    AtlasCacheRecord metrics;
+    if (cache_) {
+        if (const uint8_t* pixels = cache_->find(cacheKey, id, metrics)) {
+            return placeGlyph(key.fontID, id, rasterSize, mode, metrics, pixels);
+        }
+    }
+
     SDFGenerator generator;
     generator.setSpread(static_cast<float>(sdfSpread_));
     generator.setMode(enableMSDF_ ? SDFMode::MSDF : SDFMode::SDF);
 
-    // We need access to the outline - get it through the font
-    // For now, create a simple outline from glyph metrics
-    GlyphOutline outline;
-    outline.xMin = glyph->xMin;
-    outline.yMin = glyph->yMin;
-    outline.xMax = glyph->xMax;
-    outline.yMax = glyph->yMax;
-    outline.advanceWidth = glyph->advanceWidth;
-    outline.leftSideBearing = glyph->leftSideBearing;
-
-    // Note: Real implementation would get full contour data from TTFParser
-    // For now, just allocate space in atlas
-
-    float scale = fontSize / static_cast<float>(font.getUnitsPerEm());
-    uint32_t glyphWidth = static_cast<uint32_t>(std::ceil((glyph->xMax - glyph->xMin) * scale)) + sdfSpread_ * 2 + 2;
-    uint32_t glyphHeight = static_cast<uint32_t>(std::ceil((glyph->yMax - glyph->yMin) * scale)) + sdfSpread_ * 2 + 2;
-
-    if (glyphWidth < 1)
-        glyphWidth = 1;
-    if (glyphHeight < 1)
-        glyphHeight = 1;
-
-    // Try to pack into existing pages
-    uint32_t packX, packY;
-    uint32_t pageIdx = 0;
-    bool packed = false;
-
-    for (pageIdx = 0; pageIdx < static_cast<uint32_t>(pages_.size()); ++pageIdx) {
-        if (packGlyph(glyphWidth, glyphHeight, packX, packY)) {
-            packed = true;
-            break;
+    SDFGlyphBitmap bitmap;
+    const TTFParser* parser = font.getParser();
+    if (mode == GlyphRenderMode::Coverage) {
+        GlyphOutlineView outline;
+        if (parser) {
+            outline = parser->getGlyphOutline(static_cast<uint16_t>(glyphID));
+        } else {
+            outline.advanceWidth = glyph->advanceWidth;
         }
+        const float offsetX = static_cast<float>(subpixelOffset(id)) / static_cast<float>(SUBPIXEL_UNITS);
+        bitmap = CoverageRasterizer().rasterize(outline, rasterSize, font.getUnitsPerEm(), offsetX);
+    } else if (parser) {
+        bitmap = generator.generate(parser->getGlyphOutline(static_cast<uint16_t>(glyphID)), rasterSize, font.getUnitsPerEm());
+    } else {
+        // Fallback metrics have no outline; the glyph gets an empty cell
+        GlyphOutline outline;
+        outline.advanceWidth = glyph->advanceWidth;
+        bitmap = generator.generate(outline, rasterSize, font.getUnitsPerEm());
+    }
+    if (bitmap.width > UINT16_MAX || bitmap.height > UINT16_MAX)
+        return false;
+
+    metrics.glyphID = id;
+    metrics.width = static_cast<uint16_t>(bitmap.width);
+    metrics.height = static_cast<uint16_t>(bitmap.height);
+    metrics.channels = static_cast<uint16_t>(bitmap.channels);
+    metrics.advanceWidth = bitmap.advanceWidth;
+    metrics.bearingX = bitmap.bearingX;
+    metrics.bearingY = bitmap.bearingY;
+
+    if (!placeGlyph(key.fontID, id, rasterSize, mode, metrics, bitmap.pixels.data()))
+        return false;
+
+    if (cache_) {
+        cache_->store(cacheKey, metrics, bitmap.pixels.data());
     }
+    return true;
+}
 
-    if (!packed) {
-        // Create new page
-        AtlasPage newPage;
-        newPage.width = pageWidth_;
-        newPage.height = pageHeight_;
-        newPage.pixelData.resize(pageWidth_ * pageHeight_, 128);
-        pages_.push_back(newPage);
-
-        // Reset packer for new page
-        packRects_.clear();
-        if (!packGlyph(glyphWidth, glyphHeight, packX, packY)) {
-            return false; // Glyph too large for page
+bool GlyphAtlas::placeGlyph(uint32_t fontID, uint32_t variantID, float rasterSize, GlyphRenderMode mode, const AtlasCacheRecord& metrics, const uint8_t* pixels) {
+    uint32_t pageIdx, packX, packY;
+    if (!packGlyph(metrics.width + GLYPH_GUTTER, metrics.height + GLYPH_GUTTER, mode, pageIdx, packX, packY))
+        return false; // Glyph too large for page
+
+    // Single-channel bitmaps copy row by row; MSDF's RGB is widened to RGBA
+    AtlasPage& page = pages_[pageIdx];
+    for (uint32_t y = 0; y < metrics.height; ++y) {
+        const uint8_t* src = pixels + static_cast<size_t>(y) * metrics.width * metrics.channels;
+        uint8_t* dst = page.pixelData.data() + (static_cast<size_t>(packY + y) * page.width + packX) * page.channels;
+        if (metrics.channels == page.channels) {
+            std::memcpy(dst, src, static_cast<size_t>(metrics.width) * metrics.channels);
+            continue;
+        }
+        for (uint32_t x = 0; x < metrics.width; ++x) {
+            for (uint32_t c = 0; c < page.channels; ++c) {
+                dst[x * page.channels + c] = c < metrics.channels ? src[x * metrics.channels + c] : (metrics.channels == 1 ? src[x] : 255);
+            }
         }
-        pageIdx = static_cast<uint32_t>(pages_.size()) - 1;
     }
 
-    // Create atlas glyph entry
     AtlasGlyph atlasGlyph;
-    atlasGlyph.glyphID = glyphID;
-    atlasGlyph.fontSize = fontSize;
+    atlasGlyph.glyphID = variantID;
+    atlasGlyph.fontSize = rasterSize;
     atlasGlyph.atlasX = static_cast<float>(packX) / pageWidth_;
     atlasGlyph.atlasY = static_cast<float>(packY) / pageHeight_;
-    atlasGlyph.atlasWidth = static_cast<float>(glyphWidth) / pageWidth_;
-    atlasGlyph.atlasHeight = static_cast<float>(glyphHeight) / pageHeight_;
-    atlasGlyph.advanceWidth = glyph->advanceWidth * scale;
-    atlasGlyph.bearingX = glyph->leftSideBearing * scale;
-    atlasGlyph.bearingY = glyph->yMax * scale;
-    atlasGlyph.width = static_cast<float>(glyphWidth);
-    atlasGlyph.height = static_cast<float>(glyphHeight);
+    atlasGlyph.atlasWidth = static_cast<float>(metrics.width) / pageWidth_;
+    atlasGlyph.atlasHeight = static_cast<float>(metrics.height) / pageHeight_;
+    atlasGlyph.advanceWidth = metrics.advanceWidth;
+    atlasGlyph.bearingX = metrics.bearingX;
+    atlasGlyph.bearingY = metrics.bearingY;
+    atlasGlyph.width = static_cast<float>(metrics.width);
+    atlasGlyph.height = static_cast<float>(metrics.height);
     atlasGlyph.pageIndex = pageIdx;
 
-    glyphMap_[key] = atlasGlyph;
-
+    if (glyphMap_.insert_or_assign(GlyphKey{fontID, variantID, sizeKey(rasterSize)}, atlasGlyph).second && subpixelOffset(variantID) != 0) {
+        ++variantCount_;
+    }
     return true;
 }
 
-bool GlyphAtlas::hasGlyph(uint32_t glyphID, float fontSize) const {
-    auto key = std::make_pair(glyphID, hashFontSize(fontSize));
-    return glyphMap_.find(key) != glyphMap_.end();
+size_t GlyphAtlas::loadFromCache(Font& font) {
+    if (!cache_ || font.getContentHash() == 0)
+        return 0;
+
+    const uint32_t fontID = registerFont(font);
+    size_t added = 0;
+    for (const AtlasCacheKey& key : cache_->findKeys(font.getContentHash())) {
+        const float rasterSize = static_cast<float>(key.sizeBucket) / 10.0f;
+        const GlyphRenderMode mode = getRenderMode(rasterSize);
+        if (key.mode != static_cast<uint32_t>(mode) || key.spread != (mode == GlyphRenderMode::Coverage ? 0 : sdfSpread_))
+            continue;
+
+        cache_->forEach(key, [&](const AtlasCacheRecord& record, const uint8_t* pixels) {
+            // Variants for another phase count would never be drawn
+            const uint32_t offset = subpixelOffset(record.glyphID);
+            if (offset != 0 && (offset * subpixel_.phases % SUBPIXEL_UNITS != 0 || variantCount_ >= subpixel_.maxVariants))
+                return;
+            if (glyphMap_.find(GlyphKey{fontID, record.glyphID, key.sizeBucket}) == glyphMap_.end() && placeGlyph(fontID, record.glyphID, rasterSize, mode, record, pixels)) {
+                ++added;
+            }
+        });
+    }
+    return added;
+}
+
+const AtlasGlyph* GlyphAtlas::findGlyph(uint32_t fontID, uint32_t glyphID, float fontSize, uint32_t phase) const {
+    auto it = glyphMap_.find(GlyphKey{fontID, variantID(glyphID, getRenderMode(fontSize), phase), sizeKey(getRasterSize(fontSize))});
+    return it != glyphMap_.end() ? &it->second : nullptr;
+}
+
+bool GlyphAtlas::hasGlyph(const Font& font, uint32_t glyphID, float fontSize, uint32_t phase) const {
+    uint32_t fontID;
+    return findFont(font, fontID) && findGlyph(fontID, glyphID, fontSize, phase);
 }
 
-const AtlasGlyph& GlyphAtlas::getGlyph(uint32_t glyphID, float fontSize) const {
-    static AtlasGlyph empty{};
-    auto key = std::make_pair(glyphID, hashFontSize(fontSize));
-    auto it = glyphMap_.find(key);
-    if (it != glyphMap_.end()) {
-        return it->second;
+AtlasGlyph GlyphAtlas::getGlyph(const Font& font, uint32_t glyphID, float fontSize, uint32_t phase) const {
+    uint32_t fontID;
+    return scaledGlyph(findFont(font, fontID) ? findGlyph(fontID, glyphID, fontSize, phase) : nullptr, glyphID, fontSize);
+}
+
+bool GlyphAtlas::hasGlyph(uint32_t glyphID, float fontSize, uint32_t phase) const { return findGlyph(0, glyphID, fontSize, phase) != nullptr; }
+
+AtlasGlyph GlyphAtlas::getGlyph(uint32_t glyphID, float fontSize, uint32_t phase) const { return scaledGlyph(findGlyph(0, glyphID, fontSize, phase), glyphID, fontSize); }
+
+AtlasGlyph GlyphAtlas::scaledGlyph(const AtlasGlyph* found, uint32_t glyphID, float fontSize) const {
+    if (!found) {
+        return AtlasGlyph{};
     }
-    return empty;
+
+    // Draw the shared rasterization scaled; texture coordinates stay as they are
+    AtlasGlyph glyph = *found;
+    const float scale = fontSize / glyph.fontSize;
+    glyph.glyphID = glyphID;
+    glyph.fontSize = fontSize;
+    glyph.advanceWidth *= scale;
+    glyph.bearingX *= scale;
+    glyph.bearingY *= scale;
+    glyph.width *= scale;
+    glyph.height *= scale;
+    return glyph;
 }
 
 void GlyphAtlas::clear() {
     glyphMap_.clear();
-    packRects_.clear();
-
-    // Reset pages to initial state
-    for (auto& page : pages_) {
-        std::fill(page.pixelData.begin(), page.pixelData.end(), static_cast<uint8_t>(128));
+    fontIDs_.clear();
+    codepoints_.clear();
+    variantCount_ = 0;
+
+    // Keep only first page, reset to initial state
+    pages_.resize(1);
+    packers_.resize(1);
+    if (pages_[0].renderMode != fieldMode()) {
+        pages_.clear();
+        packers_.clear();
+        addPage(fieldMode());
+        return;
     }
-
-    // Keep only first page
-    if (pages_.size() > 1) {
-        pages_.resize(1);
+    std::fill(pages_[0].pixelData.begin(), pages_[0].pixelData.end(), pageBackground(pages_[0].renderMode));
+    if (packers_[0]) {
+        packers_[0]->reset();
+    } else {
+        packers_[0] = std::make_unique<SkylinePacker>(pageWidth_, pageHeight_);
     }
 }
 
@@ -256,10 +417,7 @@ void GlyphAtlas::regenerate(Font& font, float fontSize) {
 
     // Add all common ASCII glyphs
     for (uint32_t codepoint = 32; codepoint < 127; ++codepoint) {
-        uint16_t glyphId = font.getGlyphId(codepoint);
-        if (glyphId > 0) {
-            addGlyph(font, glyphId, fontSize);
-        }
+        addCodepoint(font, codepoint, fontSize);
     }
 }
 
@@ -267,124 +425,258 @@ void GlyphAtlas::regenerate(Font& font, float fontSize) {
 // Packing
 // ============================================================================
 
-bool GlyphAtlas::packGlyph(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY) {
-    // Simple row-based packing (could be upgraded to skyline later)
-    static uint32_t currentX = 0;
-    static uint32_t currentY = 0;
-    static uint32_t rowHeight = 0;
-
-    if (currentX + width > pageWidth_) {
-        // Move to next row
-        currentX = 0;
-        currentY += rowHeight;
-        rowHeight = 0;
-    }
-
-    if (currentY + height > pageHeight_) {
-        // Page full
-        currentX = 0;
-        currentY = 0;
-        rowHeight = 0;
+bool GlyphAtlas::packGlyph(uint32_t width, uint32_t height, GlyphRenderMode mode, uint32_t& outPage, uint32_t& outX, uint32_t& outY) {
+    if (width > pageWidth_ || height > pageHeight_)
         return false;
-    }
 
-    outX = currentX;
-    outY = currentY;
-    currentX += width;
-    rowHeight = std::max(rowHeight, height);
+    // Earlier pages still take small glyphs that fit in their gaps
+    for (uint32_t pageIdx = 0; pageIdx < static_cast<uint32_t>(pages_.size()); ++pageIdx) {
+        if (packers_[pageIdx] && pages_[pageIdx].renderMode == mode && packers_[pageIdx]->pack(width, height, outX, outY)) {
+            outPage = pageIdx;
+            return true;
+        }
+    }
 
-    return true;
+    addPage(mode);
+    outPage = static_cast<uint32_t>(pages_.size()) - 1;
+    return packers_.back()->pack(width, height, outX, outY);
 }
 
 // ============================================================================
 // File I/O
 // ============================================================================
 
-// .daktfont file format:
-// Header: "DAKTFONT" (8 bytes)
-// Version: uint32_t
-// Page count: uint32_t
-// Glyph count: uint32_t
-// Page width: uint32_t
-// Page height: uint32_t
-// SDF spread: uint32_t
-// [Pages]: For each page: raw pixel data
-// [Glyphs]: For each glyph: AtlasGlyph struct
+// .daktfont file format (version 3):
+// Header: BakedAtlasHeader
+// [Glyphs]: glyphCount AtlasGlyph entries, ordered by (glyph ID, size); the top byte of a
+//           subpixel variant's glyph ID is its offset in twelfths of a pixel
+// [Characters]: codepointCount (codepoint, glyph ID) uint32_t pairs, ordered by codepoint
+// [Page modes]: pageCount uint32_t GlyphRenderMode values
+// [Pages]: pageWidth * pageHeight * (4 for MSDF pages, else 1) bytes each
+// channels is that of the distance field pages (1 or 4)
+// dataHash is FNV-1a over everything after the header
+
+static constexpr uint32_t BAKED_ATLAS_VERSION = 3;
+
+struct BakedAtlasHeader {
+    char magic[8] = {'D', 'A', 'K', 'T', 'F', 'O', 'N', 'T'};
+    uint32_t version = BAKED_ATLAS_VERSION;
+    uint32_t pageCount = 0;
+    uint32_t pageWidth = 0;
+    uint32_t pageHeight = 0;
+    uint32_t channels = 0;
+    uint32_t sdfSpread = 0;
+    uint32_t glyphCount = 0;
+    uint32_t codepointCount = 0;
+    uint64_t fontHash = 0;
+    int16_t unitsPerEm = 0;
+    int16_t ascender = 0;
+    int16_t descender = 0;
+    int16_t lineGap = 0;
+    uint64_t dataHash = 0;
+};
 
-bool GlyphAtlas::saveToFile(const std::string& filePath) const {
-    std::ofstream file(filePath, std::ios::binary);
-    if (!file.is_open())
+static_assert(sizeof(BakedAtlasHeader) == 64, "baked atlas header layout is part of the file format");
+static_assert(sizeof(AtlasGlyph) == 48, "AtlasGlyph layout is part of the baked atlas format");
+
+static uint64_t fnv1a64(const void* data, size_t len) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool GlyphAtlas::addCodepoint(Font& font, uint32_t codepoint, float fontSize) {
+    uint32_t fontID = 0;
+    if (!fontIDs_.empty() && (!findFont(font, fontID) || fontID != 0))
+        return false; // The character map belongs to the first font only
+
+    const uint16_t glyphId = font.getGlyphId(codepoint);
+    if (glyphId == 0 || !addGlyph(font, glyphId, fontSize))
         return false;
 
-    // Header
-    const char magic[] = "DAKTFONT";
-    file.write(magic, 8);
+    codepoints_[codepoint] = glyphId;
+    return true;
+}
 
-    uint32_t version = 1;
-    uint32_t pageCount = static_cast<uint32_t>(pages_.size());
-    uint32_t glyphCount = static_cast<uint32_t>(glyphMap_.size());
+uint32_t GlyphAtlas::findGlyphId(uint32_t codepoint) const {
+    auto it = codepoints_.find(codepoint);
+    return it != codepoints_.end() ? it->second : 0;
+}
 
-    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
-    file.write(reinterpret_cast<const char*>(&pageCount), sizeof(pageCount));
-    file.write(reinterpret_cast<const char*>(&glyphCount), sizeof(glyphCount));
-    file.write(reinterpret_cast<const char*>(&pageWidth_), sizeof(pageWidth_));
-    file.write(reinterpret_cast<const char*>(&pageHeight_), sizeof(pageHeight_));
-    file.write(reinterpret_cast<const char*>(&sdfSpread_), sizeof(sdfSpread_));
+void GlyphAtlas::setFontInfo(const Font& font) {
+    fontInfo_.fontHash = font.getContentHash();
+    fontInfo_.unitsPerEm = font.getUnitsPerEm();
+    fontInfo_.ascender = font.getAscender();
+    fontInfo_.descender = font.getDescender();
+    fontInfo_.lineGap = font.getLineGap();
+}
 
-    // Write pages
+bool GlyphAtlas::saveToMemory(std::vector<uint8_t>& out) const {
+    if (fontIDs_.size() > 1)
+        return false; // Glyph entries have no font ID
+
+    BakedAtlasHeader header;
+    header.pageCount = static_cast<uint32_t>(pages_.size());
+    header.pageWidth = pageWidth_;
+    header.pageHeight = pageHeight_;
+    header.channels = enableMSDF_ ? 4 : 1;
+    header.sdfSpread = sdfSpread_;
+    header.glyphCount = static_cast<uint32_t>(glyphMap_.size());
+    header.codepointCount = static_cast<uint32_t>(codepoints_.size());
+    header.fontHash = fontInfo_.fontHash;
+    header.unitsPerEm = fontInfo_.unitsPerEm;
+    header.ascender = fontInfo_.ascender;
+    header.descender = fontInfo_.descender;
+    header.lineGap = fontInfo_.lineGap;
+
+    size_t pageBytes = 0;
     for (const auto& page : pages_) {
-        file.write(reinterpret_cast<const char*>(page.pixelData.data()), page.pixelData.size());
+        if (page.pixelData.size() != static_cast<size_t>(pageWidth_) * pageHeight_ * pageChannels(page.renderMode))
+            return false;
+        pageBytes += page.pixelData.size();
     }
 
-    // Write glyph entries
+    out.clear();
+    out.reserve(sizeof(header) + glyphMap_.size() * sizeof(AtlasGlyph) + codepoints_.size() * 8 + pages_.size() * 4 + pageBytes);
+    out.resize(sizeof(header));
+    auto append = [&](const void* data, size_t size) { out.insert(out.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size); };
+
+    // Sorted, so the same glyphs always bake to the same bytes
+    std::vector<std::pair<GlyphKey, const AtlasGlyph*>> glyphs;
+    glyphs.reserve(glyphMap_.size());
     for (const auto& [key, glyph] : glyphMap_) {
-        file.write(reinterpret_cast<const char*>(&glyph), sizeof(AtlasGlyph));
+        glyphs.emplace_back(key, &glyph);
+    }
+    std::sort(glyphs.begin(), glyphs.end(), [](const auto& a, const auto& b) { return a.first.variantID != b.first.variantID ? a.first.variantID < b.first.variantID : a.first.sizeKey < b.first.sizeKey; });
+    for (const auto& [key, glyph] : glyphs) {
+        append(glyph, sizeof(AtlasGlyph));
+    }
+    for (const auto& [codepoint, glyphId] : codepoints_) {
+        const uint32_t pair[2] = {codepoint, glyphId};
+        append(pair, sizeof(pair));
+    }
+    for (const auto& page : pages_) {
+        const uint32_t mode = static_cast<uint32_t>(page.renderMode);
+        append(&mode, sizeof(mode));
+    }
+    for (const auto& page : pages_) {
+        append(page.pixelData.data(), page.pixelData.size());
     }
 
+    header.dataHash = fnv1a64(out.data() + sizeof(header), out.size() - sizeof(header));
+    std::memcpy(out.data(), &header, sizeof(header));
     return true;
 }
 
+bool GlyphAtlas::saveToFile(const std::string& filePath) const {
+    std::vector<uint8_t> data;
+    if (!saveToMemory(data))
+        return false;
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        return false;
+
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
 bool GlyphAtlas::loadFromFile(const std::string& filePath) {
-    std::ifstream file(filePath, std::ios::binary);
+    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
     if (!file.is_open())
         return false;
 
-    // Read header
-    char magic[8];
-    file.read(magic, 8);
-    if (std::strncmp(magic, "DAKTFONT", 8) != 0)
+    std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size())))
         return false;
 
-    uint32_t version, pageCount, glyphCount;
-    file.read(reinterpret_cast<char*>(&version), sizeof(version));
-    file.read(reinterpret_cast<char*>(&pageCount), sizeof(pageCount));
-    file.read(reinterpret_cast<char*>(&glyphCount), sizeof(glyphCount));
-    file.read(reinterpret_cast<char*>(&pageWidth_), sizeof(pageWidth_));
-    file.read(reinterpret_cast<char*>(&pageHeight_), sizeof(pageHeight_));
-    file.read(reinterpret_cast<char*>(&sdfSpread_), sizeof(sdfSpread_));
+    return loadFromMemory(data.data(), data.size());
+}
 
-    if (version != 1)
+bool GlyphAtlas::loadFromMemory(const uint8_t* data, size_t size) {
+    BakedAtlasHeader header;
+    if (!data || size < sizeof(header))
         return false;
+    std::memcpy(&header, data, sizeof(header));
 
-    // Read pages
-    pages_.clear();
-    pages_.resize(pageCount);
-    for (auto& page : pages_) {
-        page.width = pageWidth_;
-        page.height = pageHeight_;
-        page.pixelData.resize(pageWidth_ * pageHeight_);
-        file.read(reinterpret_cast<char*>(page.pixelData.data()), page.pixelData.size());
+    if (std::memcmp(header.magic, "DAKTFONT", 8) != 0 || header.version != BAKED_ATLAS_VERSION || (header.channels != 1 && header.channels != 4) ||
+        header.pageCount == 0 || header.pageWidth == 0 || header.pageHeight == 0)
+        return false;
+
+    const uint64_t texels = static_cast<uint64_t>(header.pageWidth) * header.pageHeight;
+    const uint64_t glyphBytes = static_cast<uint64_t>(header.glyphCount) * sizeof(AtlasGlyph);
+    const uint64_t codepointBytes = static_cast<uint64_t>(header.codepointCount) * 8;
+    const uint64_t modeBytes = static_cast<uint64_t>(header.pageCount) * 4;
+    if (size - sizeof(header) < glyphBytes + codepointBytes + modeBytes)
+        return false;
+
+    // Page sizes follow from their modes
+    const uint8_t* modeTable = data + sizeof(header) + glyphBytes + codepointBytes;
+    std::vector<GlyphRenderMode> modes(header.pageCount);
+    uint64_t pageBytes = 0;
+    for (uint32_t i = 0; i < header.pageCount; ++i) {
+        uint32_t mode;
+        std::memcpy(&mode, modeTable + i * 4, sizeof(mode));
+        if (mode > static_cast<uint32_t>(GlyphRenderMode::Coverage) || (mode != static_cast<uint32_t>(GlyphRenderMode::Coverage) && pageChannels(static_cast<GlyphRenderMode>(mode)) != header.channels))
+            return false;
+        modes[i] = static_cast<GlyphRenderMode>(mode);
+        pageBytes += texels * pageChannels(modes[i]);
     }
+    if (size - sizeof(header) != glyphBytes + codepointBytes + modeBytes + pageBytes)
+        return false;
+    if (fnv1a64(data + sizeof(header), size - sizeof(header)) != header.dataHash)
+        return false;
 
-    // Read glyph entries
+    pageWidth_ = header.pageWidth;
+    pageHeight_ = header.pageHeight;
+    sdfSpread_ = header.sdfSpread;
+    enableMSDF_ = header.channels == 4;
+    fontInfo_ = AtlasFontInfo{header.fontHash, header.unitsPerEm, header.ascender, header.descender, header.lineGap};
+
+    const uint8_t* cursor = data + sizeof(header);
     glyphMap_.clear();
-    for (uint32_t i = 0; i < glyphCount; ++i) {
+    glyphMap_.reserve(header.glyphCount);
+    fontIDs_.clear();
+    fontIDs_.emplace(header.fontHash, 0);
+    variantCount_ = 0;
+    for (uint32_t i = 0; i < header.glyphCount; ++i, cursor += sizeof(AtlasGlyph)) {
         AtlasGlyph glyph;
-        file.read(reinterpret_cast<char*>(&glyph), sizeof(AtlasGlyph));
-        auto key = std::make_pair(glyph.glyphID, hashFontSize(glyph.fontSize));
-        glyphMap_[key] = glyph;
+        std::memcpy(&glyph, cursor, sizeof(AtlasGlyph));
+        glyphMap_.emplace(GlyphKey{0, glyph.glyphID, sizeKey(glyph.fontSize)}, glyph);
+        if (subpixelOffset(glyph.glyphID) != 0) {
+            ++variantCount_;
+        }
+    }
+
+    codepoints_.clear();
+    for (uint32_t i = 0; i < header.codepointCount; ++i, cursor += 8) {
+        uint32_t pair[2];
+        std::memcpy(pair, cursor, sizeof(pair));
+        codepoints_.emplace_hint(codepoints_.end(), pair[0], pair[1]);
     }
 
+    cursor += modeBytes;
+    pages_.clear();
+    pages_.resize(header.pageCount);
+    for (uint32_t i = 0; i < header.pageCount; ++i) {
+        AtlasPage& page = pages_[i];
+        page.width = pageWidth_;
+        page.height = pageHeight_;
+        page.renderMode = modes[i];
+        page.channels = pageChannels(modes[i]);
+        page.pixelData.assign(cursor, cursor + texels * page.channels);
+        cursor += texels * page.channels;
+    }
+
+    // Loaded pages have no free-space record; new glyphs go to new pages
+    packers_.clear();
+    packers_.resize(header.pageCount);
+
     return true;
 }
 
@@ -0,0 +1,442 @@
+#include "dakt/gui/subsystems/text/GlyphAtlasCache.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace dakt::gui {
+
+// ============================================================================
+// File Format
+// ============================================================================
+
+// <directory>/<font hash>-<size bucket>-<spread>-<mode>.daktatlas:
+// Header, glyphCount AtlasCacheRecords sorted by glyph ID, pixelBytes of pixels.
+// dataHash covers everything after the header.
+
+static constexpr uint32_t ATLAS_CACHE_MAGIC = 0x43414B44; // "DKAC"
+
+struct AtlasCacheFileHeader {
+    uint32_t magic = ATLAS_CACHE_MAGIC;
+    uint32_t version = GlyphAtlasCache::FORMAT_VERSION;
+    uint64_t fontHash = 0;
+    uint32_t sizeBucket = 0;
+    uint32_t spread = 0;
+    uint32_t mode = 0;
+    uint32_t glyphCount = 0;
+    uint64_t pixelBytes = 0;
+    uint64_t dataHash = 0;
+};
+
+static_assert(sizeof(AtlasCacheFileHeader) == 48, "cache header layout is part of the file format");
+static_assert(sizeof(AtlasCacheRecord) == 28, "cache record layout is part of the file format");
+
+// Glyphs stored within this long of each other go out in one write
+static constexpr auto WRITE_COALESCE_DELAY = std::chrono::milliseconds(250);
+
+static uint64_t fnv1a64(const void* data, size_t len) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// ============================================================================
+// Memory-Mapped File
+// ============================================================================
+
+class GlyphAtlasCache::MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path) {
+        close();
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            file_ = nullptr;
+            return false;
+        }
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart == 0) {
+            close();
+            return false;
+        }
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            close();
+            return false;
+        }
+        data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            return false;
+        }
+        struct stat info{};
+        if (fstat(fd_, &info) != 0 || info.st_size <= 0) {
+            close();
+            return false;
+        }
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+        data_ = view == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(view);
+        size_ = static_cast<size_t>(info.st_size);
+#endif
+        if (!data_) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+        if (data_) {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_) {
+            CloseHandle(mapping_);
+        }
+        if (file_) {
+            CloseHandle(file_);
+        }
+        file_ = nullptr;
+        mapping_ = nullptr;
+#else
+        if (data_) {
+            munmap(const_cast<uint8_t*>(data_), size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+        fd_ = -1;
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+  private:
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+    HANDLE file_ = nullptr;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// ============================================================================
+// GlyphAtlasCache Implementation
+// ============================================================================
+
+GlyphAtlasCache::GlyphAtlasCache(std::string directory) : directory_(std::move(directory)) {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+}
+
+GlyphAtlasCache::~GlyphAtlasCache() {
+    // Windows cannot replace a file that is still mapped
+    mapped_.clear();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requeueDeferred();
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (writer_.joinable()) {
+        writer_.join(); // Writes whatever is still queued before returning
+    }
+}
+
+std::string GlyphAtlasCache::getFilePath(const AtlasCacheKey& key) const {
+    char name[96];
+    std::snprintf(name, sizeof(name), "%016llx-%u-%u-%u.daktatlas", static_cast<unsigned long long>(key.fontHash), key.sizeBucket, key.spread, key.mode);
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+bool GlyphAtlasCache::openValidated(const std::string& path, const AtlasCacheKey& key, MappedEntry& entry) const {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->open(path) || file->size() < sizeof(AtlasCacheFileHeader)) {
+        return false;
+    }
+
+    AtlasCacheFileHeader header;
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.magic != ATLAS_CACHE_MAGIC || header.version != FORMAT_VERSION || header.fontHash != key.fontHash || header.sizeBucket != key.sizeBucket ||
+        header.spread != key.spread || header.mode != key.mode) {
+        return false;
+    }
+
+    const uint64_t recordBytes = static_cast<uint64_t>(header.glyphCount) * sizeof(AtlasCacheRecord);
+    if (header.pixelBytes > file->size() || file->size() - sizeof(header) != recordBytes + header.pixelBytes) {
+        return false;
+    }
+    const uint8_t* data = file->data() + sizeof(header);
+    if (fnv1a64(data, static_cast<size_t>(recordBytes + header.pixelBytes)) != header.dataHash) {
+        return false;
+    }
+
+    // The header size is a multiple of 8 and mappings are page aligned, so records can be read in place
+    const auto* records = reinterpret_cast<const AtlasCacheRecord*>(data);
+    for (uint32_t i = 0; i < header.glyphCount; ++i) {
+        if ((i > 0 && records[i].glyphID <= records[i - 1].glyphID) || records[i].pixelOffset + static_cast<uint64_t>(records[i].pixelSize()) > header.pixelBytes) {
+            return false;
+        }
+    }
+
+    entry.file = std::move(file);
+    entry.records = records;
+    entry.recordCount = header.glyphCount;
+    entry.pixels = data + recordBytes;
+    return true;
+}
+
+const GlyphAtlasCache::MappedEntry& GlyphAtlasCache::map(const AtlasCacheKey& key) {
+    auto it = mapped_.find(key);
+    if (it != mapped_.end()) {
+        return it->second;
+    }
+
+    MappedEntry& entry = mapped_[key];
+    const std::string path = getFilePath(key);
+    std::error_code error;
+    if (std::filesystem::exists(path, error) && !openValidated(path, key, entry)) {
+        ++rejectedCount_; // Stale or corrupt: glyphs re-rasterize and the writer replaces the file
+    }
+    return entry;
+}
+
+const uint8_t* GlyphAtlasCache::find(const AtlasCacheKey& key, uint32_t glyphID, AtlasCacheRecord& record) {
+    const MappedEntry& entry = map(key);
+    const AtlasCacheRecord* end = entry.records + entry.recordCount;
+    const AtlasCacheRecord* it = std::lower_bound(entry.records, end, glyphID, [](const AtlasCacheRecord& r, uint32_t id) { return r.glyphID < id; });
+    if (it == end || it->glyphID != glyphID) {
+        ++missCount_;
+        return nullptr;
+    }
+
+    ++hitCount_;
+    record = *it;
+    return entry.pixels + it->pixelOffset;
+}
+
+size_t GlyphAtlasCache::forEach(const AtlasCacheKey& key, const std::function<void(const AtlasCacheRecord&, const uint8_t*)>& visit) {
+    const MappedEntry& entry = map(key);
+    for (uint32_t i = 0; i < entry.recordCount; ++i) {
+        visit(entry.records[i], entry.pixels + entry.records[i].pixelOffset);
+    }
+    hitCount_ += entry.recordCount;
+    return entry.recordCount;
+}
+
+std::vector<AtlasCacheKey> GlyphAtlasCache::findKeys(uint64_t fontHash) const {
+    std::vector<AtlasCacheKey> keys;
+    std::error_code error;
+    for (const auto& file : std::filesystem::directory_iterator(directory_, error)) {
+        const std::string name = file.path().filename().string();
+        unsigned long long hash = 0;
+        AtlasCacheKey key;
+        int consumed = 0;
+        if (std::sscanf(name.c_str(), "%16llx-%u-%u-%u.daktatlas%n", &hash, &key.sizeBucket, &key.spread, &key.mode, &consumed) == 4 &&
+            static_cast<size_t>(consumed) == name.size() && hash == fontHash) {
+            key.fontHash = hash;
+            keys.push_back(key);
+        }
+    }
+    return keys;
+}
+
+void GlyphAtlasCache::store(const AtlasCacheKey& key, const AtlasCacheRecord& record, const uint8_t* pixels) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        PendingGlyphs& pending = pending_[key];
+        AtlasCacheRecord stored = record;
+        stored.pixelOffset = static_cast<uint32_t>(pending.pixels.size());
+        pending.records.push_back(stored);
+        pending.pixels.insert(pending.pixels.end(), pixels, pixels + record.pixelSize());
+        ++storedSequence_;
+
+        if (!writer_.joinable()) {
+            writer_ = std::thread(&GlyphAtlasCache::writerLoop, this);
+        }
+    }
+    wake_.notify_one();
+}
+
+void GlyphAtlasCache::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    requeueDeferred();
+    if (writtenSequence_ == storedSequence_) {
+        return;
+    }
+    const uint64_t target = storedSequence_;
+    flushRequested_ = true;
+    wake_.notify_one();
+    written_.wait(lock, [&] { return writtenSequence_ >= target; });
+}
+
+void GlyphAtlasCache::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&] { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) {
+            return; // Stopping with nothing queued
+        }
+
+        // Let a burst of new glyphs (a screen of fresh text) settle into one write per key
+        wake_.wait_for(lock, WRITE_COALESCE_DELAY, [&] { return stopping_ || flushRequested_; });
+        flushRequested_ = false;
+
+        auto batch = std::move(pending_);
+        pending_.clear();
+        const uint64_t sequence = storedSequence_;
+
+        lock.unlock();
+        for (auto& [key, glyphs] : batch) {
+            if (writeKey(key, glyphs)) {
+                glyphs.records.clear();
+            }
+        }
+        lock.lock();
+
+        for (auto& [key, glyphs] : batch) {
+            if (!glyphs.records.empty()) {
+                appendGlyphs(deferred_[key], glyphs); // Retried by the next flush()
+            }
+        }
+
+        writtenSequence_ = sequence;
+        written_.notify_all();
+    }
+}
+
+void GlyphAtlasCache::appendGlyphs(PendingGlyphs& to, const PendingGlyphs& from) {
+    const auto base = static_cast<uint32_t>(to.pixels.size());
+    for (AtlasCacheRecord record : from.records) {
+        record.pixelOffset += base;
+        to.records.push_back(record);
+    }
+    to.pixels.insert(to.pixels.end(), from.pixels.begin(), from.pixels.end());
+}
+
+void GlyphAtlasCache::requeueDeferred() {
+    for (auto& [key, glyphs] : deferred_) {
+        mapped_.erase(key); // The failed replace may have been blocked by this mapping
+        appendGlyphs(pending_[key], glyphs);
+        storedSequence_ += glyphs.records.size();
+    }
+    if (!deferred_.empty()) {
+        deferred_.clear();
+        if (!writer_.joinable()) {
+            writer_ = std::thread(&GlyphAtlasCache::writerLoop, this);
+        }
+    }
+}
+
+bool GlyphAtlasCache::writeKey(const AtlasCacheKey& key, const PendingGlyphs& pending) {
+    const std::string path = getFilePath(key);
+
+    // Merge with what is already on disk; newly stored glyphs win
+    struct Source {
+        AtlasCacheRecord record;
+        const uint8_t* pixels;
+    };
+    std::vector<Source> sources;
+    sources.reserve(pending.records.size());
+    for (const AtlasCacheRecord& record : pending.records) {
+        sources.push_back({record, pending.pixels.data() + record.pixelOffset});
+    }
+
+    MappedEntry existing;
+    std::error_code error;
+    if (std::filesystem::exists(path, error) && openValidated(path, key, existing)) {
+        for (uint32_t i = 0; i < existing.recordCount; ++i) {
+            sources.push_back({existing.records[i], existing.pixels + existing.records[i].pixelOffset});
+        }
+    }
+
+    std::stable_sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) { return a.record.glyphID < b.record.glyphID; });
+    sources.erase(std::unique(sources.begin(), sources.end(), [](const Source& a, const Source& b) { return a.record.glyphID == b.record.glyphID; }), sources.end());
+
+    AtlasCacheFileHeader header;
+    header.fontHash = key.fontHash;
+    header.sizeBucket = key.sizeBucket;
+    header.spread = key.spread;
+    header.mode = key.mode;
+    header.glyphCount = static_cast<uint32_t>(sources.size());
+    for (const Source& source : sources) {
+        header.pixelBytes += source.record.pixelSize();
+    }
+    if (header.pixelBytes > UINT32_MAX) {
+        return true; // Offsets are 32-bit; a font this large at one size is not worth caching
+    }
+
+    const size_t recordBytes = sources.size() * sizeof(AtlasCacheRecord);
+    std::vector<uint8_t> data(recordBytes + static_cast<size_t>(header.pixelBytes));
+    uint32_t pixelOffset = 0;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        AtlasCacheRecord record = sources[i].record;
+        record.pixelOffset = pixelOffset;
+        std::memcpy(data.data() + i * sizeof(AtlasCacheRecord), &record, sizeof(record));
+        std::memcpy(data.data() + recordBytes + pixelOffset, sources[i].pixels, record.pixelSize());
+        pixelOffset += static_cast<uint32_t>(record.pixelSize());
+    }
+    header.dataHash = fnv1a64(data.data(), data.size());
+    existing.file.reset();
+
+    // Write to a temporary file and rename so a crash mid-write never leaves a truncated cache
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            return false;
+        }
+    }
+
+    // Replace in one step, so readers always find either the old file or the new one
+#if defined(DAKTLIB_PLATFORM_WINDOWS) || defined(_WIN32)
+    const bool replaced = MoveFileExW(std::filesystem::path(tempPath).c_str(), std::filesystem::path(path).c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const bool replaced = std::rename(tempPath.c_str(), path.c_str()) == 0;
+#endif
+    if (!replaced) {
+        std::remove(tempPath.c_str());
+    }
+    return replaced;
+}
+
+} // namespace dakt::gui
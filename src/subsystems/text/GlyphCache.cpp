@@ -1,7 +1,9 @@
 #include "dakt/gui/subsystems/text/GlyphCache.hpp"
 #include "dakt/gui/subsystems/text/Font.hpp"
 #include "dakt/gui/subsystems/text/GlyphAtlas.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace dakt::gui {
 
@@ -96,51 +98,13 @@ CachedTextRun GlyphCache::createEntry(Font& font, float fontSize, const std::str
     float cursorX = 0;
     float cursorY = 0;
 
-    // Simple UTF-8 decoding and glyph positioning
+    const bool coverage = atlas.getRenderMode(fontSize) == GlyphRenderMode::Coverage;
+    const float phases = static_cast<float>(atlas.getSubpixelPolicy().phases);
+    const float baseline = coverage ? std::round(run.ascender) : run.ascender; // Vertically, whole pixels only
+
+    // Malformed UTF-8 decodes to U+FFFD, as on every other text path
     for (size_t i = 0; i < text.length();) {
-        uint32_t codepoint = 0;
-        unsigned char c = text[i];
-
-        // UTF-8 decode
-        if ((c & 0x80) == 0) {
-            // ASCII
-            codepoint = c;
-            ++i;
-        } else if ((c & 0xE0) == 0xC0) {
-            // 2-byte sequence
-            codepoint = (c & 0x1F) << 6;
-            if (i + 1 < text.length()) {
-                codepoint |= (text[i + 1] & 0x3F);
-            }
-            i += 2;
-        } else if ((c & 0xF0) == 0xE0) {
-            // 3-byte sequence
-            codepoint = (c & 0x0F) << 12;
-            if (i + 1 < text.length()) {
-                codepoint |= (text[i + 1] & 0x3F) << 6;
-            }
-            if (i + 2 < text.length()) {
-                codepoint |= (text[i + 2] & 0x3F);
-            }
-            i += 3;
-        } else if ((c & 0xF8) == 0xF0) {
-            // 4-byte sequence
-            codepoint = (c & 0x07) << 18;
-            if (i + 1 < text.length()) {
-                codepoint |= (text[i + 1] & 0x3F) << 12;
-            }
-            if (i + 2 < text.length()) {
-                codepoint |= (text[i + 2] & 0x3F) << 6;
-            }
-            if (i + 3 < text.length()) {
-                codepoint |= (text[i + 3] & 0x3F);
-            }
-            i += 4;
-        } else {
-            // Invalid UTF-8
-            ++i;
-            continue;
-        }
+        const uint32_t codepoint = utf8::decodeOne(text, i);
 
         // Get glyph ID
         uint16_t glyphID = font.getGlyphId(codepoint);
@@ -149,19 +113,32 @@ CachedTextRun GlyphCache::createEntry(Font& font, float fontSize, const std::str
             glyphID = 0;
         }
 
+        // Coverage bitmaps are drawn on whole pixels: round the pen to the nearest
+        // subpixel phase and draw the variant rasterized that far to the right
+        float originX = cursorX;
+        uint32_t phase = 0;
+        if (coverage) {
+            const float steps = std::round(cursorX * phases);
+            originX = std::floor(steps / phases);
+            phase = static_cast<uint32_t>(steps - originX * phases);
+        }
+
         // Ensure glyph is in atlas
-        if (!atlas.hasGlyph(glyphID, fontSize)) {
+        if (!atlas.hasGlyph(font, glyphID, fontSize, phase) && !atlas.addGlyph(font, glyphID, fontSize, phase) && phase != 0) {
+            // Out of subpixel variants: nearest whole pixel
+            originX = std::round(cursorX);
+            phase = 0;
             atlas.addGlyph(font, glyphID, fontSize);
         }
 
         // Get glyph from atlas
-        const AtlasGlyph& atlasGlyph = atlas.getGlyph(glyphID, fontSize);
+        const AtlasGlyph& atlasGlyph = atlas.getGlyph(font, glyphID, fontSize, phase);
 
         // Position the glyph
         CachedGlyphPosition pos;
         pos.glyphID = glyphID;
-        pos.x = cursorX + atlasGlyph.bearingX;
-        pos.y = cursorY + run.ascender - atlasGlyph.bearingY;
+        pos.x = originX + atlasGlyph.bearingX;
+        pos.y = cursorY + baseline - atlasGlyph.bearingY;
         pos.width = atlasGlyph.width;
         pos.height = atlasGlyph.height;
         pos.atlasX = atlasGlyph.atlasX;
@@ -0,0 +1,211 @@
+#include "dakt/gui/subsystems/text/LineBreak.hpp"
+#include "LineBreakTables.hpp"
+
+namespace dakt::gui {
+
+namespace {
+
+using LB = LineBreakClass;
+
+// LB1: no dictionary for complex context scripts, ambiguous characters are alphabetic
+LineBreakClass resolveClass(LineBreakClass c) {
+    switch (c) {
+    case LB::AI:
+    case LB::SG:
+    case LB::XX:
+    case LB::SA:
+        return LB::AL;
+    case LB::CJ:
+        return LB::NS;
+    default:
+        return c;
+    }
+}
+
+bool isNewline(LineBreakClass c) { return c == LB::BK || c == LB::CR || c == LB::LF || c == LB::NL; }
+
+bool isAlphabetic(LineBreakClass c) { return c == LB::AL || c == LB::HL; }
+
+bool isHangul(LineBreakClass c) { return c == LB::JL || c == LB::JV || c == LB::JT || c == LB::H2 || c == LB::H3; }
+
+// LB9: X (CM | ZWJ)* is treated as X, unless X is a newline, space or zero width space
+bool attaches(LineBreakClass current, LineBreakClass base) {
+    return (current == LB::CM || current == LB::ZWJ) && !isNewline(base) && base != LB::SP && base != LB::ZW;
+}
+
+struct PairContext {
+    LineBreakClass beforeSpaces; // Last class before a run of spaces (LB14-LB17)
+    LineBreakClass beforeBase;   // Class preceding a (LB21a)
+    size_t regionalCount;        // Regional indicators ending at a (LB30a)
+};
+
+// Rules LB11-LB31 between base class a and class b
+BreakAction pairAction(LineBreakClass a, LineBreakClass b, const PairContext& context) {
+    // LB11, LB12, LB12a
+    if (a == LB::WJ || b == LB::WJ || a == LB::GL) {
+        return BreakAction::None;
+    }
+    if (b == LB::GL && a != LB::SP && a != LB::BA && a != LB::HY) {
+        return BreakAction::None;
+    }
+
+    // LB13
+    if (b == LB::CL || b == LB::CP || b == LB::EX || b == LB::IS || b == LB::SY) {
+        return BreakAction::None;
+    }
+
+    // LB14-LB17: across spaces
+    const LineBreakClass open = context.beforeSpaces;
+    if (open == LB::OP || (open == LB::QU && b == LB::OP) || ((open == LB::CL || open == LB::CP) && b == LB::NS) || (open == LB::B2 && b == LB::B2)) {
+        return BreakAction::None;
+    }
+
+    // LB18
+    if (a == LB::SP) {
+        return BreakAction::Allowed;
+    }
+
+    // LB19, LB20
+    if (a == LB::QU || b == LB::QU) {
+        return BreakAction::None;
+    }
+    if (a == LB::CB || b == LB::CB) {
+        return BreakAction::Allowed;
+    }
+
+    // LB21, LB21a, LB21b, LB22
+    if (b == LB::BA || b == LB::HY || b == LB::NS || a == LB::BB || b == LB::IN) {
+        return BreakAction::None;
+    }
+    if ((a == LB::HY || a == LB::BA) && context.beforeBase == LB::HL) {
+        return BreakAction::None;
+    }
+    if (a == LB::SY && b == LB::HL) {
+        return BreakAction::None;
+    }
+
+    // LB23, LB23a, LB24: letters, numbers and ideographs with their affixes
+    if ((isAlphabetic(a) && b == LB::NU) || (a == LB::NU && isAlphabetic(b))) {
+        return BreakAction::None;
+    }
+    const bool ideograph = b == LB::Ideographic || b == LB::EB || b == LB::EM;
+    if ((a == LB::PR && ideograph) || ((a == LB::Ideographic || a == LB::EB || a == LB::EM) && b == LB::PO)) {
+        return BreakAction::None;
+    }
+    if (((a == LB::PR || a == LB::PO) && isAlphabetic(b)) || (isAlphabetic(a) && (b == LB::PR || b == LB::PO))) {
+        return BreakAction::None;
+    }
+
+    // LB25: numbers
+    if (((a == LB::CL || a == LB::CP || a == LB::NU) && (b == LB::PO || b == LB::PR)) || ((a == LB::PO || a == LB::PR) && (b == LB::OP || b == LB::NU)) ||
+        ((a == LB::HY || a == LB::IS || a == LB::NU || a == LB::SY) && b == LB::NU)) {
+        return BreakAction::None;
+    }
+
+    // LB26, LB27: Korean syllables
+    if ((a == LB::JL && (b == LB::JL || b == LB::JV || b == LB::H2 || b == LB::H3)) || ((a == LB::JV || a == LB::H2) && (b == LB::JV || b == LB::JT)) ||
+        ((a == LB::JT || a == LB::H3) && b == LB::JT)) {
+        return BreakAction::None;
+    }
+    if ((isHangul(a) && b == LB::PO) || (a == LB::PR && isHangul(b))) {
+        return BreakAction::None;
+    }
+
+    // LB28, LB29, LB30
+    if (isAlphabetic(a) && isAlphabetic(b)) {
+        return BreakAction::None;
+    }
+    if (a == LB::IS && isAlphabetic(b)) {
+        return BreakAction::None;
+    }
+    if (((isAlphabetic(a) || a == LB::NU) && b == LB::OP) || (a == LB::CP && (isAlphabetic(b) || b == LB::NU))) {
+        return BreakAction::None;
+    }
+
+    // LB30a: flags pair up; LB30b: emoji modifiers
+    if (a == LB::RI && b == LB::RI && (context.regionalCount & 1) != 0) {
+        return BreakAction::None;
+    }
+    if (a == LB::EB && b == LB::EM) {
+        return BreakAction::None;
+    }
+
+    // LB31
+    return BreakAction::Allowed;
+}
+
+} // namespace
+
+LineBreakClass getLineBreakClass(uint32_t codepoint) {
+    if (codepoint > 0x10FFFF) {
+        return LineBreakClass::XX;
+    }
+    constexpr uint32_t mask = (1u << linebreak_tables::BLOCK_SHIFT) - 1;
+    const size_t block = linebreak_tables::STAGE1[codepoint >> linebreak_tables::BLOCK_SHIFT];
+    return static_cast<LineBreakClass>(linebreak_tables::STAGE2[(block << linebreak_tables::BLOCK_SHIFT) | (codepoint & mask)]);
+}
+
+void findLineBreaks(const uint32_t* codepoints, size_t count, std::vector<BreakAction>& breaks) {
+    // LB2: never break at the start; LB3: always break at the end
+    breaks.assign(count + 1, BreakAction::None);
+    breaks[count] = BreakAction::Mandatory;
+    if (count == 0) {
+        return;
+    }
+
+    LineBreakClass previous = resolveClass(getLineBreakClass(codepoints[0])); // Class of codepoint i - 1
+    LineBreakClass base = (previous == LB::CM || previous == LB::ZWJ) ? LB::AL : previous; // After LB9 and LB10
+    PairContext context{base, LB::BK, base == LB::RI ? size_t(1) : size_t(0)};
+
+    for (size_t i = 1; i < count; ++i) {
+        const LineBreakClass current = resolveClass(getLineBreakClass(codepoints[i]));
+        const bool attached = attaches(current, base);
+
+        BreakAction action;
+        if (previous == LB::BK || previous == LB::LF || previous == LB::NL) {
+            action = BreakAction::Mandatory; // LB4, LB5
+        } else if (previous == LB::CR) {
+            action = current == LB::LF ? BreakAction::None : BreakAction::Mandatory;
+        } else if (isNewline(current) || current == LB::SP || current == LB::ZW) {
+            action = BreakAction::None; // LB6, LB7
+        } else if (context.beforeSpaces == LB::ZW) {
+            action = BreakAction::Allowed; // LB8
+        } else if (previous == LB::ZWJ || attached) {
+            action = BreakAction::None; // LB8a, LB9
+        } else {
+            action = pairAction(base, (current == LB::CM || current == LB::ZWJ) ? LB::AL : current, context); // LB10
+        }
+        breaks[i] = action;
+
+        // Combining marks leave the base class in place
+        if (!attached) {
+            context.beforeBase = base;
+            base = (current == LB::CM || current == LB::ZWJ) ? LB::AL : current;
+            context.regionalCount = base == LB::RI ? context.regionalCount + 1 : 0;
+            if (base != LB::SP) {
+                context.beforeSpaces = base;
+            }
+        }
+        previous = current;
+    }
+}
+
+bool isLineEndSpace(uint32_t codepoint) {
+    switch (getLineBreakClass(codepoint)) {
+    case LB::BK:
+    case LB::CR:
+    case LB::LF:
+    case LB::NL:
+    case LB::SP:
+    case LB::ZW:
+        return true;
+    case LB::BA:
+        // Breaking spaces that are not SP: tab, ogham, en quad to hair space, ideographic
+        return codepoint == 0x09 || codepoint == 0x1680 || (codepoint >= 0x2000 && codepoint <= 0x200A && codepoint != 0x2007) || codepoint == 0x205F ||
+               codepoint == 0x3000;
+    default:
+        return false;
+    }
+}
+
+} // namespace dakt::gui
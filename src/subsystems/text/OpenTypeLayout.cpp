@@ -0,0 +1,1203 @@
+#include "dakt/gui/subsystems/text/OpenTypeLayout.hpp"
+#include "dakt/gui/subsystems/text/TTFParser.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <map>
+
+namespace dakt::gui {
+
+namespace {
+
+constexpr uint32_t SCRIPT_DFLT = 0x44464C54; // 'DFLT'
+
+// Lookup flags
+constexpr uint16_t IGNORE_BASE_GLYPHS = 0x0002;
+constexpr uint16_t IGNORE_LIGATURES = 0x0004;
+constexpr uint16_t IGNORE_MARKS = 0x0008;
+constexpr uint16_t USE_MARK_FILTERING_SET = 0x0010;
+constexpr uint16_t MARK_ATTACHMENT_TYPE = 0xFF00;
+
+// GPOS
+constexpr uint16_t GPOS_PAIR_ADJUSTMENT = 2;
+constexpr uint16_t GPOS_EXTENSION = 9;
+constexpr uint16_t VALUE_X_ADVANCE = 0x0004;
+constexpr uint16_t VALUE_PLACEMENTS = 0x0003; // XPlacement, YPlacement precede XAdvance
+
+// GDEF glyph classes
+constexpr uint16_t GLYPH_CLASS_BASE = 1;
+constexpr uint16_t GLYPH_CLASS_LIGATURE = 2;
+constexpr uint16_t GLYPH_CLASS_MARK = 3;
+
+// Contextual lookups may call each other; fonts never nest deeply
+constexpr int MAX_NESTING = 8;
+constexpr size_t MAX_CONTEXT_LENGTH = 64;
+constexpr size_t NONE = static_cast<size_t>(-1);
+
+std::vector<uint16_t> readU16Array(BinaryStream& stream, size_t count) {
+    std::vector<uint16_t> values(count);
+    for (auto& value : values) {
+        value = stream.readU16();
+    }
+    return values;
+}
+
+void mergeBits(std::vector<uint64_t>& into, const std::vector<uint64_t>& bits) {
+    if (into.size() < bits.size()) {
+        into.resize(bits.size(), 0);
+    }
+    for (size_t i = 0; i < bits.size(); ++i) {
+        into[i] |= bits[i];
+    }
+}
+
+void setBit(std::vector<uint64_t>& bits, uint32_t glyphID) {
+    if ((glyphID >> 6) >= bits.size()) {
+        bits.resize((glyphID >> 6) + 1, 0);
+    }
+    bits[glyphID >> 6] |= uint64_t{1} << (glyphID & 63);
+}
+
+bool testBit(const std::vector<uint64_t>& bits, uint32_t glyphID) { return (glyphID >> 6) < bits.size() && ((bits[glyphID >> 6] >> (glyphID & 63)) & 1) != 0; }
+
+// Read a GPOS ValueRecord and return its XAdvance (0 if the format has none)
+int16_t readXAdvance(BinaryStream& stream, uint16_t valueFormat) {
+    int16_t xAdvance = 0;
+    const int fields = std::popcount(static_cast<uint16_t>(valueFormat & 0xFF));
+    const int xAdvanceField = (valueFormat & VALUE_X_ADVANCE) != 0 ? std::popcount(static_cast<uint16_t>(valueFormat & VALUE_PLACEMENTS)) : -1;
+    for (int field = 0; field < fields; ++field) {
+        const int16_t value = stream.readI16();
+        if (field == xAdvanceField) {
+            xAdvance = value;
+        }
+    }
+    return xAdvance;
+}
+
+/**
+ * Lookup indices reached from a script's default language system through
+ * the given features (plus any required feature), in LookupList order.
+ * Shared by GSUB and GPOS, whose script and feature lists are identical.
+ */
+std::vector<uint16_t> collectLookups(BinaryStream& stream, size_t scriptListOffset, size_t featureListOffset, uint32_t scriptTag,
+                                     const std::vector<uint32_t>& features) {
+    // Script: the requested one, then DFLT, then whatever comes first
+    stream.seek(scriptListOffset);
+    const uint16_t scriptCount = stream.readU16();
+    size_t scriptOffset = 0;
+    size_t defaultOffset = 0;
+    size_t firstOffset = 0;
+    for (uint16_t i = 0; i < scriptCount; ++i) {
+        const uint32_t tag = stream.readU32();
+        const size_t offset = scriptListOffset + stream.readU16();
+        if (i == 0) {
+            firstOffset = offset;
+        }
+        if (tag == scriptTag) {
+            scriptOffset = offset;
+        } else if (tag == SCRIPT_DFLT) {
+            defaultOffset = offset;
+        }
+    }
+    if (scriptOffset == 0) {
+        scriptOffset = defaultOffset != 0 ? defaultOffset : firstOffset;
+    }
+    if (scriptOffset == 0) {
+        return {};
+    }
+
+    stream.seek(scriptOffset);
+    const uint16_t defaultLangSys = stream.readU16();
+    if (defaultLangSys == 0) {
+        return {};
+    }
+
+    stream.seek(scriptOffset + defaultLangSys);
+    stream.skip(2); // lookupOrderOffset
+    const uint16_t requiredFeature = stream.readU16();
+    const uint16_t featureCount = stream.readU16();
+    const std::vector<uint16_t> featureIndices = readU16Array(stream, featureCount);
+
+    stream.seek(featureListOffset);
+    const uint16_t featureListCount = stream.readU16();
+
+    std::vector<uint16_t> lookups;
+    auto addFeature = [&](uint16_t featureIndex, bool required) {
+        if (featureIndex >= featureListCount) {
+            return;
+        }
+        stream.seek(featureListOffset + 2 + featureIndex * 6);
+        const uint32_t tag = stream.readU32();
+        const size_t featureOffset = featureListOffset + stream.readU16();
+        if (!required && std::find(features.begin(), features.end(), tag) == features.end()) {
+            return;
+        }
+
+        stream.seek(featureOffset);
+        stream.skip(2); // featureParamsOffset
+        const uint16_t lookupCount = stream.readU16();
+        for (uint16_t lookupIndex : readU16Array(stream, lookupCount)) {
+            lookups.push_back(lookupIndex);
+        }
+    };
+
+    if (requiredFeature != 0xFFFF) {
+        addFeature(requiredFeature, true);
+    }
+    for (uint16_t featureIndex : featureIndices) {
+        addFeature(featureIndex, false);
+    }
+
+    std::sort(lookups.begin(), lookups.end());
+    lookups.erase(std::unique(lookups.begin(), lookups.end()), lookups.end());
+    return lookups;
+}
+
+} // namespace
+
+// ============================================================================
+// GlyphCoverage / GlyphClassDef
+// ============================================================================
+
+void GlyphCoverage::load(BinaryStream& stream, size_t offset) {
+    bits_.clear();
+    glyphs_.clear();
+
+    stream.seek(offset);
+    const uint16_t format = stream.readU16();
+    if (format == 1) {
+        glyphs_ = readU16Array(stream, stream.readU16());
+    } else if (format == 2) {
+        const uint16_t rangeCount = stream.readU16();
+        for (uint16_t i = 0; i < rangeCount; ++i) {
+            const uint16_t start = stream.readU16();
+            const uint16_t end = stream.readU16();
+            stream.skip(2); // startCoverageIndex, implied by the range order
+            for (uint32_t glyph = start; glyph <= end; ++glyph) {
+                glyphs_.push_back(static_cast<uint16_t>(glyph));
+            }
+        }
+    }
+
+    for (uint16_t glyph : glyphs_) {
+        if ((glyph >> 6) >= bits_.size()) {
+            bits_.resize((glyph >> 6) + 1, 0);
+        }
+        bits_[glyph >> 6] |= uint64_t{1} << (glyph & 63);
+    }
+}
+
+int32_t GlyphCoverage::indexOf(uint32_t glyphID) const {
+    if (!contains(glyphID)) {
+        return -1;
+    }
+    auto it = std::lower_bound(glyphs_.begin(), glyphs_.end(), glyphID);
+    return it != glyphs_.end() && *it == glyphID ? static_cast<int32_t>(it - glyphs_.begin()) : -1;
+}
+
+void GlyphClassDef::load(BinaryStream& stream, size_t offset) {
+    firstGlyph_ = 0;
+    classes_.clear();
+
+    stream.seek(offset);
+    const uint16_t format = stream.readU16();
+    if (format == 1) {
+        firstGlyph_ = stream.readU16();
+        classes_ = readU16Array(stream, stream.readU16());
+    } else if (format == 2) {
+        const uint16_t rangeCount = stream.readU16();
+        std::vector<std::array<uint16_t, 3>> ranges(rangeCount);
+        uint32_t first = 0xFFFF;
+        uint32_t last = 0;
+        for (auto& range : ranges) {
+            range = {stream.readU16(), stream.readU16(), stream.readU16()};
+            if (range[0] <= range[1]) {
+                first = std::min<uint32_t>(first, range[0]);
+                last = std::max<uint32_t>(last, range[1]);
+            }
+        }
+        if (first > last) {
+            return;
+        }
+
+        firstGlyph_ = first;
+        classes_.assign(last - first + 1, 0);
+        for (const auto& range : ranges) {
+            for (uint32_t glyph = range[0]; glyph <= range[1]; ++glyph) {
+                classes_[glyph - first] = range[2];
+            }
+        }
+    }
+}
+
+// ============================================================================
+// GlyphSubstitution: Compilation
+// ============================================================================
+
+bool GlyphSubstitution::load(const uint8_t* data, size_t size, uint32_t scriptTag, const std::vector<uint32_t>& features, const uint8_t* gdef, size_t gdefSize) {
+    lookups_.clear();
+    active_.clear();
+    startMasks_.clear();
+
+    if (!data || size < 10) {
+        return false;
+    }
+
+    if (gdef && gdefSize >= 12) {
+        BinaryStream gdefStream(gdef, gdefSize);
+        gdefStream.skip(4); // version
+        const uint16_t glyphClassDef = gdefStream.readU16();
+        gdefStream.skip(4); // attachListOffset, ligCaretListOffset
+        const uint16_t markAttachClassDef = gdefStream.readU16();
+        if (glyphClassDef != 0) {
+            glyphClasses_.load(gdefStream, glyphClassDef);
+        }
+        if (markAttachClassDef != 0) {
+            markAttachClasses_.load(gdefStream, markAttachClassDef);
+        }
+    }
+
+    BinaryStream stream(data, size);
+    stream.skip(4); // version
+    const size_t scriptList = stream.readU16();
+    const size_t featureList = stream.readU16();
+    const size_t lookupList = stream.readU16();
+
+    std::vector<uint16_t> enabled = collectLookups(stream, scriptList, featureList, scriptTag, features);
+
+    stream.seek(lookupList);
+    lookups_.resize(stream.readU16());
+
+    for (uint16_t index : enabled) {
+        if (index >= lookups_.size()) {
+            continue;
+        }
+        compileLookup(stream, lookupList, index, 0);
+        if (!lookups_[index].subtables.empty()) {
+            active_.push_back(index);
+        }
+    }
+
+    // Per glyph, the active lookups it can start (lookups past the 63rd share the top bit)
+    for (size_t k = 0; k < active_.size(); ++k) {
+        const auto& bits = lookups_[active_[k]].coverageBits;
+        const uint64_t bit = uint64_t{1} << std::min<size_t>(k, 63);
+        for (size_t word = 0; word < bits.size(); ++word) {
+            for (uint64_t remaining = bits[word]; remaining != 0; remaining &= remaining - 1) {
+                const size_t glyph = word * 64 + static_cast<size_t>(std::countr_zero(remaining));
+                if (glyph >= startMasks_.size()) {
+                    startMasks_.resize(glyph + 1, 0);
+                }
+                startMasks_[glyph] |= bit;
+            }
+        }
+    }
+
+    return !active_.empty();
+}
+
+void GlyphSubstitution::compileLookup(BinaryStream& stream, size_t lookupListOffset, uint16_t index, int depth) {
+    if (index >= lookups_.size() || lookups_[index].compiled || depth > MAX_NESTING) {
+        return;
+    }
+
+    Lookup& lookup = lookups_[index];
+    lookup.compiled = true;
+
+    stream.seek(lookupListOffset + 2 + index * 2);
+    const size_t lookupOffset = lookupListOffset + stream.readU16();
+    stream.seek(lookupOffset);
+    auto type = static_cast<LookupType>(stream.readU16());
+    lookup.flags = stream.readU16();
+    const std::vector<uint16_t> subtableOffsets = readU16Array(stream, stream.readU16());
+
+    std::vector<Subtable> subtables;
+    for (uint16_t subtableOffset : subtableOffsets) {
+        size_t offset = lookupOffset + subtableOffset;
+        LookupType subtableType = type;
+
+        // Extension subtables wrap the real one behind a 32-bit offset
+        if (type == LookupType::Extension) {
+            stream.seek(offset);
+            stream.skip(2); // format
+            subtableType = static_cast<LookupType>(stream.readU16());
+            offset += stream.readU32();
+        }
+
+        Subtable subtable;
+        if (compileSubtable(stream, offset, subtableType, subtable)) {
+            subtables.push_back(std::move(subtable));
+        }
+    }
+
+    lookup.subtables = std::move(subtables);
+    for (const auto& subtable : lookup.subtables) {
+        mergeBits(lookup.coverageBits, subtable.coverage.getBits());
+    }
+
+    // Lookups called from context rules (lookups_ is pre-sized, so references stay valid)
+    for (const auto& subtable : lookup.subtables) {
+        for (const auto& record : subtable.records) {
+            compileLookup(stream, lookupListOffset, record.lookupIndex, depth + 1);
+        }
+    }
+}
+
+bool GlyphSubstitution::compileSubtable(BinaryStream& stream, size_t offset, LookupType type, Subtable& subtable) {
+    stream.seek(offset);
+    subtable.type = type;
+    subtable.format = stream.readU16();
+
+    switch (type) {
+    case LookupType::Single: {
+        const uint16_t coverage = stream.readU16();
+        if (subtable.format == 1) {
+            subtable.delta = stream.readI16();
+        } else if (subtable.format == 2) {
+            subtable.outputs = readU16Array(stream, stream.readU16());
+        } else {
+            return false;
+        }
+        subtable.coverage.load(stream, offset + coverage);
+        return true;
+    }
+
+    case LookupType::Multiple:
+    case LookupType::Alternate: {
+        if (subtable.format != 1) {
+            return false;
+        }
+        const uint16_t coverage = stream.readU16();
+        const std::vector<uint16_t> sequences = readU16Array(stream, stream.readU16());
+
+        subtable.outputStarts.push_back(0);
+        for (uint16_t sequence : sequences) {
+            stream.seek(offset + sequence);
+            for (uint16_t glyph : readU16Array(stream, stream.readU16())) {
+                subtable.outputs.push_back(glyph);
+            }
+            subtable.outputStarts.push_back(static_cast<uint32_t>(subtable.outputs.size()));
+        }
+        subtable.coverage.load(stream, offset + coverage);
+        return true;
+    }
+
+    case LookupType::Ligature: {
+        if (subtable.format != 1) {
+            return false;
+        }
+        const uint16_t coverage = stream.readU16();
+        const std::vector<uint16_t> ligatureSets = readU16Array(stream, stream.readU16());
+        subtable.coverage.load(stream, offset + coverage);
+
+        const auto& firstGlyphs = subtable.coverage.getGlyphs();
+        const size_t setCount = std::min(ligatureSets.size(), firstGlyphs.size());
+
+        // Build each set as a map-based trie, then flatten so that a node's
+        // children are contiguous and sorted. Roots take the first slots.
+        struct BuildNode {
+            std::map<uint16_t, size_t> children;
+            uint32_t ligature = NO_LIGATURE;
+        };
+
+        subtable.trie.resize(setCount);
+        for (size_t set = 0; set < setCount; ++set) {
+            std::vector<BuildNode> nodes(1);
+
+            stream.seek(offset + ligatureSets[set]);
+            const size_t setOffset = offset + ligatureSets[set];
+            const std::vector<uint16_t> ligatures = readU16Array(stream, stream.readU16());
+            for (uint16_t ligatureOffset : ligatures) {
+                stream.seek(setOffset + ligatureOffset);
+                const uint16_t ligatureGlyph = stream.readU16();
+                const uint16_t componentCount = stream.readU16();
+                if (componentCount == 0 || componentCount > MAX_CONTEXT_LENGTH) {
+                    continue;
+                }
+
+                size_t node = 0;
+                for (uint16_t component : readU16Array(stream, componentCount - 1u)) {
+                    auto it = nodes[node].children.find(component);
+                    if (it == nodes[node].children.end()) {
+                        nodes.emplace_back();
+                        it = nodes[node].children.emplace(component, nodes.size() - 1).first;
+                    }
+                    node = it->second;
+                }
+
+                // Earlier ligatures take precedence, as in the font's order
+                if (nodes[node].ligature == NO_LIGATURE) {
+                    nodes[node].ligature = ligatureGlyph;
+                }
+            }
+
+            subtable.trie[set].glyphID = firstGlyphs[set];
+            subtable.trie[set].ligature = nodes[0].ligature;
+
+            std::vector<std::pair<size_t, size_t>> pending = {{0, set}}; // (build node, trie node)
+            while (!pending.empty()) {
+                auto [source, target] = pending.back();
+                pending.pop_back();
+
+                const auto firstChild = static_cast<uint32_t>(subtable.trie.size());
+                subtable.trie[target].firstChild = firstChild;
+                subtable.trie[target].childCount = static_cast<uint16_t>(nodes[source].children.size());
+                for (const auto& [glyph, child] : nodes[source].children) {
+                    LigatureNode node;
+                    node.glyphID = glyph;
+                    node.ligature = nodes[child].ligature;
+                    pending.emplace_back(child, subtable.trie.size());
+                    subtable.trie.push_back(node);
+                }
+            }
+        }
+        return true;
+    }
+
+    case LookupType::Context:
+        compileContext(stream, offset, subtable);
+        return subtable.format >= 1 && subtable.format <= 3;
+
+    case LookupType::ChainContext:
+        compileChainContext(stream, offset, subtable);
+        return subtable.format >= 1 && subtable.format <= 3;
+
+    default:
+        // Reverse chaining (8) only matters for Arabic-style right-to-left contexts
+        return false;
+    }
+}
+
+void GlyphSubstitution::readRule(BinaryStream& stream, Subtable& subtable, bool chained) {
+    ContextRule rule;
+
+    auto readSequence = [&](uint32_t& start, uint16_t& count, uint16_t length) {
+        start = static_cast<uint32_t>(subtable.values.size());
+        count = length;
+        for (uint16_t value : readU16Array(stream, length)) {
+            subtable.values.push_back(value);
+        }
+    };
+
+    if (chained) {
+        readSequence(rule.backtrack, rule.backtrackCount, stream.readU16());
+    }
+
+    // The first input item is implied by the rule set and not stored
+    const uint16_t inputLength = stream.readU16();
+    uint16_t lookupCount = 0;
+    if (!chained) {
+        lookupCount = stream.readU16();
+    }
+    if (inputLength == 0) {
+        return;
+    }
+    readSequence(rule.input, rule.inputCount, static_cast<uint16_t>(inputLength - 1));
+
+    if (chained) {
+        readSequence(rule.lookahead, rule.lookaheadCount, stream.readU16());
+        lookupCount = stream.readU16();
+    }
+
+    rule.firstRecord = static_cast<uint32_t>(subtable.records.size());
+    rule.recordCount = lookupCount;
+    for (uint16_t i = 0; i < lookupCount; ++i) {
+        SequenceLookup record;
+        record.sequenceIndex = stream.readU16();
+        record.lookupIndex = stream.readU16();
+        subtable.records.push_back(record);
+    }
+
+    if (size_t{rule.backtrackCount} + rule.inputCount + rule.lookaheadCount < MAX_CONTEXT_LENGTH) {
+        subtable.rules.push_back(rule);
+    }
+}
+
+void GlyphSubstitution::compileContext(BinaryStream& stream, size_t offset, Subtable& subtable) {
+    if (subtable.format == 3) {
+        const uint16_t glyphCount = stream.readU16();
+        const uint16_t lookupCount = stream.readU16();
+        const std::vector<uint16_t> coverageOffsets = readU16Array(stream, glyphCount);
+        if (glyphCount == 0) {
+            return;
+        }
+
+        ContextRule rule;
+        rule.input = static_cast<uint32_t>(subtable.values.size());
+        rule.inputCount = static_cast<uint16_t>(glyphCount - 1);
+        rule.recordCount = lookupCount;
+        for (uint16_t i = 0; i < lookupCount; ++i) {
+            SequenceLookup record;
+            record.sequenceIndex = stream.readU16();
+            record.lookupIndex = stream.readU16();
+            subtable.records.push_back(record);
+        }
+
+        subtable.coverages.resize(glyphCount);
+        for (uint16_t i = 0; i < glyphCount; ++i) {
+            subtable.coverages[i].load(stream, offset + coverageOffsets[i]);
+            if (i > 0) {
+                subtable.values.push_back(i);
+            }
+        }
+        subtable.coverage = subtable.coverages[0];
+        subtable.rules.push_back(rule);
+        subtable.ruleStarts = {0, 1};
+        return;
+    }
+
+    const uint16_t coverage = stream.readU16();
+    uint16_t classDef = 0;
+    if (subtable.format == 2) {
+        classDef = stream.readU16();
+    }
+    const std::vector<uint16_t> ruleSets = readU16Array(stream, stream.readU16());
+
+    subtable.ruleStarts.push_back(0);
+    for (uint16_t ruleSet : ruleSets) {
+        if (ruleSet != 0) {
+            const size_t setOffset = offset + ruleSet;
+            stream.seek(setOffset);
+            for (uint16_t ruleOffset : readU16Array(stream, stream.readU16())) {
+                stream.seek(setOffset + ruleOffset);
+                readRule(stream, subtable, false);
+            }
+        }
+        subtable.ruleStarts.push_back(static_cast<uint32_t>(subtable.rules.size()));
+    }
+
+    subtable.coverage.load(stream, offset + coverage);
+    if (classDef != 0) {
+        subtable.inputClasses.load(stream, offset + classDef);
+    }
+}
+
+void GlyphSubstitution::compileChainContext(BinaryStream& stream, size_t offset, Subtable& subtable) {
+    if (subtable.format == 3) {
+        // Coverages are numbered backtrack, input, lookahead; rule values index them
+        std::vector<uint16_t> coverageOffsets;
+        ContextRule rule;
+
+        auto readCoverages = [&](uint32_t& start, uint16_t& count) {
+            count = stream.readU16();
+            start = static_cast<uint32_t>(subtable.values.size());
+            for (uint16_t coverageOffset : readU16Array(stream, count)) {
+                subtable.values.push_back(static_cast<uint16_t>(coverageOffsets.size()));
+                coverageOffsets.push_back(coverageOffset);
+            }
+        };
+
+        readCoverages(rule.backtrack, rule.backtrackCount);
+        readCoverages(rule.input, rule.inputCount);
+        readCoverages(rule.lookahead, rule.lookaheadCount);
+        if (rule.inputCount == 0) {
+            return;
+        }
+
+        rule.recordCount = stream.readU16();
+        for (uint16_t i = 0; i < rule.recordCount; ++i) {
+            SequenceLookup record;
+            record.sequenceIndex = stream.readU16();
+            record.lookupIndex = stream.readU16();
+            subtable.records.push_back(record);
+        }
+
+        subtable.coverages.resize(coverageOffsets.size());
+        for (size_t i = 0; i < coverageOffsets.size(); ++i) {
+            subtable.coverages[i].load(stream, offset + coverageOffsets[i]);
+        }
+        subtable.coverage = subtable.coverages[subtable.values[rule.input]];
+
+        ++rule.input;
+        --rule.inputCount;
+        if (size_t{rule.backtrackCount} + rule.inputCount + rule.lookaheadCount < MAX_CONTEXT_LENGTH) {
+            subtable.rules.push_back(rule);
+        }
+        subtable.ruleStarts = {0, static_cast<uint32_t>(subtable.rules.size())};
+        return;
+    }
+
+    const uint16_t coverage = stream.readU16();
+    uint16_t backtrackClassDef = 0, inputClassDef = 0, lookaheadClassDef = 0;
+    if (subtable.format == 2) {
+        backtrackClassDef = stream.readU16();
+        inputClassDef = stream.readU16();
+        lookaheadClassDef = stream.readU16();
+    }
+    const std::vector<uint16_t> ruleSets = readU16Array(stream, stream.readU16());
+
+    subtable.ruleStarts.push_back(0);
+    for (uint16_t ruleSet : ruleSets) {
+        if (ruleSet != 0) {
+            const size_t setOffset = offset + ruleSet;
+            stream.seek(setOffset);
+            for (uint16_t ruleOffset : readU16Array(stream, stream.readU16())) {
+                stream.seek(setOffset + ruleOffset);
+                readRule(stream, subtable, true);
+            }
+        }
+        subtable.ruleStarts.push_back(static_cast<uint32_t>(subtable.rules.size()));
+    }
+
+    subtable.coverage.load(stream, offset + coverage);
+    if (backtrackClassDef != 0) {
+        subtable.backtrackClasses.load(stream, offset + backtrackClassDef);
+    }
+    if (inputClassDef != 0) {
+        subtable.inputClasses.load(stream, offset + inputClassDef);
+    }
+    if (lookaheadClassDef != 0) {
+        subtable.lookaheadClasses.load(stream, offset + lookaheadClassDef);
+    }
+}
+
+// ============================================================================
+// GlyphSubstitution: Application
+// ============================================================================
+
+uint64_t GlyphSubstitution::startMask(const std::vector<ShapedGlyph>& glyphs) const {
+    uint64_t mask = 0;
+    for (const auto& glyph : glyphs) {
+        if (glyph.glyphID < startMasks_.size()) {
+            mask |= startMasks_[glyph.glyphID];
+        }
+    }
+    return mask;
+}
+
+bool GlyphSubstitution::apply(std::vector<ShapedGlyph>& glyphs) const {
+    if (active_.empty()) {
+        return false;
+    }
+
+    // One pass finds the lookups anything in the buffer can start; most words need none
+    uint64_t pending = startMask(glyphs);
+    if (pending == 0) {
+        return false;
+    }
+
+    bool changed = false;
+    for (size_t k = 0; k < active_.size(); ++k) {
+        const uint64_t bit = uint64_t{1} << std::min<size_t>(k, 63);
+        if ((pending & bit) == 0) {
+            continue;
+        }
+
+        // A matched context rule whose nested lookups do nothing leaves the buffer as is
+        const Lookup& lookup = lookups_[active_[k]];
+        bool modified = false;
+        for (size_t i = 0; i < glyphs.size();) {
+            const uint32_t glyphID = glyphs[i].glyphID;
+            if (!testBit(lookup.coverageBits, glyphID) || skips(glyphID, lookup.flags) || !applyAt(lookup, glyphs, i, 0, modified)) {
+                ++i;
+            }
+        }
+
+        // New glyphs may start later lookups
+        if (modified) {
+            pending |= startMask(glyphs);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+bool GlyphSubstitution::skips(uint32_t glyphID, uint16_t flags) const {
+    if ((flags & (IGNORE_BASE_GLYPHS | IGNORE_LIGATURES | IGNORE_MARKS | MARK_ATTACHMENT_TYPE)) == 0) {
+        return false;
+    }
+
+    const uint16_t glyphClass = glyphClasses_.classOf(glyphID);
+    switch (glyphClass) {
+    case GLYPH_CLASS_BASE:
+        return (flags & IGNORE_BASE_GLYPHS) != 0;
+    case GLYPH_CLASS_LIGATURE:
+        return (flags & IGNORE_LIGATURES) != 0;
+    case GLYPH_CLASS_MARK:
+        if (flags & IGNORE_MARKS) {
+            return true;
+        }
+        // Mark filtering sets are not compiled; such lookups see every mark
+        if ((flags & MARK_ATTACHMENT_TYPE) != 0 && (flags & USE_MARK_FILTERING_SET) == 0) {
+            return markAttachClasses_.classOf(glyphID) != (flags >> 8);
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+size_t GlyphSubstitution::nextIndex(const std::vector<ShapedGlyph>& glyphs, size_t index, uint16_t flags) const {
+    for (size_t i = index + 1; i < glyphs.size(); ++i) {
+        if (!skips(glyphs[i].glyphID, flags)) {
+            return i;
+        }
+    }
+    return NONE;
+}
+
+size_t GlyphSubstitution::prevIndex(const std::vector<ShapedGlyph>& glyphs, size_t index, uint16_t flags) const {
+    for (size_t i = index; i-- > 0;) {
+        if (!skips(glyphs[i].glyphID, flags)) {
+            return i;
+        }
+    }
+    return NONE;
+}
+
+bool GlyphSubstitution::applyAt(const Lookup& lookup, std::vector<ShapedGlyph>& glyphs, size_t& index, int depth, bool& changed) const {
+    for (const auto& subtable : lookup.subtables) {
+        if (applySubtable(lookup, subtable, glyphs, index, depth, changed)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool GlyphSubstitution::applySubtable(const Lookup& lookup, const Subtable& subtable, std::vector<ShapedGlyph>& glyphs, size_t& index, int depth, bool& changed) const {
+    if (!subtable.coverage.contains(glyphs[index].glyphID)) {
+        return false;
+    }
+    if (subtable.type == LookupType::Context || subtable.type == LookupType::ChainContext) {
+        return applyContext(lookup, subtable, glyphs, index, depth, changed);
+    }
+    const auto covered = static_cast<size_t>(subtable.coverage.indexOf(glyphs[index].glyphID));
+
+    switch (subtable.type) {
+    case LookupType::Single:
+        if (subtable.format == 1) {
+            glyphs[index].glyphID = (glyphs[index].glyphID + subtable.delta) & 0xFFFF;
+        } else if (covered < subtable.outputs.size()) {
+            glyphs[index].glyphID = subtable.outputs[covered];
+        } else {
+            return false;
+        }
+        changed = true;
+        ++index;
+        return true;
+
+    case LookupType::Multiple:
+    case LookupType::Alternate: {
+        if (covered + 1 >= subtable.outputStarts.size()) {
+            return false;
+        }
+        const uint32_t start = subtable.outputStarts[covered];
+        uint32_t end = subtable.outputStarts[covered + 1];
+        if (subtable.type == LookupType::Alternate) {
+            end = std::min(end, start + 1); // No alternate selection UI: use the first
+        }
+
+        changed = true;
+        if (start == end) {
+            glyphs.erase(glyphs.begin() + static_cast<std::ptrdiff_t>(index)); // Deletion
+            return true;
+        }
+
+        // Every output glyph keeps the input's cluster
+        ShapedGlyph glyph = glyphs[index];
+        glyphs[index].glyphID = subtable.outputs[start];
+        glyphs.insert(glyphs.begin() + static_cast<std::ptrdiff_t>(index + 1), end - start - 1, glyph);
+        for (uint32_t i = start + 1; i < end; ++i) {
+            glyphs[index + (i - start)].glyphID = subtable.outputs[i];
+        }
+        index += end - start;
+        return true;
+    }
+
+    case LookupType::Ligature: {
+        if (covered >= subtable.trie.size()) {
+            return false;
+        }
+
+        // Walk the trie as far as the text allows, remembering the longest ligature
+        std::array<size_t, MAX_CONTEXT_LENGTH> matched;
+        size_t matchedCount = 0;
+        size_t ligatureLength = 0;
+        uint32_t ligature = subtable.trie[covered].ligature;
+
+        const LigatureNode* node = &subtable.trie[covered];
+        size_t position = index;
+        while (node->childCount > 0 && matchedCount < matched.size()) {
+            position = nextIndex(glyphs, position, lookup.flags);
+            if (position == NONE) {
+                break;
+            }
+
+            const LigatureNode* first = subtable.trie.data() + node->firstChild;
+            const LigatureNode* last = first + node->childCount;
+            const uint32_t glyphID = glyphs[position].glyphID;
+            const LigatureNode* child = std::lower_bound(first, last, glyphID, [](const LigatureNode& n, uint32_t id) { return n.glyphID < id; });
+            if (child == last || child->glyphID != glyphID) {
+                break;
+            }
+
+            matched[matchedCount++] = position;
+            if (child->ligature != NO_LIGATURE) {
+                ligature = child->ligature;
+                ligatureLength = matchedCount;
+            }
+            node = child;
+        }
+
+        if (ligature == NO_LIGATURE) {
+            return false;
+        }
+
+        changed = true;
+        glyphs[index].glyphID = ligature;
+        for (size_t i = ligatureLength; i-- > 0;) {
+            glyphs.erase(glyphs.begin() + static_cast<std::ptrdiff_t>(matched[i]));
+        }
+        ++index;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+bool GlyphSubstitution::matchesItem(const Subtable& subtable, Sequence sequence, uint32_t glyphID, uint16_t value) const {
+    switch (subtable.format) {
+    case 1:
+        return glyphID == value;
+    case 2: {
+        const GlyphClassDef* classes = &subtable.inputClasses;
+        if (subtable.type == LookupType::ChainContext) {
+            if (sequence == Sequence::Backtrack) {
+                classes = &subtable.backtrackClasses;
+            } else if (sequence == Sequence::Lookahead) {
+                classes = &subtable.lookaheadClasses;
+            }
+        }
+        return classes->classOf(glyphID) == value;
+    }
+    default:
+        return value < subtable.coverages.size() && subtable.coverages[value].contains(glyphID);
+    }
+}
+
+bool GlyphSubstitution::applyContext(const Lookup& lookup, const Subtable& subtable, std::vector<ShapedGlyph>& glyphs, size_t& index, int depth, bool& changed) const {
+    // Pick the rule set: by coverage index, by input class, or the single format 3 rule
+    size_t ruleSet = 0;
+    if (subtable.format == 1) {
+        ruleSet = static_cast<size_t>(subtable.coverage.indexOf(glyphs[index].glyphID));
+    } else if (subtable.format == 2) {
+        ruleSet = subtable.inputClasses.classOf(glyphs[index].glyphID);
+    }
+    if (ruleSet + 1 >= subtable.ruleStarts.size()) {
+        return false;
+    }
+
+    std::array<size_t, MAX_CONTEXT_LENGTH> positions;
+
+    for (uint32_t r = subtable.ruleStarts[ruleSet]; r < subtable.ruleStarts[ruleSet + 1]; ++r) {
+        const ContextRule& rule = subtable.rules[r];
+
+        // Input, after the glyph at index
+        positions[0] = index;
+        size_t count = 1;
+        bool matched = true;
+        for (uint16_t i = 0; i < rule.inputCount && matched; ++i) {
+            const size_t next = nextIndex(glyphs, positions[count - 1], lookup.flags);
+            matched = next != NONE && matchesItem(subtable, Sequence::Input, glyphs[next].glyphID, subtable.values[rule.input + i]);
+            positions[count++] = next;
+        }
+
+        // Backtrack runs right to left from the first input glyph
+        size_t position = index;
+        for (uint16_t i = 0; i < rule.backtrackCount && matched; ++i) {
+            position = prevIndex(glyphs, position, lookup.flags);
+            matched = position != NONE && matchesItem(subtable, Sequence::Backtrack, glyphs[position].glyphID, subtable.values[rule.backtrack + i]);
+        }
+
+        position = positions[count - 1];
+        for (uint16_t i = 0; i < rule.lookaheadCount && matched; ++i) {
+            position = nextIndex(glyphs, position, lookup.flags);
+            matched = position != NONE && matchesItem(subtable, Sequence::Lookahead, glyphs[position].glyphID, subtable.values[rule.lookahead + i]);
+        }
+
+        if (!matched) {
+            continue;
+        }
+
+        // Run the nested lookups; positions after an edit shift by the length change
+        size_t end = positions[count - 1] + 1;
+        for (uint16_t i = 0; i < rule.recordCount && depth < MAX_NESTING; ++i) {
+            const SequenceLookup& record = subtable.records[rule.firstRecord + i];
+            if (record.sequenceIndex >= count || record.lookupIndex >= lookups_.size()) {
+                continue;
+            }
+
+            const Lookup& nested = lookups_[record.lookupIndex];
+            size_t at = positions[record.sequenceIndex];
+            if (at >= glyphs.size() || !testBit(nested.coverageBits, glyphs[at].glyphID)) {
+                continue;
+            }
+
+            const size_t before = glyphs.size();
+            if (!applyAt(nested, glyphs, at, depth + 1, changed)) {
+                continue;
+            }
+
+            const auto delta = static_cast<std::ptrdiff_t>(glyphs.size()) - static_cast<std::ptrdiff_t>(before);
+            if (delta != 0) {
+                for (size_t k = record.sequenceIndex + 1; k < count; ++k) {
+                    positions[k] = static_cast<size_t>(std::max<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(positions[k]) + delta, 0));
+                }
+                end = static_cast<size_t>(std::max<std::ptrdiff_t>(static_cast<std::ptrdiff_t>(end) + delta, static_cast<std::ptrdiff_t>(index) + 1));
+            }
+        }
+
+        index = std::min(end, glyphs.size());
+        return true;
+    }
+
+    return false;
+}
+
+// ============================================================================
+// GlyphPositioning
+// ============================================================================
+
+bool GlyphPositioning::load(const uint8_t* data, size_t size, uint32_t scriptTag, const std::vector<uint32_t>& features) {
+    tables_.clear();
+    if (!data || size < 10) {
+        return false;
+    }
+
+    BinaryStream stream(data, size);
+    stream.skip(4); // version
+    const size_t scriptList = stream.readU16();
+    const size_t featureList = stream.readU16();
+    const size_t lookupList = stream.readU16();
+
+    const std::vector<uint16_t> enabled = collectLookups(stream, scriptList, featureList, scriptTag, features);
+
+    stream.seek(lookupList);
+    const uint16_t lookupCount = stream.readU16();
+    for (uint16_t index : enabled) {
+        if (index < lookupCount) {
+            compileLookup(stream, lookupList, index);
+        }
+    }
+
+    return !tables_.empty();
+}
+
+bool GlyphPositioning::loadKern(const uint8_t* data, size_t size) {
+    tables_.clear();
+    if (!data || size < 4) {
+        return false;
+    }
+
+    BinaryStream stream(data, size);
+    if (stream.readU16() != 0) {
+        return false; // Apple's version 1 table
+    }
+
+    const uint16_t subtableCount = stream.readU16();
+    size_t offset = 4;
+    for (uint16_t i = 0; i < subtableCount && offset + 6 <= size; ++i) {
+        stream.seek(offset);
+        stream.skip(2); // version
+        const uint16_t length = stream.readU16();
+        const uint16_t coverage = stream.readU16();
+
+        // Format 0, horizontal, kerning values (not minimums), not cross-stream
+        if ((coverage >> 8) == 0 && (coverage & 0x0007) == 0x0001) {
+            const uint16_t pairCount = stream.readU16();
+            stream.skip(6); // searchRange, entrySelector, rangeShift
+
+            std::vector<KerningPair> pairs(std::min<size_t>(pairCount, (size - std::min(size, stream.tell())) / 6));
+            for (auto& pair : pairs) {
+                pair.left = stream.readU16();
+                pair.right = stream.readU16();
+                pair.value = stream.readI16();
+            }
+            loadPairs(pairs);
+        }
+
+        if (length < 6) {
+            break;
+        }
+        offset += length;
+    }
+
+    return !tables_.empty();
+}
+
+bool GlyphPositioning::loadPairs(const std::vector<KerningPair>& pairs) {
+    if (pairs.empty()) {
+        return false;
+    }
+    PairTable table;
+    buildPairs(table, pairs);
+    tables_.push_back(std::move(table));
+    return true;
+}
+
+void GlyphPositioning::compileLookup(BinaryStream& stream, size_t lookupListOffset, uint16_t index) {
+    stream.seek(lookupListOffset + 2 + index * 2);
+    const size_t lookupOffset = lookupListOffset + stream.readU16();
+    stream.seek(lookupOffset);
+    const uint16_t type = stream.readU16();
+    stream.skip(2); // lookupFlag
+    const std::vector<uint16_t> subtableOffsets = readU16Array(stream, stream.readU16());
+
+    // Subtables are tried in order, so earlier ones shadow later ones per first glyph
+    PairTable table;
+    std::vector<KerningPair> pairs;
+    for (uint16_t subtableOffset : subtableOffsets) {
+        size_t offset = lookupOffset + subtableOffset;
+        uint16_t subtableType = type;
+        if (type == GPOS_EXTENSION) {
+            stream.seek(offset);
+            stream.skip(2); // format
+            subtableType = stream.readU16();
+            offset += stream.readU32();
+        }
+        if (subtableType == GPOS_PAIR_ADJUSTMENT) {
+            compilePairSubtable(stream, offset, table, pairs);
+        }
+    }
+
+    buildPairs(table, pairs);
+    if (!table.pairFirsts.empty() || !table.classSubtables.empty()) {
+        tables_.push_back(std::move(table));
+    }
+}
+
+void GlyphPositioning::compilePairSubtable(BinaryStream& stream, size_t offset, PairTable& table, std::vector<KerningPair>& pairs) const {
+    stream.seek(offset);
+    const uint16_t format = stream.readU16();
+    const uint16_t coverageOffset = stream.readU16();
+    const uint16_t valueFormat1 = stream.readU16();
+    const uint16_t valueFormat2 = stream.readU16();
+    const size_t record2Size = 2 * static_cast<size_t>(std::popcount(static_cast<uint16_t>(valueFormat2 & 0xFF)));
+
+    // A first glyph already claimed by an earlier class subtable never reaches this one
+    auto claimed = [&table](uint16_t glyph) { return glyph < table.firstClasses.size() && table.firstClasses[glyph] != 0; };
+
+    if (format == 1) {
+        const std::vector<uint16_t> pairSets = readU16Array(stream, stream.readU16());
+        GlyphCoverage coverage;
+        coverage.load(stream, offset + coverageOffset);
+        const auto& firsts = coverage.getGlyphs();
+
+        for (size_t i = 0; i < pairSets.size() && i < firsts.size(); ++i) {
+            if (claimed(firsts[i])) {
+                continue;
+            }
+            stream.seek(offset + pairSets[i]);
+            const uint16_t pairCount = stream.readU16();
+            for (uint16_t j = 0; j < pairCount && !stream.eof(); ++j) {
+                KerningPair pair;
+                pair.left = firsts[i];
+                pair.right = stream.readU16();
+                pair.value = readXAdvance(stream, valueFormat1);
+                stream.skip(record2Size);
+                pairs.push_back(pair);
+            }
+        }
+    } else if (format == 2) {
+        const uint16_t classDef1 = stream.readU16();
+        const uint16_t classDef2 = stream.readU16();
+        const uint16_t class1Count = stream.readU16();
+        const uint16_t class2Count = stream.readU16();
+
+        // The class matrix must fit in the table
+        const size_t recordSize = 2 * static_cast<size_t>(std::popcount(static_cast<uint16_t>(valueFormat1 & 0xFF))) + record2Size;
+        const size_t cellCount = size_t{class1Count} * class2Count;
+        if (class1Count == 0 || class2Count == 0 || cellCount * recordSize > stream.size() - stream.tell()) {
+            return;
+        }
+
+        ClassSubtable subtable;
+        subtable.class2Count = class2Count;
+        subtable.values.resize(cellCount);
+        for (auto& value : subtable.values) {
+            value = readXAdvance(stream, valueFormat1);
+            stream.skip(record2Size);
+        }
+
+        GlyphClassDef firstClasses;
+        if (classDef1 != 0) {
+            firstClasses.load(stream, offset + classDef1);
+        }
+        if (classDef2 != 0) {
+            subtable.secondClasses.load(stream, offset + classDef2);
+        }
+
+        GlyphCoverage coverage;
+        coverage.load(stream, offset + coverageOffset);
+        const auto tag = static_cast<uint32_t>(table.classSubtables.size() + 1) << 16;
+        for (uint16_t glyph : coverage.getGlyphs()) {
+            const uint16_t class1 = firstClasses.classOf(glyph);
+            if (claimed(glyph) || class1 >= class1Count) {
+                continue;
+            }
+            if (glyph >= table.firstClasses.size()) {
+                table.firstClasses.resize(glyph + 1, 0);
+            }
+            table.firstClasses[glyph] = tag | class1;
+        }
+        table.classSubtables.push_back(std::move(subtable));
+    }
+}
+
+void GlyphPositioning::buildPairs(PairTable& table, const std::vector<KerningPair>& pairs) {
+    table.slots.assign(pairs.empty() ? 0 : std::bit_ceil(pairs.size() * 2), PairSlot{});
+    table.pairFirsts.clear();
+
+    const size_t mask = table.slots.size() - 1;
+    for (const KerningPair& pair : pairs) {
+        const uint32_t key = (static_cast<uint32_t>(pair.left) << 16) | pair.right;
+        size_t slot = (key * 0x9E3779B1u) & mask;
+        while (table.slots[slot].key != EMPTY_PAIR && table.slots[slot].key != key) {
+            slot = (slot + 1) & mask;
+        }
+        if (table.slots[slot].key == EMPTY_PAIR) {
+            table.slots[slot] = {key, pair.value};
+            setBit(table.pairFirsts, pair.left);
+        }
+    }
+}
+
+int32_t GlyphPositioning::lookupPair(const PairTable& table, uint32_t left, uint32_t right) {
+    if (testBit(table.pairFirsts, left)) {
+        const uint32_t key = (left << 16) | (right & 0xFFFF);
+        const size_t mask = table.slots.size() - 1;
+        for (size_t slot = (key * 0x9E3779B1u) & mask; table.slots[slot].key != EMPTY_PAIR; slot = (slot + 1) & mask) {
+            if (table.slots[slot].key == key) {
+                return table.slots[slot].value;
+            }
+        }
+    }
+
+    if (left < table.firstClasses.size() && table.firstClasses[left] != 0) {
+        const ClassSubtable& subtable = table.classSubtables[(table.firstClasses[left] >> 16) - 1];
+        const uint16_t class2 = subtable.secondClasses.classOf(right);
+        if (class2 < subtable.class2Count) {
+            return subtable.values[(table.firstClasses[left] & 0xFFFF) * subtable.class2Count + class2];
+        }
+    }
+    return 0;
+}
+
+int32_t GlyphPositioning::getKerning(uint32_t left, uint32_t right) const {
+    int32_t value = 0;
+    for (const auto& table : tables_) {
+        value += lookupPair(table, left, right);
+    }
+    return value;
+}
+
+void GlyphPositioning::apply(std::vector<ShapedGlyph>& glyphs) const {
+    for (size_t i = 0; i + 1 < glyphs.size(); ++i) {
+        glyphs[i].xAdvance += static_cast<float>(getKerning(glyphs[i].glyphID, glyphs[i + 1].glyphID));
+    }
+}
+
+} // namespace dakt::gui
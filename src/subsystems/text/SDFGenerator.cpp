@@ -14,282 +14,768 @@ SDFGenerator::~SDFGenerator() = default;
 
 Shape SDFGenerator::outlineToShape(const GlyphOutline& outline, float scale) {
     Shape shape;
-
     for (const auto& glyphContour : outline.contours) {
-        if (glyphContour.points.empty())
-            continue;
+        appendContour(glyphContour.points.data(), glyphContour.points.size(), scale, shape);
+    }
+    return shape;
+}
 
-        Contour contour;
-        const auto& points = glyphContour.points;
-        size_t n = points.size();
-
-        // Process points into edge segments
-        // TrueType uses quadratic beziers with on-curve and off-curve points
-        size_t i = 0;
-        while (i < n) {
-            // Find starting on-curve point
-            size_t startIdx = i;
-            while (!points[startIdx % n].onCurve && startIdx < i + n) {
-                ++startIdx;
-            }
-            if (startIdx >= i + n) {
-                // No on-curve points, create implied midpoint
-                Vec2 p0((points[i].x + points[(i + 1) % n].x) * 0.5f * scale, (points[i].y + points[(i + 1) % n].y) * 0.5f * scale);
-                startIdx = i;
-            }
+Shape SDFGenerator::outlineToShape(const GlyphOutlineView& outline, float scale) {
+    Shape shape;
+    uint16_t start = 0;
+    for (uint16_t c = 0; c < outline.contourCount; ++c) {
+        appendContour(outline.points + start, outline.contourEnds[c] - start, scale, shape);
+        start = outline.contourEnds[c];
+    }
+    return shape;
+}
+
+void SDFGenerator::appendContour(const GlyphPoint* points, size_t n, float scale, Shape& shape) const {
+    if (n == 0)
+        return;
+
+    Contour contour;
 
-            Vec2 currentPoint(points[startIdx % n].x * scale, points[startIdx % n].y * scale);
-
-            for (size_t j = 1; j <= n; ++j) {
-                size_t idx = (startIdx + j) % n;
-                const auto& pt = points[idx];
-                Vec2 nextPoint(pt.x * scale, pt.y * scale);
-
-                if (pt.onCurve) {
-                    // Linear segment
-                    EdgeSegment edge;
-                    edge.type = EdgeSegment::Linear;
-                    edge.p0 = currentPoint;
-                    edge.p1 = nextPoint;
-                    contour.edges.push_back(edge);
-                    currentPoint = nextPoint;
+    // Process points into edge segments
+    // TrueType uses quadratic beziers with on-curve and off-curve points
+    size_t i = 0;
+    while (i < n) {
+        // Find starting on-curve point
+        size_t startIdx = i;
+        while (!points[startIdx % n].onCurve && startIdx < i + n) {
+            ++startIdx;
+        }
+        if (startIdx >= i + n) {
+            // No on-curve points, create implied midpoint
+            Vec2 p0((points[i].x + points[(i + 1) % n].x) * 0.5f * scale, (points[i].y + points[(i + 1) % n].y) * 0.5f * scale);
+            startIdx = i;
+        }
+
+        Vec2 currentPoint(points[startIdx % n].x * scale, points[startIdx % n].y * scale);
+
+        for (size_t j = 1; j <= n; ++j) {
+            size_t idx = (startIdx + j) % n;
+            const auto& pt = points[idx];
+            Vec2 nextPoint(pt.x * scale, pt.y * scale);
+
+            if (pt.onCurve) {
+                // Linear segment
+                EdgeSegment edge;
+                edge.type = EdgeSegment::Linear;
+                edge.p0 = currentPoint;
+                edge.p1 = nextPoint;
+                contour.edges.push_back(edge);
+                currentPoint = nextPoint;
+            } else {
+                // Off-curve point - quadratic bezier
+                // Look ahead for next point
+                size_t nextIdx = (idx + 1) % n;
+                const auto& nextPt = points[nextIdx];
+
+                Vec2 controlPoint = nextPoint;
+                Vec2 endPoint;
+
+                if (nextPt.onCurve) {
+                    endPoint = Vec2(nextPt.x * scale, nextPt.y * scale);
+                    ++j; // Skip the end point in outer loop
                 } else {
-                    // Off-curve point - quadratic bezier
-                    // Look ahead for next point
-                    size_t nextIdx = (idx + 1) % n;
-                    const auto& nextPt = points[nextIdx];
-
-                    Vec2 controlPoint = nextPoint;
-                    Vec2 endPoint;
-
-                    if (nextPt.onCurve) {
-                        endPoint = Vec2(nextPt.x * scale, nextPt.y * scale);
-                        ++j; // Skip the end point in outer loop
-                    } else {
-                        // Implied on-curve point between two off-curve points
-                        endPoint = (controlPoint + Vec2(nextPt.x * scale, nextPt.y * scale)) * 0.5f;
-                    }
-
-                    EdgeSegment edge;
-                    edge.type = EdgeSegment::Quadratic;
-                    edge.p0 = currentPoint;
-                    edge.p1 = controlPoint;
-                    edge.p2 = endPoint;
-                    contour.edges.push_back(edge);
-                    currentPoint = endPoint;
+                    // Implied on-curve point between two off-curve points
+                    endPoint = (controlPoint + Vec2(nextPt.x * scale, nextPt.y * scale)) * 0.5f;
                 }
-            }
 
-            break; // Only process once per contour
+                EdgeSegment edge;
+                edge.type = EdgeSegment::Quadratic;
+                edge.p0 = currentPoint;
+                edge.p1 = controlPoint;
+                edge.p2 = endPoint;
+                contour.edges.push_back(edge);
+                currentPoint = endPoint;
+            }
         }
 
-        // Calculate winding direction
-        float area = 0;
-        for (const auto& edge : contour.edges) {
-            area += (edge.p1.x - edge.p0.x) * (edge.p1.y + edge.p0.y);
-        }
-        contour.winding = (area > 0) ? 1 : -1;
+        break; // Only process once per contour
+    }
 
-        if (!contour.edges.empty()) {
-            shape.contours.push_back(contour);
-        }
+    // Calculate winding direction
+    float area = 0;
+    for (const auto& edge : contour.edges) {
+        area += (edge.p1.x - edge.p0.x) * (edge.p1.y + edge.p0.y);
     }
+    contour.winding = (area > 0) ? 1 : -1;
 
-    return shape;
+    if (!contour.edges.empty()) {
+        shape.contours.push_back(contour);
+    }
 }
 
 // ============================================================================
 // Distance Calculations
 // ============================================================================
 
-float SDFGenerator::distanceToLine(Vec2 p, Vec2 a, Vec2 b) const {
-    Vec2 ab = b - a;
-    Vec2 ap = p - a;
+namespace {
+
+// MSDF channel masks (EdgeSegment::color)
+constexpr int RED = 1;
+constexpr int GREEN = 2;
+constexpr int BLUE = 4;
+constexpr int YELLOW = RED | GREEN;
+constexpr int MAGENTA = RED | BLUE;
+constexpr int CYAN = GREEN | BLUE;
+constexpr int WHITE = RED | GREEN | BLUE;
+
+constexpr double PI = 3.14159265358979323846;
+
+// Corners sharper than this (radians off straight) split MSDF channels
+constexpr float CORNER_ANGLE = 3.0f;
+
+// Distance to an edge, positive on the filled side of a TrueType (clockwise) contour.
+// dot breaks ties between edges meeting at a corner: the edge the point is more
+// perpendicular to wins. param is the curve parameter of the closest point.
+struct EdgeDistance {
+    float distance = -std::numeric_limits<float>::max();
+    float dot = 1.0f;
+    float param = 0.0f;
+
+    bool closerThan(const EdgeDistance& other) const {
+        const float a = std::abs(distance), b = std::abs(other.distance);
+        return a < b || (a == b && dot < other.dot);
+    }
+};
 
-    float t = ab.dot(ap) / ab.dot(ab);
-    t = std::clamp(t, 0.0f, 1.0f);
+float nonZeroSign(float value) { return value > 0.0f ? 1.0f : -1.0f; }
 
-    Vec2 closest = a + ab * t;
-    return (p - closest).length();
+Vec2 pointAt(const EdgeSegment& edge, float t) {
+    const float u = 1.0f - t;
+    switch (edge.type) {
+    case EdgeSegment::Linear:
+        return Vec2::lerp(edge.p0, edge.p1, t);
+    case EdgeSegment::Quadratic:
+        return edge.p0 * (u * u) + edge.p1 * (2.0f * u * t) + edge.p2 * (t * t);
+    case EdgeSegment::Cubic:
+        return edge.p0 * (u * u * u) + edge.p1 * (3.0f * u * u * t) + edge.p2 * (3.0f * u * t * t) + edge.p3 * (t * t * t);
+    }
+    return edge.p0;
 }
 
-float SDFGenerator::distanceToQuadratic(Vec2 p, Vec2 p0, Vec2 p1, Vec2 p2) const {
-    // Solve for closest point on quadratic bezier
-    // B(t) = (1-t)²p0 + 2(1-t)t·p1 + t²p2
+Vec2 endPoint(const EdgeSegment& edge) {
+    return edge.type == EdgeSegment::Linear ? edge.p1 : edge.type == EdgeSegment::Quadratic ? edge.p2 : edge.p3;
+}
 
-    // Numerical approach: sample curve and find minimum
-    float minDist = std::numeric_limits<float>::max();
-    constexpr int SAMPLES = 16;
+// Tangent direction at t, falling back to the chord where control points coincide
+Vec2 directionAt(const EdgeSegment& edge, float t) {
+    switch (edge.type) {
+    case EdgeSegment::Linear:
+        return edge.p1 - edge.p0;
+    case EdgeSegment::Quadratic: {
+        const Vec2 tangent = Vec2::lerp(edge.p1 - edge.p0, edge.p2 - edge.p1, t);
+        return tangent.lengthSquared() > 0.0f ? tangent : edge.p2 - edge.p0;
+    }
+    case EdgeSegment::Cubic: {
+        const Vec2 tangent = Vec2::lerp(Vec2::lerp(edge.p1 - edge.p0, edge.p2 - edge.p1, t), Vec2::lerp(edge.p2 - edge.p1, edge.p3 - edge.p2, t), t);
+        if (tangent.lengthSquared() > 0.0f)
+            return tangent;
+        if (t == 0.0f)
+            return edge.p2 - edge.p0;
+        if (t == 1.0f)
+            return edge.p3 - edge.p1;
+        return edge.p3 - edge.p0;
+    }
+    }
+    return Vec2(1.0f, 0.0f);
+}
 
-    for (int i = 0; i <= SAMPLES; ++i) {
-        float t = static_cast<float>(i) / SAMPLES;
-        float u = 1.0f - t;
+int solveQuadratic(double x[2], double a, double b, double c) {
+    if (std::abs(a) < 1e-14) {
+        if (std::abs(b) < 1e-14)
+            return 0;
+        x[0] = -c / b;
+        return 1;
+    }
+    double discriminant = b * b - 4.0 * a * c;
+    if (discriminant < 0.0)
+        return 0;
+    discriminant = std::sqrt(discriminant);
+    x[0] = (-b + discriminant) / (2.0 * a);
+    x[1] = (-b - discriminant) / (2.0 * a);
+    return 2;
+}
 
-        Vec2 point = p0 * (u * u) + p1 * (2 * u * t) + p2 * (t * t);
-        float dist = (p - point).length();
-        minDist = std::min(minDist, dist);
+// Real roots of a*x^3 + b*x^2 + c*x + d (Cardano, trigonometric for three roots)
+int solveCubic(double x[3], double a, double b, double c, double d) {
+    if (std::abs(a) < 1e-14 || std::abs(b / a) > 1e7)
+        return solveQuadratic(x, b, c, d);
+
+    b /= a;
+    c /= a;
+    d /= a;
+    const double b2 = b * b;
+    const double q = (b2 - 3.0 * c) / 9.0;
+    const double r = (b * (2.0 * b2 - 9.0 * c) + 27.0 * d) / 54.0;
+    const double r2 = r * r;
+    const double q3 = q * q * q;
+    const double shift = b / 3.0;
+    if (r2 < q3) {
+        const double t = std::acos(std::clamp(r / std::sqrt(q3), -1.0, 1.0));
+        const double m = -2.0 * std::sqrt(q);
+        x[0] = m * std::cos(t / 3.0) - shift;
+        x[1] = m * std::cos((t + 2.0 * PI) / 3.0) - shift;
+        x[2] = m * std::cos((t - 2.0 * PI) / 3.0) - shift;
+        return 3;
+    }
+    double u = -std::copysign(std::cbrt(std::abs(r) + std::sqrt(r2 - q3)), r);
+    const double v = u == 0.0 ? 0.0 : q / u;
+    x[0] = (u + v) - shift;
+    if (u == v || std::abs(u - v) < 1e-12 * std::abs(u + v)) {
+        x[1] = -0.5 * (u + v) - shift;
+        return 2;
     }
+    return 1;
+}
 
-    // Refine with Newton-Raphson (optional, for higher precision)
-    // For now, the sampling is sufficient for SDF generation
+EdgeDistance lineDistance(const EdgeSegment& edge, Vec2 point) {
+    const Vec2 aq = point - edge.p0;
+    const Vec2 ab = edge.p1 - edge.p0;
+    const float lengthSquared = ab.lengthSquared();
+
+    EdgeDistance result;
+    result.param = lengthSquared > 0.0f ? aq.dot(ab) / lengthSquared : 0.0f;
+    const Vec2 eq = (result.param > 0.5f ? edge.p1 : edge.p0) - point;
+    const float endpointDistance = eq.length();
+    if (result.param > 0.0f && result.param < 1.0f) {
+        const float orthoDistance = aq.cross(ab) / std::sqrt(lengthSquared);
+        if (std::abs(orthoDistance) < endpointDistance) {
+            result.distance = orthoDistance;
+            result.dot = 0.0f;
+            return result;
+        }
+    }
+    result.distance = nonZeroSign(aq.cross(ab)) * endpointDistance;
+    result.dot = endpointDistance > 0.0f && lengthSquared > 0.0f ? std::abs(ab.normalized().dot(eq.normalized())) : 0.0f;
+    return result;
+}
 
-    return minDist;
+// Endpoint distances, then the closest interior point
+EdgeDistance curveEndpointDistance(const EdgeSegment& edge, Vec2 point) {
+    EdgeDistance result;
+    const Vec2 qa = edge.p0 - point;
+    Vec2 direction = directionAt(edge, 0.0f);
+    result.distance = nonZeroSign(direction.cross(qa)) * qa.length();
+    result.param = -qa.dot(direction) / direction.lengthSquared();
+
+    const Vec2 end = endPoint(edge);
+    const float endDistance = (end - point).length();
+    if (endDistance < std::abs(result.distance)) {
+        direction = directionAt(edge, 1.0f);
+        result.distance = nonZeroSign(direction.cross(end - point)) * endDistance;
+        result.param = 1.0f + (point - end).dot(direction) / direction.lengthSquared();
+    }
+    return result;
 }
 
-float SDFGenerator::distanceToCubic(Vec2 p, Vec2 p0, Vec2 p1, Vec2 p2, Vec2 p3) const {
-    // Sample cubic bezier curve
-    float minDist = std::numeric_limits<float>::max();
-    constexpr int SAMPLES = 24;
+void finishCurveDistance(const EdgeSegment& edge, Vec2 point, EdgeDistance& result) {
+    if (result.param >= 0.0f && result.param <= 1.0f) {
+        result.dot = 0.0f;
+        return;
+    }
+    const float t = result.param < 0.5f ? 0.0f : 1.0f;
+    const Vec2 toPoint = pointAt(edge, t) - point;
+    result.dot = toPoint.lengthSquared() > 0.0f ? std::abs(directionAt(edge, t).normalized().dot(toPoint.normalized())) : 0.0f;
+}
 
-    for (int i = 0; i <= SAMPLES; ++i) {
-        float t = static_cast<float>(i) / SAMPLES;
-        float u = 1.0f - t;
+EdgeDistance quadraticDistance(const EdgeSegment& edge, Vec2 point) {
+    // Closest point: roots of the cubic d/dt |B(t) - point|^2 = 0
+    const Vec2 qa = edge.p0 - point;
+    const Vec2 ab = edge.p1 - edge.p0;
+    const Vec2 br = edge.p2 - edge.p1 - ab;
+    double roots[3];
+    const int count = solveCubic(roots, br.dot(br), 3.0 * ab.dot(br), 2.0 * ab.dot(ab) + qa.dot(br), qa.dot(ab));
+
+    EdgeDistance result = curveEndpointDistance(edge, point);
+    for (int i = 0; i < count; ++i) {
+        const float t = static_cast<float>(roots[i]);
+        if (t > 0.0f && t < 1.0f) {
+            const Vec2 qe = qa + ab * (2.0f * t) + br * (t * t);
+            const float distance = qe.length();
+            if (distance <= std::abs(result.distance)) {
+                result.distance = nonZeroSign((ab + br * t).cross(qe)) * distance;
+                result.param = t;
+            }
+        }
+    }
+    finishCurveDistance(edge, point, result);
+    return result;
+}
 
-        Vec2 point = p0 * (u * u * u) + p1 * (3 * u * u * t) + p2 * (3 * u * t * t) + p3 * (t * t * t);
-        float dist = (p - point).length();
-        minDist = std::min(minDist, dist);
+EdgeDistance cubicDistance(const EdgeSegment& edge, Vec2 point) {
+    // No closed form: Newton iterations on the distance derivative from several starts
+    constexpr int SEARCH_STARTS = 4;
+    constexpr int SEARCH_STEPS = 4;
+
+    const Vec2 qa = edge.p0 - point;
+    const Vec2 ab = edge.p1 - edge.p0;
+    const Vec2 br = edge.p2 - edge.p1 - ab;
+    const Vec2 as = (edge.p3 - edge.p2) - (edge.p2 - edge.p1) - br;
+
+    EdgeDistance result = curveEndpointDistance(edge, point);
+    for (int i = 0; i <= SEARCH_STARTS; ++i) {
+        float t = static_cast<float>(i) / SEARCH_STARTS;
+        Vec2 qe = qa + ab * (3.0f * t) + br * (3.0f * t * t) + as * (t * t * t);
+        for (int step = 0; step < SEARCH_STEPS; ++step) {
+            const Vec2 d1 = ab * 3.0f + br * (6.0f * t) + as * (3.0f * t * t);
+            const Vec2 d2 = br * 6.0f + as * (6.0f * t);
+            const float denominator = d1.dot(d1) + qe.dot(d2);
+            if (denominator == 0.0f)
+                break;
+            t -= qe.dot(d1) / denominator;
+            if (t <= 0.0f || t >= 1.0f)
+                break;
+            qe = qa + ab * (3.0f * t) + br * (3.0f * t * t) + as * (t * t * t);
+            const float distance = qe.length();
+            if (distance < std::abs(result.distance)) {
+                result.distance = nonZeroSign(directionAt(edge, t).cross(qe)) * distance;
+                result.param = t;
+            }
+        }
     }
+    finishCurveDistance(edge, point, result);
+    return result;
+}
 
-    return minDist;
+// Lower bound on the distance to an edge: a Bezier curve lies in the box of its control points
+float boundsDistance(const EdgeSegment& edge, Vec2 point) {
+    Vec2 lo = Vec2(std::min(edge.p0.x, edge.p1.x), std::min(edge.p0.y, edge.p1.y));
+    Vec2 hi = Vec2(std::max(edge.p0.x, edge.p1.x), std::max(edge.p0.y, edge.p1.y));
+    const int extraPoints = edge.type == EdgeSegment::Linear ? 0 : edge.type == EdgeSegment::Quadratic ? 1 : 2;
+    for (int i = 0; i < extraPoints; ++i) {
+        const Vec2& p = i == 0 ? edge.p2 : edge.p3;
+        lo = Vec2(std::min(lo.x, p.x), std::min(lo.y, p.y));
+        hi = Vec2(std::max(hi.x, p.x), std::max(hi.y, p.y));
+    }
+    const float dx = std::max({lo.x - point.x, 0.0f, point.x - hi.x});
+    const float dy = std::max({lo.y - point.y, 0.0f, point.y - hi.y});
+    return std::sqrt(dx * dx + dy * dy);
 }
 
-float SDFGenerator::distanceToEdge(const EdgeSegment& edge, Vec2 point) const {
+EdgeDistance edgeDistance(const EdgeSegment& edge, Vec2 point) {
     switch (edge.type) {
     case EdgeSegment::Linear:
-        return distanceToLine(point, edge.p0, edge.p1);
+        return lineDistance(edge, point);
     case EdgeSegment::Quadratic:
-        return distanceToQuadratic(point, edge.p0, edge.p1, edge.p2);
+        return quadraticDistance(edge, point);
     case EdgeSegment::Cubic:
-        return distanceToCubic(point, edge.p0, edge.p1, edge.p2, edge.p3);
+        return cubicDistance(edge, point);
     }
-    return std::numeric_limits<float>::max();
+    return EdgeDistance{};
 }
 
-int SDFGenerator::calculateWinding(const Contour& contour, Vec2 point) const {
-    // Ray casting algorithm for winding number
-    int winding = 0;
-
-    for (const auto& edge : contour.edges) {
-        Vec2 p0 = edge.p0;
-        Vec2 p1 = (edge.type == EdgeSegment::Linear) ? edge.p1 : edge.p2;
-
-        if (p0.y <= point.y) {
-            if (p1.y > point.y) {
-                // Upward crossing
-                float cross = (p1.x - p0.x) * (point.y - p0.y) - (point.x - p0.x) * (p1.y - p0.y);
-                if (cross > 0)
-                    ++winding;
+// Beyond an edge's ends, measure against the tangent line instead. Channels
+// then stay straight through corners, which is what lets MSDF keep them sharp.
+void toPseudoDistance(const EdgeSegment& edge, Vec2 point, EdgeDistance& distance) {
+    if (distance.param < 0.0f) {
+        const Vec2 direction = directionAt(edge, 0.0f).normalized();
+        const Vec2 aq = point - edge.p0;
+        if (aq.dot(direction) < 0.0f) {
+            const float pseudo = aq.cross(direction);
+            if (std::abs(pseudo) <= std::abs(distance.distance)) {
+                distance.distance = pseudo;
+                distance.dot = 0.0f;
             }
-        } else {
-            if (p1.y <= point.y) {
-                // Downward crossing
-                float cross = (p1.x - p0.x) * (point.y - p0.y) - (point.x - p0.x) * (p1.y - p0.y);
-                if (cross < 0)
-                    --winding;
+        }
+    } else if (distance.param > 1.0f) {
+        const Vec2 direction = directionAt(edge, 1.0f).normalized();
+        const Vec2 bq = point - endPoint(edge);
+        if (bq.dot(direction) > 0.0f) {
+            const float pseudo = bq.cross(direction);
+            if (std::abs(pseudo) <= std::abs(distance.distance)) {
+                distance.distance = pseudo;
+                distance.dot = 0.0f;
             }
         }
     }
-
-    return winding;
 }
 
-float SDFGenerator::signedDistance(const Shape& shape, Vec2 point) const {
+// Unsigned distance to the nearest edge of the shape
+float nearestDistance(const Shape& shape, Vec2 point) {
     float minDist = std::numeric_limits<float>::max();
+    for (const auto& contour : shape.contours) {
+        for (const auto& edge : contour.edges) {
+            if (boundsDistance(edge, point) < minDist) {
+                minDist = std::min(minDist, std::abs(edgeDistance(edge, point).distance));
+            }
+        }
+    }
+    return minDist;
+}
+
+// ============================================================================
+// Scanline Fill
+// ============================================================================
 
-    // Find minimum distance to any edge
+struct Crossing {
+    float x;
+    int direction; // +1 upward, -1 downward
+};
+
+// A y-monotonic piece crosses y under the half-open rule: min <= y < max
+void addMonotonicCrossing(const EdgeSegment& edge, float t0, float t1, float y, std::vector<Crossing>& crossings) {
+    const Vec2 a = pointAt(edge, t0);
+    const Vec2 b = pointAt(edge, t1);
+    if (a.y == b.y || y < std::min(a.y, b.y) || y >= std::max(a.y, b.y))
+        return;
+
+    // Bisect the parameter; the piece is monotonic so the root is unique
+    float lo = t0, hi = t1;
+    const bool rising = b.y > a.y;
+    for (int i = 0; i < 24; ++i) {
+        const float mid = 0.5f * (lo + hi);
+        if ((pointAt(edge, mid).y < y) == rising) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    crossings.push_back({edge.type == EdgeSegment::Linear ? a.x + (b.x - a.x) * (y - a.y) / (b.y - a.y) : pointAt(edge, 0.5f * (lo + hi)).x, rising ? 1 : -1});
+}
+
+// Where the horizontal line at y crosses the outline, sorted by x
+void findCrossings(const Shape& shape, float y, std::vector<Crossing>& crossings) {
+    crossings.clear();
     for (const auto& contour : shape.contours) {
         for (const auto& edge : contour.edges) {
-            float dist = distanceToEdge(edge, point);
-            minDist = std::min(minDist, dist);
+            switch (edge.type) {
+            case EdgeSegment::Linear:
+                addMonotonicCrossing(edge, 0.0f, 1.0f, y, crossings);
+                break;
+            case EdgeSegment::Quadratic: {
+                // Split at the y extremum
+                const float denominator = edge.p0.y - 2.0f * edge.p1.y + edge.p2.y;
+                const float extremum = denominator != 0.0f ? (edge.p0.y - edge.p1.y) / denominator : -1.0f;
+                if (extremum > 0.0f && extremum < 1.0f) {
+                    addMonotonicCrossing(edge, 0.0f, extremum, y, crossings);
+                    addMonotonicCrossing(edge, extremum, 1.0f, y, crossings);
+                } else {
+                    addMonotonicCrossing(edge, 0.0f, 1.0f, y, crossings);
+                }
+                break;
+            }
+            case EdgeSegment::Cubic: {
+                // Split at both y extrema (roots of the derivative)
+                const double a = -edge.p0.y + 3.0 * edge.p1.y - 3.0 * edge.p2.y + edge.p3.y;
+                const double b = 2.0 * (edge.p0.y - 2.0 * edge.p1.y + edge.p2.y);
+                const double c = edge.p1.y - edge.p0.y;
+                double roots[2];
+                const int count = solveQuadratic(roots, a, b, c);
+                float splits[4] = {0.0f};
+                int splitCount = 1;
+                for (int i = 0; i < count; ++i) {
+                    if (roots[i] > 0.0 && roots[i] < 1.0)
+                        splits[splitCount++] = static_cast<float>(roots[i]);
+                }
+                if (splitCount == 3 && splits[2] < splits[1])
+                    std::swap(splits[1], splits[2]);
+                splits[splitCount++] = 1.0f;
+                for (int i = 0; i + 1 < splitCount; ++i) {
+                    addMonotonicCrossing(edge, splits[i], splits[i + 1], y, crossings);
+                }
+                break;
+            }
+            }
         }
     }
+    std::sort(crossings.begin(), crossings.end(), [](const Crossing& a, const Crossing& b) { return a.x < b.x; });
+}
 
-    // Determine sign using winding number
-    int totalWinding = 0;
+// +1 when the filled side of the outline is on the right of its edges (TrueType), -1 otherwise (CFF)
+float fillOrientation(const Shape& shape) {
+    float area = 0.0f;
     for (const auto& contour : shape.contours) {
-        totalWinding += calculateWinding(contour, point);
+        for (const auto& edge : contour.edges) {
+            const Vec2 end = endPoint(edge);
+            const Vec2 control = edge.type == EdgeSegment::Linear ? edge.p0 : edge.p1;
+            area += edge.p0.cross(control) + control.cross(end);
+        }
     }
+    return area <= 0.0f ? 1.0f : -1.0f;
+}
+
+// ============================================================================
+// Edge Splitting
+// ============================================================================
+
+void splitInThirds(const EdgeSegment& edge, EdgeSegment parts[3]) {
+    for (int i = 0; i < 3; ++i) {
+        const float t0 = static_cast<float>(i) / 3.0f, t1 = static_cast<float>(i + 1) / 3.0f;
+        EdgeSegment& part = parts[i];
+        part = edge;
+        part.p0 = pointAt(edge, t0);
+        switch (edge.type) {
+        case EdgeSegment::Linear:
+            part.p1 = pointAt(edge, t1);
+            break;
+        case EdgeSegment::Quadratic:
+            // Control point of the sub-curve: intersection of the end tangents
+            part.p1 = part.p0 + directionAt(edge, t0) * (t1 - t0);
+            part.p2 = pointAt(edge, t1);
+            break;
+        case EdgeSegment::Cubic:
+            part.p1 = part.p0 + directionAt(edge, t0) * (t1 - t0);
+            part.p3 = pointAt(edge, t1);
+            part.p2 = part.p3 - directionAt(edge, t1) * (t1 - t0);
+            break;
+        }
+    }
+}
+
+} // namespace
+
+float SDFGenerator::distanceToLine(Vec2 p, Vec2 a, Vec2 b) const {
+    EdgeSegment edge{EdgeSegment::Linear, a, b, {}, {}};
+    return std::abs(lineDistance(edge, p).distance);
+}
+
+float SDFGenerator::distanceToQuadratic(Vec2 p, Vec2 p0, Vec2 p1, Vec2 p2) const {
+    EdgeSegment edge{EdgeSegment::Quadratic, p0, p1, p2, {}};
+    return std::abs(quadraticDistance(edge, p).distance);
+}
+
+float SDFGenerator::distanceToCubic(Vec2 p, Vec2 p0, Vec2 p1, Vec2 p2, Vec2 p3) const {
+    EdgeSegment edge{EdgeSegment::Cubic, p0, p1, p2, p3};
+    return std::abs(cubicDistance(edge, p).distance);
+}
+
+float SDFGenerator::distanceToEdge(const EdgeSegment& edge, Vec2 point) const {
+    switch (edge.type) {
+    case EdgeSegment::Linear:
+        return distanceToLine(point, edge.p0, edge.p1);
+    case EdgeSegment::Quadratic:
+        return distanceToQuadratic(point, edge.p0, edge.p1, edge.p2);
+    case EdgeSegment::Cubic:
+        return distanceToCubic(point, edge.p0, edge.p1, edge.p2, edge.p3);
+    }
+    return std::numeric_limits<float>::max();
+}
+
+int SDFGenerator::windingAt(const Shape& shape, Vec2 point) const {
+    std::vector<Crossing> crossings;
+    findCrossings(shape, point.y, crossings);
+    int winding = 0;
+    for (const Crossing& crossing : crossings) {
+        if (crossing.x >= point.x)
+            break;
+        winding += crossing.direction;
+    }
+    return winding;
+}
+
+float SDFGenerator::signedDistance(const Shape& shape, Vec2 point) const {
+    const float minDist = nearestDistance(shape, point);
 
     // Inside if winding != 0 (non-zero fill rule)
-    return (totalWinding != 0) ? -minDist : minDist;
+    return windingAt(shape, point) != 0 ? minDist : -minDist;
 }
 
 // ============================================================================
 // MSDF Edge Coloring
 // ============================================================================
 
+// Next color of a corner-separated run; never shares two channels with banned
+static int switchColor(int color, int banned = 0) {
+    const int combined = color & banned;
+    if (combined == RED || combined == GREEN || combined == BLUE)
+        return combined ^ WHITE;
+    if (color == 0 || color == WHITE)
+        return CYAN;
+    const int shifted = color << 1;
+    return (shifted | shifted >> 3) & WHITE;
+}
+
 void SDFGenerator::colorEdges(Shape& shape) {
-    // Simple edge coloring: assign colors 0, 1, 2 (R, G, B) to edges
-    // ensuring adjacent edges have different colors
+    // Each channel must see every corner as the meeting of two of its own
+    // edges' tangent lines: runs between corners get colors sharing exactly one
+    // channel with their neighbours, smooth contours stay white (all channels).
+    const float crossThreshold = std::sin(CORNER_ANGLE);
+    std::vector<size_t> corners;
 
-    int currentColor = 0;
     for (auto& contour : shape.contours) {
-        for (size_t i = 0; i < contour.edges.size(); ++i) {
-            contour.edges[i].color = currentColor;
-
-            // Check angle between this edge and next
-            if (i + 1 < contour.edges.size()) {
-                Vec2 dir1 = contour.edges[i].p1 - contour.edges[i].p0;
-                Vec2 dir2 = contour.edges[i + 1].p1 - contour.edges[i + 1].p0;
-                dir1 = dir1.normalized();
-                dir2 = dir2.normalized();
-
-                float cross = dir1.x * dir2.y - dir1.y * dir2.x;
-                if (std::abs(cross) > 0.5f) {
-                    // Sharp corner - change color
-                    currentColor = (currentColor + 1) % 3;
+        auto& edges = contour.edges;
+        if (edges.empty())
+            continue;
+
+        corners.clear();
+        Vec2 previous = directionAt(edges.back(), 1.0f).normalized();
+        for (size_t i = 0; i < edges.size(); ++i) {
+            const Vec2 current = directionAt(edges[i], 0.0f).normalized();
+            if (previous.dot(current) <= 0.0f || std::abs(previous.cross(current)) > crossThreshold) {
+                corners.push_back(i);
+            }
+            previous = directionAt(edges[i], 1.0f).normalized();
+        }
+
+        if (corners.empty()) {
+            for (auto& edge : edges) {
+                edge.color = WHITE;
+            }
+        } else if (corners.size() == 1) {
+            // Teardrop: spread three colors along the contour from the corner
+            const int colors[3] = {switchColor(WHITE), WHITE, switchColor(switchColor(WHITE))};
+            if (edges.size() < 3) {
+                std::vector<EdgeSegment> parts;
+                for (size_t i = 0; i < edges.size(); ++i) {
+                    EdgeSegment thirds[3];
+                    splitInThirds(edges[(corners[0] + i) % edges.size()], thirds);
+                    parts.insert(parts.end(), thirds, thirds + 3);
                 }
+                edges = std::move(parts);
+                corners[0] = 0;
+            }
+            const size_t m = edges.size();
+            for (size_t i = 0; i < m; ++i) {
+                const int third = std::clamp(static_cast<int>(3 * i / m), 0, 2);
+                edges[(corners[0] + i) % m].color = colors[third];
+            }
+        } else {
+            // Switch color at each corner; the last run must differ from the first
+            const size_t m = edges.size();
+            int color = switchColor(WHITE);
+            const int initial = color;
+            size_t run = 0;
+            for (size_t i = 0; i < m; ++i) {
+                const size_t index = (corners[0] + i) % m;
+                if (run + 1 < corners.size() && corners[run + 1] == index) {
+                    ++run;
+                    color = switchColor(color, run == corners.size() - 1 ? initial : 0);
+                }
+                edges[index].color = color;
             }
         }
     }
 }
 
 Vec3 SDFGenerator::msdfDistance(const Shape& shape, Vec2 point) const {
-    Vec3 distances(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
+    // Per channel: the nearest edge carrying that channel, then its pseudo-distance
+    EdgeDistance nearest[3];
+    const EdgeSegment* nearestEdge[3] = {nullptr, nullptr, nullptr};
 
     for (const auto& contour : shape.contours) {
         for (const auto& edge : contour.edges) {
-            float dist = distanceToEdge(edge, point);
-            int channel = edge.color;
-
-            if (dist < std::abs(distances[channel])) {
-                // Determine sign for this edge
-                int winding = calculateWinding(contour, point);
-                float signedDist = (winding != 0) ? -dist : dist;
-                distances[channel] = signedDist;
+            // Skip edges that cannot beat the current nearest of any of their channels
+            const float bound = boundsDistance(edge, point);
+            bool candidate = false;
+            for (int c = 0; c < 3; ++c) {
+                candidate |= (edge.color & (1 << c)) && bound <= std::abs(nearest[c].distance);
+            }
+            if (!candidate)
+                continue;
+
+            const EdgeDistance distance = edgeDistance(edge, point);
+            for (int c = 0; c < 3; ++c) {
+                if ((edge.color & (1 << c)) && distance.closerThan(nearest[c])) {
+                    nearest[c] = distance;
+                    nearestEdge[c] = &edge;
+                }
             }
         }
     }
 
+    Vec3 distances;
+    for (int c = 0; c < 3; ++c) {
+        if (nearestEdge[c]) {
+            toPseudoDistance(*nearestEdge[c], point, nearest[c]);
+        }
+        distances[c] = nearest[c].distance;
+    }
     return distances;
 }
 
+static float median(float a, float b, float c) { return std::max(std::min(a, b), std::min(std::max(a, b), c)); }
+
+// Would bilinear filtering between texels a and b produce a false edge?
+static bool detectClash(const float* a, const float* b, float threshold) {
+    // Order channels by how much they change between the texels
+    float a0 = a[0], a1 = a[1], a2 = a[2];
+    float b0 = b[0], b1 = b[1], b2 = b[2];
+    if (std::abs(b0 - a0) < std::abs(b1 - a1)) {
+        std::swap(a0, a1);
+        std::swap(b0, b1);
+    }
+    if (std::abs(b1 - a1) < std::abs(b2 - a2)) {
+        std::swap(a1, a2);
+        std::swap(b1, b2);
+        if (std::abs(b0 - a0) < std::abs(b1 - a1)) {
+            std::swap(a0, a1);
+            std::swap(b0, b1);
+        }
+    }
+    // Two channels flip by more than a real edge could; flag only the texel farther from the edge
+    return std::abs(b1 - a1) >= threshold && !(b0 == b1 && b0 == b2) && std::abs(a2 - 0.5f) >= std::abs(b2 - 0.5f);
+}
+
+void SDFGenerator::correctErrors(std::vector<float>& field, uint32_t width, uint32_t height, uint32_t stride) const {
+    // Values are normalized (0.5 at the edge, 0.5 / spread per pixel), so a
+    // channel may change by at most that much between neighbours
+    const float threshold = 1.001f * 0.5f / spread_;
+    const float diagonalThreshold = threshold * std::sqrt(2.0f);
+
+    auto texel = [&](uint32_t x, uint32_t y) { return field.data() + (static_cast<size_t>(y) * width + x) * stride; };
+
+    std::vector<uint32_t> clashes;
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const float* t = texel(x, y);
+            if ((x > 0 && detectClash(t, texel(x - 1, y), threshold)) || (x + 1 < width && detectClash(t, texel(x + 1, y), threshold)) ||
+                (y > 0 && detectClash(t, texel(x, y - 1), threshold)) || (y + 1 < height && detectClash(t, texel(x, y + 1), threshold)) ||
+                (x > 0 && y > 0 && detectClash(t, texel(x - 1, y - 1), diagonalThreshold)) ||
+                (x + 1 < width && y > 0 && detectClash(t, texel(x + 1, y - 1), diagonalThreshold)) ||
+                (x > 0 && y + 1 < height && detectClash(t, texel(x - 1, y + 1), diagonalThreshold)) ||
+                (x + 1 < width && y + 1 < height && detectClash(t, texel(x + 1, y + 1), diagonalThreshold))) {
+                clashes.push_back(y * width + x);
+            }
+        }
+    }
+
+    // Collapse clashing texels to their median: a plain SDF there, no false edge
+    for (uint32_t index : clashes) {
+        float* t = field.data() + static_cast<size_t>(index) * stride;
+        t[0] = t[1] = t[2] = median(t[0], t[1], t[2]);
+    }
+}
+
 // ============================================================================
 // SDF Generation
 // ============================================================================
 
 SDFGlyphBitmap SDFGenerator::generate(const GlyphOutline& outline, float fontSize, int16_t unitsPerEm) {
+    const float scale = fontSize / static_cast<float>(unitsPerEm);
+    Shape shape = outlineToShape(outline, scale);
+    return generateShape(shape, GlyphBounds{outline.xMin, outline.yMin, outline.xMax, outline.yMax}, outline.advanceWidth, scale);
+}
+
+SDFGlyphBitmap SDFGenerator::generate(const GlyphOutlineView& outline, float fontSize, int16_t unitsPerEm) {
+    const float scale = fontSize / static_cast<float>(unitsPerEm);
+    Shape shape = outlineToShape(outline, scale);
+    return generateShape(shape, GlyphBounds{outline.xMin, outline.yMin, outline.xMax, outline.yMax}, outline.advanceWidth, scale);
+}
+
+SDFGlyphBitmap SDFGenerator::generateShape(Shape& shape, const GlyphBounds& bounds, int16_t advanceWidth, float scale) {
     SDFGlyphBitmap result;
 
-    if (outline.contours.empty()) {
+    if (shape.contours.empty()) {
         // Empty glyph (e.g., space)
         result.width = 1;
         result.height = 1;
         result.pixels.resize(1, 128); // Neutral distance
-        result.advanceWidth = outline.advanceWidth * fontSize / unitsPerEm;
+        result.advanceWidth = advanceWidth * scale;
         return result;
     }
 
-    // Calculate scale and dimensions
-    float scale = fontSize / static_cast<float>(unitsPerEm);
     uint32_t padding = static_cast<uint32_t>(std::ceil(spread_));
     result.padding = padding;
 
     // Glyph bounds in pixels
-    float pxMinX = outline.xMin * scale;
-    float pxMinY = outline.yMin * scale;
-    float pxMaxX = outline.xMax * scale;
-    float pxMaxY = outline.yMax * scale;
+    float pxMinX = bounds.xMin * scale;
+    float pxMinY = bounds.yMin * scale;
+    float pxMaxX = bounds.xMax * scale;
+    float pxMaxY = bounds.yMax * scale;
 
     uint32_t glyphWidth = static_cast<uint32_t>(std::ceil(pxMaxX - pxMinX)) + 1;
     uint32_t glyphHeight = static_cast<uint32_t>(std::ceil(pxMaxY - pxMinY)) + 1;
@@ -300,55 +786,70 @@ SDFGlyphBitmap SDFGenerator::generate(const GlyphOutline& outline, float fontSiz
 
     result.bearingX = pxMinX - padding;
     result.bearingY = pxMaxY + padding; // Note: Y is typically from baseline
-    result.advanceWidth = outline.advanceWidth * scale;
-
-    // Convert outline to shape
-    Shape shape = outlineToShape(outline, scale);
+    result.advanceWidth = advanceWidth * scale;
 
     if (mode_ != SDFMode::SDF) {
         colorEdges(shape);
     }
 
-    // Generate distance field
-    result.pixels.resize(result.width * result.height * result.channels);
+    // Distances are positive inside (the text shaders treat > 0.5 as filled).
+    // Edge signs follow contour direction; flip them for CFF-oriented outlines.
+    const float orientation = fillOrientation(shape);
 
+    // Distance of -spread maps to 0, +spread maps to 1
+    std::vector<float> field(static_cast<size_t>(result.width) * result.height * result.channels);
+    auto normalize = [&](float dist) { return (dist / spread_) * 0.5f + 0.5f; };
+
+    std::vector<Crossing> crossings;
     for (uint32_t y = 0; y < result.height; ++y) {
+        // Inside/outside for the whole row from one scanline pass
+        const float rowY = pxMaxY + padding - y - 0.5f; // Flip Y
+        findCrossings(shape, rowY, crossings);
+        size_t nextCrossing = 0;
+        int winding = 0;
+
         for (uint32_t x = 0; x < result.width; ++x) {
             // Convert pixel coord to glyph space
-            Vec2 point;
-            point.x = pxMinX - padding + x + 0.5f;
-            point.y = pxMaxY + padding - y - 0.5f; // Flip Y
+            const Vec2 point(pxMinX - padding + x + 0.5f, rowY);
+            while (nextCrossing < crossings.size() && crossings[nextCrossing].x < point.x) {
+                winding += crossings[nextCrossing++].direction;
+            }
+            const bool inside = winding != 0;
+            float* texel = field.data() + (static_cast<size_t>(y) * result.width + x) * result.channels;
 
             if (mode_ == SDFMode::SDF) {
-                float dist = signedDistance(shape, point);
-
-                // Normalize to 0-255 range
-                // Distance of -spread maps to 0, +spread maps to 255
-                float normalized = (dist / spread_) * 0.5f + 0.5f;
-                normalized = std::clamp(normalized, 0.0f, 1.0f);
+                const float minDist = nearestDistance(shape, point);
+                texel[0] = normalize(inside ? minDist : -minDist);
+                continue;
+            }
 
-                result.pixels[y * result.width + x] = static_cast<uint8_t>(normalized * 255.0f);
-            } else {
-                // MSDF
-                Vec3 dist = msdfDistance(shape, point);
+            Vec3 dist = msdfDistance(shape, point) * orientation;
 
-                for (int c = 0; c < 3; ++c) {
-                    float normalized = (dist[c] / spread_) * 0.5f + 0.5f;
-                    normalized = std::clamp(normalized, 0.0f, 1.0f);
-                    result.pixels[(y * result.width + x) * result.channels + c] = static_cast<uint8_t>(normalized * 255.0f);
-                }
+            // Where overlapping contours fool the edge signs, trust the fill
+            if ((median(dist.x, dist.y, dist.z) > 0.0f) != inside) {
+                dist = dist * -1.0f;
+            }
+            for (int c = 0; c < 3; ++c) {
+                texel[c] = normalize(dist[c]);
+            }
 
-                if (mode_ == SDFMode::MTSDF) {
-                    // Alpha channel = true SDF
-                    float trueDist = signedDistance(shape, point);
-                    float normalized = (trueDist / spread_) * 0.5f + 0.5f;
-                    normalized = std::clamp(normalized, 0.0f, 1.0f);
-                    result.pixels[(y * result.width + x) * result.channels + 3] = static_cast<uint8_t>(normalized * 255.0f);
-                }
+            if (mode_ == SDFMode::MTSDF) {
+                // Alpha channel = true SDF
+                const float minDist = nearestDistance(shape, point);
+                texel[3] = normalize(inside ? minDist : -minDist);
             }
         }
     }
 
+    if (mode_ != SDFMode::SDF) {
+        correctErrors(field, result.width, result.height, result.channels);
+    }
+
+    result.pixels.resize(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        result.pixels[i] = static_cast<uint8_t>(std::clamp(field[i], 0.0f, 1.0f) * 255.0f);
+    }
+
     return result;
 }
 
@@ -11,12 +11,12 @@ namespace dakt::gui {
 // BinaryStream Implementation
 // ============================================================================
 
-BinaryStream::BinaryStream(const std::vector<uint8_t>& data) : data_(data), position_(0) {}
+BinaryStream::BinaryStream(const std::vector<uint8_t>& data) : data_(data.data()), size_(data.size()), position_(0) {}
 
-BinaryStream::BinaryStream(const uint8_t* data, size_t size) : data_(data, data + size), position_(0) {}
+BinaryStream::BinaryStream(const uint8_t* data, size_t size) : data_(data), size_(size), position_(0) {}
 
 uint8_t BinaryStream::readU8() {
-    if (position_ >= data_.size())
+    if (position_ >= size_)
         return 0;
     return data_[position_++];
 }
@@ -38,16 +38,37 @@ uint32_t BinaryStream::readU32() {
 int32_t BinaryStream::readI32() { return static_cast<int32_t>(readU32()); }
 
 std::vector<uint8_t> BinaryStream::readBytes(size_t count) {
-    std::vector<uint8_t> result;
-    for (size_t i = 0; i < count && position_ < data_.size(); ++i) {
-        result.push_back(data_[position_++]);
-    }
+    count = std::min(count, size_ - position_);
+    std::vector<uint8_t> result(data_ + position_, data_ + position_ + count);
+    position_ += count;
     return result;
 }
 
-void BinaryStream::seek(size_t offset) { position_ = std::min(offset, data_.size()); }
+void BinaryStream::seek(size_t offset) { position_ = std::min(offset, size_); }
+
+void BinaryStream::skip(size_t count) { position_ = std::min(position_ + count, size_); }
+
+// ============================================================================
+// GlyphOutlineView Implementation
+// ============================================================================
 
-void BinaryStream::skip(size_t count) { position_ = std::min(position_ + count, data_.size()); }
+GlyphOutline GlyphOutlineView::toOutline() const {
+    GlyphOutline outline;
+    outline.xMin = xMin;
+    outline.yMin = yMin;
+    outline.xMax = xMax;
+    outline.yMax = yMax;
+    outline.advanceWidth = advanceWidth;
+    outline.leftSideBearing = leftSideBearing;
+
+    outline.contours.resize(contourCount);
+    uint16_t start = 0;
+    for (uint16_t c = 0; c < contourCount; ++c) {
+        outline.contours[c].points.assign(points + start, points + contourEnds[c]);
+        start = contourEnds[c];
+    }
+    return outline;
+}
 
 // ============================================================================
 // TTFParser Implementation
@@ -72,7 +93,9 @@ bool TTFParser::loadFromMemory(const uint8_t* data, size_t size) {
     if (!data || size < 12)
         return false;
 
-    fontData_ = std::vector<uint8_t>(data, data + size);
+    if (data != fontData_.data()) {
+        fontData_.assign(data, data + size);
+    }
     BinaryStream stream(fontData_);
 
     // Parse offset table (sfnt wrapper)
@@ -97,6 +120,7 @@ bool TTFParser::loadFromMemory(const uint8_t* data, size_t size) {
     if (!parseNameTable(stream))
         return false;
 
+    buildCharacterPages();
     return true;
 }
 
@@ -214,8 +238,48 @@ bool TTFParser::parseGlyfTable(BinaryStream& stream) {
     if (!glyfTable)
         return false;
 
-    // We parse glyphs on-demand in getGlyphOutline()
-    // Just validate the table exists
+    // Outlines are decoded on demand in getGlyphOutline(); read the bounds
+    // now and reserve each simple glyph's slice of the outline arena
+    glyphBounds_.assign(glyphCount_, GlyphBounds{});
+    pointStarts_.assign(glyphCount_ + 1, 0);
+    contourStarts_.assign(glyphCount_ + 1, 0);
+
+    uint32_t pointCount = 0;
+    uint32_t contourCount = 0;
+    for (uint16_t glyphId = 0; glyphId < glyphCount_; ++glyphId) {
+        pointStarts_[glyphId] = pointCount;
+        contourStarts_[glyphId] = contourCount;
+
+        const uint32_t start = glyphLocations_[glyphId];
+        const uint32_t end = glyphLocations_[glyphId + 1];
+        if (end < start + 10 || static_cast<uint64_t>(glyfTable->offset) + end > fontData_.size())
+            continue;
+
+        stream.seek(glyfTable->offset + start);
+        const int16_t numberOfContours = stream.readI16();
+        GlyphBounds& bounds = glyphBounds_[glyphId];
+        bounds.xMin = stream.readI16();
+        bounds.yMin = stream.readI16();
+        bounds.xMax = stream.readI16();
+        bounds.yMax = stream.readI16();
+
+        // Composite glyphs (negative contour count) have no outline of their own
+        if (numberOfContours <= 0 || end < start + 10 + 2 * static_cast<uint32_t>(numberOfContours))
+            continue;
+
+        uint32_t points = 0;
+        for (int16_t i = 0; i < numberOfContours; ++i) {
+            points = std::max(points, stream.readU16() + 1u);
+        }
+        pointCount += std::min(points, 0xFFFFu);
+        contourCount += static_cast<uint32_t>(numberOfContours);
+    }
+    pointStarts_[glyphCount_] = pointCount;
+    contourStarts_[glyphCount_] = contourCount;
+
+    outlinePoints_ = std::make_unique<GlyphPoint[]>(pointCount);
+    contourEnds_ = std::make_unique<uint16_t[]>(contourCount);
+    outlineOnce_ = std::make_unique<std::once_flag[]>(glyphCount_);
     return true;
 }
 
@@ -314,7 +378,7 @@ bool TTFParser::parseCmapTable(BinaryStream& stream) {
     cmapEntries_.clear();
 
     for (uint16_t i = 0; i < segCount; ++i) {
-        for (uint16_t code = startCode[i]; code <= endCode[i]; ++code) {
+        for (uint32_t code = startCode[i]; code <= endCode[i]; ++code) { // 32-bit: the last segment ends at 0xFFFF
             uint16_t glyphId = 0;
 
             if (idRangeOffsets[i] == 0) {
@@ -373,99 +437,81 @@ bool TTFParser::parseNameTable(BinaryStream& stream) {
     return true;
 }
 
-GlyphOutline TTFParser::parseSimpleGlyph(BinaryStream& stream, int16_t xMin, int16_t yMin, int16_t xMax, int16_t yMax) {
-    GlyphOutline outline;
-    outline.xMin = xMin;
-    outline.yMin = yMin;
-    outline.xMax = xMax;
-    outline.yMax = yMax;
-
-    int16_t numberOfContours = stream.readI16();
-    if (numberOfContours <= 0)
-        return outline;
-
-    std::vector<uint16_t> endPtsOfContours(numberOfContours);
-    uint16_t totalPoints = 0;
-
-    for (int16_t i = 0; i < numberOfContours; ++i) {
-        endPtsOfContours[i] = stream.readU16();
-        totalPoints = std::max(totalPoints, (uint16_t)(endPtsOfContours[i] + 1));
+void TTFParser::parseSimpleGlyph(uint16_t glyphId) const {
+    const TableDirectory* glyfTable = findTable(0x676C7966); // 'glyf'
+    const uint32_t start = glyphLocations_[glyphId];
+    BinaryStream stream(fontData_.data() + glyfTable->offset + start, glyphLocations_[glyphId + 1] - start);
+    stream.skip(10); // numberOfContours and bounds, read at load time
+
+    const uint32_t pointCount = pointStarts_[glyphId + 1] - pointStarts_[glyphId];
+    const uint32_t contourCount = contourStarts_[glyphId + 1] - contourStarts_[glyphId];
+    GlyphPoint* points = outlinePoints_.get() + pointStarts_[glyphId];
+    uint16_t* contourEnds = contourEnds_.get() + contourStarts_[glyphId];
+
+    // Contour ends, exclusive and never decreasing
+    uint32_t end = 0;
+    for (uint32_t i = 0; i < contourCount; ++i) {
+        end = std::max(end, std::min(stream.readU16() + 1u, pointCount));
+        contourEnds[i] = static_cast<uint16_t>(end);
     }
 
     uint16_t instructionLength = stream.readU16();
     stream.skip(instructionLength); // Skip glyph program
 
-    // Read flags
-    std::vector<uint8_t> flags(totalPoints);
-    for (uint16_t i = 0; i < totalPoints; ++i) {
-        flags[i] = stream.readU8();
-        if (flags[i] & 0x08) { // Repeat flag
-            uint8_t count = stream.readU8();
-            for (uint8_t j = 0; j < count && i + 1 < totalPoints; ++j) {
-                flags[++i] = flags[i - 1];
-            }
+    // Read flags; they wait in y until the coordinates are decoded
+    for (uint32_t i = 0; i < pointCount;) {
+        const uint8_t flag = stream.readU8();
+        uint32_t repeat = (flag & 0x08) ? stream.readU8() : 0; // Repeat flag
+        points[i++].y = flag;
+        for (; repeat > 0 && i < pointCount; --repeat) {
+            points[i++].y = flag;
         }
     }
 
     // Read coordinates
-    std::vector<int16_t> xCoordinates(totalPoints);
-    std::vector<int16_t> yCoordinates(totalPoints);
-
     int16_t x = 0;
-    for (uint16_t i = 0; i < totalPoints; ++i) {
-        if (flags[i] & 0x02) { // X short
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        const uint8_t flag = static_cast<uint8_t>(points[i].y);
+        if (flag & 0x02) { // X short
             int16_t dx = stream.readU8();
-            if (!(flags[i] & 0x10))
+            if (!(flag & 0x10))
                 dx = -dx;
             x += dx;
-        } else if (!(flags[i] & 0x10)) {
+        } else if (!(flag & 0x10)) {
             x += stream.readI16();
         }
-        xCoordinates[i] = x;
+        points[i].x = x;
     }
 
     int16_t y = 0;
-    for (uint16_t i = 0; i < totalPoints; ++i) {
-        if (flags[i] & 0x04) { // Y short
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        const uint8_t flag = static_cast<uint8_t>(points[i].y);
+        if (flag & 0x04) { // Y short
             int16_t dy = stream.readU8();
-            if (!(flags[i] & 0x20))
+            if (!(flag & 0x20))
                 dy = -dy;
             y += dy;
-        } else if (!(flags[i] & 0x20)) {
+        } else if (!(flag & 0x20)) {
             y += stream.readI16();
         }
-        yCoordinates[i] = y;
+        points[i].y = y;
+        points[i].onCurve = (flag & 0x01) != 0;
     }
+}
 
-    // Build contours
-    for (int16_t contourIdx = 0; contourIdx < numberOfContours; ++contourIdx) {
-        GlyphContour contour;
-        uint16_t startPoint = (contourIdx == 0) ? 0 : (endPtsOfContours[contourIdx - 1] + 1);
-        uint16_t endPoint = endPtsOfContours[contourIdx];
-
-        for (uint16_t i = startPoint; i <= endPoint; ++i) {
-            GlyphPoint point;
-            point.x = xCoordinates[i];
-            point.y = yCoordinates[i];
-            point.onCurve = (flags[i] & 0x01) != 0;
-            contour.points.push_back(point);
+void TTFParser::buildCharacterPages() {
+    cmapPages_.assign(256, 0);
+    cmapGlyphs_.assign(256, 0);
+    for (const auto& entry : cmapEntries_) {
+        if (entry.codepoint > 0xFFFF)
+            continue;
+        uint16_t& page = cmapPages_[entry.codepoint >> 8];
+        if (page == 0) {
+            page = static_cast<uint16_t>(cmapGlyphs_.size() >> 8);
+            cmapGlyphs_.resize(cmapGlyphs_.size() + 256, 0);
         }
-
-        outline.contours.push_back(contour);
+        cmapGlyphs_[(static_cast<size_t>(page) << 8) | (entry.codepoint & 0xFF)] = entry.glyphId;
     }
-
-    return outline;
-}
-
-GlyphOutline TTFParser::parseCompositeGlyph(BinaryStream& stream, int16_t xMin, int16_t yMin, int16_t xMax, int16_t yMax) {
-    GlyphOutline outline;
-    outline.xMin = xMin;
-    outline.yMin = yMin;
-    outline.xMax = xMax;
-    outline.yMax = yMax;
-
-    // For now, return empty composite (would need recursive outline merging)
-    return outline;
 }
 
 std::string TTFParser::extractNameString(const std::vector<uint8_t>& data, uint16_t offset, uint16_t length, uint16_t platformId) {
@@ -503,60 +549,35 @@ const TableDirectory* TTFParser::findTable(uint32_t tag) const {
 }
 
 uint16_t TTFParser::getGlyphId(uint32_t codepoint) const {
-    for (const auto& entry : cmapEntries_) {
-        if (entry.codepoint == codepoint) {
-            return entry.glyphId;
-        }
-    }
-    return 0;
+    if (codepoint > 0xFFFF || cmapPages_.empty())
+        return 0;
+    return cmapGlyphs_[(static_cast<size_t>(cmapPages_[codepoint >> 8]) << 8) | (codepoint & 0xFF)];
 }
 
-const GlyphOutline* TTFParser::getGlyphOutline(uint16_t glyphId) const {
-    if (glyphId >= glyphCount_)
-        return nullptr;
-
-    auto it = glyphCache_.find(glyphId);
-    if (it != glyphCache_.end()) {
-        return &it->second;
-    }
-
-    const TableDirectory* glyfTable = findTable(0x676C7966); // 'glyf'
-    if (!glyfTable)
-        return nullptr;
-
-    if (glyphId >= glyphLocations_.size() - 1)
-        return nullptr;
-
-    uint32_t glyphOffset = glyfTable->offset + glyphLocations_[glyphId];
-    uint32_t glyphSize = glyphLocations_[glyphId + 1] - glyphLocations_[glyphId];
-
-    if (glyphSize == 0)
-        return nullptr;
-    if (glyphOffset + glyphSize > fontData_.size())
-        return nullptr;
-
-    BinaryStream stream(fontData_.data() + glyphOffset, glyphSize);
-
-    int16_t numberOfContours = stream.readI16();
-    int16_t xMin = stream.readI16();
-    int16_t yMin = stream.readI16();
-    int16_t xMax = stream.readI16();
-    int16_t yMax = stream.readI16();
+GlyphOutlineView TTFParser::getGlyphOutline(uint16_t glyphId) const {
+    GlyphOutlineView outline;
+    if (glyphId >= glyphCount_ || !outlineOnce_)
+        return outline;
 
-    GlyphOutline outline;
+    const GlyphBounds& bounds = glyphBounds_[glyphId];
+    outline.xMin = bounds.xMin;
+    outline.yMin = bounds.yMin;
+    outline.xMax = bounds.xMax;
+    outline.yMax = bounds.yMax;
+    outline.advanceWidth = getAdvanceWidth(glyphId);
+    outline.leftSideBearing = getLeftSideBearing(glyphId);
 
-    if (numberOfContours >= 0) {
-        outline = const_cast<TTFParser*>(this)->parseSimpleGlyph(stream, xMin, yMin, xMax, yMax);
-    } else {
-        outline = const_cast<TTFParser*>(this)->parseCompositeGlyph(stream, xMin, yMin, xMax, yMax);
-    }
+    outline.contourCount = static_cast<uint16_t>(contourStarts_[glyphId + 1] - contourStarts_[glyphId]);
+    if (outline.contourCount == 0)
+        return outline;
 
-    outline.advanceWidth = glyphId < advanceWidths_.size() ? advanceWidths_[glyphId] : 0;
-    outline.leftSideBearing = glyphId < leftSideBearings_.size() ? leftSideBearings_[glyphId] : 0;
+    // Decode into the glyph's reserved slice exactly once, whichever thread asks first
+    std::call_once(outlineOnce_[glyphId], [this, glyphId] { parseSimpleGlyph(glyphId); });
 
-    auto& cached = const_cast<std::unordered_map<uint16_t, GlyphOutline>&>(glyphCache_)[glyphId];
-    cached = outline;
-    return &cached;
+    outline.points = outlinePoints_.get() + pointStarts_[glyphId];
+    outline.contourEnds = contourEnds_.get() + contourStarts_[glyphId];
+    outline.pointCount = static_cast<uint16_t>(pointStarts_[glyphId + 1] - pointStarts_[glyphId]);
+    return outline;
 }
 
 int16_t TTFParser::getAdvanceWidth(uint16_t glyphId) const { return glyphId < advanceWidths_.size() ? advanceWidths_[glyphId] : 0; }
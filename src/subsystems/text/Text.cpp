@@ -1,11 +1,13 @@
 #include "dakt/gui/subsystems/text/Text.hpp"
 #include "dakt/gui/subsystems/text/Font.hpp"
 #include "dakt/gui/subsystems/text/GlyphAtlas.hpp"
+#include "dakt/gui/subsystems/text/GlyphAtlasCache.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
 #include <algorithm>
 
 namespace dakt::gui {
 
-TextRenderer::TextRenderer() = default;
+TextRenderer::TextRenderer() : atlas_(std::make_unique<GlyphAtlas>()) {}
 TextRenderer::~TextRenderer() = default;
 
 bool TextRenderer::loadFont(const std::string& name, const std::string& filePath) {
@@ -13,11 +15,35 @@ bool TextRenderer::loadFont(const std::string& name, const std::string& filePath
     if (!font->loadFromFile(filePath)) {
         return false;
     }
+
+    // Replacing a font: drop shaping data keyed by the old instance
+    auto existing = fonts_.find(name);
+    if (existing != fonts_.end()) {
+        shaper_.invalidateFont(existing->second.get());
+        wordCache_.invalidateFont(existing->second.get());
+        layoutCache_.remove_if([&](const LayoutEntry& entry) { return entry.font == existing->second.get(); });
+    }
+
+    // Glyphs already in the atlas stay; the same file loaded again finds them
+    if (atlasCache_) {
+        atlas_->loadFromCache(*font);
+    }
+
     fonts_[name] = std::move(font);
-    atlases_[name] = std::make_unique<GlyphAtlas>();
     return true;
 }
 
+void TextRenderer::setAtlasCacheDirectory(const std::string& directory) {
+    auto cache = directory.empty() ? nullptr : std::make_unique<GlyphAtlasCache>(directory);
+    atlas_->setCache(cache.get());
+    if (cache) {
+        for (auto& [name, font] : fonts_) {
+            atlas_->loadFromCache(*font);
+        }
+    }
+    atlasCache_ = std::move(cache); // The previous cache finishes its writes as it goes
+}
+
 Font* TextRenderer::getFont(const std::string& name) {
     auto it = fonts_.find(name);
     if (it != fonts_.end()) {
@@ -35,48 +61,208 @@ ShapedRun TextRenderer::shapeText(const std::string& fontName, const std::string
 }
 
 TextLayout TextRenderer::layoutText(const std::string& fontName, const std::string& text, const TextRenderParams& params) {
-    TextLayout layout;
+    TextLayout layout = reflowText(fontName, text, params);
+    layout.lines.resize(layout.lineCount); // Drop the spare lines kept for reflow
+    return layout;
+}
+
+const TextLayout& TextRenderer::reflowText(const std::string& fontName, const std::string& text, const TextRenderParams& params) {
+    static const TextLayout emptyLayout;
 
     Font* font = getFont(fontName);
     if (!font) {
-        return layout;
+        return emptyLayout;
+    }
+
+    const float maxWidth = static_cast<float>(params.maxWidth);
+    const size_t hash = std::hash<std::string_view>{}(text);
+    for (auto it = layoutCache_.begin(); it != layoutCache_.end(); ++it) {
+        if (it->font == font && it->hash == hash && it->fontSize == params.fontSize && it->lineHeight == params.lineHeight && it->text == text) {
+            layoutCache_.splice(layoutCache_.begin(), layoutCache_, it);
+            if (it->layout.maxWidth != maxWidth) {
+                it->layout.reflow(maxWidth, it->layout.hasRTL ? &shaper_.getBidiParagraph(text) : nullptr);
+            }
+            return it->layout;
+        }
+    }
+
+    // Miss: recycle the least recently used entry's storage once the cache is full
+    if (layoutCache_.size() >= LAYOUT_CACHE_SIZE) {
+        layoutCache_.splice(layoutCache_.begin(), layoutCache_, std::prev(layoutCache_.end()));
+    } else {
+        layoutCache_.emplace_front();
+    }
+
+    LayoutEntry& entry = layoutCache_.front();
+    entry.font = font;
+    entry.text.assign(text);
+    entry.hash = hash;
+    entry.fontSize = params.fontSize;
+    entry.lineHeight = params.lineHeight;
+    buildLayout(*font, text, params, entry.layout);
+    return entry.layout;
+}
+
+void TextRenderer::buildLayout(Font& font, const std::string& text, const TextRenderParams& params, TextLayout& layout) {
+    // Shape text from cached words
+    ShapedRun& run = scratchRun_;
+    wordCache_.shapeText(shaper_, font, text, run);
+
+    const uint32_t glyphCount = static_cast<uint32_t>(run.glyphs.size());
+    layout.glyphs.assign(run.glyphs.begin(), run.glyphs.end());
+    layout.advanceSums.resize(glyphCount + 1);
+    layout.advanceSums[0] = 0.0f;
+    for (uint32_t i = 0; i < glyphCount; ++i) {
+        layout.advanceSums[i + 1] = layout.advanceSums[i] + font.pixelsFromUnits(run.glyphs[i].xAdvance, params.fontSize);
+    }
+    layout.lineHeight = params.lineHeight * params.fontSize;
+
+    // Break opportunities per codepoint
+    scratchCodepoints_.resize(text.size());
+    scratchOffsets_.resize(text.size() + 1);
+    const size_t count = utf8::decode(text, scratchCodepoints_.data(), scratchOffsets_.data());
+    scratchOffsets_[count] = static_cast<uint32_t>(text.size());
+    findLineBreaks(scratchCodepoints_.data(), count, scratchBreaks_);
+
+    // Lowest cluster from each glyph on; a glyph boundary can only break if
+    // every glyph before it comes earlier in the text than every glyph after it
+    std::vector<uint32_t>& suffixMin = scratchCodepoints_;
+    suffixMin.resize(glyphCount + 1);
+    suffixMin[glyphCount] = static_cast<uint32_t>(text.size());
+    for (uint32_t i = glyphCount; i > 0; --i) {
+        suffixMin[i - 1] = std::min(suffixMin[i], run.glyphs[i - 1].cluster);
+    }
+
+    layout.breaks.clear();
+    size_t codepoint = 0;
+    uint32_t prefixMax = 0;
+    uint32_t contentEnd = 0;
+    for (uint32_t i = 0; i < glyphCount; ++i) {
+        if (i > 0 && prefixMax < suffixMin[i]) {
+            const uint32_t cluster = suffixMin[i];
+            while (scratchOffsets_[codepoint] < cluster) {
+                ++codepoint;
+            }
+            const BreakAction action = scratchOffsets_[codepoint] == cluster ? scratchBreaks_[codepoint] : BreakAction::None;
+            if (action != BreakAction::None) {
+                layout.breaks.push_back({i, contentEnd, cluster, action == BreakAction::Mandatory});
+            }
+        }
+
+        const uint32_t cluster = run.glyphs[i].cluster;
+        prefixMax = std::max(prefixMax, cluster);
+        size_t offset = cluster;
+        if (cluster >= text.size() || !isLineEndSpace(utf8::decodeOne(text, offset))) {
+            contentEnd = i + 1;
+        }
     }
+    layout.breaks.push_back({glyphCount, contentEnd, static_cast<uint32_t>(text.size()), true});
+
+    // Lines of mixed-direction text are reordered from the cached analysis on every reflow
+    const BidiParagraph& bidi = shaper_.getBidiParagraph(text);
+    layout.hasRTL = bidi.hasRTL();
+    layout.reflow(static_cast<float>(params.maxWidth), layout.hasRTL ? &bidi : nullptr);
+}
+
+void TextLayout::reflow(float width, const BidiParagraph* bidi) {
+    maxWidth = width;
+    lineCount = 0;
+    totalWidth = 0.0f;
 
-    // Shape text
-    ShapedRun run = shaper_.shape(*font, text);
+    if (!glyphs.empty()) {
+        uint32_t start = 0;
+        uint32_t startCluster = 0;
+        const Break* fit = nullptr; // Last opportunity that fits on the current line
 
-    // Layout shaped glyphs into lines
-    TextLine currentLine;
-    float currentLineWidth = 0.0f;
+        for (size_t i = 0; i < breaks.size();) {
+            const Break& next = breaks[i];
+            const uint32_t contentEnd = std::max(next.contentEnd, start);
 
-    for (const auto& glyph : run.glyphs) {
-        const Glyph* fontGlyph = font->getGlyph(glyph.glyphID);
-        float advanceWidth = (fontGlyph) ? font->pixelsFromUnits(fontGlyph->advanceWidth, params.fontSize) : 0;
+            if (width > 0.0f && advanceSums[contentEnd] - advanceSums[start] > width) {
+                if (fit) {
+                    // Break at the last fitting opportunity and try this one on the next line
+                    addLine(start, fit->glyph, std::max(fit->contentEnd, start), startCluster, fit->cluster);
+                    start = fit->glyph;
+                    startCluster = fit->cluster;
+                    fit = nullptr;
+                    continue;
+                }
 
-        // Check if we need to wrap
-        if (params.maxWidth > 0 && currentLineWidth + advanceWidth > params.maxWidth) {
-            layout.lines.push_back(currentLine);
-            currentLine.glyphs.clear();
-            currentLineWidth = 0.0f;
+                // Nothing fits: split between glyphs, keeping the rest on the current line
+                while (contentEnd - start > 1 && advanceSums[contentEnd] - advanceSums[start] > width) {
+                    auto last = std::upper_bound(advanceSums.begin() + start + 1, advanceSums.begin() + contentEnd + 1, advanceSums[start] + width);
+                    const uint32_t end = std::max(static_cast<uint32_t>(last - advanceSums.begin()) - 1, start + 1);
+                    addLine(start, end, end, startCluster, glyphs[end].cluster);
+                    start = end;
+                    startCluster = glyphs[end].cluster;
+                }
+            }
+
+            if (next.mandatory) {
+                addLine(start, next.glyph, contentEnd, startCluster, next.cluster);
+                start = next.glyph;
+                startCluster = next.cluster;
+                fit = nullptr;
+            } else {
+                fit = &next;
+            }
+            ++i;
         }
+    }
 
-        currentLine.glyphs.push_back(glyph);
-        currentLineWidth += advanceWidth;
+    totalHeight = static_cast<float>(lineCount) * lineHeight;
+    if (width > 0.0f) {
+        totalWidth = width;
     }
 
-    if (!currentLine.glyphs.empty()) {
-        layout.lines.push_back(currentLine);
+    if (bidi) {
+        for (uint32_t i = 0; i < lineCount; ++i) {
+            reorderLine(lines[i], *bidi);
+        }
     }
+}
 
-    // Calculate layout dimensions
-    layout.lineCount = layout.lines.size();
-    layout.totalHeight = layout.lineCount * params.lineHeight * params.fontSize;
-    layout.totalWidth = params.maxWidth > 0 ? params.maxWidth : currentLineWidth;
+void TextLayout::reorderLine(TextLine& line, const BidiParagraph& bidi) {
+    bidi.getLineRuns(bidi.getIndex(line.startCluster), bidi.getIndex(line.endCluster), bidiRuns_);
+    if (bidiRuns_.empty() || (bidiRuns_.size() == 1 && !bidiRuns_[0].isRTL())) {
+        return;
+    }
 
-    return layout;
+    // Gather each level run's glyphs (in logical order within the line), reversing RTL runs
+    visualGlyphs_.clear();
+    for (const BidiParagraph::Run& run : bidiRuns_) {
+        const uint32_t start = bidi.getByteOffset(run.start);
+        const uint32_t end = bidi.getByteOffset(run.end);
+        const size_t first = visualGlyphs_.size();
+        for (const ShapedGlyph& glyph : line.glyphs) {
+            if (glyph.cluster >= start && glyph.cluster < end) {
+                visualGlyphs_.push_back(glyph);
+            }
+        }
+        if (run.isRTL()) {
+            std::reverse(visualGlyphs_.begin() + static_cast<std::ptrdiff_t>(first), visualGlyphs_.end());
+        }
+    }
+    if (visualGlyphs_.size() == line.glyphs.size()) {
+        line.glyphs.swap(visualGlyphs_);
+    }
+}
+
+void TextLayout::addLine(uint32_t start, uint32_t end, uint32_t contentEnd, uint32_t startCluster, uint32_t endCluster) {
+    // Keep the previous lines' glyph storage
+    if (lineCount == lines.size()) {
+        lines.emplace_back();
+    }
+    TextLine& line = lines[lineCount++];
+    line.glyphs.assign(glyphs.begin() + start, glyphs.begin() + end);
+    line.width = advanceSums[contentEnd] - advanceSums[start];
+    line.height = lineHeight;
+    line.startCluster = startCluster;
+    line.endCluster = endCluster;
+    totalWidth = std::max(totalWidth, line.width);
 }
 
-GlyphAtlas& TextRenderer::getAtlas(const std::string& fontName) { return *atlases_[fontName]; }
+GlyphAtlas& TextRenderer::getAtlas() { return *atlas_; }
 
 Vec2 TextRenderer::measureText(const std::string& fontName, const std::string& text, float fontSize) {
     Font* font = getFont(fontName);
@@ -84,16 +270,7 @@ Vec2 TextRenderer::measureText(const std::string& fontName, const std::string& t
         return Vec2(0, 0);
     }
 
-    ShapedRun run = shaper_.shape(*font, text);
-    float width = 0.0f;
-
-    for (const auto& glyph : run.glyphs) {
-        const Glyph* fontGlyph = font->getGlyph(glyph.glyphID);
-        if (fontGlyph) {
-            width += font->pixelsFromUnits(fontGlyph->advanceWidth, fontSize);
-        }
-    }
-
+    float width = font->pixelsFromUnits(wordCache_.measureText(shaper_, *font, text), fontSize);
     float height = font->pixelsFromUnits(font->getAscender() - font->getDescender(), fontSize);
 
     return Vec2(width, height);
@@ -105,9 +282,10 @@ float TextRenderer::measureLine(const std::string& fontName, const std::string&
         return 0.0f;
     }
 
+    utf8::decode(text, scratchCodepoints_);
+
     float width = 0.0f;
-    for (char c : text) {
-        uint32_t codepoint = static_cast<unsigned char>(c);
+    for (uint32_t codepoint : scratchCodepoints_) {
         uint16_t glyphID = font->getGlyphId(codepoint);
         const Glyph* glyph = font->getGlyph(glyphID);
         if (glyph) {
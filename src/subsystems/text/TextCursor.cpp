@@ -1,5 +1,6 @@
 #include "dakt/gui/subsystems/text/TextCursor.hpp"
 #include "dakt/gui/subsystems/draw/DrawList.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
 #include <algorithm>
 #include <cmath>
 
@@ -129,39 +130,8 @@ std::string TextCursor::getSelectedText() const {
     sel.normalize();
 
     // Convert character indices to byte indices (UTF-8 aware)
-    size_t byteStart = 0;
-    size_t byteEnd = 0;
-    size_t charIdx = 0;
-
-    for (size_t i = 0; i < text_.length();) {
-        if (charIdx == sel.start) {
-            byteStart = i;
-        }
-        if (charIdx == sel.end) {
-            byteEnd = i;
-            break;
-        }
-
-        // UTF-8 byte length
-        unsigned char c = text_[i];
-        if ((c & 0x80) == 0) {
-            i += 1;
-        } else if ((c & 0xE0) == 0xC0) {
-            i += 2;
-        } else if ((c & 0xF0) == 0xE0) {
-            i += 3;
-        } else if ((c & 0xF8) == 0xF0) {
-            i += 4;
-        } else {
-            i += 1;
-        }
-
-        ++charIdx;
-    }
-
-    if (byteEnd == 0 && charIdx >= sel.end) {
-        byteEnd = text_.length();
-    }
+    const size_t byteStart = utf8::offsetOf(text_, sel.start);
+    const size_t byteEnd = byteStart + utf8::offsetOf(std::string_view(text_).substr(byteStart), sel.end - sel.start);
 
     return text_.substr(byteStart, byteEnd - byteStart);
 }
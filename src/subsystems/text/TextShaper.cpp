@@ -1,6 +1,8 @@
 #include "dakt/gui/subsystems/text/TextShaper.hpp"
 #include "dakt/gui/subsystems/text/Font.hpp"
+#include "dakt/gui/subsystems/text/OpenTypeLayout.hpp"
 #include "dakt/gui/subsystems/text/TTFParser.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
 #include <algorithm>
 #include <unordered_map>
 
@@ -28,6 +30,55 @@ struct KernPair {
     int16_t adjustment;
 };
 
+static constexpr uint32_t FEATURE_LIGA = 0x6C696761; // 'liga'
+static constexpr uint32_t FEATURE_KERN = 0x6B65726E; // 'kern'
+
+static constexpr uint32_t TABLE_GSUB = 0x47535542; // 'GSUB'
+static constexpr uint32_t TABLE_GPOS = 0x47504F53; // 'GPOS'
+static constexpr uint32_t TABLE_KERN = 0x6B65726E; // 'kern'
+static constexpr uint32_t OT_SCRIPT_LATN = 0x6C61746E; // 'latn' as tagged in GSUB/GPOS
+static constexpr uint32_t TABLE_GDEF = 0x47444546; // 'GDEF'
+
+// Kerning pairs by character for fonts without GPOS or kern tables, font units
+static const KernPair COMMON_KERN_PAIRS[] = {
+    // A + V, A + W, A + Y combinations
+    {'A', 'V', -80},
+    {'A', 'W', -60},
+    {'A', 'Y', -80},
+    {'A', 'T', -80},
+
+    // T + a, T + o combinations
+    {'T', 'a', -80},
+    {'T', 'o', -80},
+    {'T', 'e', -60},
+
+    // V + a, V + e, V + o
+    {'V', 'a', -60},
+    {'V', 'e', -50},
+    {'V', 'o', -50},
+
+    // W + a, W + e
+    {'W', 'a', -40},
+    {'W', 'e', -30},
+
+    // Y + a, Y + e, Y + o
+    {'Y', 'a', -80},
+    {'Y', 'e', -70},
+    {'Y', 'o', -70},
+};
+
+// Bytes of a font table, or null if the font lacks it (or it runs past the data)
+static const uint8_t* findTableData(const TTFParser& parser, uint32_t tag, size_t& size) {
+    const TableDirectory* table = parser.findTable(tag);
+    const auto& data = parser.getFontData();
+    if (!table || table->offset > data.size() || table->length > data.size() - table->offset) {
+        size = 0;
+        return nullptr;
+    }
+    size = table->length;
+    return data.data() + table->offset;
+}
+
 // ============================================================================
 // TextShaper Implementation
 // ============================================================================
@@ -38,53 +89,113 @@ TextShaper::TextShaper() {
         {0x6C696761, true}, // 'liga' standard ligatures
         {0x6B65726E, true}, // 'kern' kerning
         {0x636C6967, true}, // 'clig' contextual ligatures
+        {0x63616C74, true}, // 'calt' contextual alternates (programming ligatures)
+        {0x63636D70, true}, // 'ccmp' glyph composition
+        {0x726C6967, true}, // 'rlig' required ligatures
     };
 }
 
 TextShaper::~TextShaper() = default;
 
-// UTF-8 decode helper
-static uint32_t decodeUTF8(const std::string& text, size_t& i) {
-    uint32_t codepoint = 0;
-    unsigned char c = text[i];
-
-    if ((c & 0x80) == 0) {
-        codepoint = c;
-        ++i;
-    } else if ((c & 0xE0) == 0xC0) {
-        codepoint = (c & 0x1F) << 6;
-        if (i + 1 < text.length()) {
-            codepoint |= (text[i + 1] & 0x3F);
+bool TextShaper::isFeatureEnabled(uint32_t tag) const {
+    for (const auto& feature : features_) {
+        if (feature.tag == tag && feature.enabled) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const TextShaper::FontPlan& TextShaper::getPlan(Font& font) {
+    auto it = plans_.find(&font);
+    if (it != plans_.end()) {
+        return it->second;
+    }
+
+    FontPlan& plan = plans_[&font];
+
+    for (uint32_t c = 0; c < 128; ++c) {
+        uint16_t glyphID = font.getGlyphId(c);
+        const Glyph* glyph = font.getGlyph(glyphID);
+        plan.asciiGlyphs[c] = glyphID;
+        plan.asciiAdvances[c] = glyph ? static_cast<float>(glyph->advanceWidth) : 0.0f;
+    }
+
+    // Compile the font's GSUB for the enabled features (Latin; other scripts use the same plan)
+    const TTFParser* parser = font.getParser();
+    if (parser) {
+        size_t gsubSize = 0;
+        size_t gdefSize = 0;
+        const uint8_t* gsub = findTableData(*parser, TABLE_GSUB, gsubSize);
+        const uint8_t* gdef = findTableData(*parser, TABLE_GDEF, gdefSize);
+        if (gsub) {
+            std::vector<uint32_t> enabled;
+            for (const auto& feature : features_) {
+                if (feature.enabled) {
+                    enabled.push_back(feature.tag);
+                }
+            }
+
+            auto substitution = std::make_unique<GlyphSubstitution>();
+            if (substitution->load(gsub, gsubSize, OT_SCRIPT_LATN, enabled, gdef, gdefSize)) {
+                plan.gsub = std::move(substitution);
+            }
         }
-        i += 2;
-    } else if ((c & 0xF0) == 0xE0) {
-        codepoint = (c & 0x0F) << 12;
-        if (i + 1 < text.length()) {
-            codepoint |= (text[i + 1] & 0x3F) << 6;
+    }
+    // Fonts without GSUB: common Latin ligatures
+    if (!plan.gsub) {
+        plan.glyphF = font.getGlyphId('f');
+        plan.glyphI = font.getGlyphId('i');
+        plan.glyphL = font.getGlyphId('l');
+        plan.glyphFi = font.getGlyphId(0xFB01); // fi ligature
+        plan.glyphFl = font.getGlyphId(0xFB02); // fl ligature
+        plan.hasLigatures = isFeatureEnabled(FEATURE_LIGA) && plan.glyphF != 0 && (plan.glyphFi != 0 || plan.glyphFl != 0);
+        if (const Glyph* glyph = font.getGlyph(plan.glyphFi)) {
+            plan.advanceFi = static_cast<float>(glyph->advanceWidth);
         }
-        if (i + 2 < text.length()) {
-            codepoint |= (text[i + 2] & 0x3F);
+        if (const Glyph* glyph = font.getGlyph(plan.glyphFl)) {
+            plan.advanceFl = static_cast<float>(glyph->advanceWidth);
         }
-        i += 3;
-    } else if ((c & 0xF8) == 0xF0) {
-        codepoint = (c & 0x07) << 18;
-        if (i + 1 < text.length()) {
-            codepoint |= (text[i + 1] & 0x3F) << 12;
+    }
+
+    // Kerning: GPOS pair lookups, else the legacy kern table, else common Latin pairs
+    if (isFeatureEnabled(FEATURE_KERN)) {
+        auto positioning = std::make_unique<GlyphPositioning>();
+        bool loaded = false;
+        if (parser) {
+            size_t size = 0;
+            if (const uint8_t* gpos = findTableData(*parser, TABLE_GPOS, size)) {
+                loaded = positioning->load(gpos, size, OT_SCRIPT_LATN, {FEATURE_KERN});
+            }
+            if (!loaded) {
+                if (const uint8_t* kern = findTableData(*parser, TABLE_KERN, size)) {
+                    loaded = positioning->loadKern(kern, size);
+                }
+            }
         }
-        if (i + 2 < text.length()) {
-            codepoint |= (text[i + 2] & 0x3F) << 6;
+        if (!loaded) {
+            std::vector<GlyphPositioning::KerningPair> pairs;
+            for (const KernPair& pair : COMMON_KERN_PAIRS) {
+                uint16_t left = font.getGlyphId(pair.left);
+                uint16_t right = font.getGlyphId(pair.right);
+                if (left != 0 && right != 0) {
+                    pairs.push_back({left, right, pair.adjustment});
+                }
+            }
+            loaded = positioning->loadPairs(pairs);
         }
-        if (i + 3 < text.length()) {
-            codepoint |= (text[i + 3] & 0x3F);
+        if (loaded) {
+            plan.gpos = std::move(positioning);
         }
-        i += 4;
-    } else {
-        ++i;
     }
 
-    return codepoint;
+    return plan;
 }
 
+void TextShaper::invalidateFont(const Font* font) { plans_.erase(font); }
+
+static bool isWordSeparator(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
 // Detect script from codepoint
 static uint32_t detectScript(uint32_t codepoint) {
     // Arabic: U+0600-U+06FF, U+0750-U+077F, U+08A0-U+08FF
@@ -110,339 +221,317 @@ static uint32_t detectScript(uint32_t codepoint) {
 static bool isRTLScript(uint32_t script) { return script == SCRIPT_ARAB || script == SCRIPT_HEBR; }
 
 ShapedRun TextShaper::shape(Font& font, const std::string& text, uint32_t scriptTag) {
+    ShapedGlyphBuffer buffer;
+    shapeInto(font, text, buffer, scriptTag);
+
     ShapedRun run;
-    run.scriptTag = scriptTag;
+    run.glyphs = std::move(buffer.glyphs);
+    run.scriptTag = buffer.scriptTag;
+    run.isRTL = buffer.isRTL;
 
-    // Convert UTF-8 text to codepoints and get glyphs
-    std::vector<uint32_t> codepoints;
-    for (size_t i = 0; i < text.length();) {
-        uint32_t cp = decodeUTF8(text, i);
-        codepoints.push_back(cp);
+    // ShapedRun clusters count codepoints; walk forward from one cluster's byte offset to the next
+    size_t byte = 0;
+    uint32_t index = 0;
+    for (auto& glyph : run.glyphs) {
+        while (byte < glyph.cluster) {
+            utf8::decodeOne(text, byte);
+            ++index;
+        }
+        glyph.cluster = index;
     }
 
-    // Detect script if not specified
-    if (scriptTag == 0 && !codepoints.empty()) {
-        run.scriptTag = detectScript(codepoints[0]);
-    }
-    run.isRTL = isRTLScript(run.scriptTag);
+    return run;
+}
 
-    // Map codepoints to glyphs
-    uint32_t cluster = 0;
-    for (uint32_t codepoint : codepoints) {
-        uint16_t glyphID = font.getGlyphId(codepoint);
-        const Glyph* glyph = font.getGlyph(glyphID);
+void TextShaper::shapeInto(Font& font, std::string_view text, ShapedGlyphBuffer& buffer, uint32_t scriptTag) {
+    buffer.clear();
+    buffer.scriptTag = scriptTag;
 
-        ShapedGlyph shapedGlyph;
+    const FontPlan& plan = getPlan(font);
+    auto& glyphs = buffer.glyphs;
+
+    // At most one glyph per byte; shrinking afterwards keeps the capacity
+    glyphs.resize(text.length());
+    size_t count = 0;
+
+    for (size_t i = 0; i < text.length();) {
+        const auto cluster = static_cast<uint32_t>(i);
+        const auto c = static_cast<unsigned char>(text[i]);
+
+        uint32_t codepoint = c;
+        uint16_t glyphID = 0;
+        float advance = 0.0f;
+        if (c < 0x80) {
+            // ASCII fast path: glyph and advance straight from the plan
+            glyphID = plan.asciiGlyphs[c];
+            advance = plan.asciiAdvances[c];
+            ++i;
+        } else {
+            codepoint = utf8::decodeOne(text, i);
+            glyphID = font.getGlyphId(codepoint);
+            const Glyph* glyph = font.getGlyph(glyphID);
+            advance = glyph ? static_cast<float>(glyph->advanceWidth) : 0.0f;
+        }
+
+        // Detect script from the first codepoint if not specified
+        if (buffer.scriptTag == 0) {
+            buffer.scriptTag = detectScript(codepoint);
+        }
+
+        ShapedGlyph& shapedGlyph = glyphs[count++];
         shapedGlyph.glyphID = glyphID;
         shapedGlyph.cluster = cluster;
-        shapedGlyph.xAdvance = glyph ? static_cast<float>(glyph->advanceWidth) : 0.0f;
+        shapedGlyph.xAdvance = advance;
         shapedGlyph.yAdvance = 0;
         shapedGlyph.xOffset = 0;
         shapedGlyph.yOffset = 0;
-
-        run.glyphs.push_back(shapedGlyph);
-        ++cluster;
+        shapedGlyph.flags = 0;
     }
 
-    // Apply OpenType features
-    applyGSUB(font, run);
-    applyGPOS(font, run);
+    glyphs.resize(count);
+    buffer.isRTL = isRTLScript(buffer.scriptTag);
 
-    return run;
+    // Apply OpenType features, skipping passes the font has nothing for
+    substitute(font, plan, glyphs);
+    if (plan.gpos) {
+        plan.gpos->apply(glyphs);
+    }
 }
 
 std::vector<ShapedRun> TextShaper::shapeBidi(Font& font, const std::string& text) {
     std::vector<ShapedRun> runs;
 
-    // UAX #9 Bidirectional Algorithm (simplified)
-    // For full implementation, would need complete Unicode BiDi tables
-
-    std::vector<uint32_t> codepoints;
-    std::vector<uint8_t> bidiTypes;  // 0 = L, 1 = R, 2 = neutral
-    std::vector<uint8_t> bidiLevels; // Embedding level
-
-    // Decode and classify
-    for (size_t i = 0; i < text.length();) {
-        uint32_t cp = decodeUTF8(text, i);
-        codepoints.push_back(cp);
-
-        // Simple classification
-        uint8_t type = 2; // neutral
-        if ((cp >= 0x0041 && cp <= 0x005A) || (cp >= 0x0061 && cp <= 0x007A)) {
-            type = 0; // Latin letters = L
-        } else if ((cp >= 0x0600 && cp <= 0x06FF) || (cp >= 0x0590 && cp <= 0x05FF)) {
-            type = 1; // Arabic/Hebrew = R
-        }
-        bidiTypes.push_back(type);
-    }
-
-    // Simple level assignment (not full algorithm)
-    uint8_t baseLevel = 0;
-    for (uint8_t type : bidiTypes) {
-        if (type == 1) {
-            baseLevel = 1; // RTL paragraph
-            break;
+    const BidiParagraph& bidi = getBidiParagraph(text);
+    bidi.getLineRuns(0, bidi.size(), bidiRuns_);
+
+    const std::string_view view(text);
+    ShapedGlyphBuffer buffer;
+    for (const auto& level : bidiRuns_) {
+        // Shape the run's slice of the original text; clusters count codepoints from the run start
+        const uint32_t start = bidi.getByteOffset(level.start);
+        shapeInto(font, view.substr(start, bidi.getByteOffset(level.end) - start), buffer, level.isRTL() ? SCRIPT_ARAB : SCRIPT_LATN);
+
+        ShapedRun run;
+        run.glyphs = buffer.glyphs;
+        run.scriptTag = buffer.scriptTag;
+        run.isRTL = level.isRTL();
+
+        size_t codepoint = level.start;
+        for (auto& glyph : run.glyphs) {
+            while (bidi.getByteOffset(codepoint) < start + glyph.cluster) {
+                ++codepoint;
+            }
+            glyph.cluster = static_cast<uint32_t>(codepoint - level.start);
         }
-    }
 
-    bidiLevels.resize(codepoints.size(), baseLevel);
-    for (size_t i = 0; i < bidiTypes.size(); ++i) {
-        if (bidiTypes[i] == 1) {
-            bidiLevels[i] = 1;
-        } else if (bidiTypes[i] == 0) {
-            bidiLevels[i] = 0;
+        if (run.isRTL) {
+            std::reverse(run.glyphs.begin(), run.glyphs.end());
         }
-    }
 
-    // Split into runs by level
-    if (codepoints.empty()) {
-        return runs;
+        runs.push_back(std::move(run));
     }
 
-    size_t runStart = 0;
-    uint8_t currentLevel = bidiLevels[0];
-
-    for (size_t i = 1; i <= codepoints.size(); ++i) {
-        if (i == codepoints.size() || bidiLevels[i] != currentLevel) {
-            // Create run
-            std::string runText;
-            for (size_t j = runStart; j < i; ++j) {
-                // Re-encode to UTF-8
-                uint32_t cp = codepoints[j];
-                if (cp < 0x80) {
-                    runText += static_cast<char>(cp);
-                } else if (cp < 0x800) {
-                    runText += static_cast<char>(0xC0 | (cp >> 6));
-                    runText += static_cast<char>(0x80 | (cp & 0x3F));
-                } else if (cp < 0x10000) {
-                    runText += static_cast<char>(0xE0 | (cp >> 12));
-                    runText += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
-                    runText += static_cast<char>(0x80 | (cp & 0x3F));
-                }
-            }
-
-            ShapedRun run = shape(font, runText, currentLevel == 1 ? SCRIPT_ARAB : SCRIPT_LATN);
-            run.isRTL = (currentLevel % 2) == 1;
-
-            // Reverse RTL runs
-            if (run.isRTL) {
-                std::reverse(run.glyphs.begin(), run.glyphs.end());
-            }
-
-            runs.push_back(run);
+    return runs;
+}
 
-            if (i < codepoints.size()) {
-                runStart = i;
-                currentLevel = bidiLevels[i];
-            }
+const BidiParagraph& TextShaper::getBidiParagraph(std::string_view text) {
+    const size_t hash = std::hash<std::string_view>{}(text);
+    for (auto it = bidiCache_.begin(); it != bidiCache_.end(); ++it) {
+        if (it->hash == hash && it->text == text) {
+            bidiCache_.splice(bidiCache_.begin(), bidiCache_, it);
+            return it->paragraph;
         }
     }
 
-    // Reorder runs according to levels
-    std::vector<uint32_t> runLevels;
-    for (const auto& run : runs) {
-        runLevels.push_back(run.isRTL ? 1 : 0);
+    // Miss: recycle the least recently used entry's storage once the cache is full
+    if (bidiCache_.size() >= BIDI_CACHE_SIZE) {
+        bidiCache_.splice(bidiCache_.begin(), bidiCache_, std::prev(bidiCache_.end()));
+    } else {
+        bidiCache_.emplace_front();
     }
-    reorderLogicalToVisual(runs, runLevels);
 
-    return runs;
+    BidiEntry& entry = bidiCache_.front();
+    entry.text.assign(text);
+    entry.hash = hash;
+    entry.paragraph.analyze(text);
+    return entry.paragraph;
 }
 
 void TextShaper::applyGSUB(Font& font, ShapedRun& run) {
-    // Check if ligatures feature is enabled
-    bool ligaturesEnabled = false;
-    for (const auto& feature : features_) {
-        if (feature.tag == 0x6C696761 && feature.enabled) { // 'liga'
-            ligaturesEnabled = true;
-            break;
+    substitute(font, getPlan(font), run.glyphs);
+}
+
+void TextShaper::substitute(Font& font, const FontPlan& plan, std::vector<ShapedGlyph>& glyphs) {
+    if (plan.gsub) {
+        if (plan.gsub->apply(glyphs)) {
+            // Substituted glyphs come without advances
+            for (auto& glyph : glyphs) {
+                const Glyph* metrics = font.getGlyph(static_cast<uint16_t>(glyph.glyphID));
+                glyph.xAdvance = metrics ? static_cast<float>(metrics->advanceWidth) : 0.0f;
+            }
         }
+    } else if (plan.hasLigatures) {
+        substituteLigatures(plan, glyphs);
     }
+}
 
-    if (!ligaturesEnabled || run.glyphs.size() < 2) {
-        return;
+void TextShaper::applyGPOS(Font& font, ShapedRun& run) {
+    const FontPlan& plan = getPlan(font);
+    if (plan.gpos) {
+        plan.gpos->apply(run.glyphs);
     }
+}
 
-    // Common Latin ligatures (hardcoded for now - real implementation parses GSUB table)
-    // f + i -> fi (U+FB01), f + l -> fl (U+FB02), f + f -> ff, f + f + i -> ffi, etc.
-
-    uint16_t glyphF = font.getGlyphId('f');
-    uint16_t glyphI = font.getGlyphId('i');
-    uint16_t glyphL = font.getGlyphId('l');
-    uint16_t glyphFi = font.getGlyphId(0xFB01); // fi ligature
-    uint16_t glyphFl = font.getGlyphId(0xFB02); // fl ligature
-
-    if (glyphF == 0)
+void TextShaper::substituteLigatures(const FontPlan& plan, std::vector<ShapedGlyph>& glyphs) {
+    if (glyphs.size() < 2) {
         return;
+    }
 
-    // Scan for ligature sequences
-    std::vector<ShapedGlyph> newGlyphs;
-    newGlyphs.reserve(run.glyphs.size());
-
-    for (size_t i = 0; i < run.glyphs.size(); ++i) {
-        if (run.glyphs[i].glyphID == glyphF && i + 1 < run.glyphs.size()) {
-            // Check for fi
-            if (run.glyphs[i + 1].glyphID == glyphI && glyphFi != 0) {
-                ShapedGlyph lig = run.glyphs[i];
-                lig.glyphID = glyphFi;
-
-                const Glyph* ligGlyph = font.getGlyph(static_cast<uint16_t>(glyphFi));
-                if (ligGlyph) {
-                    lig.xAdvance = static_cast<float>(ligGlyph->advanceWidth);
-                }
-
-                newGlyphs.push_back(lig);
+    // f + i -> fi (U+FB01), f + l -> fl (U+FB02); hardcoded for now - real implementation parses GSUB table
+    // Ligatures only shrink the sequence, so compact in place
+    size_t out = 0;
+    for (size_t i = 0; i < glyphs.size(); ++i) {
+        ShapedGlyph glyph = glyphs[i];
+
+        if (glyph.glyphID == plan.glyphF && i + 1 < glyphs.size()) {
+            const uint32_t next = glyphs[i + 1].glyphID;
+            if (next == plan.glyphI && plan.glyphFi != 0) {
+                glyph.glyphID = plan.glyphFi;
+                glyph.xAdvance = plan.advanceFi;
                 ++i; // Skip the 'i'
-                continue;
-            }
-            // Check for fl
-            if (run.glyphs[i + 1].glyphID == glyphL && glyphFl != 0) {
-                ShapedGlyph lig = run.glyphs[i];
-                lig.glyphID = glyphFl;
-
-                const Glyph* ligGlyph = font.getGlyph(static_cast<uint16_t>(glyphFl));
-                if (ligGlyph) {
-                    lig.xAdvance = static_cast<float>(ligGlyph->advanceWidth);
-                }
-
-                newGlyphs.push_back(lig);
+            } else if (next == plan.glyphL && plan.glyphFl != 0) {
+                glyph.glyphID = plan.glyphFl;
+                glyph.xAdvance = plan.advanceFl;
                 ++i; // Skip the 'l'
-                continue;
             }
         }
 
-        newGlyphs.push_back(run.glyphs[i]);
+        glyphs[out++] = glyph;
     }
 
-    run.glyphs = std::move(newGlyphs);
+    glyphs.resize(out);
 }
 
-void TextShaper::applyGPOS(Font& font, ShapedRun& run) {
-    // Check if kerning feature is enabled
-    bool kerningEnabled = false;
-    for (const auto& feature : features_) {
-        if (feature.tag == 0x6B65726E && feature.enabled) { // 'kern'
-            kerningEnabled = true;
-            break;
+void TextShaper::substituteWhitespace(ShapedRun& run, uint32_t spaceGlyphID) {
+    for (auto& glyph : run.glyphs) {
+        // Check if this is a space character (various Unicode spaces)
+        // In a real implementation, would check cluster's original codepoint
+        if (glyph.glyphID == 0) {
+            glyph.glyphID = spaceGlyphID;
         }
     }
+}
 
-    if (!kerningEnabled || run.glyphs.size() < 2) {
-        return;
-    }
+// ============================================================================
+// ShapedWordCache Implementation
+// ============================================================================
 
-    // Apply kerning pairs (real implementation parses GPOS/kern tables)
-    // For now, use hardcoded common pairs
-
-    // Common kerning pairs (in font units, typical values)
-    static const std::unordered_map<uint32_t, int16_t> commonKernPairs = {
-        // A + V, A + W, A + Y combinations
-        {('A' << 16) | 'V', -80},
-        {('A' << 16) | 'W', -60},
-        {('A' << 16) | 'Y', -80},
-        {('A' << 16) | 'T', -80},
-
-        // T + a, T + o combinations
-        {('T' << 16) | 'a', -80},
-        {('T' << 16) | 'o', -80},
-        {('T' << 16) | 'e', -60},
-
-        // V + a, V + e, V + o
-        {('V' << 16) | 'a', -60},
-        {('V' << 16) | 'e', -50},
-        {('V' << 16) | 'o', -50},
-
-        // W + a, W + e
-        {('W' << 16) | 'a', -40},
-        {('W' << 16) | 'e', -30},
-
-        // Y + a, Y + e, Y + o
-        {('Y' << 16) | 'a', -80},
-        {('Y' << 16) | 'e', -70},
-        {('Y' << 16) | 'o', -70},
-    };
+ShapedWordCache::ShapedWordCache(size_t maxEntries) : maxEntries_(maxEntries) {}
+
+ShapedWordCache::~ShapedWordCache() = default;
 
-    // Build glyph-to-char map for kern lookup
-    std::unordered_map<uint16_t, char> glyphToChar;
-    for (char c = 'A'; c <= 'Z'; ++c) {
-        glyphToChar[font.getGlyphId(c)] = c;
+const ShapedWord& ShapedWordCache::get(TextShaper& shaper, Font& font, std::string_view word) {
+    auto it = cache_.find(KeyView{&font, word});
+    if (it != cache_.end()) {
+        // Cache hit - move to front of LRU
+        ++hitCount_;
+        lruList_.splice(lruList_.begin(), lruList_, it->second.lruIterator);
+        return it->second.word;
     }
-    for (char c = 'a'; c <= 'z'; ++c) {
-        glyphToChar[font.getGlyphId(c)] = c;
+
+    // Cache miss - shape and insert
+    ++missCount_;
+
+    if (!cache_.empty() && cache_.size() >= maxEntries_) {
+        evictLRU();
     }
 
-    // Apply kerning
-    for (size_t i = 0; i + 1 < run.glyphs.size(); ++i) {
-        auto it1 = glyphToChar.find(static_cast<uint16_t>(run.glyphs[i].glyphID));
-        auto it2 = glyphToChar.find(static_cast<uint16_t>(run.glyphs[i + 1].glyphID));
-
-        if (it1 != glyphToChar.end() && it2 != glyphToChar.end()) {
-            uint32_t pairKey = (static_cast<uint32_t>(it1->second) << 16) | it2->second;
-            auto kernIt = commonKernPairs.find(pairKey);
-            if (kernIt != commonKernPairs.end()) {
-                // Apply kern value (scaled by font units)
-                run.glyphs[i].xAdvance += kernIt->second;
-            }
-        }
+    shaper.shapeInto(font, word, scratch_);
+
+    CacheEntry entry;
+    entry.word.glyphs = scratch_.glyphs;
+    entry.word.scriptTag = scratch_.scriptTag;
+    entry.word.isRTL = scratch_.isRTL;
+    for (const auto& glyph : entry.word.glyphs) {
+        entry.word.advance += glyph.xAdvance;
     }
+
+    Key key{&font, std::string(word)};
+    lruList_.push_front(key);
+    entry.lruIterator = lruList_.begin();
+
+    auto [insertIt, success] = cache_.emplace(std::move(key), std::move(entry));
+    return insertIt->second.word;
 }
 
-void TextShaper::substituteWhitespace(ShapedRun& run, uint32_t spaceGlyphID) {
-    for (auto& glyph : run.glyphs) {
-        // Check if this is a space character (various Unicode spaces)
-        // In a real implementation, would check cluster's original codepoint
-        if (glyph.glyphID == 0) {
-            glyph.glyphID = spaceGlyphID;
-        }
+// Length of the word or whitespace run starting at start
+static size_t segmentLength(std::string_view text, size_t start) {
+    const bool separator = isWordSeparator(text[start]);
+    size_t end = start + 1;
+    while (end < text.length() && isWordSeparator(text[end]) == separator) {
+        ++end;
     }
+    return end - start;
 }
 
-void TextShaper::determineBidiLevel(const std::string& text, std::vector<uint32_t>& levels) {
-    // Simplified - real implementation follows UAX #9
-    levels.clear();
-    for (size_t i = 0; i < text.length();) {
-        uint32_t cp = decodeUTF8(text, i);
+void ShapedWordCache::shapeText(TextShaper& shaper, Font& font, std::string_view text, ShapedRun& run) {
+    run.glyphs.clear();
+    run.scriptTag = 0;
+    run.languageTag = 0;
+    run.isRTL = false;
+
+    // Words and whitespace runs alternate; both are cached segments
+    size_t start = 0;
+    while (start < text.length()) {
+        const size_t end = start + segmentLength(text, start);
+        const ShapedWord& word = get(shaper, font, text.substr(start, end - start));
+        if (start == 0) {
+            run.scriptTag = word.scriptTag;
+            run.isRTL = word.isRTL;
+        }
 
-        // RTL characters get level 1
-        if ((cp >= 0x0590 && cp <= 0x05FF) || (cp >= 0x0600 && cp <= 0x06FF)) {
-            levels.push_back(1);
-        } else {
-            levels.push_back(0);
+        for (ShapedGlyph glyph : word.glyphs) {
+            glyph.cluster += static_cast<uint32_t>(start);
+            run.glyphs.push_back(glyph);
         }
+        start = end;
     }
 }
 
-void TextShaper::reorderLogicalToVisual(std::vector<ShapedRun>& runs, const std::vector<uint32_t>& levels) {
-    if (runs.size() <= 1)
-        return;
-
-    // Find maximum level
-    uint32_t maxLevel = 0;
-    for (uint32_t level : levels) {
-        maxLevel = std::max(maxLevel, level);
+float ShapedWordCache::measureText(TextShaper& shaper, Font& font, std::string_view text) {
+    float advance = 0.0f;
+    for (size_t start = 0; start < text.length();) {
+        const size_t length = segmentLength(text, start);
+        advance += get(shaper, font, text.substr(start, length)).advance;
+        start += length;
     }
+    return advance;
+}
 
-    // Reverse subsequences at each level (from highest to lowest)
-    for (uint32_t level = maxLevel; level >= 1; --level) {
-        size_t i = 0;
-        while (i < runs.size()) {
-            // Find start of run at this level
-            while (i < runs.size() && levels[i] < level) {
-                ++i;
-            }
+void ShapedWordCache::invalidateFont(const Font* font) {
+    auto it = cache_.begin();
+    while (it != cache_.end()) {
+        if (it->first.font == font) {
+            lruList_.erase(it->second.lruIterator);
+            it = cache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
 
-            size_t start = i;
+void ShapedWordCache::clear() {
+    cache_.clear();
+    lruList_.clear();
+}
 
-            // Find end of run at this level
-            while (i < runs.size() && levels[i] >= level) {
-                ++i;
-            }
+void ShapedWordCache::evictLRU() {
+    if (lruList_.empty())
+        return;
 
-            // Reverse this subsequence
-            if (start < i) {
-                std::reverse(runs.begin() + start, runs.begin() + i);
-            }
-        }
-    }
+    // Remove least recently used (back of list)
+    cache_.erase(lruList_.back());
+    lruList_.pop_back();
 }
 
 } // namespace dakt::gui
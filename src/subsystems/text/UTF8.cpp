@@ -0,0 +1,283 @@
+#include "dakt/gui/subsystems/text/UTF8.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DAKTLIB_UTF8_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DAKTLIB_UTF8_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define DAKTLIB_UTF8_NEON 1
+#endif
+
+namespace dakt::gui::utf8 {
+
+namespace {
+
+#if defined(DAKTLIB_UTF8_AVX2)
+constexpr size_t CHUNK_SIZE = 32;
+#else
+constexpr size_t CHUNK_SIZE = 16;
+#endif
+
+// True if the CHUNK_SIZE bytes at p are all ASCII
+inline bool isAsciiChunk(const unsigned char* p) {
+#if defined(DAKTLIB_UTF8_AVX2)
+    return _mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))) == 0;
+#elif defined(DAKTLIB_UTF8_SSE2)
+    return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) == 0;
+#elif defined(DAKTLIB_UTF8_NEON)
+    return vmaxvq_u8(vld1q_u8(p)) < 0x80;
+#else
+    uint64_t a = 0;
+    uint64_t b = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        a |= static_cast<uint64_t>(p[i]) << (i * 8);
+        b |= static_cast<uint64_t>(p[i + 8]) << (i * 8);
+    }
+    return ((a | b) & 0x8080808080808080ULL) == 0;
+#endif
+}
+
+// Zero-extend CHUNK_SIZE ASCII bytes at p into codepoints
+inline void widenChunk(const unsigned char* p, uint32_t* out) {
+#if defined(DAKTLIB_UTF8_AVX2)
+    for (size_t i = 0; i < CHUNK_SIZE; i += 8) {
+        const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_cvtepu8_epi32(bytes));
+    }
+#elif defined(DAKTLIB_UTF8_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+    const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 0), _mm_unpacklo_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4), _mm_unpackhi_epi16(lo, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpacklo_epi16(hi, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm_unpackhi_epi16(hi, zero));
+#elif defined(DAKTLIB_UTF8_NEON)
+    const uint8x16_t bytes = vld1q_u8(p);
+    const uint16x8_t lo = vmovl_u8(vget_low_u8(bytes));
+    const uint16x8_t hi = vmovl_u8(vget_high_u8(bytes));
+    vst1q_u32(out + 0, vmovl_u16(vget_low_u16(lo)));
+    vst1q_u32(out + 4, vmovl_u16(vget_high_u16(lo)));
+    vst1q_u32(out + 8, vmovl_u16(vget_low_u16(hi)));
+    vst1q_u32(out + 12, vmovl_u16(vget_high_u16(hi)));
+#else
+    for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+        out[i] = p[i];
+    }
+#endif
+}
+
+inline bool isContinuation(unsigned char c) { return (c & 0xC0) == 0x80; }
+
+// Strict multi-byte decode of the sequence led by text[offset] (>= 0x80).
+// Rejects overlongs, surrogates and values above U+10FFFF; on error offset
+// skips the maximal subpart so the next call resynchronizes.
+uint32_t decodeMultiByte(std::string_view text, size_t& offset) {
+    const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t size = text.size();
+    const unsigned char lead = p[offset];
+
+    size_t length = 0;
+    uint32_t codepoint = 0;
+    unsigned char lower = 0x80; // Valid range of the second byte
+    unsigned char upper = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+        codepoint = lead & 0x1F;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        codepoint = lead & 0x0F;
+        if (lead == 0xE0) {
+            lower = 0xA0; // Overlong
+        } else if (lead == 0xED) {
+            upper = 0x9F; // Surrogates
+        }
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        codepoint = lead & 0x07;
+        if (lead == 0xF0) {
+            lower = 0x90; // Overlong
+        } else if (lead == 0xF4) {
+            upper = 0x8F; // Above U+10FFFF
+        }
+    } else {
+        ++offset; // Stray continuation byte or invalid lead
+        return REPLACEMENT_CHARACTER;
+    }
+
+    size_t i = offset + 1;
+    if (i >= size || p[i] < lower || p[i] > upper) {
+        offset = i;
+        return REPLACEMENT_CHARACTER;
+    }
+    codepoint = (codepoint << 6) | (p[i] & 0x3F);
+
+    for (++i; i < offset + length; ++i) {
+        if (i >= size || !isContinuation(p[i])) {
+            offset = i;
+            return REPLACEMENT_CHARACTER;
+        }
+        codepoint = (codepoint << 6) | (p[i] & 0x3F);
+    }
+
+    offset = i;
+    return codepoint;
+}
+
+} // namespace
+
+size_t asciiPrefix(std::string_view text) {
+    const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t size = text.size();
+
+    size_t i = 0;
+    while (i + CHUNK_SIZE <= size && isAsciiChunk(p + i)) {
+        i += CHUNK_SIZE;
+    }
+    while (i < size && p[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+uint32_t decodeOne(std::string_view text, size_t& offset) {
+    const auto c = static_cast<unsigned char>(text[offset]);
+    if (c < 0x80) {
+        ++offset;
+        return c;
+    }
+    return decodeMultiByte(text, offset);
+}
+
+size_t decode(std::string_view text, uint32_t* out, uint32_t* offsets) {
+    const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t size = text.size();
+
+    size_t count = 0;
+    size_t i = 0;
+    while (i < size) {
+        // Whole ASCII chunks widen without per-byte branches
+        if (i + CHUNK_SIZE <= size && isAsciiChunk(p + i)) {
+            widenChunk(p + i, out + count);
+            if (offsets) {
+                for (size_t k = 0; k < CHUNK_SIZE; ++k) {
+                    offsets[count + k] = static_cast<uint32_t>(i + k);
+                }
+            }
+            count += CHUNK_SIZE;
+            i += CHUNK_SIZE;
+            continue;
+        }
+
+        if (offsets) {
+            offsets[count] = static_cast<uint32_t>(i);
+        }
+        out[count++] = p[i] < 0x80 ? p[i++] : decodeMultiByte(text, i);
+    }
+
+    return count;
+}
+
+void decode(std::string_view text, std::vector<uint32_t>& out) {
+    // At most one codepoint per byte; shrinking afterwards keeps the capacity
+    out.resize(text.size());
+    out.resize(decode(text, out.data()));
+}
+
+size_t length(std::string_view text) {
+    const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t size = text.size();
+
+    size_t count = 0;
+    size_t i = 0;
+    while (i < size) {
+        if (i + CHUNK_SIZE <= size && isAsciiChunk(p + i)) {
+            count += CHUNK_SIZE;
+            i += CHUNK_SIZE;
+            continue;
+        }
+        decodeOne(text, i);
+        ++count;
+    }
+    return count;
+}
+
+size_t offsetOf(std::string_view text, size_t index) {
+    const auto* p = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t size = text.size();
+
+    size_t i = 0;
+    while (index > 0 && i < size) {
+        if (index >= CHUNK_SIZE && i + CHUNK_SIZE <= size && isAsciiChunk(p + i)) {
+            index -= CHUNK_SIZE;
+            i += CHUNK_SIZE;
+            continue;
+        }
+        decodeOne(text, i);
+        --index;
+    }
+    return i;
+}
+
+bool isValid(std::string_view text) {
+    size_t i = asciiPrefix(text);
+    while (i < text.size()) {
+        const size_t start = i;
+        if (decodeOne(text, i) == REPLACEMENT_CHARACTER) {
+            // U+FFFD itself is valid; anything else that decodes to it was malformed
+            if (i - start != 3 || text.compare(start, 3, "\xEF\xBF\xBD") != 0) {
+                return false;
+            }
+        }
+        i += asciiPrefix(text.substr(i));
+    }
+    return true;
+}
+
+void append(uint32_t codepoint, std::string& out) {
+    if (codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        codepoint = REPLACEMENT_CHARACTER;
+    }
+
+    if (codepoint < 0x80) {
+        out.push_back(static_cast<char>(codepoint));
+    } else if (codepoint < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else if (codepoint < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    }
+}
+
+std::string sanitize(std::string_view text) {
+    if (isValid(text)) {
+        return std::string(text);
+    }
+
+    std::string result;
+    result.reserve(text.size() + 8);
+    for (size_t i = 0; i < text.size();) {
+        const size_t start = i;
+        const uint32_t codepoint = decodeOne(text, i);
+        if (codepoint == REPLACEMENT_CHARACTER) {
+            append(codepoint, result);
+        } else {
+            result.append(text.data() + start, i - start);
+        }
+    }
+    return result;
+}
+
+} // namespace dakt::gui::utf8
@@ -272,11 +272,7 @@ float VariableFont::applyAvarMapping(uint32_t tag, float normalizedValue) const
 
 GlyphOutline VariableFont::getInterpolatedOutline(TTFParser& parser, uint16_t glyphID) const {
     // Get base outline
-    const GlyphOutline* baseOutline = parser.getGlyphOutline(glyphID);
-    if (!baseOutline)
-        return GlyphOutline{};
-
-    GlyphOutline result = *baseOutline;
+    GlyphOutline result = parser.getGlyphOutline(glyphID).toOutline();
 
     // If no variations, return base outline
     if (!isVariable())
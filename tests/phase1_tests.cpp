@@ -2,6 +2,7 @@
 #include "dakt/gui/subsystems/input/HitTest.hpp"
 #include "dakt/gui/subsystems/input/Input.hpp"
 #include "dakt/gui/subsystems/layout/Layout.hpp"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <vector>
@@ -173,6 +174,194 @@ void test_layout_dirty_tracking() {
     std::cout << "✓ Layout dirty tracking passed" << std::endl;
 }
 
+void test_layout_measure_cache() {
+    std::cout << "Testing layout measure cache..." << std::endl;
+
+    LayoutNode root;
+    root.setSize(300.0f, 100.0f);
+
+    int calls = 0;
+    LayoutNode* label = root.addChild();
+    label->setMeasureFunc([&calls](float width, MeasureMode, float, MeasureMode) {
+        ++calls;
+        return Vec2(std::min(width, 120.0f), 20.0f);
+    });
+
+    LayoutNode::resetStats();
+    FlexLayout_ComputeLayout(&root, 300.0f, 100.0f);
+    assert(label->getSize().x == 120.0f);
+    assert(calls == 2); // Base size, then cross size at the resolved width
+
+    // Same constraints: answered from the cache
+    FlexLayout_ComputeLayout(&root, 300.0f, 100.0f);
+    assert(calls == 2);
+
+    LayoutStats stats = LayoutNode::getStats();
+    assert(stats.nodesMeasured == 2);
+    assert(stats.measureCacheHits == 2);
+
+    // Content change invalidates
+    label->markDirty();
+    FlexLayout_ComputeLayout(&root, 300.0f, 100.0f);
+    assert(calls == 4);
+
+    std::cout << "✓ Layout measure cache passed" << std::endl;
+}
+
+void test_layout_measure_cache_phases() {
+    std::cout << "Testing layout measure cache phases..." << std::endl;
+
+    constexpr uint64_t LEAF_COUNT = 16;
+
+    LayoutNode root;
+    root.setSize(400.0f, 100.0f);
+
+    int calls = 0;
+    for (uint64_t i = 0; i < LEAF_COUNT; ++i) {
+        LayoutNode* leaf = root.addChild();
+        leaf->setMeasureFunc([&calls](float width, MeasureMode, float, MeasureMode) {
+            ++calls;
+            return Vec2(std::min(width, 20.0f), 20.0f);
+        });
+    }
+
+    // Cold pass: every measurement runs the callback
+    LayoutNode::resetStats();
+    FlexLayout_ComputeLayout(&root, 400.0f, 100.0f);
+    LayoutStats cold = LayoutNode::getStats();
+    assert(cold.nodesMeasured == LEAF_COUNT * 2);
+    assert(cold.measureCacheHits == 0);
+
+    // Identical pass: all cache hits, no callbacks
+    LayoutNode::resetStats();
+    const int callsBefore = calls;
+    FlexLayout_ComputeLayout(&root, 400.0f, 100.0f);
+    LayoutStats warm = LayoutNode::getStats();
+    assert(warm.nodesMeasured == 0);
+    assert(warm.measureCacheHits == cold.nodesMeasured);
+    assert(calls == callsBefore);
+
+    // Narrower available width changes the base-size query; the cross-size
+    // query at the unchanged final width still hits
+    root.setSize(360.0f, 100.0f);
+    LayoutNode::resetStats();
+    FlexLayout_ComputeLayout(&root, 360.0f, 100.0f);
+    LayoutStats resized = LayoutNode::getStats();
+    assert(resized.nodesMeasured == LEAF_COUNT);
+    assert(resized.measureCacheHits == LEAF_COUNT);
+
+    std::cout << "✓ Layout measure cache phases passed" << std::endl;
+}
+
+void test_layout_relayout_boundary() {
+    std::cout << "Testing layout relayout boundaries..." << std::endl;
+
+    LayoutNode root;
+    root.setFlexDirection(FlexDirection::Column);
+    root.setSize(400.0f, 4000.0f);
+
+    std::vector<LayoutNode*> rows;
+    LayoutNode* leaf = nullptr;
+    for (int i = 0; i < 100; ++i) {
+        LayoutNode* row = root.addChild();
+        row->setFlexBasis(40.0f); // Definite basis in a stretching column: boundary
+        rows.push_back(row);
+        for (int j = 0; j < 10; ++j) {
+            leaf = row->addChild();
+        }
+    }
+    assert(rows[50]->isRelayoutBoundary());
+
+    LayoutNode::resetStats();
+    root.computeLayout(400.0f, 4000.0f);
+    assert(LayoutNode::getStats().nodesVisited == 1 + 100 + 1000);
+    assert(!root.isDirty());
+
+    // A leaf change stops at its row instead of re-laying out the tree
+    LayoutNode::resetStats();
+    leaf->setFlexBasis(60.0f);
+    assert(!root.isDirty());
+    assert(rows.back()->isDirty());
+
+    root.computeLayout(400.0f, 4000.0f);
+    LayoutStats stats = LayoutNode::getStats();
+    assert(stats.relayoutRoots == 1);
+    assert(stats.nodesVisited == 2); // The row and the changed leaf
+    assert(leaf->getSize().x == 60.0f);
+    assert(!rows.back()->isDirty());
+
+    std::cout << "✓ Layout relayout boundaries passed" << std::endl;
+}
+
+void test_layout_arena_storage() {
+    std::cout << "Testing layout arena storage..." << std::endl;
+
+    LayoutNode root;
+    LayoutNode* a = root.addChild();
+    LayoutNode* b = root.addChild();
+    LayoutNode* c = root.addChild();
+    b->addChild();
+    b->addChild();
+    assert(root.getArena().getNodeCount() == 6);
+
+    // Sibling links stay consistent in both directions
+    root.removeChild(b);
+    assert(root.getArena().getNodeCount() == 3);
+    std::vector<LayoutNode*> forward(root.getChildren().begin(), root.getChildren().end());
+    assert(forward.size() == 2 && forward[0] == a && forward[1] == c);
+    assert(*root.getChildren().rbegin() == c);
+
+    // Freed slots are recycled rather than reallocated
+    LayoutNode* d = root.addChild();
+    assert(root.getArena().handles.size() == 6);
+    assert(d->getParent() == &root);
+    assert(d->getFlexProperties().grow == 0.0f);
+    assert(!d->hasMeasureFunc());
+
+    std::cout << "✓ Layout arena storage passed" << std::endl;
+}
+
+void test_layout_parallel_matches_sequential() {
+    std::cout << "Testing parallel layout determinism..." << std::endl;
+
+    auto buildTree = [](LayoutNode& root) {
+        root.setSize(800.0f, 600.0f);
+        root.setFlexDirection(FlexDirection::Column);
+        for (int panel = 0; panel < 4; ++panel) {
+            LayoutNode* section = root.addChild();
+            section->setFlexDirection(FlexDirection::Row);
+            for (int item = 0; item < 12; ++item) {
+                LayoutNode* leaf = section->addChild();
+                const float width = 10.0f + static_cast<float>(panel * 12 + item);
+                leaf->setMeasureFunc([width](float, MeasureMode, float, MeasureMode) { return Vec2(width, 20.0f); });
+                leaf->addChild();
+            }
+        }
+    };
+
+    LayoutNode sequential;
+    buildTree(sequential);
+    sequential.computeLayout(800.0f, 600.0f);
+
+    LayoutNode parallel;
+    buildTree(parallel);
+    assert((*parallel.getChildren().begin())->getSubtreeSize() == 25);
+    LayoutNode::setParallelLayout(true, 8);
+    parallel.computeLayout(800.0f, 600.0f);
+    LayoutNode::setParallelLayout(false);
+
+    const LayoutArena& a = sequential.getArena();
+    const LayoutArena& b = parallel.getArena();
+    assert(a.rects.size() == b.rects.size());
+    for (size_t i = 0; i < a.rects.size(); ++i) {
+        assert(a.rects[i].x == b.rects[i].x && a.rects[i].y == b.rects[i].y);
+        assert(a.rects[i].width == b.rects[i].width && a.rects[i].height == b.rects[i].height);
+        assert(!b.isDirty(static_cast<uint32_t>(i)));
+    }
+
+    std::cout << "✓ Parallel layout determinism passed" << std::endl;
+}
+
 // ============================================================================
 // Input System Tests
 // ============================================================================
@@ -339,6 +528,11 @@ int main() {
         test_layout_hierarchy();
         test_flex_properties();
         test_layout_dirty_tracking();
+        test_layout_measure_cache();
+        test_layout_measure_cache_phases();
+        test_layout_relayout_boundary();
+        test_layout_arena_storage();
+        test_layout_parallel_matches_sequential();
 
         // Input
         test_input_mouse_state();
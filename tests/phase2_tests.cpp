@@ -6,20 +6,30 @@
  */
 
 #include "dakt/gui/core/Types.hpp"
+#include "dakt/gui/subsystems/text/Bidi.hpp"
+#include "dakt/gui/subsystems/text/CoverageRasterizer.hpp"
 #include "dakt/gui/subsystems/text/Font.hpp"
 #include "dakt/gui/subsystems/text/GlyphAtlas.hpp"
+#include "dakt/gui/subsystems/text/GlyphAtlasCache.hpp"
 #include "dakt/gui/subsystems/text/GlyphCache.hpp"
+#include "dakt/gui/subsystems/text/LineBreak.hpp"
 #include "dakt/gui/subsystems/text/OTFParser.hpp"
+#include "dakt/gui/subsystems/text/OpenTypeLayout.hpp"
 #include "dakt/gui/subsystems/text/SDFGenerator.hpp"
+#include "dakt/gui/subsystems/text/Text.hpp"
 #include "dakt/gui/subsystems/text/TTFParser.hpp"
 #include "dakt/gui/subsystems/text/TextCursor.hpp"
 #include "dakt/gui/subsystems/text/TextShaper.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
 #include "dakt/gui/subsystems/text/VariableFont.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 
 using namespace dakt::gui;
 
@@ -208,10 +218,136 @@ TEST(SDFGenerator_shape_construction) {
     ASSERT(!shape.contours[0].edges.empty());
 }
 
+TEST(SDFGenerator_outline_view) {
+    SDFGenerator gen;
+
+    // Two squares in one arena slice: contour ends are exclusive point indices
+    const GlyphPoint points[] = {{0, 0, true}, {100, 0, true}, {100, 100, true}, {0, 100, true},
+                                 {25, 25, true}, {25, 75, true}, {75, 75, true}, {75, 25, true}};
+    const uint16_t contourEnds[] = {4, 8};
+
+    GlyphOutlineView view;
+    view.points = points;
+    view.contourEnds = contourEnds;
+    view.pointCount = 8;
+    view.contourCount = 2;
+    view.xMax = 100;
+    view.yMax = 100;
+    view.advanceWidth = 120;
+
+    GlyphOutline outline = view.toOutline();
+    ASSERT(outline.contours.size() == 2);
+    ASSERT(outline.contours[1].points.size() == 4);
+    ASSERT(outline.contours[1].points[0].x == 25);
+    ASSERT(outline.advanceWidth == 120);
+
+    Shape fromView = gen.outlineToShape(view, 0.1f);
+    Shape fromOutline = gen.outlineToShape(outline, 0.1f);
+    ASSERT(fromView.contours.size() == 2);
+    ASSERT(fromView.contours[1].edges.size() == fromOutline.contours[1].edges.size());
+    ASSERT(fromView.contours[0].winding != fromView.contours[1].winding);
+
+    SDFGlyphBitmap bitmap = gen.generate(view, 16.0f, 1000);
+    ASSERT(bitmap.width > 1);
+    ASSERT_NEAR(bitmap.advanceWidth, 1.92f, 0.001f);
+
+    // Blank glyphs (no contours) are still empty bitmaps
+    ASSERT(GlyphOutlineView{}.empty());
+    ASSERT(gen.generate(GlyphOutlineView{}, 16.0f, 1000).width == 1);
+}
+
+TEST(SDFGenerator_msdf_corners) {
+    SDFGenerator gen;
+    gen.setSpread(4.0f);
+    gen.setMode(SDFMode::MSDF);
+
+    // Clockwise (TrueType) square: four sharp corners
+    GlyphOutline outline;
+    outline.xMax = 1000;
+    outline.yMax = 1000;
+    outline.advanceWidth = 1000;
+    GlyphContour contour;
+    contour.points = {{0, 0, true}, {0, 1000, true}, {1000, 1000, true}, {1000, 0, true}};
+    outline.contours.push_back(contour);
+
+    // Each corner joins edges of different colors that share one channel
+    Shape shape = gen.outlineToShape(outline, 0.032f);
+    gen.colorEdges(shape);
+    const auto& edges = shape.contours[0].edges;
+    ASSERT(edges.size() == 4);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        const int a = edges[i].color, b = edges[(i + 1) % edges.size()].color;
+        ASSERT(a != b);
+        ASSERT((a & b) != 0);
+    }
+
+    // Positive inside, matching the text shaders (> 0.5 is filled)
+    ASSERT(gen.signedDistance(shape, Vec2(16.0f, 16.0f)) > 15.0f);
+    ASSERT(gen.signedDistance(shape, Vec2(-2.0f, 16.0f)) < 0.0f);
+
+    auto median = [](const uint8_t* t) { return std::max(std::min(t[0], t[1]), std::min(std::max(t[0], t[1]), t[2])); };
+    SDFGlyphBitmap bitmap = gen.generate(outline, 32.0f, 1000);
+    ASSERT(bitmap.channels == 3);
+    const uint8_t* center = &bitmap.pixels[((bitmap.height / 2) * bitmap.width + bitmap.width / 2) * 3];
+    const uint8_t* corner = &bitmap.pixels[0];
+    ASSERT(median(center) == 255);
+    ASSERT(median(corner) < 128);
+
+    // Counter-clockwise (CFF-style) contours give the same field
+    std::reverse(outline.contours[0].points.begin(), outline.contours[0].points.end());
+    SDFGlyphBitmap reversed = gen.generate(outline, 32.0f, 1000);
+    ASSERT(reversed.pixels.size() == bitmap.pixels.size());
+    int mismatches = 0;
+    for (size_t i = 0; i < bitmap.pixels.size(); i += 3) {
+        mismatches += (median(&bitmap.pixels[i]) > 127) != (median(&reversed.pixels[i]) > 127);
+    }
+    ASSERT(mismatches == 0);
+}
+
 // ============================================================================
 // GlyphAtlas Tests
 // ============================================================================
 
+TEST(CoverageRasterizer_square) {
+    CoverageRasterizer rasterizer;
+
+    // 4.5px square from (0.25, 0.25): whole texels inside, a quarter-covered rim
+    const GlyphPoint points[] = {{25, 25, true}, {25, 475, true}, {475, 475, true}, {475, 25, true}};
+    const uint16_t contourEnds[] = {4};
+
+    GlyphOutlineView view;
+    view.points = points;
+    view.contourEnds = contourEnds;
+    view.pointCount = 4;
+    view.contourCount = 1;
+    view.xMin = 25;
+    view.yMin = 25;
+    view.xMax = 475;
+    view.yMax = 475;
+    view.advanceWidth = 500;
+
+    SDFGlyphBitmap bitmap = rasterizer.rasterize(view, 10.0f, 1000);
+    ASSERT(bitmap.width == 5 && bitmap.height == 5 && bitmap.channels == 1 && bitmap.padding == 0);
+    ASSERT(bitmap.bearingX == 0.0f && bitmap.bearingY == 5.0f);
+    ASSERT_NEAR(bitmap.advanceWidth, 5.0f, 0.001f);
+    ASSERT(bitmap.pixels[2 * 5 + 2] == 255);
+    ASSERT(bitmap.pixels[2 * 5 + 0] >= 190 && bitmap.pixels[2 * 5 + 0] <= 192); // 3/4 covered
+    ASSERT(bitmap.pixels[0] >= 142 && bitmap.pixels[0] <= 144);                 // (3/4)^2 corner
+
+    // Winding direction does not matter, and the buffer is reset between glyphs
+    const GlyphPoint reversed[] = {{25, 25, true}, {475, 25, true}, {475, 475, true}, {25, 475, true}};
+    view.points = reversed;
+    ASSERT(rasterizer.rasterize(view, 10.0f, 1000).pixels == bitmap.pixels);
+
+    // A subpixel offset moves coverage within the same pixel grid
+    SDFGlyphBitmap shifted = rasterizer.rasterize(view, 10.0f, 1000, 0.5f);
+    ASSERT(shifted.width == 6 && shifted.bearingX == 0.0f);
+    ASSERT(shifted.pixels[2 * 6 + 0] >= 63 && shifted.pixels[2 * 6 + 0] <= 64 && shifted.pixels[2 * 6 + 5] >= 63 && shifted.pixels[2 * 6 + 5] <= 64);
+
+    SDFGlyphBitmap blank = rasterizer.rasterize(GlyphOutlineView{}, 10.0f, 1000);
+    ASSERT(blank.width == 1 && blank.pixels[0] == 0);
+}
+
 TEST(GlyphAtlas_construction) {
     GlyphAtlas atlas(512, 512);
 
@@ -239,6 +375,199 @@ TEST(GlyphAtlas_settings) {
     ASSERT(atlas.getPageCount() >= 1);
 }
 
+TEST(GlyphAtlas_size_buckets) {
+    Font font;
+    GlyphAtlas atlas(256, 256);
+    atlas.setSDFSpread(4);
+
+    // Mid sizes share the 32px reference; large ones double it; small ones stay exact
+    ASSERT(atlas.getRasterSize(13.0f) == 32.0f && atlas.getRasterSize(13.5f) == 32.0f && atlas.getRasterSize(64.0f) == 32.0f);
+    ASSERT(atlas.getRasterSize(65.0f) == 64.0f && atlas.getRasterSize(200.0f) == 128.0f);
+    ASSERT(atlas.getRasterSize(9.4f) == 9.0f && atlas.getRasterSize(11.6f) == 12.0f);
+
+    // One rasterization serves every size in the bucket, with metrics scaled to the request
+    ASSERT(atlas.addGlyph(font, 5, 20.0f));
+    ASSERT(atlas.hasGlyph(5, 24.0f) && atlas.hasGlyph(5, 13.5f) && !atlas.hasGlyph(5, 100.0f));
+    const AtlasGlyph at24 = atlas.getGlyph(5, 24.0f);
+    const AtlasGlyph at12 = atlas.getGlyph(5, 12.0f * 1.5f);
+    ASSERT(std::fabs(at24.advanceWidth - 12.0f) < 1e-4f); // 500 units of 1000 at 24px
+    ASSERT(std::fabs(at12.advanceWidth * 24.0f / 18.0f - at24.advanceWidth) < 1e-4f && at12.atlasX == at24.atlasX);
+
+    // A lower spread cannot keep anti-aliasing when minified as far
+    atlas.setSDFSpread(2);
+    ASSERT(atlas.getRasterSize(13.0f) == 13.0f && atlas.getRasterSize(16.0f) == 32.0f);
+}
+
+TEST(GlyphAtlas_coverage_pages) {
+    Font font;
+    GlyphAtlas atlas(128, 128);
+
+    // Small text skips the distance field and lands on its own single-channel page
+    ASSERT(atlas.getRenderMode(11.0f) == GlyphRenderMode::Coverage && atlas.getRenderMode(16.0f) == GlyphRenderMode::SDF);
+    ASSERT(atlas.addGlyph(font, 5, 11.0f));
+    ASSERT(atlas.addGlyph(font, 5, 16.0f));
+    ASSERT(atlas.getPageCount() == 2);
+    const AtlasGlyph small = atlas.getGlyph(5, 11.0f);
+    ASSERT(atlas.getPage(small.pageIndex).renderMode == GlyphRenderMode::Coverage && atlas.getPage(small.pageIndex).channels == 1);
+    ASSERT(atlas.getPage(atlas.getGlyph(5, 16.0f).pageIndex).renderMode == GlyphRenderMode::SDF);
+
+    // Disabling the threshold keeps everything on distance-field pages
+    SizeBucketPolicy policy;
+    policy.coverageBelow = 0.0f;
+    atlas.setSizeBuckets(policy);
+    ASSERT(atlas.getRenderMode(11.0f) == GlyphRenderMode::SDF);
+}
+
+TEST(GlyphAtlas_shared_fonts) {
+    Font regular;
+    Font copy; // Same content as regular: same font ID, same glyphs
+    GlyphAtlas atlas(128, 128);
+    ASSERT(atlas.getFontCount() == 0 && !atlas.hasGlyph(regular, 5, 16.0f));
+
+    ASSERT(atlas.addGlyph(regular, 5, 16.0f));
+    ASSERT(atlas.getFontCount() == 1 && atlas.hasGlyph(copy, 5, 16.0f) && atlas.hasGlyph(5, 16.0f));
+    ASSERT(atlas.getGlyph(copy, 5, 16.0f).atlasX == atlas.getGlyph(5, 16.0f).atlasX);
+    ASSERT(atlas.getGlyph(copy, 5, 16.0f).glyphID == 5 && atlas.getGlyph(copy, 6, 16.0f).width == 0.0f);
+
+    atlas.clear();
+    ASSERT(atlas.getFontCount() == 0 && !atlas.hasGlyph(copy, 5, 16.0f));
+}
+
+TEST(GlyphAtlas_codepoints_first_font) {
+    Font fallback;
+    Font loaded;
+    if (!loaded.loadFromFile("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
+        printf("  (skipped: no system font)\n");
+        return;
+    }
+
+    GlyphAtlas atlas(256, 256);
+    ASSERT(atlas.addCodepoint(fallback, 'A', 16.0f));
+    ASSERT(atlas.findGlyphId('A') == fallback.getGlyphId('A'));
+
+    // A second font shares the atlas for glyphs, but not the character map
+    ASSERT(!atlas.addCodepoint(loaded, 'A', 16.0f) && !atlas.addCodepoint(loaded, 'B', 16.0f));
+    ASSERT(atlas.findGlyphId('A') == fallback.getGlyphId('A') && atlas.findGlyphId('B') == 0);
+    ASSERT(atlas.addGlyph(loaded, loaded.getGlyphId('A'), 16.0f) && atlas.getFontCount() == 2);
+    ASSERT(atlas.hasGlyph(loaded, loaded.getGlyphId('A'), 16.0f));
+    ASSERT(atlas.addCodepoint(fallback, 'B', 16.0f) && atlas.findGlyphId('B') == fallback.getGlyphId('B'));
+
+    // The first font to be added owns the map, whichever it is
+    GlyphAtlas other(256, 256);
+    ASSERT(other.addCodepoint(loaded, 'A', 16.0f) && !other.addCodepoint(fallback, 'A', 16.0f));
+    ASSERT(other.findGlyphId('A') == loaded.getGlyphId('A'));
+}
+
+TEST(GlyphAtlas_baked_roundtrip) {
+    Font font;
+    GlyphAtlas atlas(128, 128);
+    atlas.setFontInfo(font);
+    ASSERT(atlas.addCodepoint(font, 'A', 16.0f));
+    ASSERT(atlas.addCodepoint(font, 'g', 100.0f));
+
+    std::vector<uint8_t> data;
+    ASSERT(atlas.saveToMemory(data));
+
+    GlyphAtlas baked;
+    ASSERT(baked.loadFromMemory(data.data(), data.size()));
+    const uint32_t glyphId = baked.findGlyphId('A');
+    ASSERT(glyphId == font.getGlyphId('A') && baked.findGlyphId('B') == 0);
+    ASSERT(baked.hasGlyph(glyphId, 16.0f) && !baked.hasGlyph(glyphId, 100.0f));
+    ASSERT(baked.getGlyph(glyphId, 16.0f).advanceWidth == atlas.getGlyph(glyphId, 16.0f).advanceWidth);
+    ASSERT(baked.getPageCount() == 1 && baked.getPage(0).pixelData == atlas.getPage(0).pixelData);
+    ASSERT(baked.getFontInfo().unitsPerEm == font.getUnitsPerEm());
+
+    // Truncated or corrupted data is rejected
+    ASSERT(!baked.loadFromMemory(data.data(), data.size() - 1));
+    data.back() ^= 0xFF;
+    ASSERT(!baked.loadFromMemory(data.data(), data.size()));
+}
+
+TEST(GlyphAtlasCache_roundtrip) {
+    const std::string dir = (std::filesystem::temp_directory_path() / "dakt_atlas_cache_test").string();
+    std::filesystem::remove_all(dir);
+
+    const AtlasCacheKey key{0x1234, 160, 2, 0};
+    const uint8_t pixels[6] = {1, 2, 3, 4, 5, 6};
+    {
+        GlyphAtlasCache cache(dir);
+        AtlasCacheRecord record;
+        record.width = 3;
+        record.height = 2;
+        record.advanceWidth = 9.0f;
+        record.glyphID = 7;
+        cache.store(key, record, pixels);
+        record.glyphID = 3;
+        cache.store(key, record, pixels);
+
+        // Glyphs rasterized by an atlas are written back too
+        Font font;
+        GlyphAtlas atlas;
+        atlas.setCache(&cache);
+        ASSERT(atlas.addGlyph(font, 5, 16.0f));
+        cache.flush();
+    }
+
+    GlyphAtlasCache cache(dir);
+    ASSERT(cache.findKeys(0x1234).size() == 1);
+    AtlasCacheRecord found;
+    const uint8_t* data = cache.find(key, 7, found);
+    ASSERT(data != nullptr && found.width == 3 && found.advanceWidth == 9.0f && data[5] == 6);
+    ASSERT(cache.find(key, 8, found) == nullptr);
+
+    Font font;
+    GlyphAtlas atlas;
+    atlas.setCache(&cache);
+    const size_t hits = cache.getHitCount();
+    ASSERT(atlas.addGlyph(font, 5, 16.0f) && cache.getHitCount() == hits + 1);
+
+    // A flipped byte fails the checksum and the file is ignored
+    const std::string path = cache.getFilePath(key);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put(0x7F);
+    }
+    GlyphAtlasCache corrupted(dir);
+    ASSERT(corrupted.find(key, 7, found) == nullptr && corrupted.getRejectedCount() == 1);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST(GlyphAtlasCache_failed_write_retried) {
+    const std::string dir = (std::filesystem::temp_directory_path() / "dakt_atlas_cache_retry_test").string();
+    std::filesystem::remove_all(dir);
+
+    const AtlasCacheKey key{0x5678, 160, 2, 0};
+    const uint8_t pixels[4] = {1, 2, 3, 4};
+    AtlasCacheRecord record;
+    record.width = 2;
+    record.height = 2;
+    record.glyphID = 9;
+    {
+        GlyphAtlasCache cache(dir);
+        const std::string path = cache.getFilePath(key);
+
+        // A directory in the file's place makes the replace fail
+        std::filesystem::create_directories(std::filesystem::path(path) / "blocker");
+        cache.store(key, record, pixels);
+        cache.flush();
+        ASSERT(std::filesystem::is_directory(path) && !std::filesystem::exists(path + ".tmp"));
+
+        // The glyph is kept and written by the next flush
+        std::filesystem::remove_all(path);
+        cache.flush();
+        ASSERT(std::filesystem::is_regular_file(path));
+    }
+
+    GlyphAtlasCache cache(dir);
+    AtlasCacheRecord found;
+    const uint8_t* data = cache.find(key, 9, found);
+    ASSERT(data != nullptr && found.width == 2 && data[3] == 4);
+
+    std::filesystem::remove_all(dir);
+}
+
 // ============================================================================
 // GlyphCache Tests
 // ============================================================================
@@ -279,6 +608,45 @@ TEST(GlyphCache_frame_update) {
     cache.newFrame();
 }
 
+TEST(GlyphCache_subpixel_positions) {
+    Font font; // Fallback glyphs advance 500 units: 5.5px at 11px
+    GlyphAtlas atlas(128, 128);
+    GlyphCache cache;
+
+    // Coverage glyphs land on whole pixels, the fraction going to a phase variant
+    const CachedTextRun* run = cache.get(font, 11.0f, "AAA", atlas);
+    ASSERT(run && run->glyphs.size() == 3);
+    ASSERT(run->glyphs[1].x == 5.0f && run->glyphs[2].x == 11.0f);
+    ASSERT_NEAR(run->totalWidth, 16.5f, 0.001f);
+    const uint32_t glyphID = font.getGlyphId('A');
+    ASSERT(atlas.hasGlyph(glyphID, 11.0f, 2) && !atlas.hasGlyph(glyphID, 11.0f, 1));
+    ASSERT(atlas.getSubpixelVariantCount() == 1 && atlas.getGlyph(glyphID, 11.0f, 2).glyphID == glyphID);
+
+    // Distance fields have no variants; past the cap, glyphs snap to the nearest pixel
+    ASSERT(atlas.addGlyph(font, glyphID, 16.0f, 1) && atlas.getSubpixelVariantCount() == 1);
+    SubpixelPolicy policy;
+    policy.maxVariants = 1;
+    atlas.setSubpixelPolicy(policy);
+    ASSERT(!atlas.addGlyph(font, glyphID, 11.0f, 1));
+    run = cache.get(font, 11.0f, "BBB", atlas);
+    ASSERT(run->glyphs[1].x == 6.0f && run->glyphs[2].x == 11.0f);
+}
+
+TEST(GlyphCache_malformed_utf8) {
+    Font font;
+    GlyphAtlas atlas(128, 128);
+    GlyphCache cache;
+
+    // A lead byte without its continuation decodes to U+FFFD; the next character survives
+    const CachedTextRun* run = cache.get(font, 16.0f, "A\xC3(B", atlas);
+    ASSERT(run && run->glyphs.size() == 4);
+    ASSERT(run->glyphs[2].glyphID == font.getGlyphId('(') && run->glyphs[3].glyphID == font.getGlyphId('B'));
+
+    // Truncated at the end of the text: one U+FFFD, nothing read past the end
+    run = cache.get(font, 16.0f, "A\xE2\x82", atlas);
+    ASSERT(run && run->glyphs.size() == 2);
+}
+
 // ============================================================================
 // TextShaper Tests
 // ============================================================================
@@ -288,6 +656,589 @@ TEST(TextShaper_construction) {
     // Should construct without error
 }
 
+TEST(TextShaper_word_cache) {
+    Font font;
+    TextShaper shaper;
+    ShapedWordCache cache;
+
+    // Word-by-word shaping matches shaping the whole paragraph, kerning included
+    const std::string text = "AVA To  AVA";
+    ShapedRun whole = shaper.shape(font, text);
+    ShapedRun cached;
+    cache.shapeText(shaper, font, text, cached);
+
+    ASSERT(cached.glyphs.size() == whole.glyphs.size());
+    for (size_t i = 0; i < whole.glyphs.size(); ++i) {
+        ASSERT(cached.glyphs[i].glyphID == whole.glyphs[i].glyphID);
+        ASSERT(cached.glyphs[i].cluster == whole.glyphs[i].cluster);
+        ASSERT_NEAR(cached.glyphs[i].xAdvance, whole.glyphs[i].xAdvance, 0.001f);
+    }
+    ASSERT(whole.glyphs[0].xAdvance < 500.0f); // 'A' 'V' kerned
+
+    // "AVA", " ", "To", "  ", "AVA": the repeated word is a hit
+    ASSERT(cache.getMissCount() == 4);
+    ASSERT(cache.getHitCount() == 1);
+
+    float total = 0.0f;
+    for (const auto& glyph : whole.glyphs) {
+        total += glyph.xAdvance;
+    }
+    ASSERT_NEAR(cache.measureText(shaper, font, text), total, 0.001f);
+
+    cache.invalidateFont(&font);
+    ASSERT(cache.getEntryCount() == 0);
+}
+
+TEST(TextShaper_shape_into) {
+    Font font;
+    TextShaper shaper;
+    ShapedGlyphBuffer buffer;
+
+    // Clusters are byte offsets: the two-byte 'é' shifts everything after it
+    shaper.shapeInto(font, "a\xC3\xA9 b", buffer);
+    ASSERT(buffer.glyphs.size() == 4);
+    ASSERT(buffer.glyphs[0].cluster == 0);
+    ASSERT(buffer.glyphs[1].cluster == 1);
+    ASSERT(buffer.glyphs[2].cluster == 3);
+    ASSERT(buffer.glyphs[3].cluster == 4);
+    ASSERT(buffer.scriptTag == 0x4C41544E); // 'LATN'
+
+    // shape() reports the same glyphs with codepoint clusters
+    ShapedRun run = shaper.shape(font, "a\xC3\xA9 b");
+    ASSERT(run.glyphs.size() == 4);
+    ASSERT(run.glyphs[2].cluster == 2);
+    ASSERT(run.glyphs[3].cluster == 3);
+
+    // Reshaping shorter text reuses the buffer's storage
+    const size_t capacity = buffer.glyphs.capacity();
+    const ShapedGlyph* storage = buffer.glyphs.data();
+    shaper.shapeInto(font, "AV", buffer);
+    ASSERT(buffer.glyphs.size() == 2);
+    ASSERT(buffer.glyphs.capacity() == capacity);
+    ASSERT(buffer.glyphs.data() == storage);
+    ASSERT(buffer.glyphs[0].xAdvance < 500.0f); // Kerned like shape()
+}
+
+TEST(UTF8_decode) {
+    // Long ASCII runs take the chunked path; the tail mixes 2-, 3- and 4-byte sequences
+    const std::string text = std::string(40, 'x') + "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80!";
+    std::vector<uint32_t> codepoints;
+    utf8::decode(text, codepoints);
+    ASSERT(codepoints.size() == 44);
+    ASSERT(codepoints[39] == 'x');
+    ASSERT(codepoints[40] == 0xE9);
+    ASSERT(codepoints[41] == 0x20AC);
+    ASSERT(codepoints[42] == 0x1F600);
+    ASSERT(codepoints[43] == '!');
+    ASSERT(utf8::length(text) == 44);
+    ASSERT(utf8::offsetOf(text, 41) == 42);
+    ASSERT(utf8::offsetOf(text, 100) == text.size());
+    ASSERT(utf8::asciiPrefix(text) == 40);
+    ASSERT(utf8::isValid(text));
+
+    // Overlong, truncated and surrogate sequences decode to U+FFFD per maximal subpart
+    utf8::decode("\xC0\xAF" "a" "\xE2\x82" "b" "\xED\xA0\x80", codepoints);
+    ASSERT(codepoints.size() == 8);
+    ASSERT(codepoints[0] == utf8::REPLACEMENT_CHARACTER);
+    ASSERT(codepoints[1] == utf8::REPLACEMENT_CHARACTER);
+    ASSERT(codepoints[2] == 'a');
+    ASSERT(codepoints[3] == utf8::REPLACEMENT_CHARACTER);
+    ASSERT(codepoints[4] == 'b');
+    ASSERT(codepoints[7] == utf8::REPLACEMENT_CHARACTER);
+    ASSERT(!utf8::isValid("\xE2\x82"));
+    ASSERT(utf8::isValid("\xEF\xBF\xBD"));
+    ASSERT(utf8::sanitize("a\xFF" "b") == "a\xEF\xBF\xBD" "b");
+
+    // Cursor selections are codepoint ranges over the UTF-8 text
+    Font font;
+    TextShaper shaper;
+    TextCursor cursor;
+    const std::string word = "a\xC3\xA9" "b";
+    cursor.init(shaper.shape(font, word), word, 16.0f, 12.0f);
+    cursor.setSelection(1, 2);
+    ASSERT(cursor.getSelectedText() == "\xC3\xA9");
+}
+
+// Big-endian table writer with back-patched 16-bit offsets
+struct TableBuilder {
+    std::vector<uint8_t> bytes;
+
+    size_t here() const { return bytes.size(); }
+    void u16(uint32_t value) {
+        bytes.push_back(static_cast<uint8_t>(value >> 8));
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+    void u32(uint32_t value) {
+        u16(value >> 16);
+        u16(value & 0xFFFF);
+    }
+    size_t slot() {
+        u16(0);
+        return here() - 2;
+    }
+    void patch(size_t at, size_t base) {
+        const size_t offset = here() - base;
+        bytes[at] = static_cast<uint8_t>(offset >> 8);
+        bytes[at + 1] = static_cast<uint8_t>(offset);
+    }
+    void coverage(std::initializer_list<uint16_t> glyphs) {
+        u16(1);
+        u16(static_cast<uint32_t>(glyphs.size()));
+        for (uint16_t glyph : glyphs) {
+            u16(glyph);
+        }
+    }
+};
+
+static std::vector<ShapedGlyph> makeGlyphs(std::initializer_list<uint32_t> ids) {
+    std::vector<ShapedGlyph> glyphs;
+    uint32_t cluster = 0;
+    for (uint32_t id : ids) {
+        glyphs.push_back({id, cluster++, 0, 0, 0, 0});
+    }
+    return glyphs;
+}
+
+TEST(GlyphSubstitution_lookups) {
+    // DFLT script (used for 'latn') with 'liga' (lookup 0: 10+11 -> 50, 10+11+12 -> 51) and 'calt'
+    // (lookup 1: 10 after 20 goes through single lookup 2, +5). Lookup 2 has no feature.
+    TableBuilder t;
+    t.u32(0x00010000);
+    const size_t scriptList = t.slot(), featureList = t.slot(), lookupList = t.slot();
+
+    t.patch(scriptList, 0);
+    const size_t scriptListBase = t.here();
+    t.u16(1);
+    t.u32(0x44464C54); // 'DFLT'
+    const size_t script = t.slot();
+    t.patch(script, scriptListBase);
+    const size_t scriptBase = t.here();
+    const size_t langSys = t.slot();
+    t.u16(0);
+    t.patch(langSys, scriptBase);
+    t.u16(0);
+    t.u16(0xFFFF);
+    t.u16(2);
+    t.u16(0);
+    t.u16(1);
+
+    t.patch(featureList, 0);
+    const size_t featureListBase = t.here();
+    t.u16(2);
+    t.u32(0x6C696761); // 'liga'
+    const size_t liga = t.slot();
+    t.u32(0x63616C74); // 'calt'
+    const size_t calt = t.slot();
+    t.patch(liga, featureListBase);
+    t.u16(0);
+    t.u16(1);
+    t.u16(0);
+    t.patch(calt, featureListBase);
+    t.u16(0);
+    t.u16(1);
+    t.u16(1);
+
+    t.patch(lookupList, 0);
+    const size_t lookupListBase = t.here();
+    t.u16(3);
+    const size_t lookups[3] = {t.slot(), t.slot(), t.slot()};
+
+    // Lookup 0: ligatures
+    t.patch(lookups[0], lookupListBase);
+    size_t base = t.here();
+    t.u16(4);
+    t.u16(0);
+    t.u16(1);
+    size_t sub = t.slot();
+    t.patch(sub, base);
+    base = t.here();
+    t.u16(1);
+    size_t cov = t.slot();
+    t.u16(1);
+    const size_t ligSet = t.slot();
+    t.patch(cov, base);
+    t.coverage({10});
+    t.patch(ligSet, base);
+    const size_t setBase = t.here();
+    t.u16(2);
+    const size_t lig0 = t.slot(), lig1 = t.slot();
+    t.patch(lig0, setBase);
+    t.u16(50);
+    t.u16(2);
+    t.u16(11);
+    t.patch(lig1, setBase);
+    t.u16(51);
+    t.u16(3);
+    t.u16(11);
+    t.u16(12);
+
+    // Lookup 1: chaining context, format 3
+    t.patch(lookups[1], lookupListBase);
+    base = t.here();
+    t.u16(6);
+    t.u16(0);
+    t.u16(1);
+    sub = t.slot();
+    t.patch(sub, base);
+    base = t.here();
+    t.u16(3);
+    t.u16(1);
+    const size_t backtrack = t.slot();
+    t.u16(1);
+    const size_t input = t.slot();
+    t.u16(0);
+    t.u16(1);
+    t.u16(0);
+    t.u16(2);
+    t.patch(backtrack, base);
+    t.coverage({20});
+    t.patch(input, base);
+    t.coverage({10});
+
+    // Lookup 2: single, format 1
+    t.patch(lookups[2], lookupListBase);
+    base = t.here();
+    t.u16(1);
+    t.u16(0);
+    t.u16(1);
+    sub = t.slot();
+    t.patch(sub, base);
+    base = t.here();
+    t.u16(1);
+    cov = t.slot();
+    t.u16(5);
+    t.patch(cov, base);
+    t.coverage({10});
+
+    GlyphSubstitution gsub;
+    ASSERT(gsub.load(t.bytes.data(), t.bytes.size(), 0x6C61746E, {0x6C696761, 0x63616C74}));
+
+    // Longest ligature wins and keeps the first component's cluster
+    auto glyphs = makeGlyphs({9, 10, 11, 12});
+    ASSERT(gsub.apply(glyphs));
+    ASSERT(glyphs.size() == 2);
+    ASSERT(glyphs[1].glyphID == 51);
+    ASSERT(glyphs[1].cluster == 1);
+
+    glyphs = makeGlyphs({10, 11, 13});
+    ASSERT(gsub.apply(glyphs));
+    ASSERT(glyphs.size() == 2);
+    ASSERT(glyphs[0].glyphID == 50);
+
+    // Chaining context calls the feature-less lookup only after glyph 20
+    glyphs = makeGlyphs({20, 10, 13});
+    ASSERT(gsub.apply(glyphs));
+    ASSERT(glyphs[1].glyphID == 15);
+
+    glyphs = makeGlyphs({21, 10, 13});
+    ASSERT(!gsub.apply(glyphs));
+    ASSERT(glyphs[1].glyphID == 10);
+
+    // Disabled features compile nothing
+    GlyphSubstitution none;
+    ASSERT(!none.load(t.bytes.data(), t.bytes.size(), 0x6C61746E, {0x6B65726E}));
+    ASSERT(none.empty());
+}
+
+TEST(GlyphPositioning_pairs) {
+    // DFLT script with 'kern' -> lookup 0: explicit pair 5+6, then classes {5, 7} x {8}
+    TableBuilder t;
+    t.u32(0x00010000);
+    const size_t scriptList = t.slot(), featureList = t.slot(), lookupList = t.slot();
+
+    t.patch(scriptList, 0);
+    const size_t scriptListBase = t.here();
+    t.u16(1);
+    t.u32(0x44464C54); // 'DFLT'
+    const size_t script = t.slot();
+    t.patch(script, scriptListBase);
+    const size_t scriptBase = t.here();
+    const size_t langSys = t.slot();
+    t.u16(0);
+    t.patch(langSys, scriptBase);
+    t.u16(0);
+    t.u16(0xFFFF);
+    t.u16(1);
+    t.u16(0);
+
+    t.patch(featureList, 0);
+    const size_t featureListBase = t.here();
+    t.u16(1);
+    t.u32(0x6B65726E); // 'kern'
+    const size_t kern = t.slot();
+    t.patch(kern, featureListBase);
+    t.u16(0);
+    t.u16(1);
+    t.u16(0);
+
+    t.patch(lookupList, 0);
+    const size_t lookupListBase = t.here();
+    t.u16(1);
+    const size_t lookup = t.slot();
+    t.patch(lookup, lookupListBase);
+    const size_t lookupBase = t.here();
+    t.u16(2);
+    t.u16(0);
+    t.u16(2);
+    const size_t subtables[2] = {t.slot(), t.slot()};
+
+    // Format 1: 5 + 6 -> -40
+    t.patch(subtables[0], lookupBase);
+    size_t base = t.here();
+    t.u16(1);
+    size_t cov = t.slot();
+    t.u16(0x0004);
+    t.u16(0);
+    t.u16(1);
+    const size_t pairSet = t.slot();
+    t.patch(cov, base);
+    t.coverage({5});
+    t.patch(pairSet, base);
+    t.u16(1);
+    t.u16(6);
+    t.u16(static_cast<uint16_t>(-40));
+
+    // Format 2: first class 1 = {5, 7}, second class 1 = {8}; 1 x 1 -> -30
+    t.patch(subtables[1], lookupBase);
+    base = t.here();
+    t.u16(2);
+    cov = t.slot();
+    t.u16(0x0004);
+    t.u16(0);
+    const size_t classDef1 = t.slot(), classDef2 = t.slot();
+    t.u16(2);
+    t.u16(2);
+    t.u16(0);
+    t.u16(0);
+    t.u16(0);
+    t.u16(static_cast<uint16_t>(-30));
+    t.patch(cov, base);
+    t.coverage({5, 7});
+    t.patch(classDef1, base);
+    t.u16(1);
+    t.u16(5);
+    t.u16(3);
+    t.u16(1);
+    t.u16(0);
+    t.u16(1);
+    t.patch(classDef2, base);
+    t.u16(1);
+    t.u16(8);
+    t.u16(1);
+    t.u16(1);
+
+    GlyphPositioning gpos;
+    ASSERT(gpos.load(t.bytes.data(), t.bytes.size(), 0x6C61746E, {0x6B65726E}));
+    ASSERT(gpos.getKerning(5, 6) == -40); // Explicit pair
+    ASSERT(gpos.getKerning(5, 8) == -30); // Falls through to the class subtable
+    ASSERT(gpos.getKerning(7, 8) == -30);
+    ASSERT(gpos.getKerning(7, 9) == 0);
+    ASSERT(gpos.getKerning(6, 8) == 0); // First glyph not covered
+
+    auto glyphs = makeGlyphs({5, 6, 7, 8});
+    for (auto& glyph : glyphs) {
+        glyph.xAdvance = 500.0f;
+    }
+    gpos.apply(glyphs);
+    ASSERT_NEAR(glyphs[0].xAdvance, 460.0f, 0.001f);
+    ASSERT_NEAR(glyphs[1].xAdvance, 500.0f, 0.001f);
+    ASSERT_NEAR(glyphs[2].xAdvance, 470.0f, 0.001f);
+    ASSERT_NEAR(glyphs[3].xAdvance, 500.0f, 0.001f);
+
+    // Legacy kern table, format 0
+    TableBuilder k;
+    k.u16(0);
+    k.u16(1);
+    k.u16(0);
+    k.u16(14 + 2 * 6);
+    k.u16(0x0001);
+    k.u16(2);
+    k.u16(12);
+    k.u16(1);
+    k.u16(0);
+    k.u16(1);
+    k.u16(2);
+    k.u16(static_cast<uint16_t>(-50));
+    k.u16(3);
+    k.u16(4);
+    k.u16(20);
+
+    GlyphPositioning legacy;
+    ASSERT(legacy.loadKern(k.bytes.data(), k.bytes.size()));
+    ASSERT(legacy.getKerning(1, 2) == -50);
+    ASSERT(legacy.getKerning(3, 4) == 20);
+    ASSERT(legacy.getKerning(2, 1) == 0);
+}
+
+TEST(Bidi_levels) {
+    ASSERT(getBidiClass('A') == BidiClass::L);
+    ASSERT(getBidiClass('1') == BidiClass::EN);
+    ASSERT(getBidiClass(' ') == BidiClass::WS);
+    ASSERT(getBidiClass('\n') == BidiClass::B);
+    ASSERT(getBidiClass(0x05D0) == BidiClass::R);
+    ASSERT(getBidiClass(0x0627) == BidiClass::AL);
+    ASSERT(getBidiClass(0x0660) == BidiClass::AN);
+    ASSERT(getBidiClass(0x2067) == BidiClass::RLI);
+
+    BidiParagraph bidi;
+
+    // LTR paragraph with a Hebrew word: three runs, visual order unchanged
+    const uint32_t mixed[] = {'a', 'b', ' ', 0x05D0, 0x05D1, ' ', 'c'};
+    bidi.analyze(mixed, 7);
+    ASSERT(bidi.getBaseLevel() == 0);
+    ASSERT(bidi.hasRTL());
+    std::vector<BidiParagraph::Run> runs;
+    bidi.getLineRuns(0, bidi.size(), runs);
+    ASSERT(runs.size() == 3);
+    ASSERT(runs[1].start == 3 && runs[1].end == 5 && runs[1].isRTL());
+
+    // RTL paragraph: numbers sit at level 2 and come first visually
+    const uint32_t numbers[] = {0x05D0, 0x05D1, ' ', '1', '2'};
+    bidi.analyze(numbers, 5);
+    ASSERT(bidi.getBaseLevel() == 1);
+    ASSERT(bidi.getLevels()[2] == 1);
+    ASSERT(bidi.getLevels()[3] == 2);
+    bidi.getLineRuns(0, bidi.size(), runs);
+    ASSERT(runs.size() == 2);
+    ASSERT(runs[0].start == 3 && runs[0].level == 2);
+    ASSERT(runs[1].start == 0 && runs[1].level == 1);
+
+    // N0: brackets around LTR text preceded by LTR text resolve to L inside RTL
+    const uint32_t brackets[] = {0x05D0, ' ', 'a', '(', 'b', ')', ' ', 0x05D1};
+    bidi.analyze(brackets, 8);
+    ASSERT(bidi.getLevels()[3] == 2);
+    ASSERT(bidi.getLevels()[5] == 2);
+    ASSERT(bidi.getLevels()[6] == 1);
+
+    // Isolates are skipped when choosing the base level; RLO overrides letters
+    const uint32_t isolate[] = {0x2067, 0x05D0, 0x2069, ' ', 'a', ' ', 0x202E, 'b', 'c', 0x202C};
+    bidi.analyze(isolate, 10);
+    ASSERT(bidi.getBaseLevel() == 0);
+    ASSERT(bidi.getLevels()[1] == 1);
+    ASSERT(bidi.getLevels()[7] == 1);
+
+    // L1: trailing whitespace returns to the paragraph level
+    const uint32_t trailing[] = {0x202B, 0x05D0, ' ', ' '};
+    bidi.analyze(trailing, 4, 0);
+    ASSERT(bidi.getLevels()[3] == 1);
+    bidi.getLineRuns(0, bidi.size(), runs);
+    ASSERT(runs.back().start == 2 && runs.back().level == 0);
+
+    // Analyses are cached per paragraph; shapeBidi returns runs in visual order
+    Font font;
+    TextShaper shaper;
+    const std::string text = "\xD7\x90\xD7\x91 ab";
+    const BidiParagraph& first = shaper.getBidiParagraph(text);
+    ASSERT(&shaper.getBidiParagraph(text) == &first);
+    ASSERT(first.size() == 5);
+    ASSERT(first.getByteOffset(3) == 5);
+
+    // RTL paragraph: "ab" (level 2) is visually left of the Hebrew word and space
+    auto shaped = shaper.shapeBidi(font, text);
+    ASSERT(shaped.size() == 2);
+    ASSERT(!shaped[0].isRTL);
+    ASSERT(shaped[0].glyphs.size() == 2);
+    ASSERT(shaped[1].isRTL);
+    ASSERT(shaped[1].glyphs.front().cluster == 2); // Reversed: the space comes first
+}
+
+TEST(LineBreak_reflow) {
+    ASSERT(getLineBreakClass(' ') == LineBreakClass::SP);
+    ASSERT(getLineBreakClass('a') == LineBreakClass::AL);
+    ASSERT(getLineBreakClass('-') == LineBreakClass::HY);
+    ASSERT(getLineBreakClass('(') == LineBreakClass::OP);
+    ASSERT(getLineBreakClass('\n') == LineBreakClass::LF);
+    ASSERT(getLineBreakClass(0x4E00) == LineBreakClass::Ideographic);
+    ASSERT(getLineBreakClass(0x0301) == LineBreakClass::CM);
+
+    // "ab cd-ef (g)!\nh": after spaces and hyphens, never before closing punctuation
+    std::vector<uint32_t> codepoints;
+    utf8::decode("ab cd-ef (g)!\nh", codepoints);
+    std::vector<BreakAction> breaks;
+    findLineBreaks(codepoints.data(), codepoints.size(), breaks);
+    ASSERT(breaks.size() == codepoints.size() + 1);
+    ASSERT(breaks[1] == BreakAction::None);
+    ASSERT(breaks[2] == BreakAction::None);      // Before the space
+    ASSERT(breaks[3] == BreakAction::Allowed);   // After the space
+    ASSERT(breaks[6] == BreakAction::Allowed);   // After the hyphen
+    ASSERT(breaks[10] == BreakAction::None);     // After "("
+    ASSERT(breaks[11] == BreakAction::None);     // Before ")"
+    ASSERT(breaks[12] == BreakAction::None);     // Before "!"
+    ASSERT(breaks[14] == BreakAction::Mandatory); // After the newline
+    ASSERT(breaks.back() == BreakAction::Mandatory);
+
+    // Ideographs break between each other; combining marks stay on their base
+    const uint32_t ideographs[] = {0x4E00, 0x4E8C, 'e', 0x0301};
+    findLineBreaks(ideographs, 4, breaks);
+    ASSERT(breaks[1] == BreakAction::Allowed);
+    ASSERT(breaks[3] == BreakAction::None);
+
+    // Reflow only re-splits: "aa bb cc" with unit advances
+    TextLayout layout;
+    for (uint32_t i = 0; i < 8; ++i) {
+        layout.glyphs.push_back(ShapedGlyph{i, i, 1.0f, 0.0f, 0.0f, 0.0f});
+        layout.advanceSums.push_back(static_cast<float>(i));
+    }
+    layout.advanceSums.push_back(8.0f);
+    layout.breaks = {{3, 2, 3, false}, {6, 5, 6, false}, {8, 8, 8, true}};
+    layout.lineHeight = 10.0f;
+
+    layout.reflow(0.0f);
+    ASSERT(layout.lineCount == 1);
+    ASSERT_NEAR(layout.totalWidth, 8.0f, 0.001f);
+
+    layout.reflow(5.0f);
+    ASSERT(layout.lineCount == 2);
+    ASSERT(layout.lines[0].glyphs.size() == 6); // Trailing space stays on the line...
+    ASSERT_NEAR(layout.lines[0].width, 5.0f, 0.001f); // ...without taking width
+    ASSERT(layout.lines[1].startCluster == 6 && layout.lines[1].endCluster == 8);
+    ASSERT_NEAR(layout.totalHeight, 20.0f, 0.001f);
+
+    layout.reflow(2.0f);
+    ASSERT(layout.lineCount == 3);
+
+    // Words wider than a line are split between glyphs
+    layout.reflow(1.0f);
+    ASSERT(layout.lineCount == 6);
+    ASSERT(layout.lines[1].glyphs.size() == 2 && layout.lines[1].glyphs[0].glyphID == 1);
+
+    // Fewer lines keep the spare line storage for the next reflow
+    layout.reflow(0.0f);
+    ASSERT(layout.lineCount == 1 && layout.lines.size() == 6);
+    ASSERT(layout.lines[0].glyphs.size() == 8);
+    ASSERT_NEAR(layout.totalHeight, 10.0f, 0.001f);
+}
+
+TEST(TextRenderer_reflow_bidi) {
+    TextRenderer renderer;
+    if (!renderer.loadFont("sans", "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf")) {
+        printf("  (skipped: no system font)\n");
+        return;
+    }
+
+    // "ab <alef bet gimel> cd": the Hebrew word reads right to left within the line
+    const std::string text = "ab \xD7\x90\xD7\x91\xD7\x92 cd";
+    TextRenderParams params;
+    params.fontSize = 16.0f;
+    const TextLayout& wide = renderer.reflowText("sans", text, params);
+    ASSERT(wide.hasRTL && wide.lineCount == 1 && wide.lines[0].glyphs.size() == 9);
+    const std::vector<uint32_t> visual = {0, 1, 2, 7, 5, 3, 9, 10, 11};
+    for (size_t i = 0; i < visual.size(); ++i) {
+        ASSERT(wide.lines[0].glyphs[i].cluster == visual[i]);
+    }
+
+    // Wrapping reorders each line from the cached analysis
+    params.maxWidth = 35; // One word per line
+    const TextLayout& narrow = renderer.reflowText("sans", text, params);
+    ASSERT(narrow.lineCount == 3);
+    ASSERT(narrow.lines[1].glyphs[0].cluster == 7 && narrow.lines[1].glyphs[2].cluster == 3);
+
+    // Copies hold only the valid lines, even after a longer reflow
+    params.maxWidth = 0;
+    const TextLayout copy = renderer.layoutText("sans", text, params);
+    ASSERT(copy.lineCount == 1 && copy.lines.size() == 1);
+}
+
 // ============================================================================
 // TextCursor Tests
 // ============================================================================
@@ -471,20 +1422,40 @@ int main() {
     TestRunner_SDFGenerator_basic runner_SDFGenerator_basic;
     TestRunner_SDFGenerator_empty_glyph runner_SDFGenerator_empty_glyph;
     TestRunner_SDFGenerator_shape_construction runner_SDFGenerator_shape_construction;
+    TestRunner_SDFGenerator_outline_view runner_SDFGenerator_outline_view;
+    TestRunner_SDFGenerator_msdf_corners runner_SDFGenerator_msdf_corners;
+    TestRunner_CoverageRasterizer_square runner_CoverageRasterizer_square;
 
     // GlyphAtlas tests
     TestRunner_GlyphAtlas_construction runner_GlyphAtlas_construction;
     TestRunner_GlyphAtlas_clear runner_GlyphAtlas_clear;
     TestRunner_GlyphAtlas_settings runner_GlyphAtlas_settings;
+    TestRunner_GlyphAtlas_size_buckets runner_GlyphAtlas_size_buckets;
+    TestRunner_GlyphAtlas_coverage_pages runner_GlyphAtlas_coverage_pages;
+    TestRunner_GlyphAtlas_shared_fonts runner_GlyphAtlas_shared_fonts;
+    TestRunner_GlyphAtlas_codepoints_first_font runner_GlyphAtlas_codepoints_first_font;
+    TestRunner_GlyphAtlas_baked_roundtrip runner_GlyphAtlas_baked_roundtrip;
+    TestRunner_GlyphAtlasCache_roundtrip runner_GlyphAtlasCache_roundtrip;
+    TestRunner_GlyphAtlasCache_failed_write_retried runner_GlyphAtlasCache_failed_write_retried;
 
     // GlyphCache tests
     TestRunner_GlyphCache_construction runner_GlyphCache_construction;
     TestRunner_GlyphCache_settings runner_GlyphCache_settings;
     TestRunner_GlyphCache_clear runner_GlyphCache_clear;
     TestRunner_GlyphCache_frame_update runner_GlyphCache_frame_update;
+    TestRunner_GlyphCache_subpixel_positions runner_GlyphCache_subpixel_positions;
+    TestRunner_GlyphCache_malformed_utf8 runner_GlyphCache_malformed_utf8;
 
     // TextShaper tests
     TestRunner_TextShaper_construction runner_TextShaper_construction;
+    TestRunner_TextShaper_word_cache runner_TextShaper_word_cache;
+    TestRunner_TextShaper_shape_into runner_TextShaper_shape_into;
+    TestRunner_UTF8_decode runner_UTF8_decode;
+    TestRunner_GlyphSubstitution_lookups runner_GlyphSubstitution_lookups;
+    TestRunner_GlyphPositioning_pairs runner_GlyphPositioning_pairs;
+    TestRunner_Bidi_levels runner_Bidi_levels;
+    TestRunner_LineBreak_reflow runner_LineBreak_reflow;
+    TestRunner_TextRenderer_reflow_bidi runner_TextRenderer_reflow_bidi;
 
     // TextCursor tests
     TestRunner_TextCursor_construction runner_TextCursor_construction;
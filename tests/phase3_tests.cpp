@@ -2,16 +2,20 @@
  * @file phase3_tests.cpp
  * @brief Phase 3 unit tests for DaktLib-GUI rendering backend
  *
- * Tests backend interface, draw batching, and shader structures.
+ * Tests backend interface, draw batching, shader structures, and the
+ * retained widget measure cache.
  */
 
 #include "dakt/gui/backend/IRenderBackend.hpp"
+#include "dakt/gui/backend/null/NullBackend.hpp"
+#include "dakt/gui/retained/widgets/WidgetBase.hpp"
 #include "dakt/gui/subsystems/draw/DrawBatcher.hpp"
 #include "dakt/gui/subsystems/draw/DrawList.hpp"
 
 #include <cassert>
 #include <cmath>
 #include <cstdio>
+#include <memory>
 
 using namespace dakt::gui;
 
@@ -125,6 +129,65 @@ TEST(backend_capabilities) {
     ASSERT(caps.deviceName == "Test Device");
 }
 
+// ============================================================================
+// NullBackend Tests
+// ============================================================================
+
+TEST(null_backend_records_submit) {
+    NullBackend backend;
+    ASSERT(backend.initialize(nullptr, 800, 600));
+    ASSERT(!backend.supportsGpuTimings());
+
+    DrawList drawList;
+    drawList.drawRectFilled(Rect(0, 0, 100, 100), Color(1, 0, 0, 1));
+    drawList.drawRectFilled(Rect(10, 10, 50, 50), Color(0, 1, 0, 1));
+
+    ASSERT(backend.beginFrame());
+    backend.submit(drawList);
+    backend.endFrame();
+    backend.present();
+
+    ASSERT_EQ(backend.getSubmits().size(), 1u);
+    const auto& record = backend.getSubmits()[0];
+    ASSERT_EQ(record.frameIndex, 1u);
+    ASSERT_EQ(record.vertexCount, 8u);
+    ASSERT_EQ(record.indexCount, 12u);
+    ASSERT_EQ(record.vertexBytes, 8u * sizeof(Vertex));
+    ASSERT_EQ(backend.getFrameStats().vertices, 8u);
+    ASSERT_EQ(backend.getTotalStats().frames, 1u);
+}
+
+TEST(null_backend_resource_bytes) {
+    NullBackend backend;
+    ASSERT(backend.initialize(nullptr, 800, 600));
+
+    uint8_t pixels[16 * 16] = {};
+    TextureDesc texDesc;
+    texDesc.width = 16;
+    texDesc.height = 16;
+    texDesc.format = TextureFormat::R8;
+    texDesc.initialData = pixels;
+    TextureHandle tex = backend.createTexture(texDesc);
+    ASSERT(tex != InvalidTexture);
+    backend.updateTexture(tex, pixels, 16, 16);
+
+    BufferDesc bufDesc;
+    bufDesc.size = 1024;
+    BufferHandle buf = backend.createBuffer(bufDesc);
+    uint32_t data[64] = {};
+    backend.updateBuffer(buf, data, sizeof(data), 128);
+
+    const auto& stats = backend.getTotalStats();
+    ASSERT_EQ(stats.textureBytesUploaded, 512u);
+    ASSERT_EQ(stats.bufferBytesUploaded, 256u);
+    ASSERT_EQ(backend.getResourceOps().size(), 4u);
+
+    backend.destroyBuffer(buf);
+    backend.destroyTexture(tex);
+    ASSERT_EQ(backend.getLiveBufferCount(), 0u);
+    ASSERT_EQ(backend.getLiveTextureCount(), 0u);
+}
+
 // ============================================================================
 // DrawBatcher Tests
 // ============================================================================
@@ -227,6 +290,30 @@ TEST(draw_batcher_clip_rect) {
     ASSERT(stats.clipRectChanges >= 1);
 }
 
+TEST(draw_batcher_shader_clip_merges) {
+    DrawBatcher batcher;
+    DrawList drawList;
+    drawList.setClipMode(ClipMode::Shader);
+
+    // One clip per cell, as tables do
+    for (int i = 0; i < 8; ++i) {
+        drawList.pushClipRect(Rect(i * 20.0f, 0, 20, 20));
+        drawList.drawRectFilled(Rect(i * 20.0f, 0, 30, 20), Color(1, 0, 0, 1));
+        drawList.popClipRect();
+    }
+
+    batcher.batchCommands(drawList);
+
+    ASSERT_EQ(batcher.getStats().batchedCommandCount, 1u);
+    ASSERT_EQ(batcher.getStats().clipRectChanges, 0u);
+    ASSERT_EQ(drawList.getClipTable().size(), 9u);
+
+    const auto& vertices = drawList.getVertices();
+    ASSERT_EQ(vertices.front().clipIndex, 1u);
+    ASSERT_EQ(vertices.back().clipIndex, 8u);
+    ASSERT(drawList.getClipTable()[8] == Rect(140, 0, 20, 20));
+}
+
 TEST(draw_batcher_sort_by_texture) {
     DrawBatcher batcher;
     batcher.setSortByTexture(true);
@@ -327,6 +414,76 @@ TEST(vertex_construction) {
     ASSERT(v.color.r == 1.0f);
 }
 
+// ============================================================================
+// Widget Measure Cache Tests
+// ============================================================================
+
+namespace {
+struct CountingWidget : Widget {
+    int measureCount = 0;
+    Vec2 measureContent() override {
+        ++measureCount;
+        return Vec2(120, 30);
+    }
+};
+} // namespace
+
+TEST(widget_measure_cache) {
+    Widget parent;
+    auto child = std::make_unique<CountingWidget>();
+    CountingWidget* childPtr = child.get();
+    parent.addChild(std::move(child));
+
+    // Repeated measurement is answered from the cache, including through the parent
+    ASSERT_EQ(parent.measure().y, 30.0f);
+    ASSERT_EQ(childPtr->measure().x, 120.0f);
+    ASSERT_EQ(parent.measure().y, 30.0f);
+    ASSERT_EQ(childPtr->measureCount, 1);
+
+    // Constraint-aware overload clamps to the available size only
+    Vec2 constrained = childPtr->measure(Vec2(100, 500));
+    ASSERT_EQ(constrained.x, 100.0f);
+    ASSERT_EQ(constrained.y, 30.0f);
+    ASSERT_EQ(childPtr->measureCount, 1);
+
+    // Dirtying the child drops its cache and its parent's
+    childPtr->markDirty();
+    parent.measure();
+    ASSERT_EQ(childPtr->measureCount, 2);
+    childPtr->measure();
+    ASSERT_EQ(childPtr->measureCount, 2);
+
+    // The constrained cache is dropped too, even for the same available size
+    childPtr->markDirty();
+    ASSERT_EQ(childPtr->measure(Vec2(100, 500)).x, 100.0f);
+    ASSERT_EQ(childPtr->measureCount, 3);
+}
+
+TEST(widget_measure_cache_propagates) {
+    Widget root;
+    auto middle = std::make_unique<Widget>();
+    auto leaf = std::make_unique<CountingWidget>();
+    CountingWidget* leafPtr = leaf.get();
+    Widget* middlePtr = middle.get();
+    middle->addChild(std::move(leaf));
+    root.addChild(std::move(middle));
+
+    ASSERT_EQ(root.measure(Vec2(500, 500)).x, 120.0f);
+    ASSERT_EQ(leafPtr->measureCount, 1);
+
+    // propagateDirty() invalidates every ancestor, not just the direct parent
+    leafPtr->markDirty();
+    ASSERT(middlePtr->isDirty());
+    ASSERT(root.isDirty());
+    ASSERT_EQ(root.measure(Vec2(500, 500)).x, 120.0f);
+    ASSERT_EQ(leafPtr->measureCount, 2);
+
+    // Layout changes on a descendant invalidate as well
+    leafPtr->markNeedsLayout();
+    root.measure();
+    ASSERT_EQ(leafPtr->measureCount, 3);
+}
+
 // ============================================================================
 // Main
 // ============================================================================
@@ -343,6 +500,10 @@ int main() {
     TestRunner_texture_desc runner_texture_desc;
     TestRunner_backend_capabilities runner_backend_capabilities;
 
+    // NullBackend tests
+    TestRunner_null_backend_records_submit runner_null_backend_records_submit;
+    TestRunner_null_backend_resource_bytes runner_null_backend_resource_bytes;
+
     // DrawBatcher tests
     TestRunner_draw_batcher_construction runner_draw_batcher_construction;
     TestRunner_draw_batcher_reset runner_draw_batcher_reset;
@@ -351,6 +512,7 @@ int main() {
     TestRunner_draw_batcher_multiple_same_state runner_draw_batcher_multiple_same_state;
     TestRunner_draw_batcher_texture_changes runner_draw_batcher_texture_changes;
     TestRunner_draw_batcher_clip_rect runner_draw_batcher_clip_rect;
+    TestRunner_draw_batcher_shader_clip_merges runner_draw_batcher_shader_clip_merges;
     TestRunner_draw_batcher_sort_by_texture runner_draw_batcher_sort_by_texture;
 
     // RenderState tests
@@ -365,6 +527,10 @@ int main() {
     // Vertex tests
     TestRunner_vertex_construction runner_vertex_construction;
 
+    // Widget measure cache tests
+    TestRunner_widget_measure_cache runner_widget_measure_cache;
+    TestRunner_widget_measure_cache_propagates runner_widget_measure_cache_propagates;
+
     printf("\n======== ✓ All Phase 3 tests passed! ========\n\n");
     return 0;
 }
@@ -0,0 +1,302 @@
+/**
+ * @file FontBake.cpp
+ * @brief dakt-fontbake: bake SDF/MSDF glyph atlases offline
+ *
+ * Rasterizes the characters an application needs at the sizes it uses and
+ * writes them as .daktfont files that GlyphAtlas::loadFromFile() reads with
+ * no rasterization. With --embed each atlas is also written as a C++ header
+ * for GlyphAtlas::loadFromMemory(), for builds that ship no font files.
+ */
+
+#include "dakt/gui/subsystems/text/Font.hpp"
+#include "dakt/gui/subsystems/text/GlyphAtlas.hpp"
+#include "dakt/gui/subsystems/text/UTF8.hpp"
+
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dakt::gui;
+namespace fs = std::filesystem;
+
+struct BakeOptions {
+    std::vector<std::string> fonts;
+    std::vector<float> sizes;
+    std::set<uint32_t> codepoints;
+    std::string outDir = ".";
+    uint32_t spread = 2;
+    uint32_t pageSize = 512;
+    bool msdf = false;
+    bool embed = false;
+};
+
+static void printUsage() {
+    std::printf("Usage: dakt-fontbake --font FILE [options]\n"
+                "\n"
+                "  --font FILE        Font to bake (repeatable); writes <out>/<font name>.daktfont\n"
+                "  --size PX          Font size in pixels (repeatable, default 16)\n"
+                "  --charset SET      ascii, latin1, latin-ext or a range like U+0400-U+04FF (repeatable)\n"
+                "  --chars TEXT       Characters to bake, as UTF-8\n"
+                "  --scan PATH        Bake every character in a string table file, or in every file under a directory\n"
+                "  --spread PX        SDF spread in pixels (default 2)\n"
+                "  --msdf             Bake multi-channel SDF pages\n"
+                "  --page-size PX     Atlas page width and height (default 512)\n"
+                "  -o, --out DIR      Output directory (default .)\n"
+                "  --embed            Also write <font name>.hpp holding the atlas as a C++ array\n"
+                "\n"
+                "Without --charset, --chars or --scan, printable ASCII is baked.\n");
+}
+
+static void addRange(uint32_t first, uint32_t last, std::set<uint32_t>& out) {
+    for (uint32_t codepoint = first; codepoint <= last; ++codepoint) {
+        out.insert(codepoint);
+    }
+}
+
+static bool addCharset(const std::string& name, std::set<uint32_t>& out) {
+    if (name == "ascii") {
+        addRange(0x20, 0x7E, out);
+    } else if (name == "latin1") {
+        addRange(0x20, 0x7E, out);
+        addRange(0xA0, 0xFF, out);
+    } else if (name == "latin-ext") {
+        addRange(0x20, 0x7E, out);
+        addRange(0xA0, 0x24F, out);
+    } else {
+        unsigned first = 0, last = 0;
+        if (std::sscanf(name.c_str(), "U+%x-U+%x", &first, &last) != 2 && std::sscanf(name.c_str(), "0x%x-0x%x", &first, &last) != 2) {
+            return false;
+        }
+        if (first > last || last > 0x10FFFF) {
+            return false;
+        }
+        addRange(first, last, out);
+    }
+    return true;
+}
+
+// Every printable character of UTF-8 text
+static void addText(const std::string& text, std::set<uint32_t>& out) {
+    std::vector<uint32_t> codepoints;
+    utf8::decode(text, codepoints);
+    for (uint32_t codepoint : codepoints) {
+        if (codepoint >= 0x20 && codepoint != 0x7F && codepoint != 0xFFFD) {
+            out.insert(codepoint);
+        }
+    }
+}
+
+static bool scanStrings(const std::string& path, std::set<uint32_t>& out) {
+    std::error_code error;
+    std::vector<fs::path> files;
+    if (fs::is_directory(path, error)) {
+        for (const auto& entry : fs::recursive_directory_iterator(path, error)) {
+            if (entry.is_regular_file()) {
+                files.push_back(entry.path());
+            }
+        }
+    } else {
+        files.push_back(path);
+    }
+
+    for (const auto& file : files) {
+        std::ifstream stream(file, std::ios::binary);
+        if (!stream.is_open()) {
+            std::fprintf(stderr, "dakt-fontbake: cannot read %s\n", file.string().c_str());
+            return false;
+        }
+        std::ostringstream text;
+        text << stream.rdbuf();
+        addText(text.str(), out);
+    }
+    return true;
+}
+
+static bool parseArgs(int argc, char** argv, BakeOptions& options) {
+    bool charsetGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        auto value = [&]() -> std::string { return argv[++i]; };
+
+        if (arg == "--font" && hasValue) {
+            options.fonts.push_back(value());
+        } else if (arg == "--size" && hasValue) {
+            const float size = std::strtof(argv[++i], nullptr);
+            if (size <= 0.0f) {
+                std::fprintf(stderr, "dakt-fontbake: bad size %s\n", argv[i]);
+                return false;
+            }
+            options.sizes.push_back(size);
+        } else if (arg == "--charset" && hasValue) {
+            const std::string name = value();
+            if (!addCharset(name, options.codepoints)) {
+                std::fprintf(stderr, "dakt-fontbake: unknown charset %s\n", name.c_str());
+                return false;
+            }
+            charsetGiven = true;
+        } else if (arg == "--chars" && hasValue) {
+            addText(value(), options.codepoints);
+            charsetGiven = true;
+        } else if (arg == "--scan" && hasValue) {
+            if (!scanStrings(value(), options.codepoints)) {
+                return false;
+            }
+            charsetGiven = true;
+        } else if (arg == "--spread" && hasValue) {
+            options.spread = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--page-size" && hasValue) {
+            options.pageSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if ((arg == "-o" || arg == "--out") && hasValue) {
+            options.outDir = value();
+        } else if (arg == "--msdf") {
+            options.msdf = true;
+        } else if (arg == "--embed") {
+            options.embed = true;
+        } else if (arg == "-h" || arg == "--help") {
+            printUsage();
+            std::exit(0);
+        } else {
+            std::fprintf(stderr, "dakt-fontbake: unexpected argument %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.fonts.empty() || options.pageSize == 0) {
+        return false;
+    }
+    if (options.sizes.empty()) {
+        options.sizes.push_back(16.0f);
+    }
+    if (!charsetGiven) {
+        addCharset("ascii", options.codepoints);
+    }
+    return true;
+}
+
+// C identifier for a font: "NotoSans-Regular" -> "NOTOSANS_REGULAR_DAKTFONT"
+static std::string symbolName(const std::string& stem) {
+    std::string symbol;
+    if (stem.empty() || std::isdigit(static_cast<unsigned char>(stem[0]))) {
+        symbol = "FONT_";
+    }
+    for (char c : stem) {
+        symbol += std::isalnum(static_cast<unsigned char>(c)) ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : '_';
+    }
+    return symbol + "_DAKTFONT";
+}
+
+static bool writeEmbedded(const fs::path& path, const std::string& symbol, const std::string& source, const std::vector<uint8_t>& data) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "/**\n"
+         << " * @file " << path.filename().string() << "\n"
+         << " * @brief Baked glyph atlas for " << source << "\n"
+         << " *\n"
+         << " * Generated by dakt-fontbake - do not edit. Load with\n"
+         << " * GlyphAtlas::loadFromMemory(" << symbol << ", sizeof(" << symbol << ")).\n"
+         << " */\n\n"
+         << "#pragma once\n\n"
+         << "#include <cstdint>\n\n"
+         << "namespace dakt::gui::fonts {\n\n"
+         << "alignas(8) static const uint8_t " << symbol << "[] = {\n";
+
+    char line[8 + 16 * 6];
+    for (size_t i = 0; i < data.size(); i += 16) {
+        int length = std::snprintf(line, sizeof(line), "   ");
+        for (size_t j = i; j < data.size() && j < i + 16; ++j) {
+            length += std::snprintf(line + length, sizeof(line) - length, " 0x%02x,", data[j]);
+        }
+        file << line << "\n";
+    }
+
+    file << "};\n\n"
+         << "} // namespace dakt::gui::fonts\n";
+    return static_cast<bool>(file);
+}
+
+static bool bakeFont(const std::string& fontPath, const BakeOptions& options) {
+    Font font;
+    if (!font.loadFromFile(fontPath)) {
+        std::fprintf(stderr, "dakt-fontbake: cannot load font %s\n", fontPath.c_str());
+        return false;
+    }
+
+    GlyphAtlas atlas(options.pageSize, options.pageSize);
+    atlas.setSDFSpread(options.spread);
+    atlas.setMSDF(options.msdf);
+    atlas.setFontInfo(font);
+
+    // Sizes and characters in ascending order keep the output byte-identical across runs
+    for (float size : options.sizes) {
+        atlas.addGlyph(font, 0, size); // .notdef, drawn for characters the font lacks
+        for (uint32_t codepoint : options.codepoints) {
+            atlas.addCodepoint(font, codepoint, size);
+        }
+    }
+
+    std::vector<uint8_t> data;
+    if (!atlas.saveToMemory(data)) {
+        std::fprintf(stderr, "dakt-fontbake: cannot serialize atlas for %s\n", fontPath.c_str());
+        return false;
+    }
+
+    const std::string stem = fs::path(fontPath).stem().string();
+    const fs::path outPath = fs::path(options.outDir) / (stem + ".daktfont");
+    {
+        std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            std::fprintf(stderr, "dakt-fontbake: cannot write %s\n", outPath.string().c_str());
+            return false;
+        }
+    }
+
+    if (options.embed) {
+        const fs::path headerPath = fs::path(options.outDir) / (stem + ".hpp");
+        if (!writeEmbedded(headerPath, symbolName(stem), fs::path(fontPath).filename().string(), data)) {
+            std::fprintf(stderr, "dakt-fontbake: cannot write %s\n", headerPath.string().c_str());
+            return false;
+        }
+    }
+
+    size_t missing = 0;
+    for (uint32_t codepoint : options.codepoints) {
+        missing += atlas.findGlyphId(codepoint) == 0 ? 1 : 0;
+    }
+    std::printf("%s: %zu characters x %zu sizes, %u pages, %zu bytes -> %s", fontPath.c_str(), options.codepoints.size() - missing, options.sizes.size(), atlas.getPageCount(),
+                data.size(), outPath.string().c_str());
+    if (missing > 0) {
+        std::printf(" (%zu characters not in font)", missing);
+    }
+    std::printf("\n");
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BakeOptions options;
+    if (!parseArgs(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    std::error_code error;
+    fs::create_directories(options.outDir, error);
+
+    int failures = 0;
+    for (const std::string& fontPath : options.fonts) {
+        if (!bakeFont(fontPath, options)) {
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Generate src/subsystems/text/BidiTables.hpp from Python's unicodedata.
+
+Usage: python3 tools/gen_bidi_tables.py > src/subsystems/text/BidiTables.hpp
+
+Bidi classes use a two-stage table: STAGE1 maps each 128-codepoint block to
+a deduplicated block in STAGE2. Unassigned codepoints take the defaults from
+DerivedBidiClass.txt. Bracket pairs are the mirrored Ps/Pe pairs listed in
+BidiBrackets.txt.
+"""
+
+import unicodedata
+
+# Order must match dakt::gui::BidiClass
+CLASSES = ['L', 'R', 'AL', 'EN', 'ES', 'ET', 'AN', 'CS', 'NSM', 'BN', 'B', 'S', 'WS', 'ON',
+           'LRE', 'LRO', 'RLE', 'RLO', 'PDF', 'LRI', 'RLI', 'FSI', 'PDI']
+
+BLOCK_SHIFT = 7
+
+DEFAULT_R = [(0x0590, 0x05FF), (0x07C0, 0x085F), (0xFB1D, 0xFB4F), (0x10800, 0x10CFF), (0x10D40, 0x10EBF),
+             (0x10F00, 0x10F2F), (0x10F70, 0x10FFF), (0x1E800, 0x1EC6F), (0x1ECC0, 0x1ECFF), (0x1ED50, 0x1EDFF),
+             (0x1EF00, 0x1EFFF)]
+DEFAULT_AL = [(0x0600, 0x07BF), (0x0860, 0x08FF), (0xFB50, 0xFDCF), (0xFDF0, 0xFDFF), (0xFE70, 0xFEFF),
+              (0x10D00, 0x10D3F), (0x10EC0, 0x10EFF), (0x10F30, 0x10F6F), (0x1EC70, 0x1ECBF), (0x1ED00, 0x1ED4F),
+              (0x1EE00, 0x1EEFF)]
+DEFAULT_ET = [(0x20A0, 0x20CF)]
+DEFAULT_BN = [(0x2060, 0x206F), (0xFDD0, 0xFDEF), (0xFFF0, 0xFFF8), (0x1BCA0, 0x1BCA3), (0xE0000, 0xE0FFF)]
+
+
+def in_ranges(cp, ranges):
+    return any(start <= cp <= end for start, end in ranges)
+
+
+def bidi_class(cp):
+    value = '' if 0xD800 <= cp <= 0xDFFF else unicodedata.bidirectional(chr(cp))
+    if value:
+        return value
+    if in_ranges(cp, DEFAULT_R):
+        return 'R'
+    if in_ranges(cp, DEFAULT_AL):
+        return 'AL'
+    if in_ranges(cp, DEFAULT_ET):
+        return 'ET'
+    if in_ranges(cp, DEFAULT_BN) or (cp & 0xFFFE) == 0xFFFE:
+        return 'BN'
+    return 'L'
+
+
+def closing_bracket(cp):
+    char = chr(cp)
+    name = unicodedata.name(char, '')
+    for closing in (name.replace('LEFT', 'RIGHT'), name.replace('OPENING', 'CLOSING')):
+        if closing == name:
+            continue
+        try:
+            other = unicodedata.lookup(closing)
+        except KeyError:
+            continue
+        if unicodedata.category(other) == 'Pe':
+            return ord(other)
+    if unicodedata.category(chr(cp + 1)) == 'Pe':
+        return cp + 1
+    return None
+
+
+def bracket_pairs():
+    pairs = []
+    for cp in range(0x110000):
+        char = chr(cp)
+        if unicodedata.category(char) == 'Ps' and unicodedata.mirrored(char) and bidi_class(cp) == 'ON':
+            closing = closing_bracket(cp)
+            if closing is not None:
+                pairs.append((cp, closing))
+    return pairs
+
+
+def rows(values, per_row):
+    for i in range(0, len(values), per_row):
+        yield '    ' + ', '.join(str(v) for v in values[i:i + per_row]) + ','
+
+
+def two_stage(values):
+    """Split per-codepoint values into (stage1, stage2, distinct block count)."""
+    block_size = 1 << BLOCK_SHIFT
+    blocks = {}
+    stage1 = []
+    stage2 = []
+    for start in range(0, len(values), block_size):
+        block = tuple(values[start:start + block_size])
+        if block not in blocks:
+            blocks[block] = len(blocks)
+            stage2.extend(block)
+        stage1.append(blocks[block])
+    assert len(blocks) < 256
+    return stage1, stage2, len(blocks)
+
+
+def stage_arrays(stage1, stage2, block_count, value_name):
+    """C++ definitions of the two stages."""
+    out = [f'constexpr uint32_t BLOCK_SHIFT = {BLOCK_SHIFT};', '']
+    out.append(f'// Block of 128 codepoints -> block in STAGE2 ({len(stage1)} entries)')
+    out.append(f'constexpr uint8_t STAGE1[{len(stage1)}] = {{')
+    out.extend(rows(stage1, 24))
+    out.append('};')
+    out.append('')
+    out.append(f'// {value_name} per codepoint within each of the {block_count} distinct blocks')
+    out.append(f'constexpr uint8_t STAGE2[{len(stage2)}] = {{')
+    out.extend(rows(stage2, 32))
+    out.append('};')
+    return out
+
+
+def main():
+    values = [CLASSES.index(bidi_class(cp)) for cp in range(0x110000)]
+    stage1, stage2, block_count = two_stage(values)
+    pairs = bracket_pairs()
+
+    out = []
+    out.append('// Generated by tools/gen_bidi_tables.py from Unicode ' + unicodedata.unidata_version + ' - do not edit')
+    out.append('#ifndef DAKTLIB_GUI_BIDI_TABLES_HPP')
+    out.append('#define DAKTLIB_GUI_BIDI_TABLES_HPP')
+    out.append('')
+    out.append('#include <cstdint>')
+    out.append('')
+    out.append('namespace dakt::gui::bidi_tables {')
+    out.append('')
+    out.extend(stage_arrays(stage1, stage2, block_count, 'Bidi class'))
+    out.append('')
+    out.append('struct BracketPair {')
+    out.append('    uint32_t open;')
+    out.append('    uint32_t close;')
+    out.append('};')
+    out.append('')
+    out.append('// Paired brackets, sorted by opening bracket')
+    out.append(f'constexpr BracketPair BRACKETS[{len(pairs)}] = {{')
+    for i in range(0, len(pairs), 4):
+        out.append('    ' + ' '.join(f'{{{o:#06x}, {c:#06x}}},' for o, c in pairs[i:i + 4]))
+    out.append('};')
+    out.append('')
+    out.append('} // namespace dakt::gui::bidi_tables')
+    out.append('')
+    out.append('#endif // DAKTLIB_GUI_BIDI_TABLES_HPP')
+    print('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()
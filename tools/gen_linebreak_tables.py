@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+"""Generate src/subsystems/text/LineBreakTables.hpp.
+
+Usage: python3 tools/gen_linebreak_tables.py [LineBreak.txt] > src/subsystems/text/LineBreakTables.hpp
+
+With LineBreak.txt from the Unicode Character Database the classes are
+exact. Without it, classes are derived from Python's unicodedata (general
+category, East Asian width, bidi class and a list of characters the
+categories do not separate); this matches LineBreak.txt for the scripts
+the UI ships with but is approximate elsewhere.
+"""
+
+import re
+import sys
+import unicodedata
+
+from gen_bidi_tables import stage_arrays, two_stage
+
+# Order must match dakt::gui::LineBreakClass
+CLASSES = ['BK', 'CR', 'LF', 'CM', 'NL', 'SG', 'WJ', 'ZW', 'GL', 'SP', 'ZWJ', 'B2', 'BA', 'BB', 'HY', 'CB',
+           'CL', 'CP', 'EX', 'IN', 'NS', 'OP', 'QU', 'IS', 'NU', 'PO', 'PR', 'SY', 'AI', 'AL', 'CJ', 'EB',
+           'EM', 'H2', 'H3', 'HL', 'ID', 'JL', 'JV', 'JT', 'RI', 'SA', 'XX']
+
+EXPLICIT = {
+    0x09: 'BA', 0x0A: 'LF', 0x0B: 'BK', 0x0C: 'BK', 0x0D: 'CR', 0x20: 'SP', 0x21: 'EX', 0x22: 'QU', 0x23: 'AL',
+    0x24: 'PR', 0x25: 'PO', 0x27: 'QU', 0x28: 'OP', 0x29: 'CP', 0x2B: 'PR', 0x2C: 'IS', 0x2D: 'HY', 0x2E: 'IS',
+    0x2F: 'SY', 0x3A: 'IS', 0x3B: 'IS', 0x3F: 'EX', 0x5B: 'OP', 0x5C: 'PR', 0x5D: 'CP', 0x7B: 'OP', 0x7C: 'BA',
+    0x7D: 'CL', 0x85: 'NL', 0xA0: 'GL', 0xA1: 'OP', 0xA2: 'PO', 0xA3: 'PR', 0xA4: 'PR', 0xA5: 'PR', 0xA7: 'AI',
+    0xAB: 'QU', 0xAD: 'BA', 0xB0: 'PO', 0xB1: 'PR', 0xB4: 'BB', 0xB7: 'AI', 0xBB: 'QU', 0xBF: 'OP',
+    0x02C8: 'BB', 0x02CC: 'BB', 0x02DF: 'BB', 0x034F: 'GL', 0x058A: 'BA', 0x05BE: 'BA', 0x0F0B: 'BA',
+    0x0F0C: 'GL', 0x1680: 'BA', 0x180E: 'GL', 0x1FFD: 'BB', 0x2007: 'GL', 0x200B: 'ZW', 0x200D: 'ZWJ',
+    0x2010: 'BA', 0x2011: 'GL', 0x2012: 'BA', 0x2013: 'BA', 0x2014: 'B2', 0x2024: 'IN', 0x2025: 'IN',
+    0x2026: 'IN', 0x2027: 'BA', 0x2028: 'BK', 0x2029: 'BK', 0x202F: 'GL', 0x2039: 'QU', 0x203A: 'QU',
+    0x203C: 'NS', 0x203D: 'NS', 0x2044: 'IS', 0x2047: 'NS', 0x2048: 'NS', 0x2049: 'NS', 0x2060: 'WJ',
+    0x20AC: 'PR', 0x2116: 'PR', 0x2212: 'PR', 0x2213: 'PR', 0x22EF: 'IN', 0x3000: 'BA', 0x3001: 'CL',
+    0x3002: 'CL', 0x3005: 'NS', 0x301C: 'NS', 0x303B: 'NS', 0x30A0: 'NS', 0x30FB: 'NS', 0x30FC: 'CJ',
+    0x30FD: 'NS', 0x30FE: 'NS', 0xFE19: 'IN', 0xFEFF: 'WJ', 0xFF01: 'EX', 0xFF0C: 'CL', 0xFF0E: 'CL',
+    0xFF1A: 'NS', 0xFF1B: 'NS', 0xFF1F: 'EX', 0xFFFC: 'CB',
+}
+
+# Small kana and prolonged sound marks (CJ), iteration marks (NS)
+SMALL_KANA = [0x3041, 0x3043, 0x3045, 0x3047, 0x3049, 0x3063, 0x3083, 0x3085, 0x3087, 0x308E, 0x3095, 0x3096,
+              0x30A1, 0x30A3, 0x30A5, 0x30A7, 0x30A9, 0x30C3, 0x30E3, 0x30E5, 0x30E7, 0x30EE, 0x30F5, 0x30F6]
+
+# South East Asian scripts that need dictionary breaking (SA)
+SA_RANGES = [(0x0E00, 0x0EFF), (0x1000, 0x109F), (0x1780, 0x17FF), (0x1950, 0x19DF), (0x1A20, 0x1AAF),
+             (0xA9E0, 0xA9FF), (0xAA60, 0xAADF), (0x11700, 0x1174F)]
+
+# Unassigned codepoints here default to ID
+ID_RANGES = [(0x3400, 0x4DBF), (0x4E00, 0x9FFF), (0xF900, 0xFAFF), (0x1F000, 0x1FAFF), (0x20000, 0x2FFFD),
+             (0x30000, 0x3FFFD)]
+
+
+def in_ranges(cp, ranges):
+    return any(start <= cp <= end for start, end in ranges)
+
+
+def derived_class(cp):
+    if cp in EXPLICIT:
+        return EXPLICIT[cp]
+    if 0xD800 <= cp <= 0xDFFF:
+        return 'SG'
+    if cp in SMALL_KANA:
+        return 'CJ'
+    if 0x1F1E6 <= cp <= 0x1F1FF:
+        return 'RI'
+    if 0x1F3FB <= cp <= 0x1F3FF:
+        return 'EM'
+    if 0x1100 <= cp <= 0x115F or 0xA960 <= cp <= 0xA97C:
+        return 'JL'
+    if 0x1160 <= cp <= 0x11A7 or 0xD7B0 <= cp <= 0xD7C6:
+        return 'JV'
+    if 0x11A8 <= cp <= 0x11FF or 0xD7CB <= cp <= 0xD7FB:
+        return 'JT'
+    if 0xAC00 <= cp <= 0xD7A3:
+        return 'H2' if (cp - 0xAC00) % 28 == 0 else 'H3'
+
+    char = chr(cp)
+    category = unicodedata.category(char)
+    wide = unicodedata.east_asian_width(char) in ('W', 'F')
+
+    if category == 'Cn':
+        return 'ID' if in_ranges(cp, ID_RANGES) else 'XX'
+    if category in ('Mn', 'Mc', 'Me'):
+        return 'SA' if in_ranges(cp, SA_RANGES) else 'CM'
+    if category in ('Cc', 'Cf'):
+        return 'CM'
+    if in_ranges(cp, SA_RANGES) and category.startswith('L'):
+        return 'SA'
+    if category == 'Zs':
+        return 'BA'
+    if category in ('Zl', 'Zp'):
+        return 'BK'
+    if category == 'Ps':
+        return 'OP'
+    if category == 'Pe':
+        return 'CL'
+    if category in ('Pi', 'Pf'):
+        return 'QU'
+    if category == 'Pd':
+        return 'BA'
+    if category == 'Sc':
+        return 'PR'
+    if category == 'Nd':
+        return 'ID' if wide else 'NU'
+    if category in ('Lo', 'Lm') and unicodedata.bidirectional(char) == 'R' and 0x0590 <= cp <= 0x05FF:
+        return 'HL'
+    if 0xFB1D <= cp <= 0xFB4F and category == 'Lo':
+        return 'HL'
+    if wide:
+        return 'ID'
+    return 'AL'
+
+
+def parse_linebreak(path):
+    values = ['XX'] * 0x110000
+    pattern = re.compile(r'^([0-9A-F]+)(?:\.\.([0-9A-F]+))?\s*;\s*(\w+)')
+    with open(path, encoding='utf-8') as source:
+        for line in source:
+            match = pattern.match(line)
+            if match:
+                start = int(match.group(1), 16)
+                end = int(match.group(2), 16) if match.group(2) else start
+                for cp in range(start, end + 1):
+                    values[cp] = match.group(3)
+    return values
+
+
+def main():
+    if len(sys.argv) > 1:
+        names = parse_linebreak(sys.argv[1])
+        source = 'LineBreak.txt'
+    else:
+        names = [derived_class(cp) for cp in range(0x110000)]
+        source = 'unicodedata (derived)'
+    stage1, stage2, block_count = two_stage([CLASSES.index(name) for name in names])
+
+    out = []
+    out.append(f'// Generated by tools/gen_linebreak_tables.py from Unicode {unicodedata.unidata_version} {source} - do not edit')
+    out.append('#ifndef DAKTLIB_GUI_LINEBREAK_TABLES_HPP')
+    out.append('#define DAKTLIB_GUI_LINEBREAK_TABLES_HPP')
+    out.append('')
+    out.append('#include <cstdint>')
+    out.append('')
+    out.append('namespace dakt::gui::linebreak_tables {')
+    out.append('')
+    out.extend(stage_arrays(stage1, stage2, block_count, 'Line break class'))
+    out.append('')
+    out.append('} // namespace dakt::gui::linebreak_tables')
+    out.append('')
+    out.append('#endif // DAKTLIB_GUI_LINEBREAK_TABLES_HPP')
+    print('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()